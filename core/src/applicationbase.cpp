@@ -102,6 +102,7 @@ void ApplicationBase::run()
         }
 
         hasDevices = false;
+        m_->debugInformation().scenesInformation.clear();
 
         if (const auto& scene = m_->scene())
         {
@@ -185,6 +186,16 @@ uint32_t ApplicationBase::FPS() const
     return m_->FPS();
 }
 
+const debug::Information& ApplicationBase::debugInformation() const
+{
+    return const_cast<ApplicationBase*>(this)->debugInformation();
+}
+
+debug::Information& ApplicationBase::debugInformation()
+{
+    return m_->debugInformation();
+}
+
 ApplicationBase::ApplicationBase(
     const std::string& name,
     ApplicationTimeCallback timeCallback,
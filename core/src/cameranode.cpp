@@ -38,6 +38,8 @@ CameraNode::CameraNode(const std::string& name)
     setCullPlanesLimits(cameraSettings.cullPlaneLimits());
     setZRange(cameraSettings.ZRange());
     setClusterSize(cameraSettings.clusterSize());
+    setAutoInstancingEnabled(settings::Settings::instance().graphics().autoInstancing());
+    setLightBinningEnabled(settings::Settings::instance().graphics().lightBinning());
     useDefaultFramebuffer();
 }
 
@@ -158,6 +160,30 @@ void CameraNode::setClusterSize(const glm::uvec3& value)
     m().clusterSize() = value;
 }
 
+bool CameraNode::isAutoInstancingEnabled() const
+{
+    return m().isAutoInstancingEnabled();
+}
+
+void CameraNode::setAutoInstancingEnabled(bool value)
+{
+    auto& mPrivate = m();
+    mPrivate.isAutoInstancingEnabled() = value;
+    if (auto& renderPipeLine = mPrivate.renderPipeLine()) renderPipeLine->setAutoInstancingEnabled(value);
+}
+
+bool CameraNode::isLightBinningEnabled() const
+{
+    return m().isLightBinningEnabled();
+}
+
+void CameraNode::setLightBinningEnabled(bool value)
+{
+    auto& mPrivate = m();
+    mPrivate.isLightBinningEnabled() = value;
+    if (auto& renderPipeLine = mPrivate.renderPipeLine()) renderPipeLine->setLightBinningEnabled(value);
+}
+
 ShadowsSettings& CameraNode::shadowsSettings()
 {
     return *m().shadowsSettings();
@@ -35,6 +35,9 @@ void CameraNodePrivate::onAttachToScene(const std::shared_ptr<Scene>& scene)
 
     m_renderPipeLine = std::make_shared<RenderPipeLine>(scene->m().shadowAtlasSize());
 
+    m_renderPipeLine->setAutoInstancingEnabled(m_isAutoInstancingEnabled);
+    m_renderPipeLine->setLightBinningEnabled(m_isLightBinningEnabled);
+
     m_renderPipeLine->setShadowFilter(m_shadowsSettings->filter());
     m_renderPipeLine->setShadowBlurSigma(m_shadowsSettings->blurSigma());
     m_renderPipeLine->setShadowLightBleedingAmount(m_shadowsSettings->lightBleedingAmount());
@@ -108,6 +111,16 @@ glm::uvec3& CameraNodePrivate::clusterSize()
     return m_clusterSize;
 }
 
+bool& CameraNodePrivate::isAutoInstancingEnabled()
+{
+    return m_isAutoInstancingEnabled;
+}
+
+bool& CameraNodePrivate::isLightBinningEnabled()
+{
+    return m_isLightBinningEnabled;
+}
+
 bool& CameraNodePrivate::isDefaultFrameBufferUsed()
 {
     return m_isDefaultFrameBufferUsed;
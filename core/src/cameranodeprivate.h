@@ -36,6 +36,8 @@ public:
     utils::Range& cullPlaneLimits();
     utils::Range& ZRange();
     glm::uvec3& clusterSize();
+    bool& isAutoInstancingEnabled();
+    bool& isLightBinningEnabled();
 
     bool& isDefaultFrameBufferUsed();
     std::optional<glm::uvec2>& separateFramebufferFixedSize();
@@ -61,6 +63,8 @@ private:
     utils::Range m_cullPlaneLimits = utils::Range();
     utils::Range m_ZRange = utils::Range();
     glm::uvec3 m_clusterSize = glm::uvec3();
+    bool m_isAutoInstancingEnabled = true;
+    bool m_isLightBinningEnabled = true;
 
     bool m_isDefaultFrameBufferUsed = true;
     std::optional<glm::uvec2> m_separateFramebufferFixedSize;
@@ -2,6 +2,7 @@
 
 #include <utils/boundingbox.h>
 #include <utils/clipspace.h>
+#include <utils/glm/gtc/packing.hpp>
 #include <utils/idgenerator.h>
 #include <utils/orientedboundingbox.h>
 #include <utils/range.h>
@@ -21,6 +22,18 @@ static const uint32_t SpotLightTypeID = castFromLightType(LightType::Spot);
 static const uint32_t ImageBasedLightTypeID = castFromLightType(LightType::ImageBased);
 static const uint32_t UndefinedLightTypeID = std::numeric_limits<uint32_t>::max();
 
+static glm::vec2 encodeOctahedral(const glm::vec3& v)
+{
+    const auto sum = glm::abs(v.x) + glm::abs(v.y) + glm::abs(v.z);
+    if (sum == 0.f) return glm::vec2(0.f);
+
+    const auto p = glm::vec2(v) / sum;
+    if (v.z >= 0.f) return p;
+
+    const auto signNotZero = glm::vec2(p.x >= 0.f ? 1.f : -1.f, p.y >= 0.f ? 1.f : -1.f);
+    return (glm::vec2(1.f) - glm::abs(glm::vec2(p.y, p.x))) * signNotZero;
+}
+
 QuatDescription QuatDescription::make(const glm::quat& value)
 {
     return {glm::vec4(value.x, value.y, value.z, value.w)};
@@ -111,11 +124,37 @@ GBufferDescription GBufferDescription::make(
     return {colorTextureHandle, depthTextureHandle, OITIndicesImageHandle, OITNodesMaxCount, 0u};
 }
 
+CompactPositionNormalTexCoordsDataDescription CompactPositionNormalTexCoordsDataDescription::make(
+    const PositionNormalTexCoordsDataDescription& value,
+    const utils::BoundingBox& bb)
+{
+    // the positions out of the bounding box are clamped to its faces
+    const auto center = bb.center();
+    const auto halfSizes = bb.halfSizes();
+
+    glm::vec3 position(0.f);
+    for (glm::length_t i = 0; i < 3; ++i)
+        if (halfSizes[i] > 0.f) position[i] = (value.position[i] - center[i]) / halfSizes[i];
+
+    return {
+        glm::packSnorm2x16(glm::vec2(position)),
+        glm::packSnorm2x16(glm::vec2(position.z, 0.f)),
+        glm::packSnorm2x16(encodeOctahedral(value.normal)),
+        glm::packHalf2x16(value.texCoords)};
+}
+
+CompactTangentDataDescription CompactTangentDataDescription::make(const TangentDataDescription& value)
+{
+    const auto tangent = glm::packSnorm2x16(encodeOctahedral(glm::vec3(value)));
+    return {glm::bitfieldInsert(tangent, (value.w < 0.f ? 1u : 0u), 0, 1)};
+}
+
 MeshDescription MeshDescription::makeEmpty()
 {
     return make(
-        utils::BoundingBox::empty(), utils::IDsGenerator::last(), false, false, false, utils::IDsGenerator::last(),
-        utils::IDsGenerator::last(), false, utils::IDsGenerator::last(), 0u);
+        utils::BoundingBox::empty(), utils::IDsGenerator::last(), false, false, false, false, utils::IDsGenerator::last(),
+        utils::IDsGenerator::last(), false, utils::IDsGenerator::last(), 0u, false, 1u, {}, {},
+        utils::IDsGenerator::last(), 0u);
 }
 
 MeshDescription MeshDescription::make(
@@ -124,19 +163,29 @@ MeshDescription MeshDescription::make(
     bool hasPositions,
     bool hasNormals,
     bool hasTexCoords,
+    bool hasCompactVertices,
     uint32_t tangentDataOffset,
     uint32_t boneDataOffset,
     uint32_t bonesCount,
     uint32_t elementDataOffset,
-    uint32_t elementDataSize)
+    uint32_t elementDataSize,
+    bool hasElement16Data,
+    uint32_t LODsCount,
+    const std::array<uint32_t, MaxLODsCount - 1u>& LODsElementDataSizes,
+    const std::array<float, MaxLODsCount - 1u>& LODsErrors,
+    uint32_t meshletsDataOffset,
+    uint32_t meshletsCount)
 {
     uint32_t flags = 0u;
     flags = glm::bitfieldInsert(flags, (hasPositions ? 1u : 0u), 0, 1);
     flags = glm::bitfieldInsert(flags, (hasNormals ? 1u : 0u), 1, 1);
     flags = glm::bitfieldInsert(flags, (hasTexCoords ? 1u : 0u), 2, 1);
     flags = glm::bitfieldInsert(flags, bonesCount, 3, 3);
+    flags = glm::bitfieldInsert(flags, (hasCompactVertices ? 1u : 0u), 6, 1);
+    flags = glm::bitfieldInsert(flags, (hasElement16Data ? 1u : 0u), 7, 1);
+    flags = glm::bitfieldInsert(flags, glm::clamp(LODsCount, 1u, MaxLODsCount) - 1u, 8, 2);
 
-    return {
+    MeshDescription result{
         BoundingBoxDescription::make(bb),
         positionNormalTexCoordsDataOffset,
         tangentDataOffset,
@@ -144,6 +193,12 @@ MeshDescription MeshDescription::make(
         elementDataOffset,
         elementDataSize,
         flags};
+    std::copy(LODsElementDataSizes.begin(), LODsElementDataSizes.end(), result.LODsElementDataSizes);
+    std::copy(LODsErrors.begin(), LODsErrors.end(), result.LODsErrors);
+    result.meshletsDataOffset = meshletsDataOffset;
+    result.meshletsCount = meshletsCount;
+
+    return result;
 }
 
 MapDescription MapDescription::makeEmpty()
@@ -230,6 +285,11 @@ DrawDataDescription DrawDataDescription::make(
     return {TransformDescription::make(transform), drawableID, skeletalAnimatedDataID};
 }
 
+DrawableInstancesDescription DrawableInstancesDescription::makeEmpty()
+{
+    return {{0u, 0u, 0u, 0u}, {0u, 0u, 0u, 0u}};
+}
+
 BackgroundDescription BackgroundDescription::makeEmpty()
 {
     return BackgroundDescription::make(glm::quat(1.f, 0.f, 0.f, 0.f), glm::vec3(1.f), 0.f, utils::IDsGenerator::last());
@@ -425,6 +485,22 @@ ShadowMapsDescription ShadowMapsDescription::make(
     return result;
 }
 
+DepthPyramidDescription DepthPyramidDescription::make(
+    const std::vector<graphics::ImageHandle>& levelsImageHandles,
+    const glm::uvec2& size)
+{
+    DepthPyramidDescription result{};
+    result.levelsCount = static_cast<uint32_t>(
+        (levelsImageHandles.size() < MaxLevelsCount) ? levelsImageHandles.size() : MaxLevelsCount);
+    for (size_t i = 0u; i < MaxLevelsCount; ++i)
+        result.levelsImageHandles[i] =
+            (i < result.levelsCount) ? levelsImageHandles[i] : utils::IDsGeneratorT<graphics::ImageHandle>::last();
+    result.size = size;
+    result.levelIndex = 0u;
+
+    return result;
+}
+
 HDRDescription HDRDescription::make(graphics::TextureHandle textureHandle, float bloomContribution)
 {
     return {textureHandle, bloomContribution, 0u};
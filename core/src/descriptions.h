@@ -1,6 +1,8 @@
 #ifndef CORE_DESCRIPTIONS_H
 #define CORE_DESCRIPTIONS_H
 
+#include <array>
+
 #include <utils/forwarddecl.h>
 #include <utils/glm/ext/quaternion_float.hpp>
 #include <utils/glm/mat4x4.hpp>
@@ -103,9 +105,10 @@ struct CameraDescription
 struct ClusterNodeDescription
 {
     BoundingBoxDescription boundingBox;
-    uint32_t firstLightNodeID;
+    uint32_t lightIndicesOffset;
+    uint32_t lightIndicesCount;
 
-    uint32_t padding[3u];
+    uint32_t padding[2u];
 };
 
 struct ClusterLocalLightDescription
@@ -115,13 +118,6 @@ struct ClusterLocalLightDescription
     uint32_t padding[3u];
 };
 
-struct LightNodeDescription
-{
-    uint32_t lightID;
-    uint32_t nextID;
-    uint32_t padding[2u];
-};
-
 struct RenderInfoDescription
 {
     // global
@@ -169,9 +165,9 @@ struct RenderInfoDescription
 
 struct CountersDescription
 {
-    uint32_t firstGlobalLightNodeID;
+    uint32_t globalLightsCount;
     uint32_t clusterLocalLightsCount;
-    uint32_t lightNodesCount;
+    uint32_t lightIndicesCount; // the global lights and the light indices needed by the clusters
     uint32_t skeletalAnimatedDataToUpdateCount;
     uint32_t shadowsToUpdateCount;
     uint32_t opaqueDrawDataRenderCommandsCount;
@@ -179,8 +175,20 @@ struct CountersDescription
     uint32_t shadowDataCount;
     uint32_t opaqueShadowDataRenderCommandsCount;
     uint32_t transparentShadowDataRenderCommandsCount;
+    uint32_t opaqueDrawData16RenderCommandsCount;
+    uint32_t transparentDrawData16RenderCommandsCount;
+    uint32_t opaqueShadowData16RenderCommandsCount;
+    uint32_t transparentShadowData16RenderCommandsCount;
+    uint32_t meshletsCullDrawDataCount;
+    uint32_t meshletsCount; // the statistics of CullMeshletsPass
+    uint32_t culledMeshletsCount;
+    uint32_t culledMeshletTrianglesCount;
+    uint32_t instancedDrawDataCount;
+    uint32_t drawDataInstancesCount;
+    uint32_t firstPhaseDrawDataRenderCommandsCount; // the commands of the draw data visible last frame
+    uint32_t occlusionCulledDrawDataCount;
 
-    uint32_t padding[2u];
+    // uint32_t padding[0u];
 };
 
 struct GBufferDescription
@@ -230,9 +238,51 @@ static_assert(sizeof(TangentDataDescription) == 16);
 using ElementDataDescription = uint32_t;
 static_assert(sizeof(ElementDataDescription) == 4);
 
+using Element16DataDescription = uint16_t;
+static_assert(sizeof(Element16DataDescription) == 2);
+
+struct CompactPositionNormalTexCoordsDataDescription
+{
+    uint32_t positionXY; // snorm16x2 relative to the mesh bounding box
+    uint32_t positionZ; // 0..15 - snorm16 relative to the mesh bounding box, 16..31 - free
+    uint32_t normal; // octahedral snorm16x2
+    uint32_t texCoords; // half2x16
+
+    static CompactPositionNormalTexCoordsDataDescription make(
+        const PositionNormalTexCoordsDataDescription&,
+        const utils::BoundingBox&);
+};
+static_assert(sizeof(CompactPositionNormalTexCoordsDataDescription) == 16);
+
+struct CompactTangentDataDescription
+{
+    uint32_t tangent; // octahedral snorm16x2, the least significant bit is the binormal flag
+
+    static CompactTangentDataDescription make(const TangentDataDescription&);
+};
+static_assert(sizeof(CompactTangentDataDescription) == 4);
+
+struct MeshletDescription
+{
+    glm::vec4 boundingSphere; // in the mesh space
+    glm::vec4 cone; // xyz - axis, w - sine of the normals cone half angle, the cone isn't culled if it's 1
+    uint32_t elementDataOffset; // relative to the element data of the mesh
+    uint32_t elementDataSize;
+    uint32_t padding[2u];
+};
+static_assert(sizeof(MeshletDescription) == 48);
+
+struct MeshletsCullDrawDataDescription
+{
+    uint32_t drawDataID;
+    uint32_t renderCommandID; // the command of the whole mesh made by CullDrawDataPass
+    uint32_t drawDataInstanceID; // the base instance of the commands
+};
+
 struct MeshDescription
 {
     static constexpr uint32_t MaxBonesCount = 7u;
+    static constexpr uint32_t MaxLODsCount = 4u;
 
     BoundingBoxDescription boundingBox;
     uint32_t positionNormalTexCoordsDataOffset;
@@ -245,8 +295,18 @@ struct MeshDescription
     //  1.. 1 - has normals
     //  2.. 2 - has tex coords
     //  3.. 5 - bones count [0..7]
-    //  6..31 - free (26 bits)
-
+    //  6.. 6 - has compact vertices
+    //  7.. 7 - has 16-bit element data
+    //  8.. 9 - LODs count - 1 [0..3]
+    // 10..31 - free (22 bits)
+
+    // the indices of LOD i follow the ones of LOD i - 1, the errors are in the mesh space
+    uint32_t LODsElementDataSizes[MaxLODsCount - 1u];
+    float LODsErrors[MaxLODsCount - 1u];
+
+    // the meshlets split the indices of LOD 0 into the contiguous ranges
+    uint32_t meshletsDataOffset;
+    uint32_t meshletsCount;
     uint32_t padding[2u];
 
     static MeshDescription makeEmpty();
@@ -256,12 +316,20 @@ struct MeshDescription
         bool hasPositions,
         bool hasNormals,
         bool hasTexCoords,
+        bool hasCompactVertices,
         uint32_t tangentDataOffset,
         uint32_t boneDataOffset,
         uint32_t bonesCount,
         uint32_t elementDataOffset,
-        uint32_t elementDataSize);
+        uint32_t elementDataSize,
+        bool hasElement16Data,
+        uint32_t LODsCount,
+        const std::array<uint32_t, MaxLODsCount - 1u>& LODsElementDataSizes,
+        const std::array<float, MaxLODsCount - 1u>& LODsErrors,
+        uint32_t meshletsDataOffset,
+        uint32_t meshletsCount);
 };
+static_assert(sizeof(MeshDescription) % 16u == 0u);
 
 struct MapDescription
 {
@@ -341,6 +409,22 @@ struct DrawDataDescription
     static DrawDataDescription make(const utils::Transform& transform, uint32_t drawableID, uint32_t skeletalAnimatedDataID);
 };
 
+// the visible draw data of a drawable per LOD, the counts are reset by GenerateInstancedDrawDataCommandsPass
+struct DrawableInstancesDescription
+{
+    uint32_t instancesCount[MeshDescription::MaxLODsCount];
+    uint32_t instancesOffset[MeshDescription::MaxLODsCount]; // in the draw data instances
+
+    static DrawableInstancesDescription makeEmpty();
+};
+
+struct InstancedDrawDataDescription
+{
+    uint32_t drawDataID;
+    uint32_t LOD;
+    uint32_t instanceIndex; // in the instances of the drawable LOD
+};
+
 struct BackgroundDescription
 {
     QuatDescription rotation;
@@ -445,6 +529,7 @@ struct LightDescription
 
 struct ShadowToUpdateDescription
 {
+    glm::vec4 boundingSphere; // the light volume covered by the shadow in the world space
     uint32_t shadowID;
 
     uint32_t padding[3u];
@@ -514,6 +599,18 @@ struct ShadowMapsDescription
         const std::vector<float>& blurKernel);
 };
 
+struct DepthPyramidDescription
+{
+    static const size_t MaxLevelsCount = 16u; // no affects the padding
+
+    graphics::ImageHandle levelsImageHandles[MaxLevelsCount];
+    glm::uvec2 size; // the size of the level 0, the power of 2 not greater than the viewport size
+    uint32_t levelsCount;
+    uint32_t levelIndex; // the level built by BuildDepthPyramidPass
+
+    static DepthPyramidDescription make(const std::vector<graphics::ImageHandle>& levelsImageHandles, const glm::uvec2& size);
+};
+
 struct HDRDescription
 {
     graphics::TextureHandle textureHandle;
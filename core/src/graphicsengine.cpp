@@ -4,6 +4,7 @@
 #include <utils/meshpainter.h>
 #include <utils/orientedboundingbox.h>
 
+#include <core/applicationbase.h>
 #include <core/cameranode.h>
 #include <core/debuginformation.h>
 #include <core/drawablenode.h>
@@ -172,6 +173,14 @@ void GraphicsEngine::update(const std::shared_ptr<Scene>& scene, uint64_t time,
     }
 
     renderer->makeCurrent();
+    renderer->beginFrame();
+
+    auto& sceneData = scene->m().sceneData();
+    if (sceneData)
+    {
+        sceneData->flushChanges();
+        sceneData->compactGeometryData(settings::Settings::instance().graphics().geometryCompactionBytesPerFrame());
+    }
 
     auto widget = renderer->widget();
     if (!widget)
@@ -185,6 +194,15 @@ void GraphicsEngine::update(const std::shared_ptr<Scene>& scene, uint64_t time,
     auto rootNode = scene->sceneRootNode();
     const auto globalBoundingBox = rootNode->globalTransform() * utils::OrientedBoundingBox(rootNode->boundingBox());
 
+    auto& sceneInformation = ApplicationBase::instance().debugInformation().scenesInformation.emplace_back();
+    sceneInformation.sceneName = scene->name();
+    if (sceneData)
+    {
+        sceneInformation.geometryDataFragmentation = sceneData->geometryDataFragmentation();
+        sceneInformation.numGeometryDataBytesReclaimed = sceneData->numGeometryDataBytesReclaimed();
+        sceneInformation.numDeduplicatedGeometryBytes = sceneData->numDeduplicatedGeometryBytes();
+    }
+
     NodeCollector<CameraNode> cameraNodeCollector;
     rootNode->acceptDown(cameraNodeCollector);
     std::stable_sort(cameraNodeCollector.nodes().begin(), cameraNodeCollector.nodes().end(), utils::SortedObjectComparator());
@@ -208,6 +226,31 @@ void GraphicsEngine::update(const std::shared_ptr<Scene>& scene, uint64_t time,
             m_->dielectricSpecular(), globalBoundingBox, camera->globalTransform().inverted(), camera->clipSpace(),
             camera->cullPlanesLimits(), camera->ZRange(), camera->clusterSize());
 
+        auto& cameraInformation = sceneInformation.camerasInformation.emplace_back();
+        cameraInformation.cameraName = camera->name();
+        cameraInformation.renderPassesInformation = renderPipeLine->renderPassesInformation();
+        for (const auto& renderPassInformation : cameraInformation.renderPassesInformation)
+        {
+            cameraInformation.GPUTime += renderPassInformation.GPUTime;
+            cameraInformation.averageGPUTime += renderPassInformation.averageGPUTime;
+        }
+
+        // the counters are read back through fenced copies a few frames late, so they never wait for the GPU
+        const auto& counters = renderPipeLine->lastCounters();
+        cameraInformation.numDrawDataRenderCommands =
+            counters.opaqueDrawDataRenderCommandsCount + counters.transparentDrawDataRenderCommandsCount +
+            counters.opaqueDrawData16RenderCommandsCount + counters.transparentDrawData16RenderCommandsCount +
+            counters.firstPhaseDrawDataRenderCommandsCount;
+        if (renderPipeLine->isAutoInstancingEnabled())
+            cameraInformation.numDrawDataInstancesRendered = counters.drawDataInstancesCount;
+        if (settings::Settings::instance().graphics().meshletCulling())
+        {
+            cameraInformation.numMeshletsProcessed = counters.meshletsCount;
+            cameraInformation.numMeshletsCulled = counters.culledMeshletsCount;
+            cameraInformation.numMeshletTrianglesCulled = counters.culledMeshletTrianglesCount;
+        }
+        cameraInformation.numDrawDataOcclusionCulled = counters.occlusionCulledDrawDataCount;
+
         m_->frameBuffer()->detachAll();
         m_->frameBuffer()->attach(graphics::FrameBufferAttachment::Color0, renderPipeLine->finalTexture());
 
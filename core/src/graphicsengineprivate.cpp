@@ -174,11 +174,14 @@ const std::string& GraphicsEnginePrivate::shaderStorageBlockNameByID(ShaderStora
     static const std::unordered_map<ShaderStorageBlockID, std::string> s_table{
         {ShaderStorageBlockID::PositionNormalTexCoordsDataBuffer, "ssbo_positionNormalTexCoordsDataBuffer"},
         {ShaderStorageBlockID::TangentDataBuffer, "ssbo_tangentDataBuffer"},
+        {ShaderStorageBlockID::CompactPositionNormalTexCoordsDataBuffer, "ssbo_compactPositionNormalTexCoordsDataBuffer"},
+        {ShaderStorageBlockID::CompactTangentDataBuffer, "ssbo_compactTangentDataBuffer"},
         {ShaderStorageBlockID::BoneDataBuffer, "ssbo_boneDataBuffer"},
         {ShaderStorageBlockID::SkeletonsDataBuffer, "ssbo_skeletonsDataBuffer"},
         {ShaderStorageBlockID::BonesTransformsDataBuffer, "ssbo_bonesTransformsDataBuffer"},
         {ShaderStorageBlockID::ShadowTransformsDataBuffer, "ssbo_shadowTransformsDataBuffer"},
         {ShaderStorageBlockID::ShadowDataBuffer, "ssbo_shadowDataBuffer"},
+        {ShaderStorageBlockID::MeshletsDataBuffer, "ssbo_meshletsDataBuffer"},
 
         {ShaderStorageBlockID::MeshesBuffer, "ssbo_meshesBuffer"},
         {ShaderStorageBlockID::MapsBuffer, "ssbo_mapsBuffer"},
@@ -190,30 +193,43 @@ const std::string& GraphicsEnginePrivate::shaderStorageBlockNameByID(ShaderStora
         {ShaderStorageBlockID::SkeletonsBuffer, "ssbo_skeletonsBuffer"},
 
         {ShaderStorageBlockID::DrawDataBuffer, "ssbo_drawDataBuffer"},
+        {ShaderStorageBlockID::LiveDrawDataBuffer, "ssbo_liveDrawDataBuffer"},
         {ShaderStorageBlockID::SkeletalAnimatedDataBuffer, "ssbo_skeletalAnimatedDataBuffer"},
 
         {ShaderStorageBlockID::SkeletalAnimatedDataToUpdateBuffer, "ssbo_skeletalAnimatedDataToUpdateBuffer"},
         {ShaderStorageBlockID::ShadowsToUpdateBuffer, "ssbo_shadowsToUpdateBuffer"},
+        {ShaderStorageBlockID::MeshletsCullDrawDataBuffer, "ssbo_meshletsCullDrawDataBuffer"},
+        {ShaderStorageBlockID::DrawablesInstancesBuffer, "ssbo_drawablesInstancesBuffer"},
+        {ShaderStorageBlockID::InstancedDrawDataBuffer, "ssbo_instancedDrawDataBuffer"},
+        {ShaderStorageBlockID::DrawDataInstancesBuffer, "ssbo_drawDataInstancesBuffer"},
+        {ShaderStorageBlockID::DrawDataVisibilityBuffer, "ssbo_drawDataVisibilityBuffer"},
 
         {ShaderStorageBlockID::SkeletalAnimatedDataToUpdateCommandBuffer, "ssbo_skeletalAnimatedDataToUpdateCommandBuffer"},
         {ShaderStorageBlockID::OpaqueDrawDataRenderCommandsBuffer, "ssbo_opaqueDrawDataRenderCommandsBuffer"},
         {ShaderStorageBlockID::TransparentDrawDataRenderCommandsBuffer, "ssbo_transparentDrawDataRenderCommandsBuffer"},
+        {ShaderStorageBlockID::OpaqueDrawData16RenderCommandsBuffer, "ssbo_opaqueDrawData16RenderCommandsBuffer"},
+        {ShaderStorageBlockID::TransparentDrawData16RenderCommandsBuffer, "ssbo_transparentDrawData16RenderCommandsBuffer"},
+        {ShaderStorageBlockID::MeshletsCullCommandBuffer, "ssbo_meshletsCullCommandBuffer"},
         {ShaderStorageBlockID::ClusterLocalLightsCommandBuffer, "ssbo_clusterLocalLightsCommandBuffer"},
         {ShaderStorageBlockID::ShadowDataCullCommandBuffer, "ssbo_shadowDataCullCommandBuffer"},
         {ShaderStorageBlockID::ShadowMapBlurCommandsBuffer, "ssbo_shadowMapBlurCommandsBuffer"},
         {ShaderStorageBlockID::ShadowDataRenderCommandsBuffer, "ssbo_shadowDataRenderCommandsBuffer"},
         {ShaderStorageBlockID::OpaqueShadowDataRenderCommandsBuffer, "ssbo_opaqueShadowDataRenderCommandsBuffer"},
         {ShaderStorageBlockID::TransparentShadowDataRenderCommandsBuffer, "ssbo_transparentShadowDataRenderCommandsBuffer"},
+        {ShaderStorageBlockID::OpaqueShadowData16RenderCommandsBuffer, "ssbo_opaqueShadowData16RenderCommandsBuffer"},
+        {ShaderStorageBlockID::TransparentShadowData16RenderCommandsBuffer, "ssbo_transparentShadowData16RenderCommandsBuffer"},
 
         {ShaderStorageBlockID::CameraBuffer, "ssbo_cameraBuffer"},
         {ShaderStorageBlockID::ClusterNodesBuffer, "ssbo_clusterNodesBuffer"},
         {ShaderStorageBlockID::ClusterLocalLightsBuffer, "ssbo_clusterLocalLightsBuffer"},
-        {ShaderStorageBlockID::LightNodesBuffer, "ssbo_lightNodesBuffer"},
+        {ShaderStorageBlockID::LightIndicesBuffer, "ssbo_lightIndicesBuffer"},
+        {ShaderStorageBlockID::LightMasksBuffer, "ssbo_lightMasksBuffer"},
         {ShaderStorageBlockID::RenderInfoBuffer, "ssbo_renderInfoBuffer"},
         {ShaderStorageBlockID::CountersBuffer, "ssbo_countersBuffer"},
         {ShaderStorageBlockID::GBuffer, "ssbo_GBuffer"},
         {ShaderStorageBlockID::OITNodesBuffer, "ssbo_OITNodesBuffer"},
         {ShaderStorageBlockID::ShadowMapsBuffer, "ssbo_shadowMapsBuffer"},
+        {ShaderStorageBlockID::DepthPyramidBuffer, "ssbo_depthPyramidBuffer"},
         {ShaderStorageBlockID::HDRBuffer, "ssbo_HDRBuffer"},
         {ShaderStorageBlockID::ToneMappingBuffer, "ssbo_toneMappingBuffer"},
 
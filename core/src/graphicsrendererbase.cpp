@@ -363,6 +363,22 @@ ShaderStorageBlockID RendererBase::shaderStorageBlockByName(const std::string& n
     return it != shaderStorageBlockIDs.end() ? it->second : core::ShaderStorageBlockID::Count;
 }
 
+void RendererBase::beginFrame()
+{
+    m_->lastFrameStatistics() = m_->frameStatistics();
+    m_->frameStatistics() = FrameStatistics();
+}
+
+FrameStatistics& RendererBase::frameStatistics()
+{
+    return m_->frameStatistics();
+}
+
+const FrameStatistics& RendererBase::lastFrameStatistics() const
+{
+    return m_->lastFrameStatistics();
+}
+
 BufferRange::~BufferRange() = default;
 
 std::shared_ptr<const IBuffer> BufferRange::buffer() const
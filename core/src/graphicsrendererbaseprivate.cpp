@@ -44,6 +44,16 @@ std::unordered_map<std::string, core::ShaderStorageBlockID>& RendererBasePrivate
     return m_shaderStorageBlockIDs;
 }
 
+FrameStatistics& RendererBasePrivate::frameStatistics()
+{
+    return m_frameStatistics;
+}
+
+FrameStatistics& RendererBasePrivate::lastFrameStatistics()
+{
+    return m_lastFrameStatistics;
+}
+
 std::weak_ptr<RendererBase>& RendererBasePrivate::current()
 {
     return s_current;
@@ -2,6 +2,7 @@
 #define CORE_GRAPHICSRENDERERBASEPRIVATE_H
 
 #include <core/forwarddecl.h>
+#include <core/graphicsrendererbase.h>
 
 namespace simplex
 {
@@ -23,6 +24,9 @@ public:
     std::unordered_map<std::string, core::UniformBlockID>& uniformBlockIDs();
     std::unordered_map<std::string, core::ShaderStorageBlockID>& shaderStorageBlockIDs();
 
+    FrameStatistics& frameStatistics();
+    FrameStatistics& lastFrameStatistics();
+
     static std::weak_ptr<RendererBase>& current();
 
 private:
@@ -34,6 +38,9 @@ private:
     std::unordered_map<std::string, core::UniformBlockID> m_uniformBlockIDs;
     std::unordered_map<std::string, core::ShaderStorageBlockID> m_shaderStorageBlockIDs;
 
+    FrameStatistics m_frameStatistics;
+    FrameStatistics m_lastFrameStatistics;
+
     static std::weak_ptr<RendererBase> s_current;
 };
 
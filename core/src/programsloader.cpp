@@ -1,3 +1,4 @@
+#include <utils/hash.h>
 #include <utils/shader.h>
 
 #include <core/graphicsrendererbase.h>
@@ -10,13 +11,40 @@ namespace simplex
 namespace core
 {
 
+static uint64_t programKey(
+    std::initializer_list<std::reference_wrapper<const std::filesystem::path>> fileNames,
+    const utils::ShaderDefines& defines)
+{
+    auto result = utils::hashSeed();
+    for (const auto& fileName : fileNames)
+    {
+        const auto& native = fileName.get().native();
+        result = utils::hashData(result, native.data(), native.size() * sizeof(native[0u]));
+        result = utils::hashData(result, "\0", 1u);
+    }
+
+    for (const auto& [defineName, defineValue] : defines)
+    {
+        result = utils::hashString(result, defineName);
+        result = utils::hashString(result, defineValue);
+    }
+
+    return result;
+}
+
 ProgramsLoader::ProgramsLoader(const std::string& name, const std::shared_ptr<graphics::RendererBase>& renderer)
     : ResourceLoaderBase<graphics::IProgram>(name)
     , m_(std::make_unique<ProgramsLoaderPrivate>(renderer))
 {
 }
 
-ProgramsLoader::~ProgramsLoader() = default;
+ProgramsLoader::~ProgramsLoader()
+{
+    const auto& statistics = m_->programBinaryCacheStatistics();
+    if (statistics.numHits + statistics.numMisses)
+        LOG_INFO << "Program binary cache of \"" << name() << "\": " << statistics.numHits << " hits, " << statistics.numMisses
+                 << " misses (" << statistics.numRejected << " rejected), " << statistics.savedTime / 1000u << " ms saved";
+}
 
 std::shared_ptr<graphics::RendererBase> ProgramsLoader::graphicsRenderer()
 {
@@ -33,16 +61,15 @@ std::shared_ptr<graphics::IRenderProgram> ProgramsLoader::loadOrGetRenderProgram
     const std::filesystem::path& fShaderFileName,
     const utils::ShaderDefines& defines)
 {
-    auto name = vShaderFileName.string() + fShaderFileName.string();
-    for (const auto& define : defines)
-        name += define.first + define.second;
+    const auto key = programKey({vShaderFileName, fShaderFileName}, defines);
 
-    if (auto program = findResource(name))
+    auto& resources = m_->resources();
+    if (auto it = resources.find(key); it != resources.end())
     {
-        auto renderProgram = std::dynamic_pointer_cast<graphics::IRenderProgram>(program);
+        auto renderProgram = std::dynamic_pointer_cast<graphics::IRenderProgram>(it->second);
         if (!renderProgram)
         {
-            LOG_CRITICAL << "Program with name \"" << name << "\" was created in a different type";
+            LOG_CRITICAL << "Program " << vShaderFileName << ", " << fShaderFileName << " was created in a different type";
             return nullptr;
         }
 
@@ -52,14 +79,19 @@ std::shared_ptr<graphics::IRenderProgram> ProgramsLoader::loadOrGetRenderProgram
     auto vShader = utils::Shader::loadFromFile(vShaderFileName, defines);
     auto fShader = utils::Shader::loadFromFile(fShaderFileName, defines);
 
-    auto renderProgram = m_->renderer()->createRenderProgram(vShader, fShader);
+    auto& renderer = m_->renderer();
+    auto renderProgram = std::dynamic_pointer_cast<graphics::IRenderProgram>(m_->createProgram(
+        {vShader, fShader},
+        [&]() -> std::shared_ptr<graphics::IProgram> { return renderer->createRenderProgram(vShader, fShader); },
+        [&](const graphics::ProgramBinary& programBinary) -> std::shared_ptr<graphics::IProgram>
+        { return renderer->createRenderProgram(programBinary); }));
     if (!renderProgram)
     {
         LOG_CRITICAL << "Failed to create render program: " << vShaderFileName << ", " << fShaderFileName;
         return nullptr;
     }
 
-    addResource(name, renderProgram);
+    resources.insert({key, renderProgram});
     return renderProgram;
 }
 
@@ -69,16 +101,16 @@ std::shared_ptr<graphics::IRenderProgram> ProgramsLoader::loadOrGetRenderProgram
     const std::filesystem::path& fShaderFileName,
     const utils::ShaderDefines& defines)
 {
-    auto name = vShaderFileName.string() + gShaderFileName.string() + fShaderFileName.string();
-    for (const auto& define : defines)
-        name += define.first + define.second;
+    const auto key = programKey({vShaderFileName, gShaderFileName, fShaderFileName}, defines);
 
-    if (auto program = findResource(name))
+    auto& resources = m_->resources();
+    if (auto it = resources.find(key); it != resources.end())
     {
-        auto renderProgram = std::dynamic_pointer_cast<graphics::IRenderProgram>(program);
+        auto renderProgram = std::dynamic_pointer_cast<graphics::IRenderProgram>(it->second);
         if (!renderProgram)
         {
-            LOG_CRITICAL << "Program with name \"" << name << "\" was created in a different type";
+            LOG_CRITICAL << "Program " << vShaderFileName << ", " << gShaderFileName << ", " << fShaderFileName
+                         << " was created in a different type";
             return nullptr;
         }
 
@@ -89,7 +121,12 @@ std::shared_ptr<graphics::IRenderProgram> ProgramsLoader::loadOrGetRenderProgram
     auto gShader = utils::Shader::loadFromFile(gShaderFileName, defines);
     auto fShader = utils::Shader::loadFromFile(fShaderFileName, defines);
 
-    auto renderProgram = m_->renderer()->createRenderProgram(vShader, gShader, fShader);
+    auto& renderer = m_->renderer();
+    auto renderProgram = std::dynamic_pointer_cast<graphics::IRenderProgram>(m_->createProgram(
+        {vShader, gShader, fShader},
+        [&]() -> std::shared_ptr<graphics::IProgram> { return renderer->createRenderProgram(vShader, gShader, fShader); },
+        [&](const graphics::ProgramBinary& programBinary) -> std::shared_ptr<graphics::IProgram>
+        { return renderer->createRenderProgram(programBinary); }));
     if (!renderProgram)
     {
         LOG_CRITICAL << "Failed to create render program: " << vShaderFileName << ", " << gShaderFileName << ", "
@@ -97,7 +134,7 @@ std::shared_ptr<graphics::IRenderProgram> ProgramsLoader::loadOrGetRenderProgram
         return nullptr;
     }
 
-    addResource(name, renderProgram);
+    resources.insert({key, renderProgram});
     return renderProgram;
 }
 
@@ -105,16 +142,15 @@ std::shared_ptr<graphics::IComputeProgram> ProgramsLoader::loadOrGetComputeProgr
     const std::filesystem::path& cShaderFileName,
     const utils::ShaderDefines& defines)
 {
-    auto name = cShaderFileName.string();
-    for (const auto& define : defines)
-        name += define.first + define.second;
+    const auto key = programKey({cShaderFileName}, defines);
 
-    if (auto program = findResource(name))
+    auto& resources = m_->resources();
+    if (auto it = resources.find(key); it != resources.end())
     {
-        auto computeProgram = std::dynamic_pointer_cast<graphics::IComputeProgram>(program);
+        auto computeProgram = std::dynamic_pointer_cast<graphics::IComputeProgram>(it->second);
         if (!computeProgram)
         {
-            LOG_CRITICAL << "Program with name \"" << name << "\" was created in a different type";
+            LOG_CRITICAL << "Program " << cShaderFileName << " was created in a different type";
             return nullptr;
         }
 
@@ -123,16 +159,26 @@ std::shared_ptr<graphics::IComputeProgram> ProgramsLoader::loadOrGetComputeProgr
 
     auto cShader = utils::Shader::loadFromFile(cShaderFileName, defines);
 
-    auto computeProgram = m_->renderer()->createComputeProgram(cShader);
+    auto& renderer = m_->renderer();
+    auto computeProgram = std::dynamic_pointer_cast<graphics::IComputeProgram>(m_->createProgram(
+        {cShader},
+        [&]() -> std::shared_ptr<graphics::IProgram> { return renderer->createComputeProgram(cShader); },
+        [&](const graphics::ProgramBinary& programBinary) -> std::shared_ptr<graphics::IProgram>
+        { return renderer->createComputeProgram(programBinary); }));
     if (!computeProgram)
     {
         LOG_CRITICAL << "Failed to create render program: " << cShaderFileName;
         return nullptr;
     }
 
-    addResource(name, computeProgram);
+    resources.insert({key, computeProgram});
     return computeProgram;
 }
 
+const ProgramBinaryCacheStatistics& ProgramsLoader::programBinaryCacheStatistics() const
+{
+    return m_->programBinaryCacheStatistics();
+}
+
 } // namespace core
 } // namespace simplex
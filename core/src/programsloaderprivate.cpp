@@ -1,4 +1,14 @@
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <utils/hash.h>
 #include <utils/logger.h>
+#include <utils/shader.h>
+
+#include <core/graphicsrendererbase.h>
+#include <core/settings.h>
 
 #include "programsloaderprivate.h"
 
@@ -7,8 +17,79 @@ namespace simplex
 namespace core
 {
 
+static const uint32_t s_programBinaryFileMagic = 0x32425053u; // "SPB2"
+
+static bool readProgramBinary(const std::filesystem::path& filePath, graphics::ProgramBinary& programBinary, uint64_t& compileTime)
+{
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    uint32_t magic = 0u;
+    uint64_t size = 0u;
+    file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    file.read(reinterpret_cast<char*>(&programBinary.format), sizeof(programBinary.format));
+    file.read(reinterpret_cast<char*>(&compileTime), sizeof(compileTime));
+    file.read(reinterpret_cast<char*>(&size), sizeof(size));
+    if (!file || (magic != s_programBinaryFileMagic) || (size == 0u)) return false;
+
+    programBinary.data.resize(static_cast<size_t>(size));
+    file.read(reinterpret_cast<char*>(programBinary.data.data()), static_cast<std::streamsize>(size));
+
+    uint32_t numReadOnlyShaderStorageBlocks = 0u;
+    file.read(reinterpret_cast<char*>(&numReadOnlyShaderStorageBlocks), sizeof(numReadOnlyShaderStorageBlocks));
+    if (!file) return false;
+
+    programBinary.readOnlyShaderStorageBlocks.resize(static_cast<size_t>(numReadOnlyShaderStorageBlocks));
+    file.read(
+        reinterpret_cast<char*>(programBinary.readOnlyShaderStorageBlocks.data()),
+        static_cast<std::streamsize>(numReadOnlyShaderStorageBlocks * sizeof(uint16_t)));
+
+    uint8_t isWritingImages = 1u;
+    file.read(reinterpret_cast<char*>(&isWritingImages), sizeof(isWritingImages));
+    programBinary.isWritingImages = isWritingImages != 0u;
+
+    return static_cast<bool>(file);
+}
+
+static bool writeProgramBinary(
+    const std::filesystem::path& filePath,
+    const graphics::ProgramBinary& programBinary,
+    uint64_t compileTime)
+{
+    std::error_code errorCode;
+    std::filesystem::create_directories(filePath.parent_path(), errorCode);
+
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+
+    const uint64_t size = programBinary.data.size();
+    file.write(reinterpret_cast<const char*>(&s_programBinaryFileMagic), sizeof(s_programBinaryFileMagic));
+    file.write(reinterpret_cast<const char*>(&programBinary.format), sizeof(programBinary.format));
+    file.write(reinterpret_cast<const char*>(&compileTime), sizeof(compileTime));
+    file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    file.write(reinterpret_cast<const char*>(programBinary.data.data()), static_cast<std::streamsize>(size));
+
+    const auto numReadOnlyShaderStorageBlocks = static_cast<uint32_t>(programBinary.readOnlyShaderStorageBlocks.size());
+    file.write(reinterpret_cast<const char*>(&numReadOnlyShaderStorageBlocks), sizeof(numReadOnlyShaderStorageBlocks));
+    file.write(
+        reinterpret_cast<const char*>(programBinary.readOnlyShaderStorageBlocks.data()),
+        static_cast<std::streamsize>(numReadOnlyShaderStorageBlocks * sizeof(uint16_t)));
+
+    const uint8_t isWritingImages = programBinary.isWritingImages ? 1u : 0u;
+    file.write(reinterpret_cast<const char*>(&isWritingImages), sizeof(isWritingImages));
+
+    return static_cast<bool>(file);
+}
+
+static uint64_t microsecondsSince(const std::chrono::steady_clock::time_point& startTime)
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count());
+}
+
 ProgramsLoaderPrivate::ProgramsLoaderPrivate(const std::shared_ptr<graphics::RendererBase> &renderer)
     : m_renderer(renderer)
+    , m_isProgramBinaryDriverKeyInitialized(false)
 {
 }
 
@@ -19,10 +100,70 @@ std::shared_ptr<graphics::RendererBase> &ProgramsLoaderPrivate::renderer()
     return m_renderer;
 }
 
-std::unordered_map<std::string, std::shared_ptr<graphics::IProgram>> &ProgramsLoaderPrivate::resources()
+std::unordered_map<uint64_t, std::shared_ptr<graphics::IProgram>> &ProgramsLoaderPrivate::resources()
 {
     return m_resources;
 }
 
+ProgramBinaryCacheStatistics &ProgramsLoaderPrivate::programBinaryCacheStatistics()
+{
+    return m_programBinaryCacheStatistics;
+}
+
+std::shared_ptr<graphics::IProgram> ProgramsLoaderPrivate::createProgram(
+    const std::vector<std::shared_ptr<utils::Shader>>& shaders,
+    const std::function<std::shared_ptr<graphics::IProgram>()>& compile,
+    const std::function<std::shared_ptr<graphics::IProgram>(const graphics::ProgramBinary&)>& load)
+{
+    if (!m_isProgramBinaryDriverKeyInitialized)
+    {
+        m_programBinaryDriverKey = m_renderer->programBinaryDriverKey();
+        m_isProgramBinaryDriverKeyInitialized = true;
+    }
+
+    const auto& cacheDirectory = settings::Settings::instance().graphics().programBinaryCacheDirectory();
+    if (m_programBinaryDriverKey.empty() || cacheDirectory.empty()) return compile();
+
+    // shaders are already preprocessed, so their data contain the version, the extensions and the defines
+    auto hash = utils::hashString(utils::hashSeed(), m_programBinaryDriverKey);
+    for (const auto& shader : shaders)
+        hash = utils::hashString(hash, shader->data());
+
+    std::ostringstream fileName;
+    fileName << std::hex << std::setw(16) << std::setfill('0') << hash << ".bin";
+    const auto filePath = cacheDirectory / fileName.str();
+
+    auto& statistics = m_programBinaryCacheStatistics;
+
+    graphics::ProgramBinary programBinary;
+    uint64_t compileTime = 0u;
+
+    auto startTime = std::chrono::steady_clock::now();
+    if (readProgramBinary(filePath, programBinary, compileTime))
+    {
+        if (auto program = load(programBinary))
+        {
+            ++statistics.numHits;
+            if (auto loadTime = microsecondsSince(startTime); compileTime > loadTime) statistics.savedTime += compileTime - loadTime;
+            return program;
+        }
+
+        ++statistics.numRejected;
+        LOG_WARNING << "Program binary " << filePath << " has been rejected, the program will be recompiled";
+    }
+
+    ++statistics.numMisses;
+
+    startTime = std::chrono::steady_clock::now();
+    auto program = compile();
+    if (!program) return nullptr;
+    compileTime = microsecondsSince(startTime);
+
+    if (program->binary(programBinary) && !writeProgramBinary(filePath, programBinary, compileTime))
+        LOG_WARNING << "Failed to write program binary " << filePath;
+
+    return program;
+}
+
 }
 }
@@ -1,11 +1,14 @@
 #ifndef CORE_PROGRAMSLOADERPRIVATE_H
 #define CORE_PROGRAMSLOADERPRIVATE_H
 
+#include <functional>
 #include <memory>
 #include <unordered_map>
 #include <string>
+#include <vector>
 
 #include <core/forwarddecl.h>
+#include <core/programsloader.h>
 
 namespace simplex
 {
@@ -19,11 +22,22 @@ public:
     ~ProgramsLoaderPrivate();
 
     std::shared_ptr<graphics::RendererBase> &renderer();
-    std::unordered_map<std::string, std::shared_ptr<graphics::IProgram>> &resources();
+    std::unordered_map<uint64_t, std::shared_ptr<graphics::IProgram>> &resources(); // key is ProgramsLoader's program key
+    ProgramBinaryCacheStatistics &programBinaryCacheStatistics();
+
+    // loads the program binary from the cache if it's possible, otherwise compiles and caches it
+    std::shared_ptr<graphics::IProgram> createProgram(
+        const std::vector<std::shared_ptr<utils::Shader>>&,
+        const std::function<std::shared_ptr<graphics::IProgram>()>&,
+        const std::function<std::shared_ptr<graphics::IProgram>(const graphics::ProgramBinary&)>&);
 
 private:
     std::shared_ptr<graphics::RendererBase> m_renderer;
-    std::unordered_map<std::string, std::shared_ptr<graphics::IProgram>> m_resources;
+    std::unordered_map<uint64_t, std::shared_ptr<graphics::IProgram>> m_resources;
+
+    ProgramBinaryCacheStatistics m_programBinaryCacheStatistics;
+    std::string m_programBinaryDriverKey;
+    bool m_isProgramBinaryDriverKeyInitialized;
 };
 
 }
@@ -7,8 +7,14 @@ namespace core
 
 RenderPass::~RenderPass() = default;
 
-RenderPass::RenderPass(const std::weak_ptr<RenderPipeLine>& renderPipeLine)
+const std::string& RenderPass::name() const
+{
+    return m_name;
+}
+
+RenderPass::RenderPass(const std::string& name, const std::weak_ptr<RenderPipeLine>& renderPipeLine)
     : StateSet()
+    , m_name(name)
     , m_renderPipeLine(renderPipeLine)
 {
 }
@@ -2,6 +2,7 @@
 #define CORE_RENDERPASS_H
 
 #include <memory>
+#include <string>
 
 #include <core/stateset.h>
 
@@ -19,6 +20,8 @@ class RenderPass : public StateSet, public std::enable_shared_from_this<RenderPa
 public:
     ~RenderPass() override;
 
+    const std::string& name() const;
+
     virtual void run(
         const std::shared_ptr<graphics::RendererBase>&,
         const std::shared_ptr<graphics::IFrameBuffer>&,
@@ -27,8 +30,9 @@ public:
         const std::shared_ptr<const SceneData>&) = 0;
 
 protected:
-    RenderPass(const std::weak_ptr<RenderPipeLine>&);
+    RenderPass(const std::string&, const std::weak_ptr<RenderPipeLine>&);
 
+    std::string m_name;
     std::weak_ptr<RenderPipeLine> m_renderPipeLine;
 };
 
@@ -0,0 +1,78 @@
+#include <core/graphicsrendererbase.h>
+
+#include "renderpassesprofiler.h"
+
+namespace simplex
+{
+namespace core
+{
+
+RenderPassesProfiler::RenderPassesProfiler() = default;
+
+RenderPassesProfiler::~RenderPassesProfiler() = default;
+
+void RenderPassesProfiler::beginFrame(const std::shared_ptr<graphics::RendererBase>& renderer, size_t numRenderPasses)
+{
+    if (m_renderPassesTimes.size() != numRenderPasses)
+    {
+        m_renderPassesTimes.assign(numRenderPasses, 0.f);
+        m_averageRenderPassesTimes.assign(numRenderPasses, 0.f);
+    }
+
+    m_frameIndex = (m_frameIndex + 1u) % FramesCount;
+    auto& frame = m_frames[m_frameIndex];
+
+    if (frame.isPending && frame.queries.back()->isAvailable()) resolve(frame);
+
+    if (frame.queries.size() != numRenderPasses + 1u)
+    {
+        frame.queries.clear();
+        for (size_t i = 0u; i <= numRenderPasses; ++i)
+            frame.queries.push_back(renderer->createTimestampQuery());
+    }
+
+    frame.queries.front()->record();
+    frame.isPending = true;
+}
+
+void RenderPassesProfiler::endRenderPass(size_t renderPassIndex)
+{
+    auto& frame = m_frames[m_frameIndex];
+    frame.queries[renderPassIndex + 1u]->record();
+}
+
+const std::vector<float>& RenderPassesProfiler::renderPassesTimes() const
+{
+    return m_renderPassesTimes;
+}
+
+const std::vector<float>& RenderPassesProfiler::averageRenderPassesTimes() const
+{
+    return m_averageRenderPassesTimes;
+}
+
+void RenderPassesProfiler::resolve(const Frame& frame)
+{
+    static constexpr float AverageFactor = .05f;
+
+    // the set of passes has been changed since the frame was recorded
+    if (frame.queries.size() != m_renderPassesTimes.size() + 1u) return;
+
+    auto previousTime = frame.queries.front()->time();
+    for (size_t i = 0u; i < m_renderPassesTimes.size(); ++i)
+    {
+        const auto time = frame.queries[i + 1u]->time();
+        const auto renderPassTime = static_cast<float>(time - previousTime) * 1e-6f;
+        previousTime = time;
+
+        auto& averageRenderPassTime = m_averageRenderPassesTimes[i];
+        averageRenderPassTime = (averageRenderPassTime > 0.f)
+                                    ? averageRenderPassTime + (renderPassTime - averageRenderPassTime) * AverageFactor
+                                    : renderPassTime;
+
+        m_renderPassesTimes[i] = renderPassTime;
+    }
+}
+
+} // namespace core
+} // namespace simplex
@@ -0,0 +1,49 @@
+#ifndef CORE_RENDERPASSESPROFILER_H
+#define CORE_RENDERPASSESPROFILER_H
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <core/forwarddecl.h>
+
+namespace simplex
+{
+namespace core
+{
+
+class RenderPassesProfiler
+{
+public:
+    RenderPassesProfiler();
+    ~RenderPassesProfiler();
+
+    void beginFrame(const std::shared_ptr<graphics::RendererBase>&, size_t numRenderPasses);
+    void endRenderPass(size_t);
+
+    const std::vector<float>& renderPassesTimes() const;
+    const std::vector<float>& averageRenderPassesTimes() const;
+
+private:
+    // results are read back a few frames later, so the queries are never waited for
+    static constexpr size_t FramesCount = 4u;
+
+    struct Frame
+    {
+        std::vector<std::shared_ptr<graphics::ITimestampQuery>> queries;
+        bool isPending = false;
+    };
+
+    void resolve(const Frame&);
+
+    std::array<Frame, FramesCount> m_frames;
+    size_t m_frameIndex = 0u;
+
+    std::vector<float> m_renderPassesTimes;
+    std::vector<float> m_averageRenderPassesTimes;
+};
+
+} // namespace core
+} // namespace simplex
+
+#endif // CORE_RENDERPASSESPROFILER_H
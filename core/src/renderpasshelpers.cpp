@@ -14,8 +14,11 @@ namespace simplex
 namespace core
 {
 
-SimplePass::SimplePass(const std::shared_ptr<RenderPipeLine>& renderPipeLine, const RunMethod& runMethod)
-    : RenderPass(renderPipeLine)
+SimplePass::SimplePass(
+    const std::string& name,
+    const std::shared_ptr<RenderPipeLine>& renderPipeLine,
+    const RunMethod& runMethod)
+    : RenderPass(name, renderPipeLine)
     , m_runMethod(runMethod)
 {
 }
@@ -35,7 +38,7 @@ void SimplePass::run(
 InitializePass::InitializePass(
     const std::shared_ptr<ProgramsLoader>& programsManager,
     const std::shared_ptr<RenderPipeLine>& renderPipeLine)
-    : RenderPass(renderPipeLine)
+    : RenderPass("InitializePass", renderPipeLine)
 {
     m_program = programsManager->loadOrGetComputeProgram(resources::InitializePassComputeShaderPath, {});
 
@@ -64,7 +67,7 @@ void InitializePass::run(
 BuildClusterPass::BuildClusterPass(
     const std::shared_ptr<ProgramsLoader>& programsManager,
     const std::shared_ptr<RenderPipeLine>& renderPipeLine)
-    : RenderPass(renderPipeLine)
+    : RenderPass("BuildClusterPass", renderPipeLine)
 {
     m_program = programsManager->loadOrGetComputeProgram(resources::BuildClusterPassComputeShaderPath, {});
 
@@ -96,13 +99,26 @@ void BuildClusterPass::run(
 
 CullDrawDataPass::CullDrawDataPass(
     const std::shared_ptr<ProgramsLoader>& programsManager,
-    const std::shared_ptr<RenderPipeLine>& renderPipeLine)
-    : RenderPass(renderPipeLine)
+    const std::shared_ptr<RenderPipeLine>& renderPipeLine,
+    OcclusionCullingPhase occlusionCullingPhase)
+    : RenderPass("CullDrawDataPass", renderPipeLine)
 {
-    const auto drawDataCullingAlgorithm = settings::Settings::instance().graphics().drawDataCullingAlgorithm();
+    const auto& graphicsSettings = settings::Settings::instance().graphics();
+    const auto drawDataCullingAlgorithm = graphicsSettings.drawDataCullingAlgorithm();
     m_program = programsManager->loadOrGetComputeProgram(
         resources::CullDrawDataPassComputeShaderPath,
-        {{"DRAW_DATA_CULLING_ALGORITHM", std::to_string(castFromDrawDataCullingAlgorithm(drawDataCullingAlgorithm))}});
+        {{"DRAW_DATA_CULLING_ALGORITHM", std::to_string(castFromDrawDataCullingAlgorithm(drawDataCullingAlgorithm))},
+         {"MESH_LOD_BIAS", std::to_string(graphicsSettings.meshLODBias())},
+         {"AUTO_INSTANCING", renderPipeLine->isAutoInstancingEnabled() ? "1" : "0"},
+         {"OCCLUSION_CULLING_PHASE", std::to_string(castFromOcclusionCullingPhase(occlusionCullingPhase))}});
+
+    if (occlusionCullingPhase != OcclusionCullingPhase::Disabled)
+        getOrCreateShaderStorageBlock(ShaderStorageBlockID::DrawDataVisibilityBuffer) =
+            graphics::BufferRange::create(renderPipeLine->drawDataVisibilityBuffer()->buffer());
+
+    if (occlusionCullingPhase == OcclusionCullingPhase::Second)
+        getOrCreateShaderStorageBlock(ShaderStorageBlockID::DepthPyramidBuffer) =
+            graphics::BufferRange::create(renderPipeLine->depthPyramidBuffer()->buffer());
 
     getOrCreateShaderStorageBlock(ShaderStorageBlockID::RenderInfoBuffer) =
         graphics::BufferRange::create(renderPipeLine->renderInfoBuffer()->buffer());
@@ -118,6 +134,24 @@ CullDrawDataPass::CullDrawDataPass(
 
     getOrCreateShaderStorageBlock(ShaderStorageBlockID::TransparentDrawDataRenderCommandsBuffer) =
         graphics::BufferRange::create(renderPipeLine->transparentDrawDataRenderCommandsBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::OpaqueDrawData16RenderCommandsBuffer) =
+        graphics::BufferRange::create(renderPipeLine->opaqueDrawData16RenderCommandsBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::TransparentDrawData16RenderCommandsBuffer) =
+        graphics::BufferRange::create(renderPipeLine->transparentDrawData16RenderCommandsBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::MeshletsCullDrawDataBuffer) =
+        graphics::BufferRange::create(renderPipeLine->meshletsCullDrawDataBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::DrawablesInstancesBuffer) =
+        graphics::BufferRange::create(renderPipeLine->drawablesInstancesBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::InstancedDrawDataBuffer) =
+        graphics::BufferRange::create(renderPipeLine->instancedDrawDataBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::DrawDataInstancesBuffer) =
+        graphics::BufferRange::create(renderPipeLine->drawDataInstancesBuffer()->buffer());
 }
 
 CullDrawDataPass::~CullDrawDataPass() = default;
@@ -133,10 +167,160 @@ void CullDrawDataPass::run(
         glm::uvec3(static_cast<uint32_t>(sceneData->drawDataCount()), 1u, 1u), m_program, {sceneData, shared_from_this()});
 }
 
+GenerateInstancedDrawDataCommandsPass::GenerateInstancedDrawDataCommandsPass(
+    const std::shared_ptr<ProgramsLoader>& programsManager,
+    const std::shared_ptr<RenderPipeLine>& renderPipeLine)
+    : RenderPass("GenerateInstancedDrawDataCommandsPass", renderPipeLine)
+{
+    m_program = programsManager->loadOrGetComputeProgram(resources::GenerateInstancedDrawDataCommandsPassComputeShaderPath, {});
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::CountersBuffer) =
+        graphics::BufferRange::create(renderPipeLine->countersBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::OpaqueDrawDataRenderCommandsBuffer) =
+        graphics::BufferRange::create(renderPipeLine->opaqueDrawDataRenderCommandsBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::TransparentDrawDataRenderCommandsBuffer) =
+        graphics::BufferRange::create(renderPipeLine->transparentDrawDataRenderCommandsBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::OpaqueDrawData16RenderCommandsBuffer) =
+        graphics::BufferRange::create(renderPipeLine->opaqueDrawData16RenderCommandsBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::TransparentDrawData16RenderCommandsBuffer) =
+        graphics::BufferRange::create(renderPipeLine->transparentDrawData16RenderCommandsBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::DrawablesInstancesBuffer) =
+        graphics::BufferRange::create(renderPipeLine->drawablesInstancesBuffer()->buffer());
+}
+
+GenerateInstancedDrawDataCommandsPass::~GenerateInstancedDrawDataCommandsPass() = default;
+
+void GenerateInstancedDrawDataCommandsPass::run(
+    const std::shared_ptr<graphics::RendererBase>& renderer,
+    const std::shared_ptr<graphics::IFrameBuffer>&,
+    const std::shared_ptr<graphics::IVertexArray>&,
+    const std::shared_ptr<const GeometryBuffer>&,
+    const std::shared_ptr<const SceneData>& sceneData)
+{
+    renderer->compute(
+        glm::uvec3(static_cast<uint32_t>(sceneData->drawablesCount()), 1u, 1u), m_program, {sceneData, shared_from_this()});
+}
+
+FillDrawDataInstancesPass::FillDrawDataInstancesPass(
+    const std::shared_ptr<ProgramsLoader>& programsManager,
+    const std::shared_ptr<RenderPipeLine>& renderPipeLine)
+    : RenderPass("FillDrawDataInstancesPass", renderPipeLine)
+{
+    m_program = programsManager->loadOrGetComputeProgram(resources::FillDrawDataInstancesPassComputeShaderPath, {});
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::RenderInfoBuffer) =
+        graphics::BufferRange::create(renderPipeLine->renderInfoBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::CountersBuffer) =
+        graphics::BufferRange::create(renderPipeLine->countersBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::DrawablesInstancesBuffer) =
+        graphics::BufferRange::create(renderPipeLine->drawablesInstancesBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::InstancedDrawDataBuffer) =
+        graphics::BufferRange::create(renderPipeLine->instancedDrawDataBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::DrawDataInstancesBuffer) =
+        graphics::BufferRange::create(renderPipeLine->drawDataInstancesBuffer()->buffer());
+}
+
+FillDrawDataInstancesPass::~FillDrawDataInstancesPass() = default;
+
+void FillDrawDataInstancesPass::run(
+    const std::shared_ptr<graphics::RendererBase>& renderer,
+    const std::shared_ptr<graphics::IFrameBuffer>&,
+    const std::shared_ptr<graphics::IVertexArray>&,
+    const std::shared_ptr<const GeometryBuffer>&,
+    const std::shared_ptr<const SceneData>& sceneData)
+{
+    // the number of the instanced draw data is only known on GPU, the draw data count is its upper bound
+    renderer->compute(
+        glm::uvec3(static_cast<uint32_t>(sceneData->drawDataCount()), 1u, 1u), m_program, {sceneData, shared_from_this()});
+}
+
+PrepareMeshletsCullCommandPass::PrepareMeshletsCullCommandPass(
+    const std::shared_ptr<ProgramsLoader>& programsManager,
+    const std::shared_ptr<RenderPipeLine>& renderPipeLine)
+    : RenderPass("PrepareMeshletsCullCommandPass", renderPipeLine)
+{
+    m_program = programsManager->loadOrGetComputeProgram(resources::PrepareMeshletsCullCommandPassComputeShaderPath, {});
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::CountersBuffer) =
+        graphics::BufferRange::create(renderPipeLine->countersBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::MeshletsCullCommandBuffer) =
+        graphics::BufferRange::create(renderPipeLine->meshletsCullCommandBuffer()->buffer());
+}
+
+PrepareMeshletsCullCommandPass::~PrepareMeshletsCullCommandPass() = default;
+
+void PrepareMeshletsCullCommandPass::run(
+    const std::shared_ptr<graphics::RendererBase>& renderer,
+    const std::shared_ptr<graphics::IFrameBuffer>&,
+    const std::shared_ptr<graphics::IVertexArray>&,
+    const std::shared_ptr<const GeometryBuffer>&,
+    const std::shared_ptr<const SceneData>&)
+{
+    renderer->compute(glm::uvec3(1u), m_program, {shared_from_this()});
+}
+
+CullMeshletsPass::CullMeshletsPass(
+    const std::shared_ptr<ProgramsLoader>& programsManager,
+    const std::shared_ptr<RenderPipeLine>& renderPipeLine)
+    : RenderPass("CullMeshletsPass", renderPipeLine)
+{
+    m_program = programsManager->loadOrGetComputeProgram(resources::CullMeshletsPassComputeShaderPath, {});
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::CameraBuffer) =
+        graphics::BufferRange::create(renderPipeLine->cameraBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::CountersBuffer) =
+        graphics::BufferRange::create(renderPipeLine->countersBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::OpaqueDrawDataRenderCommandsBuffer) =
+        graphics::BufferRange::create(renderPipeLine->opaqueDrawDataRenderCommandsBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::TransparentDrawDataRenderCommandsBuffer) =
+        graphics::BufferRange::create(renderPipeLine->transparentDrawDataRenderCommandsBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::OpaqueDrawData16RenderCommandsBuffer) =
+        graphics::BufferRange::create(renderPipeLine->opaqueDrawData16RenderCommandsBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::TransparentDrawData16RenderCommandsBuffer) =
+        graphics::BufferRange::create(renderPipeLine->transparentDrawData16RenderCommandsBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::MeshletsCullDrawDataBuffer) =
+        graphics::BufferRange::create(renderPipeLine->meshletsCullDrawDataBuffer()->buffer());
+}
+
+CullMeshletsPass::~CullMeshletsPass() = default;
+
+void CullMeshletsPass::run(
+    const std::shared_ptr<graphics::RendererBase>& renderer,
+    const std::shared_ptr<graphics::IFrameBuffer>&,
+    const std::shared_ptr<graphics::IVertexArray>&,
+    const std::shared_ptr<const GeometryBuffer>&,
+    const std::shared_ptr<const SceneData>& sceneData)
+{
+    auto renderPipeLine = m_renderPipeLine.lock();
+    if (!renderPipeLine)
+    {
+        LOG_CRITICAL << "RenderPipeLine can't be nullptr";
+        return;
+    }
+
+    renderer->computeIndirect(m_program, {sceneData, shared_from_this()}, renderPipeLine->meshletsCullCommandBuffer());
+}
+
 CollectSkeletalAnimatedDataToUpdatePass::CollectSkeletalAnimatedDataToUpdatePass(
     const std::shared_ptr<ProgramsLoader>& programsManager,
     const std::shared_ptr<RenderPipeLine>& renderPipeLine)
-    : RenderPass(renderPipeLine)
+    : RenderPass("CollectSkeletalAnimatedDataToUpdatePass", renderPipeLine)
 {
     m_program = programsManager->loadOrGetComputeProgram(resources::CollectSkeletalAnimatedDataToUpdatePassComputeShaderPath, {});
 
@@ -167,7 +351,7 @@ void CollectSkeletalAnimatedDataToUpdatePass::run(
 UpdateCameraPass::UpdateCameraPass(
     const std::shared_ptr<ProgramsLoader>& programsManager,
     const std::shared_ptr<RenderPipeLine>& renderPipeLine)
-    : RenderPass(renderPipeLine)
+    : RenderPass("UpdateCameraPass", renderPipeLine)
 {
     m_program = programsManager->loadOrGetComputeProgram(resources::UpdateCameraPassComputeShaderPath, {});
 
@@ -196,7 +380,7 @@ void UpdateCameraPass::run(
 PrepareBonesTransformsDataCalculateCommandPass::PrepareBonesTransformsDataCalculateCommandPass(
     const std::shared_ptr<ProgramsLoader>& programsManager,
     const std::shared_ptr<RenderPipeLine>& renderPipeLine)
-    : RenderPass(renderPipeLine)
+    : RenderPass("PrepareBonesTransformsDataCalculateCommandPass", renderPipeLine)
 {
     const auto calculateBonesTransformsDataComputeProgram =
         programsManager->loadOrGetComputeProgram(resources::CalculateBonesTransformsDataPassComputeShaderPath, {});
@@ -231,7 +415,7 @@ void PrepareBonesTransformsDataCalculateCommandPass::run(
 CalculateBonesTransformsDataPass::CalculateBonesTransformsDataPass(
     const std::shared_ptr<ProgramsLoader>& programsManager,
     const std::shared_ptr<RenderPipeLine>& renderPipeLine)
-    : RenderPass(renderPipeLine)
+    : RenderPass("CalculateBonesTransformsDataPass", renderPipeLine)
 {
     m_program = programsManager->loadOrGetComputeProgram(resources::CalculateBonesTransformsDataPassComputeShaderPath, {});
 
@@ -268,7 +452,7 @@ void CalculateBonesTransformsDataPass::run(
 RenderDrawDataPass::RenderDrawDataPass(
     const std::shared_ptr<ProgramsLoader>& programsManager,
     const std::shared_ptr<RenderPipeLine>& renderPipeLine)
-    : RenderPass(renderPipeLine)
+    : RenderPass("RenderDrawDataPass", renderPipeLine)
 
 {
     m_opaqueProgram = programsManager->loadOrGetRenderProgram(
@@ -282,6 +466,9 @@ RenderDrawDataPass::RenderDrawDataPass(
 
     getOrCreateShaderStorageBlock(ShaderStorageBlockID::CameraBuffer) =
         graphics::BufferRange::create(renderPipeLine->cameraBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::DrawDataInstancesBuffer) =
+        graphics::BufferRange::create(renderPipeLine->drawDataInstancesBuffer()->buffer());
 }
 
 RenderDrawDataPass::~RenderDrawDataPass() = default;
@@ -308,16 +495,32 @@ void RenderDrawDataPass::run(
     framebuffer->setDepthTest(true);
     framebuffer->setDepthMask(true);
 
+    vertexArray->attachIndexBuffer(sceneData->elementDataBuffer()->buffer());
     renderer->multiDrawElementsIndirectCount(
         glm::uvec4(0u, 0u, renderPipeLine->viewportSize()), m_opaqueProgram, framebuffer, vertexArray,
         {sceneData, shared_from_this()}, utils::PrimitiveType::Triangles,
         utils::toDrawElementsIndexType<ElementDataDescription>(), renderPipeLine->opaqueDrawDataRenderCommandsBuffer(),
         renderPipeLine->opaqueDrawDataRenderParameterBuffer());
 
+    vertexArray->attachIndexBuffer(sceneData->element16DataBuffer()->buffer());
+    renderer->multiDrawElementsIndirectCount(
+        glm::uvec4(0u, 0u, renderPipeLine->viewportSize()), m_opaqueProgram, framebuffer, vertexArray,
+        {sceneData, shared_from_this()}, utils::PrimitiveType::Triangles,
+        utils::toDrawElementsIndexType<Element16DataDescription>(), renderPipeLine->opaqueDrawData16RenderCommandsBuffer(),
+        renderPipeLine->opaqueDrawData16RenderParameterBuffer());
+
     framebuffer->reset();
     framebuffer->attach(graphics::FrameBufferAttachment::Depth, geometryBuffer->depthTexture());
     framebuffer->setDepthTest(true);
 
+    vertexArray->attachIndexBuffer(sceneData->element16DataBuffer()->buffer());
+    renderer->multiDrawElementsIndirectCount(
+        glm::uvec4(0u, 0u, renderPipeLine->viewportSize()), m_transparentProgram, framebuffer, vertexArray,
+        {geometryBuffer, sceneData, shared_from_this()}, utils::PrimitiveType::Triangles,
+        utils::toDrawElementsIndexType<Element16DataDescription>(), renderPipeLine->transparentDrawData16RenderCommandsBuffer(),
+        renderPipeLine->transparentDrawData16RenderParameterBuffer());
+
+    vertexArray->attachIndexBuffer(sceneData->elementDataBuffer()->buffer());
     renderer->multiDrawElementsIndirectCount(
         glm::uvec4(0u, 0u, renderPipeLine->viewportSize()), m_transparentProgram, framebuffer, vertexArray,
         {geometryBuffer, sceneData, shared_from_this()}, utils::PrimitiveType::Triangles,
@@ -325,10 +528,76 @@ void RenderDrawDataPass::run(
         renderPipeLine->transparentDrawDataRenderParameterBuffer());
 }
 
+BuildDepthPyramidPass::BuildDepthPyramidPass(
+    const std::shared_ptr<ProgramsLoader>& programsManager,
+    const std::shared_ptr<RenderPipeLine>& renderPipeLine)
+    : RenderPass("BuildDepthPyramidPass", renderPipeLine)
+{
+    m_program = programsManager->loadOrGetComputeProgram(resources::BuildDepthPyramidPassComputeShaderPath, {});
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::RenderInfoBuffer) =
+        graphics::BufferRange::create(renderPipeLine->renderInfoBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::DepthPyramidBuffer) =
+        graphics::BufferRange::create(renderPipeLine->depthPyramidBuffer()->buffer());
+}
+
+BuildDepthPyramidPass::~BuildDepthPyramidPass() = default;
+
+void BuildDepthPyramidPass::run(
+    const std::shared_ptr<graphics::RendererBase>& renderer,
+    const std::shared_ptr<graphics::IFrameBuffer>&,
+    const std::shared_ptr<graphics::IVertexArray>&,
+    const std::shared_ptr<const GeometryBuffer>& geometryBuffer,
+    const std::shared_ptr<const SceneData>&)
+{
+    auto renderPipeLine = m_renderPipeLine.lock();
+    if (!renderPipeLine)
+    {
+        LOG_CRITICAL << "RenderPipeLine can't be nullptr";
+        return;
+    }
+
+    const auto depthPyramidTexture = renderPipeLine->depthPyramidTexture();
+    if (!depthPyramidTexture) return;
+
+    // every level is reduced from the previous one, the level 0 is reduced from the depth buffer
+    const auto& depthPyramidBuffer = renderPipeLine->depthPyramidBuffer();
+    for (uint32_t level = 0u; level < depthPyramidTexture->numMipmapLevels(); ++level)
+    {
+        depthPyramidBuffer->setField(offsetof(DepthPyramidDescription, levelIndex), level);
+        renderer->compute(
+            glm::uvec3(glm::uvec2(depthPyramidTexture->mipmapSize(level)), 1u), m_program, {geometryBuffer, shared_from_this()});
+    }
+}
+
+ResetDrawDataRenderCommandsPass::ResetDrawDataRenderCommandsPass(
+    const std::shared_ptr<ProgramsLoader>& programsManager,
+    const std::shared_ptr<RenderPipeLine>& renderPipeLine)
+    : RenderPass("ResetDrawDataRenderCommandsPass", renderPipeLine)
+{
+    m_program = programsManager->loadOrGetComputeProgram(resources::ResetDrawDataRenderCommandsPassComputeShaderPath, {});
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::CountersBuffer) =
+        graphics::BufferRange::create(renderPipeLine->countersBuffer()->buffer());
+}
+
+ResetDrawDataRenderCommandsPass::~ResetDrawDataRenderCommandsPass() = default;
+
+void ResetDrawDataRenderCommandsPass::run(
+    const std::shared_ptr<graphics::RendererBase>& renderer,
+    const std::shared_ptr<graphics::IFrameBuffer>&,
+    const std::shared_ptr<graphics::IVertexArray>&,
+    const std::shared_ptr<const GeometryBuffer>&,
+    const std::shared_ptr<const SceneData>&)
+{
+    renderer->compute(glm::uvec3(1u), m_program, {shared_from_this()});
+}
+
 ClusterGlobalLightPass::ClusterGlobalLightPass(
     const std::shared_ptr<ProgramsLoader>& programsManager,
     const std::shared_ptr<RenderPipeLine>& renderPipeLine)
-    : RenderPass(renderPipeLine)
+    : RenderPass("ClusterGlobalLightPass", renderPipeLine)
 {
     const auto spotLightCullingAlgorithm = settings::Settings::instance().graphics().spotLightCullingAlgorithm();
     m_program = programsManager->loadOrGetComputeProgram(
@@ -350,8 +619,8 @@ ClusterGlobalLightPass::ClusterGlobalLightPass(
     getOrCreateShaderStorageBlock(ShaderStorageBlockID::ClusterLocalLightsBuffer) =
         graphics::BufferRange::create(renderPipeLine->clusterLocalLightsBuffer()->buffer());
 
-    getOrCreateShaderStorageBlock(ShaderStorageBlockID::LightNodesBuffer) =
-        graphics::BufferRange::create(renderPipeLine->lightNodesBuffer()->buffer());
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::LightIndicesBuffer) =
+        graphics::BufferRange::create(renderPipeLine->lightIndicesBuffer()->buffer());
 
     getOrCreateShaderStorageBlock(ShaderStorageBlockID::ShadowsToUpdateBuffer) =
         graphics::BufferRange::create(renderPipeLine->shadowsToUpdateBuffer()->buffer());
@@ -373,22 +642,55 @@ void ClusterGlobalLightPass::run(
         glm::uvec3(static_cast<uint32_t>(sceneData->lightsCount()), 1u, 1u), m_program, {sceneData, shared_from_this()});
 }
 
+ClearLightMasksPass::ClearLightMasksPass(
+    const std::shared_ptr<ProgramsLoader>& programsManager,
+    const std::shared_ptr<RenderPipeLine>& renderPipeLine)
+    : RenderPass("ClearLightMasksPass", renderPipeLine)
+{
+    m_program = programsManager->loadOrGetComputeProgram(resources::ClearLightMasksPassComputeShaderPath, {});
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::RenderInfoBuffer) =
+        graphics::BufferRange::create(renderPipeLine->renderInfoBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::LightMasksBuffer) =
+        graphics::BufferRange::create(renderPipeLine->lightMasksBuffer()->buffer());
+}
+
+ClearLightMasksPass::~ClearLightMasksPass() = default;
+
+void ClearLightMasksPass::run(
+    const std::shared_ptr<graphics::RendererBase>& renderer,
+    const std::shared_ptr<graphics::IFrameBuffer>&,
+    const std::shared_ptr<graphics::IVertexArray>&,
+    const std::shared_ptr<const GeometryBuffer>&,
+    const std::shared_ptr<const SceneData>&)
+{
+    auto renderPipeLine = m_renderPipeLine.lock();
+    if (!renderPipeLine)
+    {
+        LOG_CRITICAL << "RenderPipeLine can't be nullptr";
+        return;
+    }
+
+    renderer->compute(
+        glm::uvec3(static_cast<uint32_t>(renderPipeLine->lightMasksBuffer()->size()), 1u, 1u), m_program,
+        {shared_from_this()});
+}
+
 PrepareClusterLocalLightsCommandPass::PrepareClusterLocalLightsCommandPass(
     const std::shared_ptr<ProgramsLoader>& programsManager,
     const std::shared_ptr<RenderPipeLine>& renderPipeLine)
-    : RenderPass(renderPipeLine)
+    : RenderPass("PrepareClusterLocalLightsCommandPass", renderPipeLine)
 {
-    const auto clusterLocalLightComputeProgram =
-        programsManager->loadOrGetComputeProgram(resources::ClusterLocalLightPassComputeShaderPath, {});
+    const auto binClusterLocalLightsComputeProgram =
+        programsManager->loadOrGetComputeProgram(resources::BinClusterLocalLightsPassComputeShaderPath, {});
 
-    const auto clusterLocalLightComputeProgramWorkGroupSize = clusterLocalLightComputeProgram->workGroupSize();
+    const auto binClusterLocalLightsComputeProgramWorkGroupSize = binClusterLocalLightsComputeProgram->workGroupSize();
 
     m_program = programsManager->loadOrGetComputeProgram(
         resources::PrepareClusterLocalLightCommandPassComputeShaderPath,
-        {{"CLUSTER_LOCAL_LIGHT_COMPUTE_PROGRAM_WORK_GROUP_SIZE_X",
-          std::to_string(clusterLocalLightComputeProgramWorkGroupSize.x)},
-         {"CLUSTER_LOCAL_LIGHT_COMPUTE_PROGRAM_WORK_GROUP_SIZE_Y",
-          std::to_string(clusterLocalLightComputeProgramWorkGroupSize.y)}});
+        {{"BIN_CLUSTER_LOCAL_LIGHTS_COMPUTE_PROGRAM_WORK_GROUP_SIZE_X",
+          std::to_string(binClusterLocalLightsComputeProgramWorkGroupSize.x)}});
 
     getOrCreateShaderStorageBlock(ShaderStorageBlockID::CountersBuffer) =
         graphics::BufferRange::create(renderPipeLine->countersBuffer()->buffer());
@@ -412,15 +714,62 @@ void PrepareClusterLocalLightsCommandPass::run(
     renderer->compute(glm::uvec3(1u), m_program, {shared_from_this()});
 }
 
+BinClusterLocalLightsPass::BinClusterLocalLightsPass(
+    const std::shared_ptr<ProgramsLoader>& programsManager,
+    const std::shared_ptr<RenderPipeLine>& renderPipeLine)
+    : RenderPass("BinClusterLocalLightsPass", renderPipeLine)
+{
+    m_program = programsManager->loadOrGetComputeProgram(resources::BinClusterLocalLightsPassComputeShaderPath, {});
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::RenderInfoBuffer) =
+        graphics::BufferRange::create(renderPipeLine->renderInfoBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::CountersBuffer) =
+        graphics::BufferRange::create(renderPipeLine->countersBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::CameraBuffer) =
+        graphics::BufferRange::create(renderPipeLine->cameraBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::ClusterLocalLightsBuffer) =
+        graphics::BufferRange::create(renderPipeLine->clusterLocalLightsBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::LightMasksBuffer) =
+        graphics::BufferRange::create(renderPipeLine->lightMasksBuffer()->buffer());
+}
+
+BinClusterLocalLightsPass::~BinClusterLocalLightsPass() = default;
+
+void BinClusterLocalLightsPass::run(
+    const std::shared_ptr<graphics::RendererBase>& renderer,
+    const std::shared_ptr<graphics::IFrameBuffer>&,
+    const std::shared_ptr<graphics::IVertexArray>&,
+    const std::shared_ptr<const GeometryBuffer>&,
+    const std::shared_ptr<const SceneData>& sceneData)
+{
+    auto renderPipeLine = m_renderPipeLine.lock();
+    if (!renderPipeLine)
+    {
+        LOG_CRITICAL << "RenderPipeLine can't be nullptr";
+        return;
+    }
+
+    renderer->computeIndirect(m_program, {sceneData, shared_from_this()}, renderPipeLine->clusterLocalLightsCommandBuffer());
+}
+
 ClusterLocalLightPass::ClusterLocalLightPass(
     const std::shared_ptr<ProgramsLoader>& programsManager,
     const std::shared_ptr<RenderPipeLine>& renderPipeLine)
-    : RenderPass(renderPipeLine)
+    : RenderPass("ClusterLocalLightPass", renderPipeLine)
 {
-    const auto spotLightCullingAlgorithm = settings::Settings::instance().graphics().spotLightCullingAlgorithm();
+    const auto& graphicsSettings = settings::Settings::instance().graphics();
     m_program = programsManager->loadOrGetComputeProgram(
         resources::ClusterLocalLightPassComputeShaderPath,
-        {{"SPOT_LIGHT_CULLING_ALGORITHM", std::to_string(castFromSpotLightCullingAlgorithm(spotLightCullingAlgorithm))}});
+        {{"SPOT_LIGHT_CULLING_ALGORITHM",
+          std::to_string(castFromSpotLightCullingAlgorithm(graphicsSettings.spotLightCullingAlgorithm()))},
+         {"LIGHT_BINNING", renderPipeLine->isLightBinningEnabled() ? "1" : "0"}});
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::RenderInfoBuffer) =
+        graphics::BufferRange::create(renderPipeLine->renderInfoBuffer()->buffer());
 
     getOrCreateShaderStorageBlock(ShaderStorageBlockID::CountersBuffer) =
         graphics::BufferRange::create(renderPipeLine->countersBuffer()->buffer());
@@ -434,8 +783,11 @@ ClusterLocalLightPass::ClusterLocalLightPass(
     getOrCreateShaderStorageBlock(ShaderStorageBlockID::ClusterLocalLightsBuffer) =
         graphics::BufferRange::create(renderPipeLine->clusterLocalLightsBuffer()->buffer());
 
-    getOrCreateShaderStorageBlock(ShaderStorageBlockID::LightNodesBuffer) =
-        graphics::BufferRange::create(renderPipeLine->lightNodesBuffer()->buffer());
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::LightIndicesBuffer) =
+        graphics::BufferRange::create(renderPipeLine->lightIndicesBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::LightMasksBuffer) =
+        graphics::BufferRange::create(renderPipeLine->lightMasksBuffer()->buffer());
 }
 
 ClusterLocalLightPass::~ClusterLocalLightPass() = default;
@@ -454,13 +806,101 @@ void ClusterLocalLightPass::run(
         return;
     }
 
-    renderer->computeIndirect(m_program, {sceneData, shared_from_this()}, renderPipeLine->clusterLocalLightsCommandBuffer());
+    renderer->compute(renderPipeLine->clusterSize(), m_program, {sceneData, shared_from_this()});
+}
+
+ClusterLightIndicesOffsetsPass::ClusterLightIndicesOffsetsPass(
+    const std::shared_ptr<ProgramsLoader>& programsManager,
+    const std::shared_ptr<RenderPipeLine>& renderPipeLine)
+    : RenderPass("ClusterLightIndicesOffsetsPass", renderPipeLine)
+{
+    m_program = programsManager->loadOrGetComputeProgram(resources::ClusterLightIndicesOffsetsPassComputeShaderPath, {});
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::CountersBuffer) =
+        graphics::BufferRange::create(renderPipeLine->countersBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::CameraBuffer) =
+        graphics::BufferRange::create(renderPipeLine->cameraBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::ClusterNodesBuffer) =
+        graphics::BufferRange::create(renderPipeLine->clusterNodesBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::LightIndicesBuffer) =
+        graphics::BufferRange::create(renderPipeLine->lightIndicesBuffer()->buffer());
+}
+
+ClusterLightIndicesOffsetsPass::~ClusterLightIndicesOffsetsPass() = default;
+
+void ClusterLightIndicesOffsetsPass::run(
+    const std::shared_ptr<graphics::RendererBase>& renderer,
+    const std::shared_ptr<graphics::IFrameBuffer>&,
+    const std::shared_ptr<graphics::IVertexArray>&,
+    const std::shared_ptr<const GeometryBuffer>&,
+    const std::shared_ptr<const SceneData>&)
+{
+    // the prefix sum over all the clusters is done by one work group
+    renderer->compute(glm::uvec3(1u), m_program, {shared_from_this()});
+}
+
+FillClusterLightIndicesPass::FillClusterLightIndicesPass(
+    const std::shared_ptr<ProgramsLoader>& programsManager,
+    const std::shared_ptr<RenderPipeLine>& renderPipeLine)
+    : RenderPass("FillClusterLightIndicesPass", renderPipeLine)
+{
+    const auto& graphicsSettings = settings::Settings::instance().graphics();
+    m_program = programsManager->loadOrGetComputeProgram(
+        resources::ClusterLocalLightPassComputeShaderPath,
+        {{"SPOT_LIGHT_CULLING_ALGORITHM",
+          std::to_string(castFromSpotLightCullingAlgorithm(graphicsSettings.spotLightCullingAlgorithm()))},
+         {"LIGHT_BINNING", renderPipeLine->isLightBinningEnabled() ? "1" : "0"},
+         {"FILL_LIGHT_INDICES", "1"}});
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::RenderInfoBuffer) =
+        graphics::BufferRange::create(renderPipeLine->renderInfoBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::CountersBuffer) =
+        graphics::BufferRange::create(renderPipeLine->countersBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::CameraBuffer) =
+        graphics::BufferRange::create(renderPipeLine->cameraBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::ClusterNodesBuffer) =
+        graphics::BufferRange::create(renderPipeLine->clusterNodesBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::ClusterLocalLightsBuffer) =
+        graphics::BufferRange::create(renderPipeLine->clusterLocalLightsBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::LightIndicesBuffer) =
+        graphics::BufferRange::create(renderPipeLine->lightIndicesBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::LightMasksBuffer) =
+        graphics::BufferRange::create(renderPipeLine->lightMasksBuffer()->buffer());
+}
+
+FillClusterLightIndicesPass::~FillClusterLightIndicesPass() = default;
+
+void FillClusterLightIndicesPass::run(
+    const std::shared_ptr<graphics::RendererBase>& renderer,
+    const std::shared_ptr<graphics::IFrameBuffer>&,
+    const std::shared_ptr<graphics::IVertexArray>&,
+    const std::shared_ptr<const GeometryBuffer>&,
+    const std::shared_ptr<const SceneData>& sceneData)
+{
+    auto renderPipeLine = m_renderPipeLine.lock();
+    if (!renderPipeLine)
+    {
+        LOG_CRITICAL << "RenderPipeLine can't be nullptr";
+        return;
+    }
+
+    // the same tests as ClusterLocalLightPass, the intersections are written to the ranges of the clusters
+    renderer->compute(renderPipeLine->clusterSize(), m_program, {sceneData, shared_from_this()});
 }
 
 PrepareShadowDataCullCommnadPass::PrepareShadowDataCullCommnadPass(
     const std::shared_ptr<ProgramsLoader>& programsManager,
     const std::shared_ptr<RenderPipeLine>& renderPipeLine)
-    : RenderPass(renderPipeLine)
+    : RenderPass("PrepareShadowDataCullCommnadPass", renderPipeLine)
 {
     const auto cullShadowDataComputeProgram =
         programsManager->loadOrGetComputeProgram(resources::CullShadowDataPassComputeShaderPath, {});
@@ -497,7 +937,7 @@ void PrepareShadowDataCullCommnadPass::run(
 PrepareShadowMapBlurCommandsPass::PrepareShadowMapBlurCommandsPass(
     const std::shared_ptr<ProgramsLoader>& programsManager,
     const std::shared_ptr<RenderPipeLine>& renderPipeLine)
-    : RenderPass(renderPipeLine)
+    : RenderPass("PrepareShadowMapBlurCommandsPass", renderPipeLine)
 {
     m_program = programsManager->loadOrGetComputeProgram(resources::PrepareShadowMapBlurCommandsComputeShaderPath, {});
 
@@ -523,12 +963,14 @@ void PrepareShadowMapBlurCommandsPass::run(
 CullShadowDataPass::CullShadowDataPass(
     const std::shared_ptr<ProgramsLoader>& programsManager,
     const std::shared_ptr<RenderPipeLine>& renderPipeLine)
-    : RenderPass(renderPipeLine)
+    : RenderPass("CullShadowDataPass", renderPipeLine)
 {
-    const auto shadowDataCullingAlgorithm = settings::Settings::instance().graphics().shadowDataCullingAlgorithm();
+    const auto& graphicsSettings = settings::Settings::instance().graphics();
+    const auto shadowDataCullingAlgorithm = graphicsSettings.shadowDataCullingAlgorithm();
     m_program = programsManager->loadOrGetComputeProgram(
         resources::CullShadowDataPassComputeShaderPath,
-        {{"SHADOW_DATA_CULLING_ALGORITHM", std::to_string(castFromShadowDataCullingAlgorithm(shadowDataCullingAlgorithm))}});
+        {{"SHADOW_DATA_CULLING_ALGORITHM", std::to_string(castFromShadowDataCullingAlgorithm(shadowDataCullingAlgorithm))},
+         {"MESH_LOD_BIAS", std::to_string(graphicsSettings.meshLODBias())}});
 
     getOrCreateShaderStorageBlock(ShaderStorageBlockID::RenderInfoBuffer) =
         graphics::BufferRange::create(renderPipeLine->renderInfoBuffer()->buffer());
@@ -547,6 +989,12 @@ CullShadowDataPass::CullShadowDataPass(
 
     getOrCreateShaderStorageBlock(ShaderStorageBlockID::TransparentShadowDataRenderCommandsBuffer) =
         graphics::BufferRange::create(renderPipeLine->transparentShadowDataRenderCommandsBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::OpaqueShadowData16RenderCommandsBuffer) =
+        graphics::BufferRange::create(renderPipeLine->opaqueShadowData16RenderCommandsBuffer()->buffer());
+
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::TransparentShadowData16RenderCommandsBuffer) =
+        graphics::BufferRange::create(renderPipeLine->transparentShadowData16RenderCommandsBuffer()->buffer());
 }
 
 CullShadowDataPass::~CullShadowDataPass() = default;
@@ -571,7 +1019,7 @@ void CullShadowDataPass::run(
 RenderShadowDataPass::RenderShadowDataPass(
     const std::shared_ptr<ProgramsLoader>& programsManager,
     const std::shared_ptr<RenderPipeLine>& renderPipeLine)
-    : RenderPass(renderPipeLine)
+    : RenderPass("RenderShadowDataPass", renderPipeLine)
 {
     m_opaqueProgram = programsManager->loadOrGetRenderProgram(
         resources::RenderShadowDataPassVertexShaderPath, resources::RenderShadowDataPassGeometryShaderPath,
@@ -638,11 +1086,18 @@ void RenderShadowDataPass::run(
         for (uint32_t i = 0; i < 6u; ++i)
             framebuffer->setClipDistance(i, true);
 
+        vertexArray->attachIndexBuffer(sceneData->elementDataBuffer()->buffer());
         renderer->multiDrawElementsIndirectCount(
             viewport, m_opaqueProgram, framebuffer, vertexArray, {sceneData, shared_from_this()}, utils::PrimitiveType::Triangles,
             utils::toDrawElementsIndexType<ElementDataDescription>(), renderPipeLine->opaqueShadowDataRenderCommandsBuffer(),
             renderPipeLine->opaqueShadowDataRenderParameterBuffer());
 
+        vertexArray->attachIndexBuffer(sceneData->element16DataBuffer()->buffer());
+        renderer->multiDrawElementsIndirectCount(
+            viewport, m_opaqueProgram, framebuffer, vertexArray, {sceneData, shared_from_this()}, utils::PrimitiveType::Triangles,
+            utils::toDrawElementsIndexType<Element16DataDescription>(), renderPipeLine->opaqueShadowData16RenderCommandsBuffer(),
+            renderPipeLine->opaqueShadowData16RenderParameterBuffer());
+
         framebuffer->reset();
         framebuffer->attach(graphics::FrameBufferAttachment::Color0, colorTexture);
         framebuffer->attach(graphics::FrameBufferAttachment::Depth, depthTexture);
@@ -657,6 +1112,14 @@ void RenderShadowDataPass::run(
         for (uint32_t i = 0; i < 6u; ++i)
             framebuffer->setClipDistance(i, true);
 
+        vertexArray->attachIndexBuffer(sceneData->element16DataBuffer()->buffer());
+        renderer->multiDrawElementsIndirectCount(
+            viewport, m_transparentProgram, framebuffer, vertexArray, {sceneData, shared_from_this()},
+            utils::PrimitiveType::Triangles, utils::toDrawElementsIndexType<Element16DataDescription>(),
+            renderPipeLine->transparentShadowData16RenderCommandsBuffer(),
+            renderPipeLine->transparentShadowData16RenderParameterBuffer());
+
+        vertexArray->attachIndexBuffer(sceneData->elementDataBuffer()->buffer());
         renderer->multiDrawElementsIndirectCount(
             viewport, m_transparentProgram, framebuffer, vertexArray, {sceneData, shared_from_this()},
             utils::PrimitiveType::Triangles, utils::toDrawElementsIndexType<ElementDataDescription>(),
@@ -668,7 +1131,7 @@ void RenderShadowDataPass::run(
 BlurShadowMapPass::BlurShadowMapPass(
     const std::shared_ptr<ProgramsLoader>& programsManager,
     const std::shared_ptr<RenderPipeLine>& renderPipeLine)
-    : RenderPass(renderPipeLine)
+    : RenderPass("BlurShadowMapPass", renderPipeLine)
 {
     m_horizontalProgram = programsManager->loadOrGetRenderProgram(
         resources::BlurShadowMapPassVertexShaderPath, resources::BlurShadowMapPassGeometryShaderPath,
@@ -731,7 +1194,7 @@ void BlurShadowMapPass::run(
 RenderBackgroundPass::RenderBackgroundPass(
     const std::shared_ptr<ProgramsLoader>& programsManager,
     const std::shared_ptr<RenderPipeLine>& renderPipeLine)
-    : RenderPass(renderPipeLine)
+    : RenderPass("RenderBackgroundPass", renderPipeLine)
 {
     m_program = programsManager->loadOrGetRenderProgram(
         resources::RenderBackgroundPassVertexShaderPath, resources::RenderBackgroundPassFragmentShaderPath, {});
@@ -766,7 +1229,7 @@ void RenderBackgroundPass::run(
 }
 
 BlendPass::BlendPass(const std::shared_ptr<ProgramsLoader>& programsManager, const std::shared_ptr<RenderPipeLine>& renderPipeLine)
-    : RenderPass(renderPipeLine)
+    : RenderPass("BlendPass", renderPipeLine)
 {
     m_program = programsManager->loadOrGetRenderProgram(
         resources::BlendPassVertexShaderPath, resources::BlendPassFragmentShaderPath,
@@ -784,8 +1247,8 @@ BlendPass::BlendPass(const std::shared_ptr<ProgramsLoader>& programsManager, con
     getOrCreateShaderStorageBlock(ShaderStorageBlockID::ClusterNodesBuffer) =
         graphics::BufferRange::create(renderPipeLine->clusterNodesBuffer()->buffer());
 
-    getOrCreateShaderStorageBlock(ShaderStorageBlockID::LightNodesBuffer) =
-        graphics::BufferRange::create(renderPipeLine->lightNodesBuffer()->buffer());
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::LightIndicesBuffer) =
+        graphics::BufferRange::create(renderPipeLine->lightIndicesBuffer()->buffer());
 
     getOrCreateShaderStorageBlock(ShaderStorageBlockID::ShadowMapsBuffer) =
         graphics::BufferRange::create(renderPipeLine->shadowMapsBuffer()->buffer());
@@ -824,7 +1287,7 @@ void BlendPass::run(
 ToneMappingPass::ToneMappingPass(
     const std::shared_ptr<ProgramsLoader>& programsManager,
     const std::shared_ptr<RenderPipeLine>& renderPipeLine)
-    : RenderPass(renderPipeLine)
+    : RenderPass("ToneMappingPass", renderPipeLine)
 {
     m_calculateHistogramsProgram = programsManager->loadOrGetComputeProgram(resources::CalculateHistogramsComputeShaderPath, {});
     m_calculateExposureProgram = programsManager->loadOrGetComputeProgram(resources::CalculateExposureComputeShaderPath, {});
@@ -860,7 +1323,7 @@ void ToneMappingPass::run(
 }
 
 BloomPass::BloomPass(const std::shared_ptr<ProgramsLoader>& programsManager, const std::shared_ptr<RenderPipeLine>& renderPipeLine)
-    : RenderPass(renderPipeLine)
+    : RenderPass("BloomPass", renderPipeLine)
 {
     m_downSampleProgram = programsManager->loadOrGetRenderProgram(
         resources::BloomPassVertexShaderPath, resources::BloomDownSamplePassFragmentShaderPath, {});
@@ -939,7 +1402,7 @@ void BloomPass::run(
 }
 
 FinalPass::FinalPass(const std::shared_ptr<ProgramsLoader>& programsManager, const std::shared_ptr<RenderPipeLine>& renderPipeLine)
-    : RenderPass(renderPipeLine)
+    : RenderPass("FinalPass", renderPipeLine)
 {
     m_program =
         programsManager->loadOrGetRenderProgram(resources::FinalPassVertexShaderPath, resources::FinalPassFragmentShaderPath, {});
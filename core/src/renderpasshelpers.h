@@ -2,6 +2,7 @@
 #define CORE_RENDERPASSHELPERS_H
 
 #include <utils/clipspace.h>
+#include <utils/enumclass.h>
 #include <utils/transform.h>
 
 #include "renderpass.h"
@@ -22,7 +23,7 @@ public:
         const std::shared_ptr<const GeometryBuffer>&,
         const std::shared_ptr<const SceneData>&)>;
 
-    SimplePass(const std::shared_ptr<RenderPipeLine>&, const RunMethod&);
+    SimplePass(const std::string&, const std::shared_ptr<RenderPipeLine>&, const RunMethod&);
     ~SimplePass() override;
 
     void run(
@@ -70,10 +71,13 @@ private:
     std::shared_ptr<graphics::IComputeProgram> m_program;
 };
 
+// the first phase culls the draw data by their visibility last frame, the second one by the depth pyramid of the first one
+ENUMCLASS(OcclusionCullingPhase, uint16_t, Disabled, First, Second)
+
 class CullDrawDataPass : public RenderPass
 {
 public:
-    CullDrawDataPass(const std::shared_ptr<ProgramsLoader>&, const std::shared_ptr<RenderPipeLine>&);
+    CullDrawDataPass(const std::shared_ptr<ProgramsLoader>&, const std::shared_ptr<RenderPipeLine>&, OcclusionCullingPhase);
     ~CullDrawDataPass() override;
 
     void run(
@@ -87,6 +91,74 @@ private:
     std::shared_ptr<graphics::IComputeProgram> m_program;
 };
 
+class GenerateInstancedDrawDataCommandsPass : public RenderPass
+{
+public:
+    GenerateInstancedDrawDataCommandsPass(const std::shared_ptr<ProgramsLoader>&, const std::shared_ptr<RenderPipeLine>&);
+    ~GenerateInstancedDrawDataCommandsPass() override;
+
+    void run(
+        const std::shared_ptr<graphics::RendererBase>&,
+        const std::shared_ptr<graphics::IFrameBuffer>&,
+        const std::shared_ptr<graphics::IVertexArray>&,
+        const std::shared_ptr<const GeometryBuffer>&,
+        const std::shared_ptr<const SceneData>&) override;
+
+private:
+    std::shared_ptr<graphics::IComputeProgram> m_program;
+};
+
+class FillDrawDataInstancesPass : public RenderPass
+{
+public:
+    FillDrawDataInstancesPass(const std::shared_ptr<ProgramsLoader>&, const std::shared_ptr<RenderPipeLine>&);
+    ~FillDrawDataInstancesPass() override;
+
+    void run(
+        const std::shared_ptr<graphics::RendererBase>&,
+        const std::shared_ptr<graphics::IFrameBuffer>&,
+        const std::shared_ptr<graphics::IVertexArray>&,
+        const std::shared_ptr<const GeometryBuffer>&,
+        const std::shared_ptr<const SceneData>&) override;
+
+private:
+    std::shared_ptr<graphics::IComputeProgram> m_program;
+};
+
+class PrepareMeshletsCullCommandPass : public RenderPass
+{
+public:
+    PrepareMeshletsCullCommandPass(const std::shared_ptr<ProgramsLoader>&, const std::shared_ptr<RenderPipeLine>&);
+    ~PrepareMeshletsCullCommandPass() override;
+
+    void run(
+        const std::shared_ptr<graphics::RendererBase>&,
+        const std::shared_ptr<graphics::IFrameBuffer>&,
+        const std::shared_ptr<graphics::IVertexArray>&,
+        const std::shared_ptr<const GeometryBuffer>&,
+        const std::shared_ptr<const SceneData>&) override;
+
+private:
+    std::shared_ptr<graphics::IComputeProgram> m_program;
+};
+
+class CullMeshletsPass : public RenderPass
+{
+public:
+    CullMeshletsPass(const std::shared_ptr<ProgramsLoader>&, const std::shared_ptr<RenderPipeLine>&);
+    ~CullMeshletsPass() override;
+
+    void run(
+        const std::shared_ptr<graphics::RendererBase>&,
+        const std::shared_ptr<graphics::IFrameBuffer>&,
+        const std::shared_ptr<graphics::IVertexArray>&,
+        const std::shared_ptr<const GeometryBuffer>&,
+        const std::shared_ptr<const SceneData>&) override;
+
+private:
+    std::shared_ptr<graphics::IComputeProgram> m_program;
+};
+
 class CollectSkeletalAnimatedDataToUpdatePass : public RenderPass
 {
 public:
@@ -173,6 +245,40 @@ private:
     std::shared_ptr<graphics::IRenderProgram> m_transparentProgram;
 };
 
+class BuildDepthPyramidPass : public RenderPass
+{
+public:
+    BuildDepthPyramidPass(const std::shared_ptr<ProgramsLoader>&, const std::shared_ptr<RenderPipeLine>&);
+    ~BuildDepthPyramidPass() override;
+
+    void run(
+        const std::shared_ptr<graphics::RendererBase>&,
+        const std::shared_ptr<graphics::IFrameBuffer>&,
+        const std::shared_ptr<graphics::IVertexArray>&,
+        const std::shared_ptr<const GeometryBuffer>&,
+        const std::shared_ptr<const SceneData>&) override;
+
+private:
+    std::shared_ptr<graphics::IComputeProgram> m_program;
+};
+
+class ResetDrawDataRenderCommandsPass : public RenderPass
+{
+public:
+    ResetDrawDataRenderCommandsPass(const std::shared_ptr<ProgramsLoader>&, const std::shared_ptr<RenderPipeLine>&);
+    ~ResetDrawDataRenderCommandsPass() override;
+
+    void run(
+        const std::shared_ptr<graphics::RendererBase>&,
+        const std::shared_ptr<graphics::IFrameBuffer>&,
+        const std::shared_ptr<graphics::IVertexArray>&,
+        const std::shared_ptr<const GeometryBuffer>&,
+        const std::shared_ptr<const SceneData>&) override;
+
+private:
+    std::shared_ptr<graphics::IComputeProgram> m_program;
+};
+
 class ClusterGlobalLightPass : public RenderPass
 {
 public:
@@ -190,6 +296,23 @@ private:
     std::shared_ptr<graphics::IComputeProgram> m_program;
 };
 
+class ClearLightMasksPass : public RenderPass
+{
+public:
+    ClearLightMasksPass(const std::shared_ptr<ProgramsLoader>&, const std::shared_ptr<RenderPipeLine>&);
+    ~ClearLightMasksPass() override;
+
+    void run(
+        const std::shared_ptr<graphics::RendererBase>&,
+        const std::shared_ptr<graphics::IFrameBuffer>&,
+        const std::shared_ptr<graphics::IVertexArray>&,
+        const std::shared_ptr<const GeometryBuffer>&,
+        const std::shared_ptr<const SceneData>&) override;
+
+private:
+    std::shared_ptr<graphics::IComputeProgram> m_program;
+};
+
 class PrepareClusterLocalLightsCommandPass : public RenderPass
 {
 public:
@@ -207,6 +330,23 @@ private:
     std::shared_ptr<graphics::IComputeProgram> m_program;
 };
 
+class BinClusterLocalLightsPass : public RenderPass
+{
+public:
+    BinClusterLocalLightsPass(const std::shared_ptr<ProgramsLoader>&, const std::shared_ptr<RenderPipeLine>&);
+    ~BinClusterLocalLightsPass() override;
+
+    void run(
+        const std::shared_ptr<graphics::RendererBase>&,
+        const std::shared_ptr<graphics::IFrameBuffer>&,
+        const std::shared_ptr<graphics::IVertexArray>&,
+        const std::shared_ptr<const GeometryBuffer>&,
+        const std::shared_ptr<const SceneData>&) override;
+
+private:
+    std::shared_ptr<graphics::IComputeProgram> m_program;
+};
+
 class ClusterLocalLightPass : public RenderPass
 {
 public:
@@ -224,6 +364,40 @@ private:
     std::shared_ptr<graphics::IComputeProgram> m_program;
 };
 
+class ClusterLightIndicesOffsetsPass : public RenderPass
+{
+public:
+    ClusterLightIndicesOffsetsPass(const std::shared_ptr<ProgramsLoader>&, const std::shared_ptr<RenderPipeLine>&);
+    ~ClusterLightIndicesOffsetsPass() override;
+
+    void run(
+        const std::shared_ptr<graphics::RendererBase>&,
+        const std::shared_ptr<graphics::IFrameBuffer>&,
+        const std::shared_ptr<graphics::IVertexArray>&,
+        const std::shared_ptr<const GeometryBuffer>&,
+        const std::shared_ptr<const SceneData>&) override;
+
+private:
+    std::shared_ptr<graphics::IComputeProgram> m_program;
+};
+
+class FillClusterLightIndicesPass : public RenderPass
+{
+public:
+    FillClusterLightIndicesPass(const std::shared_ptr<ProgramsLoader>&, const std::shared_ptr<RenderPipeLine>&);
+    ~FillClusterLightIndicesPass() override;
+
+    void run(
+        const std::shared_ptr<graphics::RendererBase>&,
+        const std::shared_ptr<graphics::IFrameBuffer>&,
+        const std::shared_ptr<graphics::IVertexArray>&,
+        const std::shared_ptr<const GeometryBuffer>&,
+        const std::shared_ptr<const SceneData>&) override;
+
+private:
+    std::shared_ptr<graphics::IComputeProgram> m_program;
+};
+
 class PrepareShadowDataCullCommnadPass : public RenderPass
 {
 public:
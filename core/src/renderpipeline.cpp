@@ -1,5 +1,8 @@
+#include <cstring>
+
 #include "renderpipeline.h"
 
+#include <utils/glm/gtc/round.hpp>
 #include <utils/glm/gtx/component_wise.hpp>
 #include <utils/glm/gtx/functions.hpp>
 #include <utils/glm/gtx/texture.hpp>
@@ -7,6 +10,7 @@
 
 #include <core/graphicsrendererbase.h>
 #include <core/programsloader.h>
+#include <core/settings.h>
 
 #include "geometrybuffer.h"
 #include "renderpasshelpers.h"
@@ -18,16 +22,25 @@ namespace core
 {
 
 RenderPipeLine::RenderPipeLine(uint32_t shadowAtlasSize)
-    : m_shadowAtlasSize(shadowAtlasSize)
+    : m_isAutoInstancingEnabled(settings::Settings::instance().graphics().autoInstancing())
+    , m_isLightBinningEnabled(settings::Settings::instance().graphics().lightBinning())
+    , m_isOcclusionCullingEnabled(settings::Settings::instance().graphics().occlusionCulling())
+    , m_shadowAtlasSize(shadowAtlasSize)
 {
     m_renderInfoBuffer = RenderInfoBuffer::element_type::create();
     m_countersBuffer = CountersBuffer::element_type::create();
     m_cameraBuffer = CameraBuffer::element_type::create();
     m_clusterNodesBuffer = ClusterNodesBuffer::element_type::create();
     m_clusterLocalLightsBuffer = ClusterLocalLightsBuffer::element_type::create();
-    m_lightNodesBuffer = LightNodesBuffer::element_type::create();
+    m_lightIndicesBuffer = LightIndicesBuffer::element_type::create();
+    m_lightMasksBuffer = LightMasksBuffer::element_type::create();
     m_skeletalAnimatedDataToUpdateBuffer = SkeletalAnimatedDataToUpdateBuffer::element_type::create();
     m_shadowsToUpdateBuffer = ShadowsToUpdateBuffer::element_type::create();
+    m_meshletsCullDrawDataBuffer = MeshletsCullDrawDataBuffer::element_type::create();
+    m_drawablesInstancesBuffer = DrawablesInstancesBuffer::element_type::create();
+    m_instancedDrawDataBuffer = InstancedDrawDataBuffer::element_type::create();
+    m_drawDataInstancesBuffer = DrawDataInstancesBuffer::element_type::create();
+    m_drawDataVisibilityBuffer = DrawDataVisibilityBuffer::element_type::create();
     m_shadowDataBuffer = ShadowDataBuffer::element_type::create();
     m_shadowMapsBuffer = ShadowMapsBuffer::element_type::create(ShadowMapsDescription::makeEmpty());
     m_bonesTransformsDataCalculateCommandBuffer = graphics::DispatchComputeIndirectCommandBuffer::create();
@@ -39,10 +52,20 @@ RenderPipeLine::RenderPipeLine(uint32_t shadowAtlasSize)
     m_transparentDrawDataRenderParameterBuffer = graphics::PBufferRange::element_type::create(
         m_countersBuffer->buffer(), offsetof(CountersDescription, transparentDrawDataRenderCommandsCount),
         sizeof(CountersDescription::transparentDrawDataRenderCommandsCount));
+    m_opaqueDrawData16RenderCommandsBuffer = graphics::PDrawElementsIndirectCommandBuffer::element_type::create();
+    m_transparentDrawData16RenderCommandsBuffer = graphics::PDrawElementsIndirectCommandBuffer::element_type::create();
+    m_opaqueDrawData16RenderParameterBuffer = graphics::PBufferRange::element_type::create(
+        m_countersBuffer->buffer(), offsetof(CountersDescription, opaqueDrawData16RenderCommandsCount),
+        sizeof(CountersDescription::opaqueDrawData16RenderCommandsCount));
+    m_transparentDrawData16RenderParameterBuffer = graphics::PBufferRange::element_type::create(
+        m_countersBuffer->buffer(), offsetof(CountersDescription, transparentDrawData16RenderCommandsCount),
+        sizeof(CountersDescription::transparentDrawData16RenderCommandsCount));
+    m_meshletsCullCommandBuffer = graphics::DispatchComputeIndirectCommandBuffer::create();
     m_clusterLocalLightsCommandBuffer = graphics::DispatchComputeIndirectCommandBuffer::create();
     m_shadowDataCullCommandBuffer = graphics::DispatchComputeIndirectCommandBuffer::create();
     m_shadowMapBlurCommandsBuffer =
         graphics::PDrawArraysIndirectCommandsBuffer::element_type::create({graphics::DrawArraysIndirectCommand()});
+    m_depthPyramidBuffer = DepthPyramidBuffer::element_type::create();
     m_HDRBuffer = HighDynamicRangeBuffer::element_type::create();
     m_toneMappingBuffer = ToneMappingBuffer::element_type::create();
     m_opaqueShadowDataRenderCommandsBuffer = graphics::PDrawElementsIndirectCommandBuffer::element_type::create();
@@ -53,6 +76,14 @@ RenderPipeLine::RenderPipeLine(uint32_t shadowAtlasSize)
     m_transparentShadowDataRenderParameterBuffer = graphics::PBufferRange::element_type::create(
         m_countersBuffer->buffer(), offsetof(CountersDescription, transparentShadowDataRenderCommandsCount),
         sizeof(CountersDescription::transparentShadowDataRenderCommandsCount));
+    m_opaqueShadowData16RenderCommandsBuffer = graphics::PDrawElementsIndirectCommandBuffer::element_type::create();
+    m_transparentShadowData16RenderCommandsBuffer = graphics::PDrawElementsIndirectCommandBuffer::element_type::create();
+    m_opaqueShadowData16RenderParameterBuffer = graphics::PBufferRange::element_type::create(
+        m_countersBuffer->buffer(), offsetof(CountersDescription, opaqueShadowData16RenderCommandsCount),
+        sizeof(CountersDescription::opaqueShadowData16RenderCommandsCount));
+    m_transparentShadowData16RenderParameterBuffer = graphics::PBufferRange::element_type::create(
+        m_countersBuffer->buffer(), offsetof(CountersDescription, transparentShadowData16RenderCommandsCount),
+        sizeof(CountersDescription::transparentShadowData16RenderCommandsCount));
 }
 
 RenderPipeLine::~RenderPipeLine() = default;
@@ -82,16 +113,35 @@ void RenderPipeLine::initialize(const std::shared_ptr<ProgramsLoader>& programsL
     m_passes.clear();
     m_passes.push_back(std::make_shared<InitializePass>(programsLoader, sharedThis));
     m_passes.push_back(std::make_shared<BuildClusterPass>(programsLoader, sharedThis));
-    m_passes.push_back(std::make_shared<CullDrawDataPass>(programsLoader, sharedThis));
+    m_passes.push_back(std::make_shared<CullDrawDataPass>(
+        programsLoader, sharedThis,
+        m_isOcclusionCullingEnabled ? OcclusionCullingPhase::First : OcclusionCullingPhase::Disabled));
+    addDrawDataRenderCommandsPasses(programsLoader);
     m_passes.push_back(std::make_shared<CollectSkeletalAnimatedDataToUpdatePass>(programsLoader, sharedThis));
     m_passes.push_back(std::make_shared<PrepareBonesTransformsDataCalculateCommandPass>(programsLoader, sharedThis));
     m_passes.push_back(std::make_shared<CalculateBonesTransformsDataPass>(programsLoader, sharedThis));
-    m_passes.push_back(std::make_shared<SimplePass>(sharedThis, clear));
+    m_passes.push_back(std::make_shared<SimplePass>("ClearPass", sharedThis, clear));
     m_passes.push_back(std::make_shared<RenderDrawDataPass>(programsLoader, sharedThis));
-    m_passes.push_back(std::make_shared<SimplePass>(sharedThis, sort));
+    if (m_isOcclusionCullingEnabled)
+    {
+        // the draw data disoccluded since last frame and the transparent ones are drawn over the depth of the first phase
+        m_passes.push_back(std::make_shared<BuildDepthPyramidPass>(programsLoader, sharedThis));
+        m_passes.push_back(std::make_shared<ResetDrawDataRenderCommandsPass>(programsLoader, sharedThis));
+        m_passes.push_back(std::make_shared<CullDrawDataPass>(programsLoader, sharedThis, OcclusionCullingPhase::Second));
+        addDrawDataRenderCommandsPasses(programsLoader);
+        m_passes.push_back(std::make_shared<RenderDrawDataPass>(programsLoader, sharedThis));
+    }
+    m_passes.push_back(std::make_shared<SimplePass>("SortOITNodesPass", sharedThis, sort));
     m_passes.push_back(std::make_shared<ClusterGlobalLightPass>(programsLoader, sharedThis));
-    m_passes.push_back(std::make_shared<PrepareClusterLocalLightsCommandPass>(programsLoader, sharedThis));
+    if (m_isLightBinningEnabled)
+    {
+        m_passes.push_back(std::make_shared<ClearLightMasksPass>(programsLoader, sharedThis));
+        m_passes.push_back(std::make_shared<PrepareClusterLocalLightsCommandPass>(programsLoader, sharedThis));
+        m_passes.push_back(std::make_shared<BinClusterLocalLightsPass>(programsLoader, sharedThis));
+    }
     m_passes.push_back(std::make_shared<ClusterLocalLightPass>(programsLoader, sharedThis));
+    m_passes.push_back(std::make_shared<ClusterLightIndicesOffsetsPass>(programsLoader, sharedThis));
+    m_passes.push_back(std::make_shared<FillClusterLightIndicesPass>(programsLoader, sharedThis));
     m_passes.push_back(std::make_shared<PrepareShadowDataCullCommnadPass>(programsLoader, sharedThis));
     m_passes.push_back(std::make_shared<PrepareShadowMapBlurCommandsPass>(programsLoader, sharedThis));
     m_passes.push_back(std::make_shared<CullShadowDataPass>(programsLoader, sharedThis));
@@ -126,9 +176,48 @@ void RenderPipeLine::run(
     m_viewportSize = viewportSize;
     m_clusterSize = clusterSize;
 
+    // the counters of the last finished frame, the capacities are kept until new ones are ready
+    const auto isCountersUpdated = readCounters();
+
     const auto drawDataCount = sceneData->drawDataCount();
-    m_opaqueDrawDataRenderCommandsBuffer->resize(drawDataCount);
-    m_transparentDrawDataRenderCommandsBuffer->resize(drawDataCount);
+    m_meshletsCullDrawDataBuffer->resize(drawDataCount);
+    m_drawDataInstancesBuffer->resize(drawDataCount);
+
+    // the flags of the new draw data are undefined for a frame, the second phase draws what the first one misses
+    if (m_isOcclusionCullingEnabled) m_drawDataVisibilityBuffer->resize(drawDataCount);
+
+    if (m_isAutoInstancingEnabled)
+    {
+        m_instancedDrawDataBuffer->resize(drawDataCount);
+
+        // the instances counts are reset on GPU after every use, so they only need to be zeroed when the buffer is reallocated
+        if (const auto drawablesCount = sceneData->drawablesCount(); drawablesCount != m_drawablesInstancesBuffer->size())
+        {
+            const std::vector<DrawableInstancesDescription> drawablesInstances(
+                drawablesCount, DrawableInstancesDescription::makeEmpty());
+            m_drawablesInstancesBuffer->resize(drawablesCount);
+            m_drawablesInstancesBuffer->set(0u, drawablesInstances.data(), drawablesInstances.size());
+        }
+    }
+
+    // the commands of the visible meshlets of all the draw data are sized by the last finished frame, the draw data whose
+    // meshlets don't fit are drawn whole by CullMeshletsPass, so every draw data needs only its own command
+    static const size_t s_minDrawDataRenderCommandsCapacity = 1024u;
+    const auto neededDrawDataRenderCommandsCount = static_cast<size_t>(std::max({
+        m_lastCounters.opaqueDrawDataRenderCommandsCount,
+        m_lastCounters.transparentDrawDataRenderCommandsCount,
+        m_lastCounters.opaqueDrawData16RenderCommandsCount,
+        m_lastCounters.transparentDrawData16RenderCommandsCount,
+        m_lastCounters.firstPhaseDrawDataRenderCommandsCount}));
+    if (!m_drawDataRenderCommandsCapacity || (neededDrawDataRenderCommandsCount > m_drawDataRenderCommandsCapacity) ||
+        (isCountersUpdated && (neededDrawDataRenderCommandsCount < m_drawDataRenderCommandsCapacity / 4u)))
+        m_drawDataRenderCommandsCapacity = std::max(
+            neededDrawDataRenderCommandsCount + neededDrawDataRenderCommandsCount / 2u, s_minDrawDataRenderCommandsCapacity);
+    const auto drawDataRenderCommandsCount = std::max(m_drawDataRenderCommandsCapacity, drawDataCount);
+    m_opaqueDrawDataRenderCommandsBuffer->resize(drawDataRenderCommandsCount);
+    m_transparentDrawDataRenderCommandsBuffer->resize(drawDataRenderCommandsCount);
+    m_opaqueDrawData16RenderCommandsBuffer->resize(drawDataRenderCommandsCount);
+    m_transparentDrawData16RenderCommandsBuffer->resize(drawDataRenderCommandsCount);
 
     const auto skeletalAnimatedDataCount = sceneData->skeletalAnimatedDataCount();
     m_skeletalAnimatedDataToUpdateBuffer->resize(skeletalAnimatedDataCount);
@@ -142,13 +231,41 @@ void RenderPipeLine::run(
     const auto lightsCount = sceneData->lightsCount();
     m_clusterLocalLightsBuffer->resize(lightsCount);
 
-    const auto lightNodesCount = clusterNodesCount * lightsCount;
-    m_lightNodesBuffer->resize(lightNodesCount);
+    // the bit masks of the local lights for every screen tile and then for every depth slice of the clusters
+    if (m_isLightBinningEnabled)
+    {
+        const auto lightMaskWordsCount = (lightsCount + 31u) / 32u;
+        m_lightMasksBuffer->resize((m_clusterSize.x * m_clusterSize.y + m_clusterSize.z) * lightMaskWordsCount);
+    }
 
-    const auto shadowDataCount = drawDataCount * shadowsCount;
+    // the light indices pool is sized by the intersections of the last finished frame scaled by the change of the lights count,
+    // it grows at once and shrinks only by new counters, the overflowing indices are clamped by the pass for a few frames
+    static const size_t s_minLightIndicesCapacity = 4096u;
+    static const size_t s_maxLightIndicesCapacity =
+        static_cast<size_t>(settings::Settings::instance().graphics().camera().maxClusterLightIndicesCount());
+    const auto neededLightIndicesCount = static_cast<size_t>(m_lastCounters.lightIndicesCount) *
+        glm::max(lightsCount, m_lastCountersLightsCount) / glm::max(m_lastCountersLightsCount, size_t(1u));
+    if (!m_lightIndicesCapacity || (neededLightIndicesCount > m_lightIndicesCapacity) ||
+        (isCountersUpdated && (neededLightIndicesCount < m_lightIndicesCapacity / 4u)))
+        m_lightIndicesCapacity = std::max(neededLightIndicesCount + neededLightIndicesCount / 2u, s_minLightIndicesCapacity);
+    const auto lightIndicesCount = std::max(
+        std::min(std::min(m_lightIndicesCapacity, s_maxLightIndicesCapacity), (clusterNodesCount + 1u) * lightsCount),
+        lightsCount);
+    m_lightIndicesBuffer->resize(lightIndicesCount);
+
+    // the shadow data is sized by the visible pairs of the previous frame, the pairs over the capacity are dropped for a frame
+    static const size_t s_minShadowDataCapacity = 1024u;
+    const auto maxShadowDataCount = drawDataCount * shadowsCount;
+    const auto neededShadowDataCount = static_cast<size_t>(m_lastCounters.shadowDataCount);
+    if (!m_shadowDataCapacity || (isCountersUpdated &&
+        ((neededShadowDataCount > m_shadowDataCapacity) || (neededShadowDataCount < m_shadowDataCapacity / 4u))))
+        m_shadowDataCapacity = std::max(neededShadowDataCount + neededShadowDataCount / 2u, s_minShadowDataCapacity);
+    const auto shadowDataCount = std::min(m_shadowDataCapacity, maxShadowDataCount);
     m_shadowDataBuffer->resize(shadowDataCount);
     m_opaqueShadowDataRenderCommandsBuffer->resize(shadowDataCount);
     m_transparentShadowDataRenderCommandsBuffer->resize(shadowDataCount);
+    m_opaqueShadowData16RenderCommandsBuffer->resize(shadowDataCount);
+    m_transparentShadowData16RenderCommandsBuffer->resize(shadowDataCount);
 
     m_renderInfoBuffer->set(RenderInfoDescription::make(
         m_viewportSize, static_cast<uint32_t>(time), dt, dielectricSpecular, globalBoundingBox,
@@ -159,6 +276,8 @@ void RenderPipeLine::run(
     resizeShadowTextures(graphicsRenderer, sceneData->shadowMapsLayersCount());
     updateShadowMapsBuffer();
 
+    if (m_isOcclusionCullingEnabled) resizeDepthPyramidTexture(graphicsRenderer);
+
     resizeHDRTexture(graphicsRenderer);
     updateHDRBuffer();
 
@@ -166,10 +285,14 @@ void RenderPipeLine::run(
 
     resizeFinalTexture(graphicsRenderer);
 
-    vertexArray->attachIndexBuffer(sceneData->elementDataBuffer()->buffer());
+    m_renderPassesProfiler.beginFrame(graphicsRenderer, m_passes.size());
+    for (size_t i = 0u; i < m_passes.size(); ++i)
+    {
+        m_passes[i]->run(graphicsRenderer, frameBuffer, vertexArray, geometryBuffer, sceneData);
+        m_renderPassesProfiler.endRenderPass(i);
+    }
 
-    for (auto& pass : m_passes)
-        pass->run(graphicsRenderer, frameBuffer, vertexArray, geometryBuffer, sceneData);
+    recordCounters(graphicsRenderer, lightsCount);
 }
 
 const glm::uvec2& RenderPipeLine::viewportSize() const
@@ -192,6 +315,34 @@ ShadowFilter RenderPipeLine::shadowFilter() const
     return m_shadowFilter;
 }
 
+bool RenderPipeLine::isAutoInstancingEnabled() const
+{
+    return m_isAutoInstancingEnabled;
+}
+
+void RenderPipeLine::setAutoInstancingEnabled(bool value)
+{
+    if (m_isAutoInstancingEnabled != value)
+    {
+        m_isAutoInstancingEnabled = value;
+        deinitialize(); // need to recreate passes 'cause the instancing passes and the culling shader depend on the flag
+    }
+}
+
+bool RenderPipeLine::isLightBinningEnabled() const
+{
+    return m_isLightBinningEnabled;
+}
+
+void RenderPipeLine::setLightBinningEnabled(bool value)
+{
+    if (m_isLightBinningEnabled != value)
+    {
+        m_isLightBinningEnabled = value;
+        deinitialize(); // need to recreate passes 'cause the binning passes and the cluster shaders depend on the flag
+    }
+}
+
 void RenderPipeLine::setShadowFilter(ShadowFilter value)
 {
     if (m_shadowFilter != value)
@@ -364,6 +515,11 @@ CountersBuffer& RenderPipeLine::countersBuffer()
     return m_countersBuffer;
 }
 
+const CountersDescription& RenderPipeLine::lastCounters() const
+{
+    return m_lastCounters;
+}
+
 CameraBuffer& RenderPipeLine::cameraBuffer()
 {
     return m_cameraBuffer;
@@ -379,9 +535,14 @@ ClusterLocalLightsBuffer& RenderPipeLine::clusterLocalLightsBuffer()
     return m_clusterLocalLightsBuffer;
 }
 
-LightNodesBuffer& RenderPipeLine::lightNodesBuffer()
+LightIndicesBuffer& RenderPipeLine::lightIndicesBuffer()
+{
+    return m_lightIndicesBuffer;
+}
+
+LightMasksBuffer& RenderPipeLine::lightMasksBuffer()
 {
-    return m_lightNodesBuffer;
+    return m_lightMasksBuffer;
 }
 
 SkeletalAnimatedDataToUpdateBuffer& RenderPipeLine::skeletalAnimatedDataToUpdateBuffer()
@@ -394,6 +555,31 @@ ShadowsToUpdateBuffer& RenderPipeLine::shadowsToUpdateBuffer()
     return m_shadowsToUpdateBuffer;
 }
 
+MeshletsCullDrawDataBuffer& RenderPipeLine::meshletsCullDrawDataBuffer()
+{
+    return m_meshletsCullDrawDataBuffer;
+}
+
+DrawablesInstancesBuffer& RenderPipeLine::drawablesInstancesBuffer()
+{
+    return m_drawablesInstancesBuffer;
+}
+
+InstancedDrawDataBuffer& RenderPipeLine::instancedDrawDataBuffer()
+{
+    return m_instancedDrawDataBuffer;
+}
+
+DrawDataInstancesBuffer& RenderPipeLine::drawDataInstancesBuffer()
+{
+    return m_drawDataInstancesBuffer;
+}
+
+DrawDataVisibilityBuffer& RenderPipeLine::drawDataVisibilityBuffer()
+{
+    return m_drawDataVisibilityBuffer;
+}
+
 ShadowDataBuffer& RenderPipeLine::shadowDataBuffer()
 {
     return m_shadowDataBuffer;
@@ -404,6 +590,11 @@ ShadowMapsBuffer& RenderPipeLine::shadowMapsBuffer()
     return m_shadowMapsBuffer;
 }
 
+DepthPyramidBuffer& RenderPipeLine::depthPyramidBuffer()
+{
+    return m_depthPyramidBuffer;
+}
+
 HighDynamicRangeBuffer& RenderPipeLine::highDynamicRangeBuffer()
 {
     return m_HDRBuffer;
@@ -439,6 +630,31 @@ graphics::PBufferRange& RenderPipeLine::transparentDrawDataRenderParameterBuffer
     return m_transparentDrawDataRenderParameterBuffer;
 }
 
+graphics::PDrawElementsIndirectCommandBuffer& RenderPipeLine::opaqueDrawData16RenderCommandsBuffer()
+{
+    return m_opaqueDrawData16RenderCommandsBuffer;
+}
+
+graphics::PDrawElementsIndirectCommandBuffer& RenderPipeLine::transparentDrawData16RenderCommandsBuffer()
+{
+    return m_transparentDrawData16RenderCommandsBuffer;
+}
+
+graphics::PBufferRange& RenderPipeLine::opaqueDrawData16RenderParameterBuffer()
+{
+    return m_opaqueDrawData16RenderParameterBuffer;
+}
+
+graphics::PBufferRange& RenderPipeLine::transparentDrawData16RenderParameterBuffer()
+{
+    return m_transparentDrawData16RenderParameterBuffer;
+}
+
+graphics::PDispatchComputeIndirectCommandBuffer& RenderPipeLine::meshletsCullCommandBuffer()
+{
+    return m_meshletsCullCommandBuffer;
+}
+
 graphics::PDispatchComputeIndirectCommandBuffer& RenderPipeLine::clusterLocalLightsCommandBuffer()
 {
     return m_clusterLocalLightsCommandBuffer;
@@ -469,6 +685,26 @@ graphics::PBufferRange& RenderPipeLine::transparentShadowDataRenderParameterBuff
     return m_transparentShadowDataRenderParameterBuffer;
 }
 
+graphics::PDrawElementsIndirectCommandBuffer& RenderPipeLine::opaqueShadowData16RenderCommandsBuffer()
+{
+    return m_opaqueShadowData16RenderCommandsBuffer;
+}
+
+graphics::PDrawElementsIndirectCommandBuffer& RenderPipeLine::transparentShadowData16RenderCommandsBuffer()
+{
+    return m_transparentShadowData16RenderCommandsBuffer;
+}
+
+graphics::PBufferRange& RenderPipeLine::opaqueShadowData16RenderParameterBuffer()
+{
+    return m_opaqueShadowData16RenderParameterBuffer;
+}
+
+graphics::PBufferRange& RenderPipeLine::transparentShadowData16RenderParameterBuffer()
+{
+    return m_transparentShadowData16RenderParameterBuffer;
+}
+
 graphics::PConstTexture RenderPipeLine::shadowDepthTexture() const
 {
     return m_shadowDepthTextureHandle ? m_shadowDepthTextureHandle->texture() : nullptr;
@@ -494,6 +730,11 @@ graphics::PConstTexture RenderPipeLine::shadowColorBluredTexture() const
     return m_shadowColorBluredTextureHandle ? m_shadowColorBluredTextureHandle->texture() : nullptr;
 }
 
+graphics::PConstTexture RenderPipeLine::depthPyramidTexture() const
+{
+    return m_depthPyramidTexture;
+}
+
 graphics::PConstTexture RenderPipeLine::highDynamicRangeTexture() const
 {
     return m_HDRTextureHandle ? m_HDRTextureHandle->texture() : nullptr;
@@ -504,6 +745,21 @@ graphics::PConstTexture RenderPipeLine::finalTexture() const
     return m_finalTexture;
 }
 
+std::vector<debug::RenderPassInformation> RenderPipeLine::renderPassesInformation() const
+{
+    const auto& renderPassesTimes = m_renderPassesProfiler.renderPassesTimes();
+    const auto& averageRenderPassesTimes = m_renderPassesProfiler.averageRenderPassesTimes();
+
+    std::vector<debug::RenderPassInformation> result;
+    if (renderPassesTimes.size() != m_passes.size()) return result;
+
+    result.reserve(m_passes.size());
+    for (size_t i = 0u; i < m_passes.size(); ++i)
+        result.push_back({m_passes[i]->name(), renderPassesTimes[i], averageRenderPassesTimes[i]});
+
+    return result;
+}
+
 glm::vec4 RenderPipeLine::shadowMomentsTextureClearColor() const
 {
     glm::vec4 result(0.f);
@@ -545,6 +801,39 @@ graphics::PDrawArraysIndirectCommandsBuffer& RenderPipeLine::shadowMapBlurComman
     return m_shadowMapBlurCommandsBuffer;
 }
 
+bool RenderPipeLine::readCounters()
+{
+    bool result = false;
+
+    // from the oldest readback to the newest one, so the last finished frame wins
+    for (size_t i = 1u; i <= CountersReadbacksCount; ++i)
+    {
+        auto& countersReadback = m_countersReadbacks[(m_countersReadbackIndex + i) % CountersReadbacksCount];
+        if (countersReadback.isPending && countersReadback.readback->isAvailable())
+        {
+            std::memcpy(&m_lastCounters, countersReadback.readback->data(), sizeof(CountersDescription));
+            m_lastCountersLightsCount = countersReadback.lightsCount;
+            countersReadback.isPending = false;
+            result = true;
+        }
+    }
+
+    return result;
+}
+
+void RenderPipeLine::recordCounters(const std::shared_ptr<graphics::RendererBase>& graphicsRenderer, size_t lightsCount)
+{
+    m_countersReadbackIndex = (m_countersReadbackIndex + 1u) % CountersReadbacksCount;
+
+    // the oldest readback is overwritten if it's still not finished, its counters are dropped
+    auto& countersReadback = m_countersReadbacks[m_countersReadbackIndex];
+    if (!countersReadback.readback)
+        countersReadback.readback = graphicsRenderer->createBufferReadback(sizeof(CountersDescription));
+    countersReadback.readback->record(m_countersBuffer->buffer(), 0u);
+    countersReadback.lightsCount = lightsCount;
+    countersReadback.isPending = true;
+}
+
 void RenderPipeLine::deinitialize()
 {
     m_isInitialized = false;
@@ -553,6 +842,19 @@ void RenderPipeLine::deinitialize()
     dirtyToneMappingBuffer();
 }
 
+void RenderPipeLine::addDrawDataRenderCommandsPasses(const std::shared_ptr<ProgramsLoader>& programsLoader)
+{
+    auto sharedThis = shared_from_this();
+
+    if (m_isAutoInstancingEnabled)
+    {
+        m_passes.push_back(std::make_shared<GenerateInstancedDrawDataCommandsPass>(programsLoader, sharedThis));
+        m_passes.push_back(std::make_shared<FillDrawDataInstancesPass>(programsLoader, sharedThis));
+    }
+    m_passes.push_back(std::make_shared<PrepareMeshletsCullCommandPass>(programsLoader, sharedThis));
+    m_passes.push_back(std::make_shared<CullMeshletsPass>(programsLoader, sharedThis));
+}
+
 void RenderPipeLine::dirtyShadowMapsBuffer()
 {
     m_isShadowMapsBufferDirty = true;
@@ -694,6 +996,33 @@ void RenderPipeLine::updateShadowMapsBuffer()
     m_isShadowMapsBufferDirty = false;
 }
 
+void RenderPipeLine::resizeDepthPyramidTexture(const std::shared_ptr<graphics::RendererBase>& renderer)
+{
+    // the power of 2 size halves exactly down the levels, so the texels of the levels cover the same screen rects
+    const auto newSize = glm::floorPowerOfTwo(glm::max(m_viewportSize, glm::uvec2(1u)));
+    const auto oldSize = m_depthPyramidTexture ? m_depthPyramidTexture->size() : glm::uvec2(0u);
+
+    if (newSize == oldSize) return;
+
+    const auto levelsCount = glm::min(glm::levels(newSize), static_cast<uint32_t>(DepthPyramidDescription::MaxLevelsCount));
+    m_depthPyramidTexture =
+        renderer->createTexture2DEmpty(newSize.x, newSize.y, graphics::PixelInternalFormat::R32F, levelsCount);
+
+    m_depthPyramidLevelsImageHandles.clear();
+    std::vector<graphics::ImageHandle> levelsImageHandles;
+    for (uint32_t level = 0u; level < levelsCount; ++level)
+    {
+        auto image = graphics::Image::create(graphics::Image::DataAccess::ReadWrite, m_depthPyramidTexture, level);
+        auto imageHandle = renderer->createImageHandle(image);
+        imageHandle->makeResident();
+
+        levelsImageHandles.push_back(imageHandle->handle());
+        m_depthPyramidLevelsImageHandles.push_back(imageHandle);
+    }
+
+    m_depthPyramidBuffer->set(DepthPyramidDescription::make(levelsImageHandles, newSize));
+}
+
 void RenderPipeLine::resizeHDRTexture(const std::shared_ptr<graphics::RendererBase>& renderer)
 {
     const auto newSize = glm::max(m_viewportSize, glm::uvec2(1u));
@@ -1,15 +1,18 @@
 #ifndef CORE_RENDERPIPELINE_H
 #define CORE_RENDERPIPELINE_H
 
+#include <array>
 #include <memory>
 #include <vector>
 
 #include <utils/range.h>
 
+#include <core/debuginformation.h>
 #include <core/forwarddecl.h>
 #include <core/shadowssettings.h>
 
 #include "descriptions.h"
+#include "renderpassesprofiler.h"
 
 namespace simplex
 {
@@ -26,11 +29,18 @@ using CountersBuffer = std::shared_ptr<graphics::StructBuffer<CountersDescriptio
 using CameraBuffer = std::shared_ptr<graphics::StructBuffer<CameraDescription>>;
 using ClusterNodesBuffer = std::shared_ptr<graphics::VectorBuffer<ClusterNodeDescription>>;
 using ClusterLocalLightsBuffer = std::shared_ptr<graphics::VectorBuffer<ClusterLocalLightDescription>>;
-using LightNodesBuffer = std::shared_ptr<graphics::VectorBuffer<LightNodeDescription>>;
+using LightIndicesBuffer = std::shared_ptr<graphics::VectorBuffer<uint32_t>>;
+using LightMasksBuffer = std::shared_ptr<graphics::VectorBuffer<uint32_t>>;
 using SkeletalAnimatedDataToUpdateBuffer = std::shared_ptr<graphics::VectorBuffer<SkeletalAnimatedDataToUpdateDescription>>;
 using ShadowsToUpdateBuffer = std::shared_ptr<graphics::VectorBuffer<ShadowToUpdateDescription>>;
+using MeshletsCullDrawDataBuffer = std::shared_ptr<graphics::VectorBuffer<MeshletsCullDrawDataDescription>>;
+using DrawablesInstancesBuffer = std::shared_ptr<graphics::VectorBuffer<DrawableInstancesDescription>>;
+using InstancedDrawDataBuffer = std::shared_ptr<graphics::VectorBuffer<InstancedDrawDataDescription>>;
+using DrawDataInstancesBuffer = std::shared_ptr<graphics::VectorBuffer<uint32_t>>;
+using DrawDataVisibilityBuffer = std::shared_ptr<graphics::VectorBuffer<uint32_t>>;
 using ShadowDataBuffer = std::shared_ptr<graphics::VectorBuffer<ShadowDataDescription>>;
 using ShadowMapsBuffer = std::shared_ptr<graphics::StructBuffer<ShadowMapsDescription>>;
+using DepthPyramidBuffer = std::shared_ptr<graphics::StructBuffer<DepthPyramidDescription>>;
 using HighDynamicRangeBuffer = std::shared_ptr<graphics::StructBuffer<HDRDescription>>;
 using ToneMappingBuffer = std::shared_ptr<graphics::StructBuffer<ToneMappingDescription>>;
 
@@ -65,6 +75,12 @@ public:
     uint32_t shadowAtlasSize() const;
     ShadowFilter shadowFilter() const;
 
+    bool isAutoInstancingEnabled() const;
+    void setAutoInstancingEnabled(bool);
+
+    bool isLightBinningEnabled() const;
+    void setLightBinningEnabled(bool);
+
     void setShadowFilter(ShadowFilter);
     void setShadowBlurSigma(float);
     void setShadowLightBleedingAmount(float);
@@ -88,14 +104,22 @@ public:
 
     RenderInfoBuffer& renderInfoBuffer();
     CountersBuffer& countersBuffer();
+    const CountersDescription& lastCounters() const;
     CameraBuffer& cameraBuffer();
     ClusterNodesBuffer& clusterNodesBuffer();
     ClusterLocalLightsBuffer& clusterLocalLightsBuffer();
-    LightNodesBuffer& lightNodesBuffer();
+    LightIndicesBuffer& lightIndicesBuffer();
+    LightMasksBuffer& lightMasksBuffer();
     SkeletalAnimatedDataToUpdateBuffer& skeletalAnimatedDataToUpdateBuffer();
     ShadowsToUpdateBuffer& shadowsToUpdateBuffer();
+    MeshletsCullDrawDataBuffer& meshletsCullDrawDataBuffer();
+    DrawablesInstancesBuffer& drawablesInstancesBuffer();
+    InstancedDrawDataBuffer& instancedDrawDataBuffer();
+    DrawDataInstancesBuffer& drawDataInstancesBuffer();
+    DrawDataVisibilityBuffer& drawDataVisibilityBuffer();
     ShadowDataBuffer& shadowDataBuffer();
     ShadowMapsBuffer& shadowMapsBuffer();
+    DepthPyramidBuffer& depthPyramidBuffer();
     HighDynamicRangeBuffer& highDynamicRangeBuffer();
     ToneMappingBuffer& toneMappingBuffer();
     graphics::PDispatchComputeIndirectCommandBuffer& bonesTransformsDataCalculateCommandBuffer();
@@ -103,6 +127,11 @@ public:
     graphics::PDrawElementsIndirectCommandBuffer& transparentDrawDataRenderCommandsBuffer();
     graphics::PBufferRange& opaqueDrawDataRenderParameterBuffer();
     graphics::PBufferRange& transparentDrawDataRenderParameterBuffer();
+    graphics::PDrawElementsIndirectCommandBuffer& opaqueDrawData16RenderCommandsBuffer();
+    graphics::PDrawElementsIndirectCommandBuffer& transparentDrawData16RenderCommandsBuffer();
+    graphics::PBufferRange& opaqueDrawData16RenderParameterBuffer();
+    graphics::PBufferRange& transparentDrawData16RenderParameterBuffer();
+    graphics::PDispatchComputeIndirectCommandBuffer& meshletsCullCommandBuffer();
     graphics::PDispatchComputeIndirectCommandBuffer& clusterLocalLightsCommandBuffer();
     graphics::PDispatchComputeIndirectCommandBuffer& shadowDataCullCommandBuffer();
     graphics::PDrawArraysIndirectCommandsBuffer& shadowMapBlurCommandsBuffer();
@@ -110,19 +139,27 @@ public:
     graphics::PDrawElementsIndirectCommandBuffer& transparentShadowDataRenderCommandsBuffer();
     graphics::PBufferRange& opaqueShadowDataRenderParameterBuffer();
     graphics::PBufferRange& transparentShadowDataRenderParameterBuffer();
+    graphics::PDrawElementsIndirectCommandBuffer& opaqueShadowData16RenderCommandsBuffer();
+    graphics::PDrawElementsIndirectCommandBuffer& transparentShadowData16RenderCommandsBuffer();
+    graphics::PBufferRange& opaqueShadowData16RenderParameterBuffer();
+    graphics::PBufferRange& transparentShadowData16RenderParameterBuffer();
 
     graphics::PConstTexture shadowDepthTexture() const;
     graphics::PConstTexture shadowMomentsTexture() const;
     graphics::PConstTexture shadowColorTexture() const;
     graphics::PConstTexture shadowMomentsBluredTexture() const;
     graphics::PConstTexture shadowColorBluredTexture() const;
+    graphics::PConstTexture depthPyramidTexture() const;
     graphics::PConstTexture highDynamicRangeTexture() const;
     graphics::PConstTexture finalTexture() const;
 
     glm::vec4 shadowMomentsTextureClearColor() const;
 
+    std::vector<debug::RenderPassInformation> renderPassesInformation() const;
+
 private:
     void deinitialize();
+    void addDrawDataRenderCommandsPasses(const std::shared_ptr<ProgramsLoader>&);
     void dirtyShadowMapsBuffer();
     void dirtyHDRBuffer();
     void dirtyToneMappingBuffer();
@@ -134,6 +171,8 @@ private:
     void resizeShadowTextures(const std::shared_ptr<graphics::RendererBase>&, uint32_t);
     void updateShadowMapsBuffer();
 
+    void resizeDepthPyramidTexture(const std::shared_ptr<graphics::RendererBase>&);
+
     void resizeHDRTexture(const std::shared_ptr<graphics::RendererBase>&);
     void updateHDRBuffer();
 
@@ -141,15 +180,39 @@ private:
 
     void resizeFinalTexture(const std::shared_ptr<graphics::RendererBase>&);
 
+    bool readCounters();
+    void recordCounters(const std::shared_ptr<graphics::RendererBase>&, size_t lightsCount);
+
+    // counters are read back a few frames later, so the GPU is never waited for
+    static constexpr size_t CountersReadbacksCount = 3u;
+
+    struct CountersReadback
+    {
+        std::shared_ptr<graphics::IBufferReadback> readback;
+        size_t lightsCount = 0u; // the lights count of the frame, the light indices are scaled by its change
+        bool isPending = false;
+    };
+
     bool m_isInitialized = false;
     bool m_isShadowMapsBufferDirty = true;
     bool m_isHDRBufferDirty = true;
     bool m_isBloomBufferDirty = true;
     bool m_isToneMappingBufferDirty = true;
+    bool m_isAutoInstancingEnabled = false;
+    bool m_isLightBinningEnabled = false;
+    bool m_isOcclusionCullingEnabled = false;
 
     glm::uvec2 m_viewportSize = glm::uvec2(0u);
     glm::uvec3 m_clusterSize = glm::uvec3(0u);
 
+    std::array<CountersReadback, CountersReadbacksCount> m_countersReadbacks;
+    size_t m_countersReadbackIndex = 0u;
+    CountersDescription m_lastCounters{};
+    size_t m_lastCountersLightsCount = 0u;
+    size_t m_drawDataRenderCommandsCapacity = 0u;
+    size_t m_shadowDataCapacity = 0u;
+    size_t m_lightIndicesCapacity = 0u;
+
     uint32_t m_shadowAtlasSize = 0u;
     ShadowFilter m_shadowFilter = ShadowFilter::Discrete;
     float m_shadowBlurSigma = 1.f;
@@ -177,11 +240,18 @@ private:
     CameraBuffer m_cameraBuffer;
     ClusterNodesBuffer m_clusterNodesBuffer;
     ClusterLocalLightsBuffer m_clusterLocalLightsBuffer;
-    LightNodesBuffer m_lightNodesBuffer;
+    LightIndicesBuffer m_lightIndicesBuffer;
+    LightMasksBuffer m_lightMasksBuffer;
     SkeletalAnimatedDataToUpdateBuffer m_skeletalAnimatedDataToUpdateBuffer;
     ShadowsToUpdateBuffer m_shadowsToUpdateBuffer;
+    MeshletsCullDrawDataBuffer m_meshletsCullDrawDataBuffer;
+    DrawablesInstancesBuffer m_drawablesInstancesBuffer;
+    InstancedDrawDataBuffer m_instancedDrawDataBuffer;
+    DrawDataInstancesBuffer m_drawDataInstancesBuffer;
+    DrawDataVisibilityBuffer m_drawDataVisibilityBuffer;
     ShadowDataBuffer m_shadowDataBuffer;
     ShadowMapsBuffer m_shadowMapsBuffer;
+    DepthPyramidBuffer m_depthPyramidBuffer;
     HighDynamicRangeBuffer m_HDRBuffer;
     ToneMappingBuffer m_toneMappingBuffer;
     graphics::PDispatchComputeIndirectCommandBuffer m_bonesTransformsDataCalculateCommandBuffer;
@@ -189,6 +259,11 @@ private:
     graphics::PDrawElementsIndirectCommandBuffer m_transparentDrawDataRenderCommandsBuffer;
     graphics::PBufferRange m_opaqueDrawDataRenderParameterBuffer;
     graphics::PBufferRange m_transparentDrawDataRenderParameterBuffer;
+    graphics::PDrawElementsIndirectCommandBuffer m_opaqueDrawData16RenderCommandsBuffer;
+    graphics::PDrawElementsIndirectCommandBuffer m_transparentDrawData16RenderCommandsBuffer;
+    graphics::PBufferRange m_opaqueDrawData16RenderParameterBuffer;
+    graphics::PBufferRange m_transparentDrawData16RenderParameterBuffer;
+    graphics::PDispatchComputeIndirectCommandBuffer m_meshletsCullCommandBuffer;
     graphics::PDispatchComputeIndirectCommandBuffer m_clusterLocalLightsCommandBuffer;
     graphics::PDispatchComputeIndirectCommandBuffer m_shadowDataCullCommandBuffer;
     graphics::PDrawArraysIndirectCommandsBuffer m_shadowMapBlurCommandsBuffer;
@@ -196,16 +271,23 @@ private:
     graphics::PDrawElementsIndirectCommandBuffer m_transparentShadowDataRenderCommandsBuffer;
     graphics::PBufferRange m_opaqueShadowDataRenderParameterBuffer;
     graphics::PBufferRange m_transparentShadowDataRenderParameterBuffer;
+    graphics::PDrawElementsIndirectCommandBuffer m_opaqueShadowData16RenderCommandsBuffer;
+    graphics::PDrawElementsIndirectCommandBuffer m_transparentShadowData16RenderCommandsBuffer;
+    graphics::PBufferRange m_opaqueShadowData16RenderParameterBuffer;
+    graphics::PBufferRange m_transparentShadowData16RenderParameterBuffer;
 
     graphics::PTextureHandle m_shadowDepthTextureHandle;
     graphics::PTextureHandle m_shadowMomentsTextureHandle;
     graphics::PTextureHandle m_shadowColorTextureHandle;
     graphics::PTextureHandle m_shadowMomentsBluredTextureHandle;
     graphics::PTextureHandle m_shadowColorBluredTextureHandle;
+    graphics::PTexture m_depthPyramidTexture;
+    std::vector<graphics::PImageHandle> m_depthPyramidLevelsImageHandles;
     graphics::PTextureHandle m_HDRTextureHandle;
     graphics::PTexture m_finalTexture;
 
     std::vector<std::shared_ptr<RenderPass>> m_passes;
+    RenderPassesProfiler m_renderPassesProfiler;
 };
 
 } // namespace core
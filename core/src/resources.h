@@ -17,6 +17,13 @@ static const std::filesystem::path DefaultIBLSpecularMapPath = "./resources/text
 
 static const std::filesystem::path InitializePassComputeShaderPath = "./resources/shaders/initialize_pass.comp";
 static const std::filesystem::path CullDrawDataPassComputeShaderPath = "./resources/shaders/cull_draw_data_pass.comp";
+static const std::filesystem::path PrepareMeshletsCullCommandPassComputeShaderPath =
+    "./resources/shaders/prepare_meshlets_cull_command_pass.comp";
+static const std::filesystem::path CullMeshletsPassComputeShaderPath = "./resources/shaders/cull_meshlets_pass.comp";
+static const std::filesystem::path GenerateInstancedDrawDataCommandsPassComputeShaderPath =
+    "./resources/shaders/generate_instanced_draw_data_commands_pass.comp";
+static const std::filesystem::path FillDrawDataInstancesPassComputeShaderPath =
+    "./resources/shaders/fill_draw_data_instances_pass.comp";
 static const std::filesystem::path CollectSkeletalAnimatedDataToUpdatePassComputeShaderPath =
     "./resources/shaders/collect_skeletal_animated_data_to_update_pass.comp";
 static const std::filesystem::path UpdateCameraPassComputeShaderPath = "./resources/shaders/update_camera_pass.comp";
@@ -32,11 +39,20 @@ static const std::filesystem::path RenderOpaqueDrawDataPassFragmentShaderPath =
     "./resources/shaders/render_opaque_draw_data_pass.frag";
 static const std::filesystem::path RenderTransparentDrawDataPassFragmentShaderPath =
     "./resources/shaders/render_transparent_draw_data_pass.frag";
+static const std::filesystem::path BuildDepthPyramidPassComputeShaderPath =
+    "./resources/shaders/build_depth_pyramid_pass.comp";
+static const std::filesystem::path ResetDrawDataRenderCommandsPassComputeShaderPath =
+    "./resources/shaders/reset_draw_data_render_commands_pass.comp";
 static const std::filesystem::path SortOITNodesPassComputeShaderPath = "./resources/shaders/sort_oit_nodes_pass.comp";
 static const std::filesystem::path ClusterGlobalLightPassComputeShaderPath = "./resources/shaders/cluster_global_light_pass.comp";
 static const std::filesystem::path PrepareClusterLocalLightCommandPassComputeShaderPath =
     "./resources/shaders/prepare_cluster_local_light_command_pass.comp";
+static const std::filesystem::path ClearLightMasksPassComputeShaderPath = "./resources/shaders/clear_light_masks_pass.comp";
+static const std::filesystem::path BinClusterLocalLightsPassComputeShaderPath =
+    "./resources/shaders/bin_cluster_local_lights_pass.comp";
 static const std::filesystem::path ClusterLocalLightPassComputeShaderPath = "./resources/shaders/cluster_local_light_pass.comp";
+static const std::filesystem::path ClusterLightIndicesOffsetsPassComputeShaderPath =
+    "./resources/shaders/cluster_light_indices_offsets_pass.comp";
 static const std::filesystem::path PrepareShadowDataCullCommandPassComputeShaderPath =
     "./resources/shaders/prepare_shadow_data_cull_command_pass.comp";
 static const std::filesystem::path PrepareShadowMapBlurCommandsComputeShaderPath =
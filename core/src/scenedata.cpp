@@ -1,5 +1,10 @@
+#include <numeric>
+#include <thread>
+
 #include "scenedata.h"
 
+#include <utils/hash.h>
+
 #include <core/background.h>
 #include <core/drawable.h>
 #include <core/graphicsengine.h>
@@ -26,6 +31,53 @@ namespace simplex
 namespace core
 {
 
+// splits [0, count) into the ranges processed by the separate threads, small counts are processed in the calling thread
+static void parallelFor(size_t count, const std::function<void(size_t, size_t)>& func)
+{
+    static constexpr size_t s_minCountPerThread = 16384u;
+
+    const auto maxNumThreads = static_cast<size_t>(glm::max(std::thread::hardware_concurrency(), 1u));
+    const auto numThreads = glm::clamp(count / s_minCountPerThread, size_t(1u), maxNumThreads);
+    if (numThreads == 1u)
+    {
+        if (count) func(0u, count);
+        return;
+    }
+
+    const auto countPerThread = (count + numThreads - 1u) / numThreads;
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1u);
+    for (size_t first = countPerThread; first < count; first += countPerThread)
+        threads.emplace_back(func, first, glm::min(countPerThread, count - first));
+
+    func(0u, countPerThread);
+
+    for (auto& thread : threads)
+        thread.join();
+}
+
+// the word-wise multiplicative hash, it's independent of FNV-1a of the geometry keys
+static uint64_t geometryCheckHash(uint64_t hash, const void* data, size_t size)
+{
+    auto mix = [](uint64_t state, uint64_t value)
+    {
+        state ^= value * 0x9e3779b97f4a7c15ull;
+        state = (state << 31u) | (state >> 33u);
+        return state * 0xc2b2ae3d27d4eb4full;
+    };
+
+    const auto bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0u; i < size; i += sizeof(uint64_t))
+    {
+        uint64_t word = 0u;
+        std::memcpy(&word, bytes + i, glm::min(sizeof(uint64_t), size - i));
+        hash = mix(hash, word);
+    }
+
+    return mix(hash, static_cast<uint64_t>(size));
+}
+
 ResourceHandler::ResourceHandler(const std::weak_ptr<SceneData>& sceneData)
     : m_sceneData(sceneData)
 {
@@ -108,6 +160,16 @@ uint32_t MeshHandler::elementDataSize() const
     return m_elementDataSize;
 }
 
+uint64_t MeshHandler::geometryKey() const
+{
+    return m_geometryKey;
+}
+
+void MeshHandler::updateGeometryKey(uint64_t value)
+{
+    m_geometryKey = value;
+}
+
 void MeshHandler::updateOffsetsAndSizes(
     uint32_t positionNormalTexCoordsDataOffset,
     uint32_t positionNormalTexCoordsDataSize,
@@ -415,16 +477,26 @@ void SkeletalAnimatedDataHandler::updateOffsetAndSize(uint32_t bonesTransformsDa
 
 SceneData::SceneData(uint32_t shadowAtlasSize)
     : m_shadowAtlasSize(shadowAtlasSize)
+    , m_isVertexFormatCompact(settings::Settings::instance().graphics().compactVertexFormat())
+    , m_meshLODsCount(glm::clamp(settings::Settings::instance().graphics().meshLODsCount(), 1u, MeshDescription::MaxLODsCount))
+    , m_meshletMaxTrianglesCount(
+          settings::Settings::instance().graphics().meshletCulling()
+              ? settings::Settings::instance().graphics().meshletMaxTrianglesCount()
+              : 0u)
 {
     m_positionNormalTexCoordsDataBuffer = PositionNormalTexCoordsDataBuffer::element_type::create();
     m_tangentDataBuffer = TangentDataBuffer::element_type::create();
+    m_compactPositionNormalTexCoordsDataBuffer = CompactPositionNormalTexCoordsDataBuffer::element_type::create();
+    m_compactTangentDataBuffer = CompactTangentDataBuffer::element_type::create();
     m_boneDataBuffer = BoneDataBuffer::element_type::create();
     m_elementDataBuffer = ElementDataBuffer::element_type::create();
+    m_element16DataBuffer = Element16DataBuffer::element_type::create();
+    m_meshletsDataBuffer = MeshletsDataBuffer::element_type::create();
     m_skeletonsDataBuffer = SkeletonsDataBuffer::element_type::create();
     m_bonesTransformsDataBuffer = BonesTransformsDataBuffer::element_type::create();
     m_shadowTransformsDataBuffer = ShadowTransformsDataBuffer::element_type::create();
 
-    m_meshesBuffer = MeshesBuffer::element_type::create();
+    m_meshesBuffer = MeshesBuffer::element_type::create({}, true); // the compaction patches the offsets of the descriptions
     m_mapsBuffer = MapsBuffer::element_type::create();
     m_materialsBuffer = MaterialsBuffer::element_type::create();
     m_drawablesBuffer = DrawablesBuffer::element_type::create();
@@ -434,14 +506,21 @@ SceneData::SceneData(uint32_t shadowAtlasSize)
     m_skeletonsBuffer = SkeletonsBuffer::element_type::create();
 
     m_drawDataBuffer = DrawDataBuffer::element_type::create();
+    m_liveDrawDataBuffer = LiveDrawDataBuffer::element_type::create();
     m_skeletalAnimatedDataBuffer = SkeletalAnimatedDataBuffer::element_type::create();
 
     getOrCreateShaderStorageBlock(ShaderStorageBlockID::PositionNormalTexCoordsDataBuffer) =
         graphics::BufferRange::create(m_positionNormalTexCoordsDataBuffer->buffer());
     getOrCreateShaderStorageBlock(ShaderStorageBlockID::TangentDataBuffer) =
         graphics::BufferRange::create(m_tangentDataBuffer->buffer());
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::CompactPositionNormalTexCoordsDataBuffer) =
+        graphics::BufferRange::create(m_compactPositionNormalTexCoordsDataBuffer->buffer());
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::CompactTangentDataBuffer) =
+        graphics::BufferRange::create(m_compactTangentDataBuffer->buffer());
     getOrCreateShaderStorageBlock(ShaderStorageBlockID::BoneDataBuffer) =
         graphics::BufferRange::create(m_boneDataBuffer->buffer());
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::MeshletsDataBuffer) =
+        graphics::BufferRange::create(m_meshletsDataBuffer->buffer());
     getOrCreateShaderStorageBlock(ShaderStorageBlockID::SkeletonsDataBuffer) =
         graphics::BufferRange::create(m_skeletonsDataBuffer->buffer());
     getOrCreateShaderStorageBlock(ShaderStorageBlockID::BonesTransformsDataBuffer) =
@@ -464,13 +543,15 @@ SceneData::SceneData(uint32_t shadowAtlasSize)
 
     getOrCreateShaderStorageBlock(ShaderStorageBlockID::DrawDataBuffer) =
         graphics::BufferRange::create(m_drawDataBuffer->buffer());
+    getOrCreateShaderStorageBlock(ShaderStorageBlockID::LiveDrawDataBuffer) =
+        graphics::BufferRange::create(m_liveDrawDataBuffer->buffer());
     getOrCreateShaderStorageBlock(ShaderStorageBlockID::SkeletalAnimatedDataBuffer) =
         graphics::BufferRange::create(m_skeletalAnimatedDataBuffer->buffer());
 }
 
 SceneData::~SceneData() = default;
 
-SceneData::AddVerticesDataResult SceneData::addVerticesData(
+SceneData::VerticesData SceneData::makeVerticesData(
     const std::unordered_map<utils::VertexAttribute, std::shared_ptr<utils::VertexBuffer>>& verticesBuffers)
 {
     const size_t verticesCount = verticesBuffers.empty() ? 0u : verticesBuffers.begin()->second->numVertices();
@@ -487,152 +568,154 @@ SceneData::AddVerticesDataResult SceneData::addVerticesData(
     std::vector<TangentDataDescription> tangentData;
     std::vector<BoneDataDescription> boneData;
 
-    const bool hasPositions = verticesBuffers.count(utils::VertexAttribute::Position);
-    const bool hasNormals = verticesBuffers.count(utils::VertexAttribute::Normal);
-    const bool hasTexCoords = verticesBuffers.count(utils::VertexAttribute::TexCoords);
-    if (hasPositions || hasNormals || hasTexCoords)
+    auto findBuffer = [&verticesBuffers](utils::VertexAttribute attrib) -> const utils::VertexBuffer*
     {
-        positionNormalTexCoordsData.resize(verticesCount);
-        auto* data = reinterpret_cast<uint8_t*>(positionNormalTexCoordsData.data());
-
-        using Description = decltype(positionNormalTexCoordsData)::value_type;
-
-        if (auto it = verticesBuffers.find(utils::VertexAttribute::Position); it != verticesBuffers.end())
-        {
-            std::shared_ptr<utils::VertexBuffer> buffer = it->second;
-
-            using AttributeType = decltype(Description::position);
-            static constexpr auto AttributeOffset = offsetof(Description, position);
+        auto it = verticesBuffers.find(attrib);
+        return (it != verticesBuffers.end()) ? it->second.get() : nullptr;
+    };
 
-            static constexpr auto TargetComponentsCount = AttributeType::length();
-            static constexpr auto TargetComponentType = utils::toVertexComponentType<AttributeType::value_type>();
+    const auto* positionBuffer = findBuffer(utils::VertexAttribute::Position);
+    const auto* normalBuffer = findBuffer(utils::VertexAttribute::Normal);
+    const auto* texCoordsBuffer = findBuffer(utils::VertexAttribute::TexCoords);
 
-            if ((buffer->numComponents() != TargetComponentsCount) || (buffer->componentType() != TargetComponentType))
-                buffer = buffer->converted(TargetComponentsCount, TargetComponentType);
+    auto* tangentBuffer = normalBuffer ? findBuffer(utils::VertexAttribute::Tangent) : nullptr;
+    if (tangentBuffer && (tangentBuffer->numComponents() != static_cast<uint32_t>(TangentDataDescription::length())))
+    {
+        LOG_ERROR << "Only 4-components tangent is suitable";
+        tangentBuffer = nullptr;
+    }
 
-            for (size_t i = 0u; i < verticesCount; ++i)
-                std::memcpy(data + i * sizeof(Description) + AttributeOffset, buffer->vertex(i), sizeof(AttributeType));
-        }
+    const auto* boneIDsBuffer = findBuffer(utils::VertexAttribute::BonesIDs);
+    const auto* boneWeightsBuffer = findBuffer(utils::VertexAttribute::BonesWeights);
+    if (boneIDsBuffer && boneWeightsBuffer && (boneIDsBuffer->numComponents() != boneWeightsBuffer->numComponents()))
+    {
+        LOG_ERROR << "Bones IDs and weights buffers have different number of components";
+        boneIDsBuffer = nullptr;
+    }
 
-        if (auto it = verticesBuffers.find(utils::VertexAttribute::Normal); it != verticesBuffers.end())
+    const bool hasPositions = positionBuffer;
+    const bool hasNormals = normalBuffer;
+    const bool hasTexCoords = texCoordsBuffer;
+    const uint32_t bonesCount =
+        (boneIDsBuffer && boneWeightsBuffer) ? glm::min(MeshDescription::MaxBonesCount, boneIDsBuffer->numComponents()) : 0u;
+
+    if (hasPositions || hasNormals || hasTexCoords) positionNormalTexCoordsData.resize(verticesCount);
+    if (tangentBuffer) tangentData.resize(verticesCount);
+    if (bonesCount) boneData.resize(verticesCount * bonesCount);
+
+    // every attribute is converted while it is written into its place in the interleaved data, so the vertices are
+    // passed once without the intermediate converted buffers
+    parallelFor(
+        verticesCount,
+        [&](size_t first, size_t count)
         {
-            std::shared_ptr<utils::VertexBuffer> buffer = it->second;
-
-            using AttributeType = decltype(Description::normal);
-            static constexpr auto AttributeOffset = offsetof(Description, normal);
+            using Description = PositionNormalTexCoordsDataDescription;
+            auto* data = reinterpret_cast<uint8_t*>(positionNormalTexCoordsData.data() + first);
 
-            static constexpr auto TargetComponentsCount = AttributeType::length();
-            static constexpr auto TargetComponentType = utils::toVertexComponentType<AttributeType::value_type>();
+            static constexpr auto s_type = utils::VertexComponentType::Single;
 
-            if ((buffer->numComponents() != TargetComponentsCount) || (buffer->componentType() != TargetComponentType))
-                buffer = buffer->converted(TargetComponentsCount, TargetComponentType);
+            if (positionBuffer)
+                positionBuffer->gather(first, count, decltype(Description::position)::length(), s_type,
+                                       data + offsetof(Description, position), sizeof(Description));
 
-            for (size_t i = 0u; i < verticesCount; ++i)
-                std::memcpy(data + i * sizeof(Description) + AttributeOffset, buffer->vertex(i), sizeof(AttributeType));
-        }
-
-        if (auto it = verticesBuffers.find(utils::VertexAttribute::TexCoords); it != verticesBuffers.end())
-        {
-            std::shared_ptr<utils::VertexBuffer> buffer = it->second;
+            if (normalBuffer)
+                normalBuffer->gather(first, count, decltype(Description::normal)::length(), s_type,
+                                     data + offsetof(Description, normal), sizeof(Description));
 
-            using AttributeType = decltype(Description::texCoords);
-            static constexpr auto AttributeOffset = offsetof(Description, texCoords);
+            if (texCoordsBuffer)
+                texCoordsBuffer->gather(first, count, decltype(Description::texCoords)::length(), s_type,
+                                        data + offsetof(Description, texCoords), sizeof(Description));
 
-            static constexpr auto TargetComponentsCount = AttributeType::length();
-            static constexpr auto TargetComponentType = utils::toVertexComponentType<AttributeType::value_type>();
+            if (tangentBuffer)
+                tangentBuffer->gather(first, count, TangentDataDescription::length(), s_type,
+                                      reinterpret_cast<uint8_t*>(tangentData.data() + first), sizeof(TangentDataDescription));
 
-            if ((buffer->numComponents() != TargetComponentsCount) || (buffer->componentType() != TargetComponentType))
-                buffer = buffer->converted(TargetComponentsCount, TargetComponentType);
+            if (bonesCount)
+            {
+                std::vector<uint32_t> IDs(count * bonesCount);
+                boneIDsBuffer->gather(first, count, bonesCount, utils::VertexComponentType::Uint32,
+                                      reinterpret_cast<uint8_t*>(IDs.data()), bonesCount * sizeof(uint32_t));
 
-            for (size_t i = 0u; i < verticesCount; ++i)
-                std::memcpy(data + i * sizeof(Description) + AttributeOffset, buffer->vertex(i), sizeof(AttributeType));
-        }
-    }
+                std::vector<float> weights(count * bonesCount);
+                boneWeightsBuffer->gather(first, count, bonesCount, utils::VertexComponentType::Single,
+                                          reinterpret_cast<uint8_t*>(weights.data()), bonesCount * sizeof(float));
 
-    if (auto it = verticesBuffers.find(utils::VertexAttribute::Tangent); (it != verticesBuffers.end()) && hasNormals)
-    {
-        using Description = TangentDataDescription;
-        static constexpr auto TargetComponentsCount = Description::length();
-        static constexpr auto TargetComponentType = utils::toVertexComponentType<Description::value_type>();
+                auto* bones = boneData.data() + first * bonesCount;
+                for (size_t i = 0u; i < count * bonesCount; ++i)
+                    bones[i] = {IDs[i], weights[i]};
+            }
+        });
 
-        std::shared_ptr<utils::VertexBuffer> buffer = it->second;
-        if (buffer->numComponents() == TargetComponentsCount) // only 4-components tangent is suitable
-        {
-            if (buffer->componentType() != TargetComponentType)
-                buffer = buffer->converted(TargetComponentsCount, TargetComponentType);
+    return {
+        std::move(positionNormalTexCoordsData),
+        std::move(tangentData),
+        std::move(boneData),
+        {},
+        {},
+        hasPositions,
+        hasNormals,
+        hasTexCoords,
+        bonesCount};
+}
 
-            tangentData.resize(verticesCount);
-            std::memcpy(tangentData.data(), buffer->data(), verticesCount * sizeof(Description));
-        }
-        else
+void SceneData::compactVerticesData(VerticesData& verticesData, const utils::BoundingBox& bb)
+{
+    verticesData.compactPositionNormalTexCoordsData.resize(verticesData.positionNormalTexCoordsData.size());
+    parallelFor(
+        verticesData.positionNormalTexCoordsData.size(),
+        [&verticesData, &bb](size_t first, size_t count)
         {
-            LOG_ERROR << "Only 4-components tangent is suitable";
-        }
-    }
-
-    uint32_t bonesCount = 0u;
-    if (verticesBuffers.count(utils::VertexAttribute::BonesIDs) && verticesBuffers.count(utils::VertexAttribute::BonesWeights))
-    {
-        std::shared_ptr<utils::VertexBuffer> boneIDsBuffer = verticesBuffers.at(utils::VertexAttribute::BonesIDs);
-        std::shared_ptr<utils::VertexBuffer> boneWeightsBuffer = verticesBuffers.at(utils::VertexAttribute::BonesWeights);
-
-        if (boneIDsBuffer->numComponents() == boneWeightsBuffer->numComponents())
+            for (size_t i = first; i < first + count; ++i)
+                verticesData.compactPositionNormalTexCoordsData[i] =
+                    CompactPositionNormalTexCoordsDataDescription::make(verticesData.positionNormalTexCoordsData[i], bb);
+        });
+
+    verticesData.compactTangentData.resize(verticesData.tangentData.size());
+    parallelFor(
+        verticesData.tangentData.size(),
+        [&verticesData](size_t first, size_t count)
         {
-            bonesCount = glm::min(MeshDescription::MaxBonesCount, boneIDsBuffer->numComponents());
-
-            using Description = BoneDataDescription;
+            for (size_t i = first; i < first + count; ++i)
+                verticesData.compactTangentData[i] = CompactTangentDataDescription::make(verticesData.tangentData[i]);
+        });
 
-            using IDType = decltype(Description::ID);
-            static constexpr auto IDOffset = offsetof(Description, ID);
-
-            using WeightType = decltype(Description::weight);
-            static constexpr auto WeightOffset = offsetof(Description, weight);
-
-            static constexpr auto TargetIDType = utils::toVertexComponentType<IDType>();
-            static constexpr auto TargetWeightType = utils::toVertexComponentType<WeightType>();
-
-            if (boneIDsBuffer->componentType() != TargetIDType)
-                boneIDsBuffer = boneIDsBuffer->converted(bonesCount, TargetIDType);
-
-            if (boneWeightsBuffer->componentType() != TargetWeightType)
-                boneWeightsBuffer = boneWeightsBuffer->converted(bonesCount, TargetWeightType);
-
-            boneData.resize(verticesCount * bonesCount);
-            auto* data = reinterpret_cast<uint8_t*>(boneData.data());
+    verticesData.positionNormalTexCoordsData.clear();
+    verticesData.tangentData.clear();
+}
 
-            for (size_t i = 0u; i < verticesCount; ++i)
-            {
-                const auto* IDs = reinterpret_cast<const IDType*>(boneIDsBuffer->vertex(i));
-                const auto* weights = reinterpret_cast<const WeightType*>(boneWeightsBuffer->vertex(i));
-                for (uint32_t c = 0u; c < bonesCount; ++c)
-                {
-                    std::memcpy(data + i * sizeof(Description) + IDOffset, IDs + i, sizeof(IDType));
-                    std::memcpy(data + i * sizeof(Description) + WeightOffset, weights + i, sizeof(WeightType));
-                }
-            }
-        }
-        else
-        {
-            LOG_ERROR << "Bones IDs and weights buffers have different number of components";
-        }
+SceneData::AddVerticesDataResult SceneData::addVerticesData(const VerticesData& verticesData)
+{
+    size_t positionNormalTexCoordsDataOffset, positionNormalTexCoordsDataSize, tangentDataOffset, tangentDataSize;
+    if (m_isVertexFormatCompact)
+    {
+        positionNormalTexCoordsDataSize = verticesData.compactPositionNormalTexCoordsData.size();
+        positionNormalTexCoordsDataOffset = m_compactPositionNormalTexCoordsDataBuffer->allocate(
+            positionNormalTexCoordsDataSize, verticesData.compactPositionNormalTexCoordsData.data());
+        tangentDataSize = verticesData.compactTangentData.size();
+        tangentDataOffset = m_compactTangentDataBuffer->allocate(tangentDataSize, verticesData.compactTangentData.data());
     }
-
-    const auto positionNormalTexCoordsDataOffset =
-        m_positionNormalTexCoordsDataBuffer->allocate(positionNormalTexCoordsData.size(), positionNormalTexCoordsData.data());
-    const auto tangentDataOffset = m_tangentDataBuffer->allocate(tangentData.size(), tangentData.data());
-    const auto boneDataOffset = m_boneDataBuffer->allocate(boneData.size(), boneData.data());
+    else
+    {
+        positionNormalTexCoordsDataSize = verticesData.positionNormalTexCoordsData.size();
+        positionNormalTexCoordsDataOffset = m_positionNormalTexCoordsDataBuffer->allocate(
+            positionNormalTexCoordsDataSize, verticesData.positionNormalTexCoordsData.data());
+        tangentDataSize = verticesData.tangentData.size();
+        tangentDataOffset = m_tangentDataBuffer->allocate(tangentDataSize, verticesData.tangentData.data());
+    }
+    const auto boneDataOffset = m_boneDataBuffer->allocate(verticesData.boneData.size(), verticesData.boneData.data());
 
     return {
         static_cast<uint32_t>(positionNormalTexCoordsDataOffset),
-        static_cast<uint32_t>(positionNormalTexCoordsData.size()),
-        hasPositions,
-        hasNormals,
-        hasTexCoords,
+        static_cast<uint32_t>(positionNormalTexCoordsDataSize),
+        verticesData.hasPositions,
+        verticesData.hasNormals,
+        verticesData.hasTexCoords,
+        m_isVertexFormatCompact,
         static_cast<uint32_t>(tangentDataOffset),
-        static_cast<uint32_t>(tangentData.size()),
+        static_cast<uint32_t>(tangentDataSize),
         static_cast<uint32_t>(boneDataOffset),
-        static_cast<uint32_t>(boneData.size()),
-        bonesCount,
+        static_cast<uint32_t>(verticesData.boneData.size()),
+        verticesData.bonesCount,
     };
 }
 
@@ -645,16 +728,26 @@ void SceneData::removeVerticeshData(
     uint32_t boneDataSize)
 {
     if ((positionNormalTexCoordsDataOffset != utils::IDsGenerator::last()) || (positionNormalTexCoordsDataSize != 0u))
-        m_positionNormalTexCoordsDataBuffer->free(positionNormalTexCoordsDataOffset, positionNormalTexCoordsDataSize);
+    {
+        if (m_isVertexFormatCompact)
+            m_compactPositionNormalTexCoordsDataBuffer->free(positionNormalTexCoordsDataOffset, positionNormalTexCoordsDataSize);
+        else
+            m_positionNormalTexCoordsDataBuffer->free(positionNormalTexCoordsDataOffset, positionNormalTexCoordsDataSize);
+    }
 
     if ((tangentDataOffset != utils::IDsGenerator::last()) || (tangentDataSize != 0u))
-        m_tangentDataBuffer->free(tangentDataOffset, tangentDataSize);
+    {
+        if (m_isVertexFormatCompact)
+            m_compactTangentDataBuffer->free(tangentDataOffset, tangentDataSize);
+        else
+            m_tangentDataBuffer->free(tangentDataOffset, tangentDataSize);
+    }
 
     if ((boneDataOffset != utils::IDsGenerator::last()) || (boneDataSize != 0u))
         m_boneDataBuffer->free(boneDataOffset, boneDataSize);
 }
 
-SceneData::AddElementDataResult SceneData::addElementData(
+std::vector<ElementDataDescription> SceneData::makeElementData(
     const std::unordered_set<std::shared_ptr<utils::PrimitiveSet>>& primitiveSets)
 {
     static constexpr auto s_indexType = utils::toDrawElementsIndexType<ElementDataDescription>();
@@ -704,15 +797,119 @@ SceneData::AddElementDataResult SceneData::addElementData(
         elementData.insert(elementData.end(), data, data + drawElemetsBuffer->numIndices());
     }
 
-    const auto elementDataOffset = m_elementDataBuffer->allocate(elementDataSize, elementData.data());
-    return {static_cast<uint32_t>(elementDataOffset), static_cast<uint32_t>(elementDataSize)};
+    return elementData;
 }
 
-void SceneData::removeElementData(uint32_t elementDataOffset, uint32_t elementDataSize)
+SceneData::ElementDataLODs SceneData::makeElementDataLODs(
+    std::vector<ElementDataDescription>& elementData,
+    const utils::VertexBuffer& positions,
+    uint32_t LODsCount)
+{
+    static constexpr auto s_indexType = utils::toDrawElementsIndexType<ElementDataDescription>();
+
+    // the LOD which doesn't reduce the number of indices enough isn't worth the memory
+    static constexpr float s_maxLODIndicesRatio = .75f;
+
+    ElementDataLODs result;
+    if (elementData.empty()) return result;
+
+    auto LOD = std::make_shared<utils::DrawElementsBuffer>(utils::PrimitiveType::Triangles, elementData.size(), s_indexType, 0u);
+    std::memcpy(LOD->data(), elementData.data(), elementData.size() * sizeof(ElementDataDescription));
+
+    // every LOD is simplified from the previous one, so their errors are accumulated
+    float error = 0.f;
+    for (; result.count < glm::min(LODsCount, MeshDescription::MaxLODsCount); ++result.count)
+    {
+        float LODError = 0.f;
+        auto simplifiedLOD = LOD->simplified(positions, LOD->numIndices() / 2u, LODError);
+        if (!simplifiedLOD ||
+            (static_cast<float>(simplifiedLOD->numIndices()) > s_maxLODIndicesRatio * static_cast<float>(LOD->numIndices())))
+            break;
+
+        LOD = simplifiedLOD;
+        error += LODError;
+
+        const auto* data = reinterpret_cast<const ElementDataDescription*>(LOD->data());
+        elementData.insert(elementData.end(), data, data + LOD->numIndices());
+
+        result.sizes[result.count - 1u] = static_cast<uint32_t>(LOD->numIndices());
+        result.errors[result.count - 1u] = error;
+    }
+
+    return result;
+}
+
+SceneData::AddElementDataResult SceneData::addElementData(
+    const std::vector<ElementDataDescription>& elementData,
+    const ElementDataLODs& LODs)
+{
+    if (elementData.empty()) return {};
+
+    if (*std::max_element(elementData.begin(), elementData.end()) <= std::numeric_limits<Element16DataDescription>::max())
+    {
+        const std::vector<Element16DataDescription> element16Data(elementData.begin(), elementData.end());
+        const auto elementDataOffset = m_element16DataBuffer->allocate(element16Data.size(), element16Data.data());
+        return {static_cast<uint32_t>(elementDataOffset), static_cast<uint32_t>(element16Data.size()), true, LODs};
+    }
+
+    const auto elementDataOffset = m_elementDataBuffer->allocate(elementData.size(), elementData.data());
+    return {static_cast<uint32_t>(elementDataOffset), static_cast<uint32_t>(elementData.size()), false, LODs};
+}
+
+void SceneData::removeElementData(uint32_t elementDataOffset, uint32_t elementDataSize, bool is16Bit)
 {
     if ((elementDataOffset == utils::IDsGenerator::last()) || (!elementDataSize)) return;
 
-    m_elementDataBuffer->free(elementDataOffset, elementDataSize);
+    if (is16Bit)
+        m_element16DataBuffer->free(elementDataOffset, elementDataSize);
+    else
+        m_elementDataBuffer->free(elementDataOffset, elementDataSize);
+}
+
+std::vector<MeshletDescription> SceneData::makeMeshletsData(
+    std::vector<ElementDataDescription>& elementData,
+    const utils::VertexBuffer& positions,
+    uint32_t maxTrianglesCount)
+{
+    static constexpr auto s_indexType = utils::toDrawElementsIndexType<ElementDataDescription>();
+
+    // the mesh of a couple of meshlets is culled well enough by its bounding box
+    if (elementData.size() < 3u * 2u * maxTrianglesCount) return {};
+
+    auto buffer =
+        std::make_shared<utils::DrawElementsBuffer>(utils::PrimitiveType::Triangles, elementData.size(), s_indexType, 0u);
+    std::memcpy(buffer->data(), elementData.data(), elementData.size() * sizeof(ElementDataDescription));
+
+    const auto meshlets = buffer->buildMeshlets(positions, maxTrianglesCount);
+    if (meshlets.empty()) return {};
+
+    std::memcpy(elementData.data(), buffer->data(), elementData.size() * sizeof(ElementDataDescription));
+
+    std::vector<MeshletDescription> result;
+    result.reserve(meshlets.size());
+    for (const auto& meshlet : meshlets)
+        result.push_back({meshlet.boundingSphere,
+                          meshlet.cone,
+                          static_cast<uint32_t>(meshlet.firstIndex),
+                          static_cast<uint32_t>(meshlet.numIndices),
+                          {0u, 0u}});
+
+    return result;
+}
+
+SceneData::AddMeshletsDataResult SceneData::addMeshletsData(const std::vector<MeshletDescription>& meshletsData)
+{
+    if (meshletsData.empty()) return {};
+
+    const auto meshletsDataOffset = m_meshletsDataBuffer->allocate(meshletsData.size(), meshletsData.data());
+    return {static_cast<uint32_t>(meshletsDataOffset), static_cast<uint32_t>(meshletsData.size())};
+}
+
+void SceneData::removeMeshletsData(uint32_t meshletsDataOffset, uint32_t meshletsDataSize)
+{
+    if ((meshletsDataOffset == utils::IDsGenerator::last()) || (!meshletsDataSize)) return;
+
+    m_meshletsDataBuffer->free(meshletsDataOffset, meshletsDataSize);
 }
 
 SceneData::AddSkeletonDataResult SceneData::addSkeletonData(
@@ -1028,12 +1225,15 @@ std::shared_ptr<MeshHandler> SceneData::addMesh(const std::shared_ptr<const Mesh
         if (!result)
         {
             const auto meshID = m_meshIDsGenerator.generate();
-            m_meshesBuffer->resize(static_cast<size_t>(meshID) + 1u);
+            if (meshID >= m_meshesBuffer->size()) m_meshesBuffer->resize(static_cast<size_t>(meshID) + 1u);
             m_meshesBuffer->set(meshID, MeshDescription::makeEmpty());
 
             result = std::make_shared<MeshHandler>(weak_from_this(), mesh, meshID);
             onMeshChanged(*result, mesh->mesh(), mesh->boundingBox());
             meshPrivate.handlers().insert(result);
+
+            if (meshID >= m_meshHandlers.size()) m_meshHandlers.resize(static_cast<size_t>(meshID) + 1u);
+            m_meshHandlers[meshID] = result;
         }
     }
 
@@ -1049,6 +1249,7 @@ void SceneData::removeMesh(const std::shared_ptr<const Mesh>& mesh)
         if ((*it)->sceneData().lock() == shared_from_this())
         {
             onMeshChanged(*(*it), nullptr, utils::BoundingBox::empty());
+            m_meshHandlers[(*it)->ID()].reset();
             m_meshIDsGenerator.clear((*it)->ID());
             meshHandlers.erase(it);
             break;
@@ -1058,31 +1259,171 @@ void SceneData::removeMesh(const std::shared_ptr<const Mesh>& mesh)
 
 void SceneData::onMeshChanged(MeshHandler& handler, const std::shared_ptr<const utils::Mesh>& mesh, const utils::BoundingBox& bb)
 {
-    removeVerticeshData(
-        handler.positionNormalTexCoordsDataOffset(), handler.positionNormalTexCoordsDataSize(), handler.boneDataOffset(),
-        handler.boneDataSize(), handler.tangentDataOffset(), handler.tangentDataSize());
-    removeElementData(handler.elementDataOffset(), handler.elementDataSize());
+    // the new geometry is acquired first, so the unchanged geometry isn't freed and uploaded again
+    const auto geometryKey = mesh ? acquireGeometry(*mesh, bb) : s_emptyGeometryKey;
+    if (auto it = m_geometries.find(handler.geometryKey()); it != m_geometries.end()) it->second.meshIDs.erase(handler.ID());
+    releaseGeometry(handler.geometryKey());
 
     AddVerticesDataResult addVerticesDataResult;
     AddElementDataResult addElementDataResult;
+    AddMeshletsDataResult addMeshletsDataResult;
 
-    if (mesh)
+    if (auto it = m_geometries.find(geometryKey); it != m_geometries.end())
     {
-        addVerticesDataResult = addVerticesData(mesh->vertexBuffers());
-        addElementDataResult = addElementData(mesh->primitiveSets());
+        it->second.meshIDs.insert(handler.ID());
+        addVerticesDataResult = it->second.verticesData;
+        addElementDataResult = it->second.elementData;
+        addMeshletsDataResult = it->second.meshletsData;
     }
 
+    const auto& LODs = addElementDataResult.LODs;
+    const auto LOD0ElementDataSize = addElementDataResult.size - std::accumulate(LODs.sizes.begin(), LODs.sizes.end(), 0u);
+
     m_meshesBuffer->set(
         handler.ID(), MeshDescription::make(
                           bb, addVerticesDataResult.positionNormalTexCoordsDataOffset, addVerticesDataResult.hasPositions,
                           addVerticesDataResult.hasNormals, addVerticesDataResult.hasTexCoords,
-                          addVerticesDataResult.tangentDataOffset, addVerticesDataResult.boneDataOffset,
-                          addVerticesDataResult.bonesCount, addElementDataResult.offset, addElementDataResult.size));
+                          addVerticesDataResult.hasCompactVertices, addVerticesDataResult.tangentDataOffset,
+                          addVerticesDataResult.boneDataOffset, addVerticesDataResult.bonesCount, addElementDataResult.offset,
+                          LOD0ElementDataSize, addElementDataResult.is16Bit, LODs.count, LODs.sizes, LODs.errors,
+                          addMeshletsDataResult.offset, addMeshletsDataResult.size));
 
     handler.updateOffsetsAndSizes(
         addVerticesDataResult.positionNormalTexCoordsDataOffset, addVerticesDataResult.positionNormalTexCoordsDataSize,
-        addVerticesDataResult.boneDataOffset, addVerticesDataResult.boneDataSize, addVerticesDataResult.tangentDataOffset,
-        addVerticesDataResult.tangentDataSize, addElementDataResult.offset, addElementDataResult.size);
+        addVerticesDataResult.tangentDataOffset, addVerticesDataResult.tangentDataSize, addVerticesDataResult.boneDataOffset,
+        addVerticesDataResult.boneDataSize, addElementDataResult.offset, addElementDataResult.size);
+    handler.updateGeometryKey(geometryKey);
+}
+
+uint64_t SceneData::acquireGeometry(const utils::Mesh& mesh, const utils::BoundingBox& bb)
+{
+    auto verticesData = makeVerticesData(mesh.vertexBuffers());
+    auto elementData = makeElementData(mesh.primitiveSets());
+
+    // the compact positions are quantized in the bounding box, it's hashed below with them
+    if (m_isVertexFormatCompact) compactVerticesData(verticesData, bb);
+
+    if (verticesData.positionNormalTexCoordsData.empty() && verticesData.tangentData.empty() && verticesData.boneData.empty() &&
+        verticesData.compactPositionNormalTexCoordsData.empty() && verticesData.compactTangentData.empty() && elementData.empty())
+        return s_emptyGeometryKey;
+
+    // the streams are hashed by two independent functions instead of keeping their copy, the colliding meshes differ by
+    // the second hash or by the sizes of the streams, so they don't share the geometry
+    auto key = utils::hashSeed();
+    uint64_t keyCheckHash = 0u;
+    std::vector<uint64_t> keySizes;
+    auto appendData = [&key, &keyCheckHash, &keySizes](const void* data, size_t size)
+    {
+        key = utils::hashData(key, data, size);
+        keyCheckHash = geometryCheckHash(keyCheckHash, data, size);
+        keySizes.push_back(static_cast<uint64_t>(size));
+    };
+    auto appendVector = [&appendData](const auto& data) { appendData(data.data(), data.size() * sizeof(data.front())); };
+
+    const uint32_t flags = (verticesData.hasPositions ? 1u : 0u) | (verticesData.hasNormals ? 2u : 0u) |
+                           (verticesData.hasTexCoords ? 4u : 0u) | (verticesData.bonesCount << 3u);
+
+    appendData(&flags, sizeof(flags));
+    appendVector(verticesData.positionNormalTexCoordsData);
+    appendVector(verticesData.tangentData);
+    appendVector(verticesData.boneData);
+    appendVector(verticesData.compactPositionNormalTexCoordsData);
+    appendVector(verticesData.compactTangentData);
+    appendVector(elementData);
+    if (!verticesData.compactPositionNormalTexCoordsData.empty())
+    {
+        // the meshes decode the compact positions by their own boxes, so the same quantized data with other boxes isn't shared
+        const std::array<glm::vec3, 2u> decodeBox{bb.minPoint(), bb.maxPoint()};
+        appendData(decodeBox.data(), sizeof(decodeBox));
+    }
+
+    // the meshlets bounds and the LODs are made from the mesh space positions, so they are the part of the shared data
+    const auto& vertexBuffers = mesh.vertexBuffers();
+    auto positionsIter = vertexBuffers.find(utils::VertexAttribute::Position);
+    const bool isMeshletsDataNeeded = m_meshletMaxTrianglesCount && !verticesData.bonesCount;
+    if ((positionsIter != vertexBuffers.end()) && (isMeshletsDataNeeded || (m_meshLODsCount > 1u)))
+    {
+        const auto& positions = *positionsIter->second;
+        const uint32_t positionsFormat =
+            (positions.numComponents() << 16u) | utils::castFromVertexComponentType(positions.componentType());
+        appendData(&positionsFormat, sizeof(positionsFormat));
+        appendData(positions.data(), positions.sizeInBytes());
+    }
+
+    // the colliding geometries take the next free keys
+    for (auto it = m_geometries.find(key); (key == s_emptyGeometryKey) || (it != m_geometries.end());)
+    {
+        if ((it != m_geometries.end()) && (it->second.keyCheckHash == keyCheckHash) && (it->second.keySizes == keySizes)) break;
+        it = m_geometries.find(++key);
+    }
+
+    auto& geometry = m_geometries[key];
+    if (geometry.refsCount++)
+    {
+        m_numDeduplicatedGeometryBytes += geometryBytes(geometry);
+    }
+    else
+    {
+        // the meshlets and the LODs are made only for the new geometry, they are defined by the hashed positions and indices
+        std::vector<MeshletDescription> meshletsData;
+        ElementDataLODs LODs;
+        if (positionsIter != vertexBuffers.end())
+        {
+            // the bounds of the meshlets don't follow the skinned vertices
+            if (isMeshletsDataNeeded)
+                meshletsData = makeMeshletsData(elementData, *positionsIter->second, m_meshletMaxTrianglesCount);
+
+            if (m_meshLODsCount > 1u) LODs = makeElementDataLODs(elementData, *positionsIter->second, m_meshLODsCount);
+        }
+
+        geometry.verticesData = addVerticesData(verticesData);
+        geometry.elementData = addElementData(elementData, LODs);
+        geometry.meshletsData = addMeshletsData(meshletsData);
+        geometry.keySizes = std::move(keySizes);
+        geometry.keyCheckHash = keyCheckHash;
+        addGeometryRanges(key, geometry);
+    }
+
+    return key;
+}
+
+void SceneData::releaseGeometry(uint64_t key)
+{
+    auto it = m_geometries.find(key);
+    if (it == m_geometries.end()) return;
+
+    auto& geometry = it->second;
+    if (--geometry.refsCount)
+    {
+        m_numDeduplicatedGeometryBytes -= geometryBytes(geometry);
+        return;
+    }
+
+    const auto& verticesData = geometry.verticesData;
+    removeVerticeshData(
+        verticesData.positionNormalTexCoordsDataOffset, verticesData.positionNormalTexCoordsDataSize,
+        verticesData.tangentDataOffset, verticesData.tangentDataSize, verticesData.boneDataOffset, verticesData.boneDataSize);
+    removeElementData(geometry.elementData.offset, geometry.elementData.size, geometry.elementData.is16Bit);
+    removeMeshletsData(geometry.meshletsData.offset, geometry.meshletsData.size);
+
+    removeGeometryRanges(geometry);
+    m_geometries.erase(it);
+}
+
+size_t SceneData::geometryBytes(const Geometry& geometry) const
+{
+    const auto positionNormalTexCoordsDescriptionSize = m_isVertexFormatCompact
+                                                            ? sizeof(CompactPositionNormalTexCoordsDataDescription)
+                                                            : sizeof(PositionNormalTexCoordsDataDescription);
+    const auto tangentDescriptionSize = m_isVertexFormatCompact ? sizeof(CompactTangentDataDescription)
+                                                                 : sizeof(TangentDataDescription);
+
+    return geometry.verticesData.positionNormalTexCoordsDataSize * positionNormalTexCoordsDescriptionSize +
+           geometry.verticesData.tangentDataSize * tangentDescriptionSize +
+           geometry.verticesData.boneDataSize * sizeof(BoneDataDescription) +
+           geometry.elementData.size *
+               (geometry.elementData.is16Bit ? sizeof(Element16DataDescription) : sizeof(ElementDataDescription)) +
+           geometry.meshletsData.size * sizeof(MeshletDescription);
 }
 
 std::shared_ptr<MaterialMapHandler> SceneData::addMaterialMap(const std::shared_ptr<const MaterialMap>& materialMap)
@@ -1109,7 +1450,7 @@ std::shared_ptr<MaterialMapHandler> SceneData::addMaterialMap(const std::shared_
         if (!result)
         {
             const auto mapID = m_mapIDsGenerator.generate();
-            m_mapsBuffer->resize(static_cast<size_t>(mapID) + 1u);
+            if (mapID >= m_mapsBuffer->size()) m_mapsBuffer->resize(static_cast<size_t>(mapID) + 1u);
             m_mapsBuffer->set(mapID, MapDescription::makeEmpty());
             m_textureHandles.resize(static_cast<size_t>(mapID) + 1u);
             m_textureHandles[mapID] = nullptr;
@@ -1209,8 +1550,8 @@ std::shared_ptr<MaterialHandler> SceneData::addMaterial(const std::shared_ptr<co
         if (!result)
         {
             const auto materialID = m_materialIDsGenerator.generate();
-            m_materialsBuffer->resize(static_cast<size_t>(materialID) + 1u);
-            m_materialsBuffer->set(materialID, MaterialDescription::makeEmpty());
+            if (materialID >= m_materialsBuffer->size()) m_materialsBuffer->resize(static_cast<size_t>(materialID) + 1u);
+            m_materialsChanges.set(materialID, MaterialDescription::makeEmpty());
 
             result = std::make_shared<MaterialHandler>(weak_from_this(), material, materialID);
             onMaterialChanged(
@@ -1266,7 +1607,7 @@ void SceneData::onMaterialChanged(
     bool isShadowCasted,
     bool isDoubleSided)
 {
-    m_materialsBuffer->set(
+    m_materialsChanges.set(
         handler.ID(),
         MaterialDescription::make(
             baseColor, emission, addMaterialMap(baseColorMap)->ID(), addMaterialMap(opacityMap)->ID(),
@@ -1300,7 +1641,7 @@ std::shared_ptr<DrawableHandler> SceneData::addDrawable(const std::shared_ptr<co
         if (!result)
         {
             auto drawableID = m_drawableIDsGenerator.generate();
-            m_drawablesBuffer->resize(static_cast<size_t>(drawableID) + 1u);
+            if (drawableID >= m_drawablesBuffer->size()) m_drawablesBuffer->resize(static_cast<size_t>(drawableID) + 1u);
             m_drawablesBuffer->set(drawableID, DrawableDescription::makeEmpty());
 
             result = std::make_shared<DrawableHandler>(weak_from_this(), drawable, drawableID);
@@ -1400,8 +1741,8 @@ std::shared_ptr<ShadowHandler> SceneData::addShadow(const std::shared_ptr<const
         if (!result)
         {
             auto shadowID = m_shadowIDsGenerator.generate();
-            m_shadowsBuffer->resize(static_cast<size_t>(shadowID) + 1u);
-            m_shadowsBuffer->set(shadowID, ShadowDescription::makeEmpty());
+            if (shadowID >= m_shadowsBuffer->size()) m_shadowsBuffer->resize(static_cast<size_t>(shadowID) + 1u);
+            m_shadowsChanges.set(shadowID, ShadowDescription::makeEmpty());
 
             const auto& shadowedLightNode = shadow->shadowedLightNode();
 
@@ -1449,7 +1790,7 @@ void SceneData::onShadowChanged(
 
     auto addShadowTransformsDataResult = addShadowTransformsData(layers);
 
-    m_shadowsBuffer->set(
+    m_shadowsChanges.set(
         handler.ID(),
         ShadowDescription::make(mapSize, cullPlaneLimits, layersCount, addShadowTransformsDataResult.shadowTransformsDataOffset));
 
@@ -1609,7 +1950,7 @@ std::shared_ptr<SkeletonHandler> SceneData::addSkeleton(const std::shared_ptr<co
         if (!result)
         {
             const auto skeletonID = m_skeletonIDsGenerator.generate();
-            m_skeletonsBuffer->resize(static_cast<size_t>(skeletonID) + 1u);
+            if (skeletonID >= m_skeletonsBuffer->size()) m_skeletonsBuffer->resize(static_cast<size_t>(skeletonID) + 1u);
             m_skeletonsBuffer->set(skeletonID, SkeletonDescription::makeEmpty());
 
             result = std::make_shared<SkeletonHandler>(weak_from_this(), skeleton, skeletonID);
@@ -1665,8 +2006,14 @@ std::shared_ptr<DrawDataHandler> SceneData::addDrawData(
     else
     {
         const auto drawDataID = m_drawDataIDsGenerator.generate();
-        m_drawDataBuffer->resize(static_cast<size_t>(drawDataID) + 1u);
-        m_drawDataBuffer->set(drawDataID, DrawDataDescription::makeEmpty());
+        if (drawDataID >= m_drawDataBuffer->size()) m_drawDataBuffer->resize(static_cast<size_t>(drawDataID) + 1u);
+        m_drawDataChanges.set(drawDataID, DrawDataDescription::makeEmpty());
+
+        if (drawDataID >= m_liveDrawDataIndices.size()) m_liveDrawDataIndices.resize(static_cast<size_t>(drawDataID) + 1u);
+        m_liveDrawDataIndices[drawDataID] = static_cast<uint32_t>(m_liveDrawDataIDs.size());
+        m_liveDrawDataChanges.set(m_liveDrawDataIDs.size(), drawDataID);
+        m_liveDrawDataIDs.push_back(drawDataID);
+        m_liveDrawDataBuffer->resize(m_liveDrawDataIDs.size());
 
         result = std::make_shared<DrawDataHandler>(weak_from_this(), drawDataID);
         onDrawDataChanged(*result, drawable, transform, skeletalAnimatedDataID);
@@ -1678,6 +2025,16 @@ std::shared_ptr<DrawDataHandler> SceneData::addDrawData(
 void SceneData::removeDrawData(DrawDataHandler& handler)
 {
     onDrawDataChanged(handler, nullptr, utils::Transform::makeIdentity(), utils::IDsGenerator::last());
+
+    // swap-remove, so the live draw data stay packed
+    const auto liveIndex = m_liveDrawDataIndices[handler.ID()];
+    const auto lastLiveDrawDataID = m_liveDrawDataIDs.back();
+    m_liveDrawDataIDs[liveIndex] = lastLiveDrawDataID;
+    m_liveDrawDataIndices[lastLiveDrawDataID] = liveIndex;
+    m_liveDrawDataChanges.set(liveIndex, lastLiveDrawDataID);
+    m_liveDrawDataIDs.pop_back();
+    m_liveDrawDataBuffer->resize(m_liveDrawDataIDs.size());
+
     m_drawDataIDsGenerator.clear(handler.ID());
 }
 
@@ -1687,7 +2044,7 @@ void SceneData::onDrawDataChanged(
     const utils::Transform& transform,
     utils::IDsGenerator::value_type skeletalAnimatedDataID)
 {
-    m_drawDataBuffer->set(
+    m_drawDataChanges.set(
         handler.ID(), DrawDataDescription::make(transform, addDrawable(drawable)->ID(), skeletalAnimatedDataID));
 }
 
@@ -1704,7 +2061,8 @@ std::shared_ptr<SkeletalAnimatedDataHandler> SceneData::addSkeletalAnimatedData(
     else
     {
         const auto skeletalAnimatedDataID = m_skeletalAnimatedDataIDsGenerator.generate();
-        m_skeletalAnimatedDataBuffer->resize(static_cast<size_t>(skeletalAnimatedDataID) + 1u);
+        if (skeletalAnimatedDataID >= m_skeletalAnimatedDataBuffer->size())
+            m_skeletalAnimatedDataBuffer->resize(static_cast<size_t>(skeletalAnimatedDataID) + 1u);
         m_skeletalAnimatedDataBuffer->set(skeletalAnimatedDataID, SkeletalAnimatedDataDescription::makeEmpty());
 
         result = std::make_shared<SkeletalAnimatedDataHandler>(weak_from_this(), skeletalAnimatedDataID);
@@ -1753,9 +2111,19 @@ ElementDataBuffer SceneData::elementDataBuffer() const
     return m_elementDataBuffer;
 }
 
+Element16DataBuffer SceneData::element16DataBuffer() const
+{
+    return m_element16DataBuffer;
+}
+
+size_t SceneData::drawablesCount() const
+{
+    return m_drawablesBuffer->size();
+}
+
 size_t SceneData::drawDataCount() const
 {
-    return m_drawDataBuffer->size();
+    return m_liveDrawDataIDs.size();
 }
 
 size_t SceneData::skeletalAnimatedDataCount() const
@@ -1778,17 +2146,216 @@ size_t SceneData::shadowMapsLayersCount() const
     return m_shadowMapsRectPackers.size();
 }
 
+size_t SceneData::meshletsCount() const
+{
+    return m_meshletsDataBuffer->size() - m_meshletsDataBuffer->freeSize();
+}
+
+void SceneData::flushChanges()
+{
+    m_materialsChanges.flush(*m_materialsBuffer);
+    m_lightsChanges.flush(*m_lightsBuffer);
+    m_shadowsChanges.flush(*m_shadowsBuffer);
+    m_drawDataChanges.flush(*m_drawDataBuffer);
+    m_liveDrawDataChanges.flush(*m_liveDrawDataBuffer);
+}
+
+void SceneData::compactGeometryData(size_t maxBytes)
+{
+    auto patchMesh = [this](MeshHandler& handler, const std::function<void(MeshDescription&)>& patchDescription)
+    {
+        auto meshDescription = m_meshesBuffer->get(handler.ID());
+        patchDescription(meshDescription);
+        m_meshesBuffer->set(handler.ID(), meshDescription);
+
+        handler.updateOffsetsAndSizes(
+            meshDescription.positionNormalTexCoordsDataOffset, handler.positionNormalTexCoordsDataSize(),
+            meshDescription.tangentDataOffset, handler.tangentDataSize(), meshDescription.boneDataOffset,
+            handler.boneDataSize(), meshDescription.elementDataOffset, handler.elementDataSize());
+    };
+
+    size_t movedBytes = 0u;
+
+    movedBytes += compactGeometryDataStore(
+        *m_positionNormalTexCoordsDataBuffer, GeometryDataStore::PositionNormalTexCoords, maxBytes - movedBytes,
+        [&patchMesh](MeshHandler& handler, uint32_t offset)
+        { patchMesh(handler, [offset](MeshDescription& description) { description.positionNormalTexCoordsDataOffset = offset; }); });
+
+    movedBytes += compactGeometryDataStore(
+        *m_tangentDataBuffer, GeometryDataStore::Tangent, maxBytes - movedBytes,
+        [&patchMesh](MeshHandler& handler, uint32_t offset)
+        { patchMesh(handler, [offset](MeshDescription& description) { description.tangentDataOffset = offset; }); });
+
+    movedBytes += compactGeometryDataStore(
+        *m_compactPositionNormalTexCoordsDataBuffer, GeometryDataStore::CompactPositionNormalTexCoords, maxBytes - movedBytes,
+        [&patchMesh](MeshHandler& handler, uint32_t offset)
+        { patchMesh(handler, [offset](MeshDescription& description) { description.positionNormalTexCoordsDataOffset = offset; }); });
+
+    movedBytes += compactGeometryDataStore(
+        *m_compactTangentDataBuffer, GeometryDataStore::CompactTangent, maxBytes - movedBytes,
+        [&patchMesh](MeshHandler& handler, uint32_t offset)
+        { patchMesh(handler, [offset](MeshDescription& description) { description.tangentDataOffset = offset; }); });
+
+    movedBytes += compactGeometryDataStore(
+        *m_boneDataBuffer, GeometryDataStore::Bone, maxBytes - movedBytes,
+        [&patchMesh](MeshHandler& handler, uint32_t offset)
+        { patchMesh(handler, [offset](MeshDescription& description) { description.boneDataOffset = offset; }); });
+
+    movedBytes += compactGeometryDataStore(
+        *m_elementDataBuffer, GeometryDataStore::Element, maxBytes - movedBytes,
+        [&patchMesh](MeshHandler& handler, uint32_t offset)
+        { patchMesh(handler, [offset](MeshDescription& description) { description.elementDataOffset = offset; }); });
+
+    movedBytes += compactGeometryDataStore(
+        *m_element16DataBuffer, GeometryDataStore::Element16, maxBytes - movedBytes,
+        [&patchMesh](MeshHandler& handler, uint32_t offset)
+        { patchMesh(handler, [offset](MeshDescription& description) { description.elementDataOffset = offset; }); });
+
+    movedBytes += compactGeometryDataStore(
+        *m_meshletsDataBuffer, GeometryDataStore::Meshlets, maxBytes - movedBytes,
+        [&patchMesh](MeshHandler& handler, uint32_t offset)
+        { patchMesh(handler, [offset](MeshDescription& description) { description.meshletsDataOffset = offset; }); });
+}
+
+float SceneData::geometryDataFragmentation() const
+{
+    const auto size = m_positionNormalTexCoordsDataBuffer->size() * sizeof(PositionNormalTexCoordsDataDescription) +
+                      m_tangentDataBuffer->size() * sizeof(TangentDataDescription) +
+                      m_compactPositionNormalTexCoordsDataBuffer->size() * sizeof(CompactPositionNormalTexCoordsDataDescription) +
+                      m_compactTangentDataBuffer->size() * sizeof(CompactTangentDataDescription) +
+                      m_boneDataBuffer->size() * sizeof(BoneDataDescription) +
+                      m_elementDataBuffer->size() * sizeof(ElementDataDescription) +
+                      m_element16DataBuffer->size() * sizeof(Element16DataDescription) +
+                      m_meshletsDataBuffer->size() * sizeof(MeshletDescription);
+
+    const auto freeSize = m_positionNormalTexCoordsDataBuffer->freeSize() * sizeof(PositionNormalTexCoordsDataDescription) +
+                          m_tangentDataBuffer->freeSize() * sizeof(TangentDataDescription) +
+                          m_compactPositionNormalTexCoordsDataBuffer->freeSize() *
+                              sizeof(CompactPositionNormalTexCoordsDataDescription) +
+                          m_compactTangentDataBuffer->freeSize() * sizeof(CompactTangentDataDescription) +
+                          m_boneDataBuffer->freeSize() * sizeof(BoneDataDescription) +
+                          m_elementDataBuffer->freeSize() * sizeof(ElementDataDescription) +
+                          m_element16DataBuffer->freeSize() * sizeof(Element16DataDescription) +
+                          m_meshletsDataBuffer->freeSize() * sizeof(MeshletDescription);
+
+    return size ? 100.f * static_cast<float>(freeSize) / static_cast<float>(size) : 0.f;
+}
+
+uint64_t SceneData::numGeometryDataBytesReclaimed() const
+{
+    return m_numGeometryDataBytesReclaimed;
+}
+
+uint64_t SceneData::numDeduplicatedGeometryBytes() const
+{
+    return m_numDeduplicatedGeometryBytes;
+}
+
 std::shared_ptr<LightHandler> SceneData::addLight()
 {
     const auto lightID = m_lightIDsGenerator.generate();
-    m_lightsBuffer->resize(static_cast<size_t>(lightID) + 1u);
-    m_lightsBuffer->set(lightID, LightDescription::makeEmpty());
+    if (lightID >= m_lightsBuffer->size()) m_lightsBuffer->resize(static_cast<size_t>(lightID) + 1u);
+    m_lightsChanges.set(lightID, LightDescription::makeEmpty());
     return std::make_shared<LightHandler>(weak_from_this(), lightID);
 }
 
 void SceneData::onLightChanged(LightHandler& handler, const LightDescription& lightDescription)
 {
-    m_lightsBuffer->set(handler.ID(), lightDescription);
+    m_lightsChanges.set(handler.ID(), lightDescription);
+}
+
+SceneData::GeometryRange SceneData::geometryRange(GeometryDataStore store, Geometry& geometry)
+{
+    auto& verticesData = geometry.verticesData;
+    auto& elementData = geometry.elementData;
+    const auto isCompact = verticesData.hasCompactVertices;
+
+    // the full and the compact vertices, and the 32-bit and 16-bit elements share the offsets, so the other store gets 0 size
+    switch (store)
+    {
+        case GeometryDataStore::PositionNormalTexCoords:
+            return {
+                verticesData.positionNormalTexCoordsDataOffset, isCompact ? 0u : verticesData.positionNormalTexCoordsDataSize};
+        case GeometryDataStore::Tangent:
+            return {verticesData.tangentDataOffset, isCompact ? 0u : verticesData.tangentDataSize};
+        case GeometryDataStore::CompactPositionNormalTexCoords:
+            return {
+                verticesData.positionNormalTexCoordsDataOffset, isCompact ? verticesData.positionNormalTexCoordsDataSize : 0u};
+        case GeometryDataStore::CompactTangent:
+            return {verticesData.tangentDataOffset, isCompact ? verticesData.tangentDataSize : 0u};
+        case GeometryDataStore::Bone:
+            return {verticesData.boneDataOffset, verticesData.boneDataSize};
+        case GeometryDataStore::Element:
+            return {elementData.offset, elementData.is16Bit ? 0u : elementData.size};
+        case GeometryDataStore::Element16:
+            return {elementData.offset, elementData.is16Bit ? elementData.size : 0u};
+        case GeometryDataStore::Meshlets:
+        default:
+            return {geometry.meshletsData.offset, geometry.meshletsData.size};
+    }
+}
+
+void SceneData::addGeometryRanges(uint64_t key, Geometry& geometry)
+{
+    for (uint16_t i = 0u; i < numElementsGeometryDataStore(); ++i)
+        if (const auto range = geometryRange(castToGeometryDataStore(i), geometry); range.size)
+            m_geometriesByOffset[i][range.offset] = key;
+}
+
+void SceneData::removeGeometryRanges(Geometry& geometry)
+{
+    for (uint16_t i = 0u; i < numElementsGeometryDataStore(); ++i)
+        if (const auto range = geometryRange(castToGeometryDataStore(i), geometry); range.size)
+            m_geometriesByOffset[i].erase(range.offset);
+}
+
+template <typename T>
+size_t SceneData::compactGeometryDataStore(
+    DataStore<T>& store,
+    GeometryDataStore storeType,
+    size_t maxBytes,
+    const std::function<void(MeshHandler&, uint32_t)>& onRelocated)
+{
+    auto& geometriesByOffset = m_geometriesByOffset[castFromGeometryDataStore(storeType)];
+
+    size_t movedBytes = 0u;
+    bool isBudgetExceeded = false;
+
+    while (store.freeSize() && !geometriesByOffset.empty())
+    {
+        // the last range of the store always belongs to some geometry, because the free blocks at the end are trimmed
+        auto lastIter = std::prev(geometriesByOffset.end());
+        const auto key = lastIter->second;
+        auto& geometry = m_geometries.at(key);
+
+        auto lastRange = geometryRange(storeType, geometry);
+        if (lastRange.offset + lastRange.size != store.size()) break;
+
+        const auto lastBytes = lastRange.size * sizeof(T);
+
+        isBudgetExceeded = (movedBytes + lastBytes > maxBytes);
+        if (isBudgetExceeded) break;
+
+        const auto storeSize = store.size();
+        const auto newOffset = static_cast<uint32_t>(store.relocate(lastRange.offset, lastRange.size));
+        if (newOffset == lastRange.offset) break;
+
+        geometriesByOffset.erase(lastIter);
+        geometriesByOffset[newOffset] = key;
+        lastRange.offset = newOffset;
+
+        // all the meshes sharing the geometry are patched
+        for (auto meshID : geometry.meshIDs)
+            if (auto handler = m_meshHandlers[meshID].lock()) onRelocated(*handler, newOffset);
+
+        movedBytes += lastBytes;
+        m_numGeometryDataBytesReclaimed += (storeSize - store.size()) * sizeof(T);
+    }
+
+    // shrinking reallocates the buffer, so it's done once the store can't be compacted more
+    if (!isBudgetExceeded && store.isShrinkToFitNeeded()) store.shrinkToFit();
+
+    return movedBytes;
 }
 
 bool SceneData::isMaterialTransparent(
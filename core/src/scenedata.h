@@ -1,14 +1,20 @@
 #ifndef CORE_SCENEDATA_H
 #define CORE_SCENEDATA_H
 
+#include <array>
 #include <deque>
+#include <functional>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <utils/glm/mat4x4.hpp>
 #include <utils/glm/vec3.hpp>
+#include <utils/enumclass.h>
 #include <utils/glm/vec4.hpp>
 #include <utils/idgenerator.h>
 #include <utils/rectpacker.h>
+#include <utils/tlsfallocator.h>
 
 #include <core/forwarddecl.h>
 #include <core/graphicsrendererbase.h>
@@ -27,31 +33,21 @@ class DataStore
 public:
     using value_type = T;
 
-    DataStore()
-        : m_vectorBuffer(graphics::VectorBuffer<value_type>::create())
+    DataStore(bool isHostMirrored = false)
+        : m_vectorBuffer(graphics::VectorBuffer<value_type>::create({}, isHostMirrored))
     {
     }
     ~DataStore() {}
 
     size_t allocate(size_t count, const value_type* data)
     {
-        auto result = std::numeric_limits<size_t>::max();
+        const auto result = m_allocator.allocate(count);
+        if (result == utils::TLSFAllocator::invalidOffset()) return result;
 
-        if (!count) return result;
-
-        if (auto it = findFreeBlock(count); it != m_freeBlocks.end())
-        {
-            result = it->first + it->second - count;
+        if (result < m_vectorBuffer->size())
             m_vectorBuffer->set(result, data, count);
-
-            it->second -= count;
-            if (it->second == 0u) m_freeBlocks.erase(it);
-        }
         else
-        {
-            result = m_vectorBuffer->size();
             m_vectorBuffer->insert(result, data, count);
-        }
 
         return result;
     }
@@ -71,80 +67,102 @@ public:
             LOG_CRITICAL << "Count is out of range";
         }
 
-        auto insertionResult = m_freeBlocks.insert({index, count});
-        if (!insertionResult.second) LOG_CRITICAL << "Free blocks already have the memory with equal offset";
+        m_allocator.free(index, count);
 
-        auto& iter = insertionResult.first;
+        if (const auto size = m_allocator.size(); size < m_vectorBuffer->size()) m_vectorBuffer->resize(size);
+    }
 
-        auto nextIter = std::next(insertionResult.first, 1u);
-        if (nextIter != m_freeBlocks.end())
+    // moves the range to a free block below it if there is a suitable one, returns the new index
+    size_t relocate(size_t index, size_t count)
+    {
+        const auto result = m_allocator.allocate(count);
+        if (result >= index)
         {
-            if (const auto end = iter->first + iter->second; end > nextIter->first)
-            {
-                LOG_CRITICAL << "The memory is not allocated to be freed";
-            }
-            else if (end == nextIter->first)
-            {
-                iter->second += nextIter->second;
-                m_freeBlocks.erase(nextIter);
-            }
+            m_allocator.free(result, count);
+            return index;
         }
 
-        if (iter != m_freeBlocks.begin())
-        {
-            auto prevIter = std::prev(insertionResult.first, 1u);
-            if (const auto prevEnd = prevIter->first + prevIter->second; prevEnd > iter->first)
-            {
-                LOG_CRITICAL << "The memory is not allocated to be freed";
-            }
-            else if (prevEnd == iter->first)
-            {
-                prevIter->second += iter->second;
-                m_freeBlocks.erase(iter);
-            }
-        }
+        m_vectorBuffer->copy(index, result, count);
+        free(index, count);
+        m_isShrinkToFitNeeded = true;
 
-        if (auto lastIter = std::prev(m_freeBlocks.end(), 1u); lastIter->first + lastIter->second == m_vectorBuffer->size())
-        {
-            m_vectorBuffer->resize(m_vectorBuffer->size() - lastIter->second);
-            m_freeBlocks.erase(lastIter);
-        }
+        return result;
+    }
+
+    size_t size() const { return m_vectorBuffer->size(); }
+    size_t freeSize() const { return m_allocator.freeSize(); }
+    bool isShrinkToFitNeeded() const { return m_isShrinkToFitNeeded; }
+    void shrinkToFit()
+    {
+        m_vectorBuffer->shrinkToFit();
+        m_isShrinkToFitNeeded = false;
     }
 
     value_type get(size_t index) const { return m_vectorBuffer->get(index); }
 
     std::shared_ptr<const graphics::IDynamicBuffer> buffer() const { return m_vectorBuffer->buffer(); }
 
-    static std::shared_ptr<DataStore<value_type>> create() { return std::make_shared<DataStore<value_type>>(); }
+    static std::shared_ptr<DataStore<value_type>> create(bool isHostMirrored = false)
+    {
+        return std::make_shared<DataStore<value_type>>(isHostMirrored);
+    }
 
 private:
     std::shared_ptr<graphics::VectorBuffer<value_type>> m_vectorBuffer;
-    std::map<size_t, size_t> m_freeBlocks;
+    utils::TLSFAllocator m_allocator;
+    bool m_isShrinkToFitNeeded = false;
+};
+
+// keeps the latest value of each changed element until the flush, which uploads contiguous IDs as one range
+template <typename T>
+class ChangesQueue
+{
+public:
+    using value_type = T;
+
+    void set(size_t index, const value_type& value) { m_changes[index] = value; }
 
-    std::map<size_t, size_t>::iterator findFreeBlock(size_t count)
+    bool isEmpty() const { return m_changes.empty(); }
+    size_t size() const { return m_changes.size(); }
+
+    void flush(graphics::VectorBuffer<value_type>& vectorBuffer)
     {
-        auto result = m_freeBlocks.end();
-        auto sizeDiff = std::numeric_limits<size_t>::max();
+        const auto bufferSize = vectorBuffer.size();
+
+        std::vector<value_type> range;
+        auto rangeIndex = std::numeric_limits<size_t>::max();
 
-        for (auto it = m_freeBlocks.begin(); (it != m_freeBlocks.end()) && sizeDiff; ++it)
+        for (const auto& [index, value] : m_changes)
         {
-            if (it->second < count) continue;
+            if (index >= bufferSize) break; // the buffer was shrunk after the change
 
-            if (const auto diff = it->second - count; diff < sizeDiff)
+            if (!range.empty() && (rangeIndex + range.size() != index))
             {
-                result = it;
-                sizeDiff = diff;
+                vectorBuffer.set(rangeIndex, range.data(), range.size());
+                range.clear();
             }
+
+            if (range.empty()) rangeIndex = index;
+            range.push_back(value);
         }
 
-        return result;
+        if (!range.empty()) vectorBuffer.set(rangeIndex, range.data(), range.size());
+
+        m_changes.clear();
     }
+
+private:
+    std::map<size_t, value_type> m_changes;
 };
 
 using PositionNormalTexCoordsDataBuffer = std::shared_ptr<DataStore<PositionNormalTexCoordsDataDescription>>;
 using TangentDataBuffer = std::shared_ptr<DataStore<TangentDataDescription>>;
+using CompactPositionNormalTexCoordsDataBuffer = std::shared_ptr<DataStore<CompactPositionNormalTexCoordsDataDescription>>;
+using CompactTangentDataBuffer = std::shared_ptr<DataStore<CompactTangentDataDescription>>;
 using BoneDataBuffer = std::shared_ptr<DataStore<BoneDataDescription>>;
 using ElementDataBuffer = std::shared_ptr<DataStore<ElementDataDescription>>;
+using Element16DataBuffer = std::shared_ptr<DataStore<Element16DataDescription>>;
+using MeshletsDataBuffer = std::shared_ptr<DataStore<MeshletDescription>>;
 using SkeletonsDataBuffer = std::shared_ptr<DataStore<SkeletonsDataDescription>>;
 using BonesTransformsDataBuffer = std::shared_ptr<DataStore<BonesTransformsDataDescription>>;
 using ShadowTransformsDataBuffer = std::shared_ptr<DataStore<ShadowTransformsDataDescription>>;
@@ -159,6 +177,7 @@ using ShadowsBuffer = std::shared_ptr<graphics::VectorBuffer<ShadowDescription>>
 using SkeletonsBuffer = std::shared_ptr<graphics::VectorBuffer<SkeletonDescription>>;
 
 using DrawDataBuffer = std::shared_ptr<graphics::VectorBuffer<DrawDataDescription>>;
+using LiveDrawDataBuffer = std::shared_ptr<graphics::VectorBuffer<uint32_t>>;
 using SkeletalAnimatedDataBuffer = std::shared_ptr<graphics::VectorBuffer<SkeletalAnimatedDataDescription>>;
 
 class SceneData;
@@ -193,7 +212,9 @@ public:
     uint32_t boneDataSize() const;
     uint32_t elementDataOffset() const;
     uint32_t elementDataSize() const;
+    uint64_t geometryKey() const;
 
+    void updateGeometryKey(uint64_t);
     void updateOffsetsAndSizes(
         uint32_t positionNormalTexCoordsDataOffset,
         uint32_t positionNormalTexCoordsDataSize,
@@ -215,6 +236,7 @@ private:
     uint32_t m_boneDataSize = 0u;
     uint32_t m_elementDataOffset = utils::IDsGenerator::last();
     uint32_t m_elementDataSize = 0u;
+    uint64_t m_geometryKey = 0u;
 };
 
 class MaterialMapHandler : public ResourceHandler
@@ -361,6 +383,17 @@ private:
     uint32_t m_bonesTransformsDataSize = 0u;
 };
 
+// the stores of the geometries data, which are compacted by moving their last ranges to the holes
+ENUMCLASS(GeometryDataStore, uint16_t,
+          PositionNormalTexCoords,
+          Tangent,
+          CompactPositionNormalTexCoords,
+          CompactTangent,
+          Bone,
+          Element,
+          Element16,
+          Meshlets)
+
 class SceneData : public StateSet, public std::enable_shared_from_this<SceneData>
 {
 public:
@@ -374,13 +407,28 @@ public:
         bool hasPositions = false;
         bool hasNormals = false;
         bool hasTexCoords = false;
+        bool hasCompactVertices = false;
         uint32_t tangentDataOffset = utils::IDsGenerator::last();
         uint32_t tangentDataSize = 0u;
         uint32_t boneDataOffset = utils::IDsGenerator::last();
         uint32_t boneDataSize = 0u;
         uint32_t bonesCount = 0u;
     };
-    AddVerticesDataResult addVerticesData(const std::unordered_map<utils::VertexAttribute, std::shared_ptr<utils::VertexBuffer>>&);
+    struct VerticesData
+    {
+        std::vector<PositionNormalTexCoordsDataDescription> positionNormalTexCoordsData;
+        std::vector<TangentDataDescription> tangentData;
+        std::vector<BoneDataDescription> boneData;
+        std::vector<CompactPositionNormalTexCoordsDataDescription> compactPositionNormalTexCoordsData;
+        std::vector<CompactTangentDataDescription> compactTangentData;
+        bool hasPositions = false;
+        bool hasNormals = false;
+        bool hasTexCoords = false;
+        uint32_t bonesCount = 0u;
+    };
+    static VerticesData makeVerticesData(const std::unordered_map<utils::VertexAttribute, std::shared_ptr<utils::VertexBuffer>>&);
+    static void compactVerticesData(VerticesData&, const utils::BoundingBox&); // replaces the full precision data
+    AddVerticesDataResult addVerticesData(const VerticesData&);
     void removeVerticeshData(
         uint32_t positionNormalTexCoordsDataOffset,
         uint32_t positionNormalTexCoordsDataSize,
@@ -389,13 +437,38 @@ public:
         uint32_t boneDataOffset,
         uint32_t boneDataSize);
 
+    struct ElementDataLODs
+    {
+        uint32_t count = 1u; // including the full detailed one
+        std::array<uint32_t, MeshDescription::MaxLODsCount - 1u> sizes{};
+        std::array<float, MeshDescription::MaxLODsCount - 1u> errors{};
+    };
     struct AddElementDataResult
+    {
+        uint32_t offset = utils::IDsGenerator::last();
+        uint32_t size = 0u; // including the LODs
+        bool is16Bit = false; // the data is in m_element16DataBuffer
+        ElementDataLODs LODs;
+    };
+    static std::vector<ElementDataDescription> makeElementData(const std::unordered_set<std::shared_ptr<utils::PrimitiveSet>>&);
+    // appends the indices of the simplified LODs to the element data
+    static ElementDataLODs makeElementDataLODs(std::vector<ElementDataDescription>&, const utils::VertexBuffer&, uint32_t);
+    // uses 16-bit indices if they fit
+    AddElementDataResult addElementData(const std::vector<ElementDataDescription>&, const ElementDataLODs&);
+    void removeElementData(uint32_t, uint32_t, bool is16Bit);
+
+    struct AddMeshletsDataResult
     {
         uint32_t offset = utils::IDsGenerator::last();
         uint32_t size = 0u;
     };
-    AddElementDataResult addElementData(const std::unordered_set<std::shared_ptr<utils::PrimitiveSet>>&);
-    void removeElementData(uint32_t, uint32_t);
+    // reorders the element data, so every meshlet is a contiguous range of it
+    static std::vector<MeshletDescription> makeMeshletsData(
+        std::vector<ElementDataDescription>&,
+        const utils::VertexBuffer&,
+        uint32_t maxTrianglesCount);
+    AddMeshletsDataResult addMeshletsData(const std::vector<MeshletDescription>&);
+    void removeMeshletsData(uint32_t, uint32_t);
 
     struct AddSkeletonDataResult
     {
@@ -579,17 +652,62 @@ public:
     void onSkeletalAnimatedDataChanged(SkeletalAnimatedDataHandler&, const std::shared_ptr<Skeleton>&, const std::string&);
 
     ElementDataBuffer elementDataBuffer() const;
+    Element16DataBuffer element16DataBuffer() const;
 
-    size_t drawDataCount() const;
+    size_t drawablesCount() const; // including the removed ones, so every drawable ID is less than it
+    size_t drawDataCount() const; // the number of live draw data, see m_liveDrawDataIDs
     size_t skeletalAnimatedDataCount() const;
     size_t shadowsCount() const;
     size_t lightsCount() const;
     size_t shadowMapsLayersCount() const;
+    size_t meshletsCount() const; // the number of the meshlets of all the meshes
+
+    // uploads the draw data, lights, shadows and materials changed since the previous flush
+    void flushChanges();
+
+    // moves the meshes data from the ends of the vertices and elements stores to the holes, no more than maxBytes per call
+    void compactGeometryData(size_t maxBytes);
+    float geometryDataFragmentation() const; // percents
+    uint64_t numGeometryDataBytesReclaimed() const;
+
+    uint64_t numDeduplicatedGeometryBytes() const; // the bytes not uploaded because the meshes share the same geometry
 
 private:
     std::shared_ptr<LightHandler> addLight();
     void onLightChanged(LightHandler&, const LightDescription&);
 
+    // the vertices and elements data shared by the meshes with byte-identical geometry
+    struct Geometry
+    {
+        AddVerticesDataResult verticesData;
+        AddElementDataResult elementData;
+        AddMeshletsDataResult meshletsData;
+        std::vector<uint64_t> keySizes; // the sizes of the hashed streams
+        uint64_t keyCheckHash = 0u; // the second hash of the streams, it's compared with the sizes on the key hits
+        std::unordered_set<utils::IDsGenerator::value_type> meshIDs;
+        uint32_t refsCount = 0u;
+    };
+    static constexpr uint64_t s_emptyGeometryKey = 0u;
+    uint64_t acquireGeometry(const utils::Mesh&, const utils::BoundingBox&);
+    void releaseGeometry(uint64_t);
+    size_t geometryBytes(const Geometry&) const;
+
+    struct GeometryRange
+    {
+        uint32_t& offset;
+        uint32_t size; // 0 if the geometry has no data in the store
+    };
+    static GeometryRange geometryRange(GeometryDataStore, Geometry&);
+    void addGeometryRanges(uint64_t, Geometry&);
+    void removeGeometryRanges(Geometry&);
+
+    template <typename T>
+    size_t compactGeometryDataStore(
+        DataStore<T>&,
+        GeometryDataStore,
+        size_t maxBytes,
+        const std::function<void(MeshHandler&, uint32_t)>& onRelocated);
+
     static bool isMaterialTransparent(
         const glm::vec4& baseColor,
         const std::shared_ptr<const MaterialMap>& baseColorMap,
@@ -598,11 +716,20 @@ private:
 
     PositionNormalTexCoordsDataBuffer m_positionNormalTexCoordsDataBuffer;
     TangentDataBuffer m_tangentDataBuffer;
+    CompactPositionNormalTexCoordsDataBuffer m_compactPositionNormalTexCoordsDataBuffer;
+    CompactTangentDataBuffer m_compactTangentDataBuffer;
     BoneDataBuffer m_boneDataBuffer;
     ElementDataBuffer m_elementDataBuffer;
+    Element16DataBuffer m_element16DataBuffer;
+    MeshletsDataBuffer m_meshletsDataBuffer;
     SkeletonsDataBuffer m_skeletonsDataBuffer;
     BonesTransformsDataBuffer m_bonesTransformsDataBuffer;
     ShadowTransformsDataBuffer m_shadowTransformsDataBuffer;
+    std::vector<std::weak_ptr<MeshHandler>> m_meshHandlers;
+    std::unordered_map<uint64_t, Geometry> m_geometries;
+    std::array<std::map<uint32_t, uint64_t>, numElementsGeometryDataStore()> m_geometriesByOffset; // per store
+    uint64_t m_numDeduplicatedGeometryBytes = 0u;
+    uint64_t m_numGeometryDataBytesReclaimed = 0u;
     std::deque<graphics::PTextureHandle> m_textureHandles;
 
     MeshesBuffer m_meshesBuffer;
@@ -617,6 +744,17 @@ private:
     DrawDataBuffer m_drawDataBuffer;
     SkeletalAnimatedDataBuffer m_skeletalAnimatedDataBuffer;
 
+    // the packed IDs of live draw data, so the passes don't process the holes of m_drawDataBuffer
+    LiveDrawDataBuffer m_liveDrawDataBuffer;
+    std::vector<uint32_t> m_liveDrawDataIDs;
+    std::vector<uint32_t> m_liveDrawDataIndices; // draw data ID -> index in m_liveDrawDataIDs
+
+    ChangesQueue<MaterialDescription> m_materialsChanges;
+    ChangesQueue<LightDescription> m_lightsChanges;
+    ChangesQueue<ShadowDescription> m_shadowsChanges;
+    ChangesQueue<DrawDataDescription> m_drawDataChanges;
+    ChangesQueue<uint32_t> m_liveDrawDataChanges;
+
     utils::IDsGenerator m_meshIDsGenerator;
     utils::IDsGenerator m_mapIDsGenerator;
     utils::IDsGenerator m_materialIDsGenerator;
@@ -630,6 +768,10 @@ private:
 
     uint32_t m_shadowAtlasSize = 0u;
     std::vector<std::shared_ptr<utils::RectPacker>> m_shadowMapsRectPackers;
+
+    bool m_isVertexFormatCompact = false;
+    uint32_t m_meshLODsCount = 1u;
+    uint32_t m_meshletMaxTrianglesCount = 0u; // 0 if the meshlets aren't built
 };
 
 } // namespace core
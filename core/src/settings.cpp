@@ -193,6 +193,12 @@ const glm::u32vec3& Camera::clusterSize() const
     return s_clusterSize;
 }
 
+uint32_t Camera::maxClusterLightIndicesCount() const
+{
+    static const auto s_maxClusterLightIndicesCount = readUint("MaxClusterLightIndicesCount", 1048576u);
+    return s_maxClusterLightIndicesCount;
+}
+
 Background::Background(const rapidjson::Document::ValueType* value)
     : utils::SettingsComponent(value)
 {
@@ -627,6 +633,12 @@ const LightNodeAreaBoundingBox& DebugRendering::lightNodeAreaBoundingBox() const
     return s_lightNodeAreaBoundingBox;
 }
 
+bool DebugRendering::fullMemoryBarriers() const
+{
+    static const auto s_fullMemoryBarriers = readBool("FullMemoryBarriers", false);
+    return s_fullMemoryBarriers;
+}
+
 Graphics::Graphics(const rapidjson::Document::ValueType* value)
     : utils::SettingsComponent(value)
 {
@@ -650,6 +662,12 @@ DrawDataCullingAlgorithm Graphics::drawDataCullingAlgorithm() const
     return s_drawDataCullingAlgorithm;
 }
 
+bool Graphics::occlusionCulling() const
+{
+    static const auto s_occlusionCulling = readBool("OcclusionCulling", true);
+    return s_occlusionCulling;
+}
+
 ShadowDataCullingAlgorithm Graphics::shadowDataCullingAlgorithm() const
 {
     static auto s_shadowDataCullingAlgorithm = ShadowDataCullingAlgorithm::Count;
@@ -682,6 +700,60 @@ SpotLightCullingAlgorithm Graphics::spotLightCullingAlgorithm() const
     return s_spotLightCullingAlgorithm;
 }
 
+const std::filesystem::path& Graphics::programBinaryCacheDirectory() const
+{
+    static const std::filesystem::path s_programBinaryCacheDirectory = readString("ProgramBinaryCacheDirectory", "");
+    return s_programBinaryCacheDirectory;
+}
+
+uint32_t Graphics::geometryCompactionBytesPerFrame() const
+{
+    static const auto s_geometryCompactionBytesPerFrame = readUint("GeometryCompactionBytesPerFrame", 4u * 1024u * 1024u);
+    return s_geometryCompactionBytesPerFrame;
+}
+
+bool Graphics::compactVertexFormat() const
+{
+    static const auto s_compactVertexFormat = readBool("CompactVertexFormat", false);
+    return s_compactVertexFormat;
+}
+
+uint32_t Graphics::meshLODsCount() const
+{
+    static const auto s_meshLODsCount = readUint("MeshLODsCount", 4u);
+    return s_meshLODsCount;
+}
+
+float Graphics::meshLODBias() const
+{
+    static const auto s_meshLODBias = readSingle("MeshLODBias", 1.f);
+    return s_meshLODBias;
+}
+
+bool Graphics::meshletCulling() const
+{
+    static const auto s_meshletCulling = readBool("MeshletCulling", true);
+    return s_meshletCulling;
+}
+
+uint32_t Graphics::meshletMaxTrianglesCount() const
+{
+    static const auto s_meshletMaxTrianglesCount = readUint("MeshletMaxTrianglesCount", 128u);
+    return s_meshletMaxTrianglesCount;
+}
+
+bool Graphics::autoInstancing() const
+{
+    static const auto s_autoInstancing = readBool("AutoInstancing", true);
+    return s_autoInstancing;
+}
+
+bool Graphics::lightBinning() const
+{
+    static const auto s_lightBinning = readBool("LightBinning", true);
+    return s_lightBinning;
+}
+
 const Camera& Graphics::camera() const
 {
     static const Camera s_camera(read("Camera"));
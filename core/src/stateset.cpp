@@ -14,6 +14,11 @@ StateSet::StateSet()
 
 StateSet::~StateSet() = default;
 
+uint64_t StateSet::version() const
+{
+    return m_->version();
+}
+
 const UniformCollection &StateSet::uniformCollection() const
 {
     return m_->uniformCollection();
@@ -32,12 +37,14 @@ PAbstractUniform StateSet::uniform(UniformID ID)
 
 PAbstractUniform &StateSet::getOrCreateUniform(UniformID ID)
 {
+    m_->updateVersion();
     auto it = m_->uniformCollection().find(ID);
     return it != m_->uniformCollection().end() ? it->second : (m_->uniformCollection()[ID] = PAbstractUniform());
 }
 
 void StateSet::removeUniform(UniformID ID)
 {
+    m_->updateVersion();
     m_->uniformCollection().erase(ID);
 }
 
@@ -59,12 +66,14 @@ PAbstractUniform StateSet::userUniform(const std::string& name)
 
 PAbstractUniform &StateSet::getOrCreateUserUniform(const std::string& name)
 {
+    m_->updateVersion();
     auto it = m_->userUniformCollection().find(name);
     return it != m_->userUniformCollection().end() ? it->second : (m_->userUniformCollection()[name] = PAbstractUniform());
 }
 
 void StateSet::removeUserUniform(const std::string &name)
 {
+    m_->updateVersion();
     m_->userUniformCollection().erase(name);
 }
 
@@ -81,12 +90,14 @@ graphics::PConstBufferRange StateSet::uniformBlock(UniformBlockID ID) const
 
 graphics::PConstBufferRange& StateSet::getOrCreateUniformBlock(UniformBlockID ID)
 {
+    m_->updateVersion();
     auto it = m_->uniformBlockCollection().find(ID);
     return it != m_->uniformBlockCollection().end() ? it->second : (m_->uniformBlockCollection()[ID] = graphics::PConstBufferRange());
 }
 
 void StateSet::removeUniformBlock(UniformBlockID ID)
 {
+    m_->updateVersion();
     m_->uniformBlockCollection().erase(ID);
 }
 
@@ -103,12 +114,14 @@ graphics::PConstBufferRange StateSet::shaderStorageBlock(ShaderStorageBlockID ID
 
 graphics::PConstBufferRange &StateSet::getOrCreateShaderStorageBlock(ShaderStorageBlockID ID)
 {
+    m_->updateVersion();
     auto it = m_->shaderStorageBlockCollection().find(ID);
     return it != m_->shaderStorageBlockCollection().end() ? it->second : (m_->shaderStorageBlockCollection()[ID] = graphics::PConstBufferRange());
 }
 
 void StateSet::removeShaderStorageBlock(ShaderStorageBlockID ID)
 {
+    m_->updateVersion();
     m_->shaderStorageBlockCollection().erase(ID);
 }
 
@@ -1,3 +1,5 @@
+#include <atomic>
+
 #include "statesetprivate.h"
 
 namespace simplex
@@ -5,12 +7,30 @@ namespace simplex
 namespace core
 {
 
+// versions are unique among all state sets, so a version also identifies its state set
+static uint64_t nextVersion()
+{
+    static std::atomic<uint64_t> s_version = 0u;
+    return ++s_version;
+}
+
 StateSetPrivate::StateSetPrivate()
+    : m_version(nextVersion())
 {
 }
 
 StateSetPrivate::~StateSetPrivate() = default;
 
+uint64_t StateSetPrivate::version() const
+{
+    return m_version;
+}
+
+void StateSetPrivate::updateVersion()
+{
+    m_version = nextVersion();
+}
+
 UniformCollection &StateSetPrivate::uniformCollection()
 {
     return m_uniformCollection;
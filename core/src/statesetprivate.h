@@ -14,12 +14,16 @@ public:
     StateSetPrivate();
     virtual ~StateSetPrivate();
 
+    uint64_t version() const;
+    void updateVersion();
+
     UniformCollection &uniformCollection();
     UserUniformCollection &userUniformCollection();
     UniformBlockCollection& uniformBlockCollection();
     ShaderStorageBlockCollection& shaderStorageBlockCollection();
 
 protected:
+    uint64_t m_version;
     UniformCollection m_uniformCollection;
     UserUniformCollection m_userUniformCollection;
     UniformBlockCollection m_uniformBlockCollection;
@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <utils/logger.h>
+#include <utils/tlsfallocator.h>
+
+// the best fit search over the sorted free blocks, which was used by core::DataStore before the TLSF allocator
+class BestFitAllocator
+{
+public:
+    size_t allocate(size_t count)
+    {
+        auto it = m_freeBlocks.end();
+        auto sizeDiff = std::numeric_limits<size_t>::max();
+
+        for (auto freeIt = m_freeBlocks.begin(); (freeIt != m_freeBlocks.end()) && sizeDiff; ++freeIt)
+        {
+            if (freeIt->second < count) continue;
+
+            if (const auto diff = freeIt->second - count; diff < sizeDiff)
+            {
+                it = freeIt;
+                sizeDiff = diff;
+            }
+        }
+
+        if (it == m_freeBlocks.end())
+        {
+            const auto result = m_size;
+            m_size += count;
+            return result;
+        }
+
+        const auto result = it->first + it->second - count;
+        it->second -= count;
+        if (it->second == 0u) m_freeBlocks.erase(it);
+
+        return result;
+    }
+
+    void free(size_t offset, size_t count)
+    {
+        auto iter = m_freeBlocks.insert({offset, count}).first;
+
+        if (auto nextIter = std::next(iter); (nextIter != m_freeBlocks.end()) && (iter->first + iter->second == nextIter->first))
+        {
+            iter->second += nextIter->second;
+            m_freeBlocks.erase(nextIter);
+        }
+
+        if (iter != m_freeBlocks.begin())
+        {
+            if (auto prevIter = std::prev(iter); prevIter->first + prevIter->second == iter->first)
+            {
+                prevIter->second += iter->second;
+                m_freeBlocks.erase(iter);
+            }
+        }
+
+        if (auto lastIter = std::prev(m_freeBlocks.end()); lastIter->first + lastIter->second == m_size)
+        {
+            m_size = lastIter->first;
+            m_freeBlocks.erase(lastIter);
+        }
+    }
+
+    size_t size() const { return m_size; }
+
+private:
+    size_t m_size = 0u;
+    std::map<size_t, size_t> m_freeBlocks;
+};
+
+template <typename Allocator>
+static void benchmarkAllocator(const std::string& name, size_t numOperations)
+{
+    std::mt19937 generator(0u);
+    std::uniform_int_distribution<size_t> countDistribution(1u, 4096u);
+
+    std::vector<std::pair<size_t, size_t>> allocations;
+    allocations.reserve(numOperations);
+
+    Allocator allocator;
+    size_t maxSize = 0u;
+
+    const auto startTime = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0u; i < numOperations; ++i)
+    {
+        // allocations are a bit more frequent than frees, so the number of live ranges grows as in a streaming scene
+        if (allocations.empty() || (generator() % 8u < 5u))
+        {
+            const auto count = countDistribution(generator);
+            allocations.push_back({allocator.allocate(count), count});
+            maxSize = std::max(maxSize, allocator.size());
+        }
+        else
+        {
+            const auto index = generator() % allocations.size();
+            allocator.free(allocations[index].first, allocations[index].second);
+            allocations[index] = allocations.back();
+            allocations.pop_back();
+        }
+    }
+    const auto time = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime).count();
+
+    size_t allocatedSize = 0u;
+    for (const auto& allocation : allocations)
+        allocatedSize += allocation.second;
+
+    LOG_INFO << name << ": " << static_cast<uint64_t>(numOperations) << " operations in " << time << " s ("
+             << (time > 0. ? static_cast<double>(numOperations) / time : 0.) << " ops/s), live ranges "
+             << static_cast<uint64_t>(allocations.size()) << ", fragmentation "
+             << (allocator.size() ? 100. * static_cast<double>(allocator.size() - allocatedSize) / static_cast<double>(allocator.size()) : 0.)
+             << "%, max size " << static_cast<uint64_t>(maxSize);
+}
+
+int main(int argc, char* argv[])
+{
+    static const size_t numOperations = 1000000u;
+
+    // both allocators run the same sequence of operations, so the numbers are comparable
+    benchmarkAllocator<simplex::utils::TLSFAllocator>("TLSF", numOperations);
+    benchmarkAllocator<BestFitAllocator>("Best fit", numOperations);
+
+    return 0;
+}
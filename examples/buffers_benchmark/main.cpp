@@ -0,0 +1,78 @@
+#include <chrono>
+#include <vector>
+
+#include <utils/logger.h>
+
+#include <core/applicationbase.h>
+#include <core/graphicsengine.h>
+#include <core/graphicsrendererbase.h>
+
+#include <graphics_glfw/glfwwidget.h>
+
+static void waitGPU(const std::shared_ptr<simplex::core::graphics::IDynamicBuffer>& buffer)
+{
+    // reading from the buffer waits for all the commands that use it
+    buffer->map(simplex::core::graphics::IBuffer::MapAccess::ReadOnly, 0u, 1u);
+}
+
+static void benchmarkBuffer(const std::shared_ptr<simplex::core::graphics::RendererBase>& renderer, size_t bufferSize)
+{
+    static const size_t chunkSize = 4u * 1024u;
+    static const size_t numIterations = 256u;
+
+    std::vector<uint8_t> chunk(chunkSize, 0xFFu);
+
+    auto buffer = renderer->createDynamicBuffer(bufferSize);
+    buffer->reserve(bufferSize + chunkSize * numIterations);
+    waitGPU(buffer);
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0u; i < numIterations; ++i)
+        buffer->insert(buffer->size() / 2u, chunk.data(), chunkSize);
+    waitGPU(buffer);
+    auto insertTime = std::chrono::high_resolution_clock::now() - startTime;
+
+    startTime = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0u; i < numIterations; ++i)
+        buffer->erase(buffer->size() / 2u, chunkSize);
+    waitGPU(buffer);
+    auto eraseTime = std::chrono::high_resolution_clock::now() - startTime;
+
+    auto opsPerSecond = [](const std::chrono::high_resolution_clock::duration& duration)
+    {
+        const auto seconds = std::chrono::duration<double>(duration).count();
+        return seconds > 0. ? static_cast<double>(numIterations) / seconds : 0.;
+    };
+
+    auto movedMBPerSecond = [bufferSize](const std::chrono::high_resolution_clock::duration& duration)
+    {
+        const auto seconds = std::chrono::duration<double>(duration).count();
+        const auto movedMB = static_cast<double>(numIterations * bufferSize / 2u) / (1024. * 1024.);
+        return seconds > 0. ? movedMB / seconds : 0.;
+    };
+
+    LOG_INFO << "Buffer size " << bufferSize / (1024u * 1024u) << " MB: insert " << opsPerSecond(insertTime) << " ops/s ("
+             << movedMBPerSecond(insertTime) << " MB/s moved), erase " << opsPerSecond(eraseTime) << " ops/s ("
+             << movedMBPerSecond(eraseTime) << " MB/s moved)";
+}
+
+int main(int argc, char* argv[])
+{
+    if (!simplex::core::ApplicationBase::initialize(
+        []() { return simplex::graphics_glfw::GLFWWidget::time(); },
+        []() { simplex::graphics_glfw::GLFWWidget::pollEvents(); }
+    ))
+    {
+        LOG_CRITICAL << "Failed to initialize application";
+        return 0;
+    }
+
+    auto window = simplex::graphics_glfw::GLFWWidget::getOrCreate("Buffers benchmark");
+    auto renderer = window->graphicsEngine()->graphicsRenderer();
+    renderer->makeCurrent();
+
+    for (size_t bufferSizeMB : {1u, 10u, 50u, 100u})
+        benchmarkBuffer(renderer, bufferSizeMB * 1024u * 1024u);
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include <chrono>
+
+#include <utils/logger.h>
+#include <utils/mesh.h>
+#include <utils/meshpainter.h>
+#include <utils/range.h>
+#include <utils/transform.h>
+
+#include <core/applicationbase.h>
+#include <core/cameranode.h>
+#include <core/drawable.h>
+#include <core/drawablenode.h>
+#include <core/graphicsengine.h>
+#include <core/graphicsrendererbase.h>
+#include <core/material.h>
+#include <core/mesh.h>
+#include <core/pointlightnode.h>
+#include <core/scene.h>
+#include <core/scenerootnode.h>
+
+#include <graphics_headless/headlesswidget.h>
+
+// Runs the render pipeline on the headless renderer, so no GPU is needed, and logs the CPU time of a frame
+// with the commands and the buffer traffic the renderer was asked for.
+
+static const uint32_t s_gridSize = 100u;
+static const uint32_t s_lightsGridSize = 10u;
+static const uint32_t s_numWarmUpFrames = 10u;
+static const uint32_t s_numFrames = 200u;
+
+static std::weak_ptr<simplex::graphics_headless::HeadlessWidget> s_widget;
+static uint32_t s_frameIndex = 0u;
+static std::chrono::high_resolution_clock::time_point s_frameStartTime;
+static double s_CPUTime = 0.;
+static simplex::graphics_headless::HeadlessFrameRecord s_totalFrameRecord;
+
+static std::shared_ptr<simplex::core::Scene> createScene(const std::shared_ptr<simplex::core::graphics::RendererBase>& renderer)
+{
+    renderer->makeCurrent();
+
+    auto scene = simplex::core::Scene::createEmpty("HeadlessBenchmarkScene");
+
+    auto cameraNode = std::make_shared<simplex::core::CameraNode>("");
+    cameraNode->setTransform(
+        simplex::utils::Transform::makeTranslation(glm::vec3(0.f, 30.f, 60.f)) *
+        simplex::utils::Transform::makeRotation(glm::quat(glm::vec3(-.5f, 0.f, 0.f))));
+    scene->sceneRootNode()->attach(cameraNode);
+
+    simplex::utils::MeshPainter painter(simplex::utils::Mesh::createEmptyMesh(
+        {{simplex::utils::VertexAttribute::Position, {3u, simplex::utils::VertexComponentType::Single}},
+         {simplex::utils::VertexAttribute::Normal, {3u, simplex::utils::VertexComponentType::Single}}}));
+    painter.drawCube(glm::vec3(.5f));
+
+    auto drawable = std::make_shared<simplex::core::Drawable>(
+        std::make_shared<simplex::core::Mesh>(painter.mesh(), painter.calculateBoundingBox()),
+        std::make_shared<simplex::core::Material>());
+
+    for (uint32_t x = 0u; x < s_gridSize; ++x)
+        for (uint32_t z = 0u; z < s_gridSize; ++z)
+        {
+            auto drawableNode = std::make_shared<simplex::core::DrawableNode>("");
+            drawableNode->setTransform(simplex::utils::Transform::makeTranslation(
+                glm::vec3(static_cast<float>(x) - .5f * s_gridSize, 0.f, static_cast<float>(z) - .5f * s_gridSize)));
+            drawableNode->addDrawable(drawable);
+            scene->sceneRootNode()->attach(drawableNode);
+        }
+
+    const auto lightsStep = static_cast<float>(s_gridSize) / static_cast<float>(s_lightsGridSize);
+    for (uint32_t x = 0u; x < s_lightsGridSize; ++x)
+        for (uint32_t z = 0u; z < s_lightsGridSize; ++z)
+        {
+            auto pointLightNode = std::make_shared<simplex::core::PointLightNode>("");
+            pointLightNode->setTransform(simplex::utils::Transform::makeTranslation(
+                glm::vec3((static_cast<float>(x) + .5f) * lightsStep - .5f * s_gridSize, 2.f,
+                          (static_cast<float>(z) + .5f) * lightsStep - .5f * s_gridSize)));
+            pointLightNode->setRadiuses(simplex::utils::Range(.5f, lightsStep));
+            scene->sceneRootNode()->attach(pointLightNode);
+        }
+
+    return scene;
+}
+
+static void updateCallback(uint64_t, uint32_t)
+{
+    s_frameStartTime = std::chrono::high_resolution_clock::now();
+}
+
+static void pollEvents()
+{
+    auto& app = simplex::core::ApplicationBase::instance();
+
+    // the record of the frame is valid until the next frame starts
+    if (auto widget = s_widget.lock(); widget && (s_frameIndex >= s_numWarmUpFrames))
+    {
+        s_CPUTime +=
+            std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - s_frameStartTime).count();
+
+        const auto& frameRecord = widget->lastFrameRecord();
+        s_totalFrameRecord.numDraws += frameRecord.numDraws;
+        s_totalFrameRecord.numDispatches += frameRecord.numDispatches;
+        s_totalFrameRecord.numBytesUploaded += frameRecord.numBytesUploaded;
+        s_totalFrameRecord.numBytesRead += frameRecord.numBytesRead;
+        s_totalFrameRecord.numBytesCopied += frameRecord.numBytesCopied;
+        s_totalFrameRecord.numTextureBytesUploaded += frameRecord.numTextureBytesUploaded;
+    }
+
+    if (++s_frameIndex == s_numWarmUpFrames + s_numFrames)
+    {
+        LOG_INFO << s_gridSize * s_gridSize << " drawables, " << s_lightsGridSize * s_lightsGridSize << " point lights: CPU "
+                 << s_CPUTime / s_numFrames << " ms, " << s_totalFrameRecord.numDraws / s_numFrames << " draws, "
+                 << s_totalFrameRecord.numDispatches / s_numFrames << " dispatches, "
+                 << s_totalFrameRecord.numBytesUploaded / s_numFrames << " bytes uploaded, "
+                 << s_totalFrameRecord.numBytesRead / s_numFrames << " bytes read, "
+                 << s_totalFrameRecord.numBytesCopied / s_numFrames << " bytes copied, "
+                 << s_totalFrameRecord.numTextureBytesUploaded / s_numFrames << " texture bytes uploaded per frame";
+
+        app.stop();
+    }
+
+    simplex::graphics_headless::HeadlessWidget::pollEvents();
+}
+
+int main(int argc, char* argv[])
+{
+    if (!simplex::core::ApplicationBase::initialize(
+            []() { return simplex::graphics_headless::HeadlessWidget::time(); }, pollEvents))
+    {
+        LOG_CRITICAL << "Failed to initialize application";
+        return 0;
+    }
+
+    auto widget = simplex::graphics_headless::HeadlessWidget::getOrCreate("Headless benchmark");
+    widget->setUpdateCallback(updateCallback);
+    s_widget = widget;
+
+    auto& app = simplex::core::ApplicationBase::instance();
+    app.setScene(createScene(widget->graphicsEngine()->graphicsRenderer()));
+
+    app.registerDevice(widget);
+    app.run();
+    app.unregisterDevice(widget);
+
+    return 0;
+}
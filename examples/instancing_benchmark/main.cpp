@@ -0,0 +1,138 @@
+#include <chrono>
+
+#include <utils/logger.h>
+#include <utils/mesh.h>
+#include <utils/meshpainter.h>
+#include <utils/transform.h>
+
+#include <core/applicationbase.h>
+#include <core/cameranode.h>
+#include <core/drawable.h>
+#include <core/drawablenode.h>
+#include <core/graphicsengine.h>
+#include <core/graphicsrendererbase.h>
+#include <core/material.h>
+#include <core/mesh.h>
+#include <core/scene.h>
+#include <core/scenerootnode.h>
+
+#include <graphics_headless/headlesswidget.h>
+
+// Renders a grid of the same drawable on the headless renderer and logs the CPU time of a frame with the commands
+// the renderer was asked for, first with the auto instancing and then with one command per draw data.
+
+static const uint32_t s_gridSize = 317u; // ~100k instances
+static const uint32_t s_numWarmUpFrames = 60u;
+static const uint32_t s_numFrames = 600u;
+
+static std::weak_ptr<simplex::graphics_headless::HeadlessWidget> s_widget;
+static std::weak_ptr<simplex::core::CameraNode> s_cameraNode;
+static bool s_isAutoInstancingEnabled = true;
+static uint32_t s_frameIndex = 0u;
+static std::chrono::high_resolution_clock::time_point s_frameStartTime;
+static double s_CPUTime = 0.;
+static simplex::graphics_headless::HeadlessFrameRecord s_totalFrameRecord;
+
+static std::shared_ptr<simplex::core::Scene> createScene(const std::shared_ptr<simplex::core::graphics::RendererBase>& renderer)
+{
+    renderer->makeCurrent();
+
+    auto scene = simplex::core::Scene::createEmpty("InstancingBenchmarkScene");
+
+    auto cameraNode = std::make_shared<simplex::core::CameraNode>("");
+    cameraNode->setTransform(
+        simplex::utils::Transform::makeTranslation(glm::vec3(0.f, 60.f, 120.f)) *
+        simplex::utils::Transform::makeRotation(glm::quat(glm::vec3(-.5f, 0.f, 0.f))));
+    scene->sceneRootNode()->attach(cameraNode);
+    s_cameraNode = cameraNode;
+
+    simplex::utils::MeshPainter painter(simplex::utils::Mesh::createEmptyMesh(
+        {{simplex::utils::VertexAttribute::Position, {3u, simplex::utils::VertexComponentType::Single}},
+         {simplex::utils::VertexAttribute::Normal, {3u, simplex::utils::VertexComponentType::Single}}}));
+    painter.drawCube(glm::vec3(.5f));
+
+    auto mesh = std::make_shared<simplex::core::Mesh>(painter.mesh(), painter.calculateBoundingBox());
+    auto material = std::make_shared<simplex::core::Material>();
+    auto drawable = std::make_shared<simplex::core::Drawable>(mesh, material);
+
+    for (uint32_t x = 0u; x < s_gridSize; ++x)
+        for (uint32_t z = 0u; z < s_gridSize; ++z)
+        {
+            auto drawableNode = std::make_shared<simplex::core::DrawableNode>("");
+            drawableNode->setTransform(simplex::utils::Transform::makeTranslation(
+                glm::vec3(static_cast<float>(x) - .5f * s_gridSize, 0.f, static_cast<float>(z) - .5f * s_gridSize)));
+            drawableNode->addDrawable(drawable);
+            scene->sceneRootNode()->attach(drawableNode);
+        }
+
+    return scene;
+}
+
+static void updateCallback(uint64_t, uint32_t)
+{
+    s_frameStartTime = std::chrono::high_resolution_clock::now();
+}
+
+static void pollEvents()
+{
+    auto& app = simplex::core::ApplicationBase::instance();
+
+    // the record of the frame is valid until the next frame starts
+    if (auto widget = s_widget.lock(); widget && (s_frameIndex >= s_numWarmUpFrames))
+    {
+        s_CPUTime +=
+            std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - s_frameStartTime).count();
+
+        const auto& frameRecord = widget->lastFrameRecord();
+        s_totalFrameRecord.numDraws += frameRecord.numDraws;
+        s_totalFrameRecord.numDispatches += frameRecord.numDispatches;
+        s_totalFrameRecord.numBytesUploaded += frameRecord.numBytesUploaded;
+        s_totalFrameRecord.numBytesCopied += frameRecord.numBytesCopied;
+    }
+
+    if (++s_frameIndex == s_numWarmUpFrames + s_numFrames)
+    {
+        LOG_INFO << static_cast<uint64_t>(s_gridSize * s_gridSize) << " draw data, auto instancing "
+                 << (s_isAutoInstancingEnabled ? "on" : "off") << ": CPU " << s_CPUTime / s_numFrames << " ms, "
+                 << s_totalFrameRecord.numDraws / s_numFrames << " draws, "
+                 << s_totalFrameRecord.numDispatches / s_numFrames << " dispatches, "
+                 << s_totalFrameRecord.numBytesUploaded / s_numFrames << " bytes uploaded, "
+                 << s_totalFrameRecord.numBytesCopied / s_numFrames << " bytes copied per frame";
+
+        s_frameIndex = 0u;
+        s_CPUTime = 0.;
+        s_totalFrameRecord = {};
+
+        // the same scene is measured again without the instancing, the passes are recreated during the warm up frames
+        s_isAutoInstancingEnabled = !s_isAutoInstancingEnabled;
+        if (s_isAutoInstancingEnabled)
+            app.stop();
+        else if (auto cameraNode = s_cameraNode.lock())
+            cameraNode->setAutoInstancingEnabled(false);
+    }
+
+    simplex::graphics_headless::HeadlessWidget::pollEvents();
+}
+
+int main(int argc, char* argv[])
+{
+    if (!simplex::core::ApplicationBase::initialize(
+            []() { return simplex::graphics_headless::HeadlessWidget::time(); }, pollEvents))
+    {
+        LOG_CRITICAL << "Failed to initialize application";
+        return 0;
+    }
+
+    auto widget = simplex::graphics_headless::HeadlessWidget::getOrCreate("Instancing benchmark");
+    widget->setUpdateCallback(updateCallback);
+    s_widget = widget;
+
+    auto& app = simplex::core::ApplicationBase::instance();
+    app.setScene(createScene(widget->graphicsEngine()->graphicsRenderer()));
+
+    app.registerDevice(widget);
+    app.run();
+    app.unregisterDevice(widget);
+
+    return 0;
+}
@@ -0,0 +1,159 @@
+#include <array>
+#include <cstdlib>
+#include <string>
+#include <unordered_set>
+
+#include <utils/logger.h>
+#include <utils/mesh.h>
+#include <utils/meshpainter.h>
+#include <utils/range.h>
+#include <utils/transform.h>
+
+#include <core/applicationbase.h>
+#include <core/cameranode.h>
+#include <core/debuginformation.h>
+#include <core/drawable.h>
+#include <core/drawablenode.h>
+#include <core/graphicsengine.h>
+#include <core/graphicsrendererbase.h>
+#include <core/material.h>
+#include <core/mesh.h>
+#include <core/pointlightnode.h>
+#include <core/scene.h>
+#include <core/scenerootnode.h>
+
+#include <graphics_glfw/glfwwidget.h>
+
+// Renders a floor lit by 1k, 10k and 50k point lights and logs the GPU time of the light culling passes for each count,
+// first with the light binning and then with the tests of all the local lights in every cluster.
+
+static const std::array<uint32_t, 3u> s_lightsCounts{1000u, 10000u, 50000u};
+static const uint32_t s_numWarmUpFrames = 60u;
+static const uint32_t s_numFrames = 300u;
+
+static const std::unordered_set<std::string> s_lightCullingPassesNames{
+    "ClearLightMasksPass",
+    "PrepareClusterLocalLightsCommandPass",
+    "BinClusterLocalLightsPass",
+    "ClusterLocalLightPass",
+    "ClusterLightIndicesOffsetsPass",
+    "FillClusterLightIndicesPass"};
+
+static std::weak_ptr<simplex::graphics_glfw::GLFWWidget> s_window;
+static std::weak_ptr<simplex::core::CameraNode> s_cameraNode;
+static size_t s_lightsCountIndex = 0u;
+static bool s_isLightBinningEnabled = true;
+static uint32_t s_frameIndex = 0u;
+static double s_lightCullingGPUTime = 0.;
+static double s_GPUTime = 0.;
+
+static float randRange(float start, float end)
+{
+    return glm::mix(start, end, static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX));
+}
+
+static std::shared_ptr<simplex::core::Scene> createScene(
+    uint32_t lightsCount,
+    const std::shared_ptr<simplex::core::graphics::RendererBase>& renderer)
+{
+    renderer->makeCurrent();
+    std::srand(0u);
+
+    auto scene = simplex::core::Scene::createEmpty("LightCullingBenchmarkScene" + std::to_string(lightsCount));
+
+    auto cameraNode = std::make_shared<simplex::core::CameraNode>("");
+    cameraNode->setTransform(
+        simplex::utils::Transform::makeTranslation(glm::vec3(0.f, 20.f, 60.f)) *
+        simplex::utils::Transform::makeRotation(glm::quat(glm::vec3(-.4f, 0.f, 0.f))));
+    cameraNode->setLightBinningEnabled(s_isLightBinningEnabled);
+    scene->sceneRootNode()->attach(cameraNode);
+    s_cameraNode = cameraNode;
+
+    simplex::utils::MeshPainter painter(simplex::utils::Mesh::createEmptyMesh(
+        {{simplex::utils::VertexAttribute::Position, {3u, simplex::utils::VertexComponentType::Single}},
+         {simplex::utils::VertexAttribute::Normal, {3u, simplex::utils::VertexComponentType::Single}}}));
+    painter.drawCube(glm::vec3(200.f, .1f, 200.f));
+
+    auto floorNode = std::make_shared<simplex::core::DrawableNode>("");
+    floorNode->addDrawable(std::make_shared<simplex::core::Drawable>(
+        std::make_shared<simplex::core::Mesh>(painter.mesh(), painter.calculateBoundingBox()),
+        std::make_shared<simplex::core::Material>()));
+    scene->sceneRootNode()->attach(floorNode);
+
+    for (uint32_t i = 0u; i < lightsCount; ++i)
+    {
+        auto pointLightNode = std::make_shared<simplex::core::PointLightNode>("");
+        pointLightNode->setTransform(simplex::utils::Transform::makeTranslation(
+            glm::vec3(randRange(-100.f, 100.f), randRange(.5f, 10.f), randRange(-100.f, 100.f))));
+        pointLightNode->setRadiuses(simplex::utils::Range(.5f, randRange(1.f, 3.f)));
+        pointLightNode->setColor(glm::vec3(randRange(.3f, 5.f), randRange(.3f, 5.f), randRange(.3f, 5.f)));
+        scene->sceneRootNode()->attach(pointLightNode);
+    }
+
+    return scene;
+}
+
+static void pollEvents()
+{
+    // the debug information of the frame is valid until the next frame starts
+    auto& app = simplex::core::ApplicationBase::instance();
+    if ((s_frameIndex >= s_numWarmUpFrames) && !app.debugInformation().scenesInformation.empty())
+    {
+        for (const auto& cameraInformation : app.debugInformation().scenesInformation.front().camerasInformation)
+        {
+            s_GPUTime += static_cast<double>(cameraInformation.GPUTime);
+            for (const auto& renderPassInformation : cameraInformation.renderPassesInformation)
+                if (s_lightCullingPassesNames.count(renderPassInformation.renderPassName))
+                    s_lightCullingGPUTime += static_cast<double>(renderPassInformation.GPUTime);
+        }
+    }
+
+    if (++s_frameIndex == s_numWarmUpFrames + s_numFrames)
+    {
+        LOG_INFO << s_lightsCounts[s_lightsCountIndex] << " point lights, "
+                 << (s_isLightBinningEnabled ? "binning" : "brute force") << ": light culling GPU "
+                 << s_lightCullingGPUTime / s_numFrames << " ms, total GPU " << s_GPUTime / s_numFrames << " ms per frame";
+
+        s_frameIndex = 0u;
+        s_lightCullingGPUTime = 0.;
+        s_GPUTime = 0.;
+
+        // the same scene is measured again without the binning, the passes are recreated during the warm up frames
+        s_isLightBinningEnabled = !s_isLightBinningEnabled;
+        if (!s_isLightBinningEnabled)
+        {
+            if (auto cameraNode = s_cameraNode.lock()) cameraNode->setLightBinningEnabled(false);
+        }
+        else if (++s_lightsCountIndex == s_lightsCounts.size())
+        {
+            app.stop();
+        }
+        else if (auto window = s_window.lock())
+        {
+            app.setScene(createScene(s_lightsCounts[s_lightsCountIndex], window->graphicsEngine()->graphicsRenderer()));
+        }
+    }
+
+    simplex::graphics_glfw::GLFWWidget::pollEvents();
+}
+
+int main(int argc, char* argv[])
+{
+    if (!simplex::core::ApplicationBase::initialize([]() { return simplex::graphics_glfw::GLFWWidget::time(); }, pollEvents))
+    {
+        LOG_CRITICAL << "Failed to initialize application";
+        return 0;
+    }
+
+    auto window = simplex::graphics_glfw::GLFWWidget::getOrCreate("Light culling benchmark");
+    s_window = window;
+
+    auto& app = simplex::core::ApplicationBase::instance();
+    app.setScene(createScene(s_lightsCounts[s_lightsCountIndex], window->graphicsEngine()->graphicsRenderer()));
+
+    app.registerDevice(window);
+    app.run();
+    app.unregisterDevice(window);
+
+    return 0;
+}
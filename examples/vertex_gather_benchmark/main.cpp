@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <utils/logger.h>
+#include <utils/mesh.h>
+
+// the same layout as core::PositionNormalTexCoordsDataDescription
+struct Vertex
+{
+    float position[3];
+    float normal[3];
+    float texCoords[2];
+};
+
+static std::shared_ptr<simplex::utils::VertexBuffer> makeBuffer(
+    size_t numVertices,
+    uint32_t numComponents,
+    simplex::utils::VertexComponentType type)
+{
+    auto result = std::make_shared<simplex::utils::VertexBuffer>(numVertices, numComponents, type);
+    auto* data = result->data();
+    for (size_t i = 0u; i < result->sizeInBytes(); ++i)
+        data[i] = static_cast<uint8_t>(i * 31u);
+    return result;
+}
+
+// the path which was used by core::SceneData before the gathering: the converted copy of the buffer and the memcpy per vertex
+static void interleaveByCopy(const simplex::utils::VertexBuffer& buffer, uint32_t numComponents, size_t offset, Vertex* dst)
+{
+    std::shared_ptr<const simplex::utils::VertexBuffer> converted = buffer.converted(numComponents, buffer.componentType());
+    auto* data = reinterpret_cast<uint8_t*>(dst) + offset;
+    for (size_t i = 0u; i < converted->numVertices(); ++i)
+        std::memcpy(data + i * sizeof(Vertex), converted->vertex(i), numComponents * sizeof(float));
+}
+
+static void gather(
+    const simplex::utils::VertexBuffer& buffer,
+    uint32_t numComponents,
+    size_t offset,
+    Vertex* dst,
+    size_t numThreads)
+{
+    const auto numVertices = buffer.numVertices();
+    const auto countPerThread = (numVertices + numThreads - 1u) / numThreads;
+
+    auto func = [&](size_t first)
+    {
+        auto* data = reinterpret_cast<uint8_t*>(dst + first) + offset;
+        buffer.gather(first, std::min(countPerThread, numVertices - first), numComponents,
+                      simplex::utils::VertexComponentType::Single, data, sizeof(Vertex));
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t first = countPerThread; first < numVertices; first += countPerThread)
+        threads.emplace_back(func, first);
+    func(0u);
+    for (auto& thread : threads)
+        thread.join();
+}
+
+static void benchmark(
+    const std::string& name,
+    size_t numVertices,
+    simplex::utils::VertexComponentType type,
+    const std::function<void(const simplex::utils::VertexBuffer&, uint32_t, size_t, Vertex*)>& func)
+{
+    static const size_t numIterations = 10u;
+
+    const auto positions = makeBuffer(numVertices, 3u, type);
+    const auto normals = makeBuffer(numVertices, 3u, type);
+    const auto texCoords = makeBuffer(numVertices, 2u, type);
+    std::vector<Vertex> vertices(numVertices);
+
+    const auto startTime = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0u; i < numIterations; ++i)
+    {
+        func(*positions, 3u, offsetof(Vertex, position), vertices.data());
+        func(*normals, 3u, offsetof(Vertex, normal), vertices.data());
+        func(*texCoords, 2u, offsetof(Vertex, texCoords), vertices.data());
+    }
+    const auto time = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime).count() /
+                      static_cast<double>(numIterations);
+
+    LOG_INFO << name << ": " << static_cast<uint64_t>(numVertices) << " vertices in " << time * 1000. << " ms ("
+             << (time > 0. ? static_cast<double>(numVertices) / time / 1000000. : 0.) << " Mvertices/s)";
+}
+
+int main(int argc, char* argv[])
+{
+    static const size_t numVertices = 4000000u;
+    const size_t numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    using simplex::utils::VertexComponentType;
+
+    benchmark("Copy, float", numVertices, VertexComponentType::Single, interleaveByCopy);
+    benchmark("Gather, float", numVertices, VertexComponentType::Single,
+              [](auto& buffer, auto numComponents, auto offset, auto dst) { gather(buffer, numComponents, offset, dst, 1u); });
+    benchmark("Gather " + std::to_string(numThreads) + " threads, float", numVertices, VertexComponentType::Single,
+              [numThreads](auto& buffer, auto numComponents, auto offset, auto dst)
+              { gather(buffer, numComponents, offset, dst, numThreads); });
+
+    // the copy path can't convert these types to float
+    for (const auto& [typeName, type] : {std::make_pair(std::string("double"), VertexComponentType::Double),
+                                          std::make_pair(std::string("int16"), VertexComponentType::Int16),
+                                          std::make_pair(std::string("uint8"), VertexComponentType::Uint8)})
+    {
+        benchmark("Gather, " + typeName, numVertices, type,
+                  [](auto& buffer, auto numComponents, auto offset, auto dst)
+                  { gather(buffer, numComponents, offset, dst, 1u); });
+        benchmark("Gather " + std::to_string(numThreads) + " threads, " + typeName, numVertices, type,
+                  [numThreads](auto& buffer, auto numComponents, auto offset, auto dst)
+                  { gather(buffer, numComponents, offset, dst, numThreads); });
+    }
+
+    return 0;
+}
@@ -1,5 +1,6 @@
 ﻿#include <array>
 #include <functional>
+#include <regex>
 
 // #define GLAD_GL_IMPLEMENTATION
 #include <glad/gl.h>
@@ -12,6 +13,7 @@
 #include <utils/shader.h>
 
 #include <core/drawable.h>
+#include <core/settings.h>
 #include <core/uniform.h>
 
 #include <GLFW/glfw3.h>
@@ -539,6 +541,135 @@ GLenum Conversions::ClipControlDepth2GL(core::graphics::ClipControlDepth value)
     return s_table[core::graphics::castFromClipControlDepth(value)];
 }
 
+// StagingBuffer_4_5
+
+static std::shared_ptr<GLFWRenderer> currentGLFWRenderer()
+{
+    return std::dynamic_pointer_cast<GLFWRenderer>(core::graphics::RendererBase::current());
+}
+
+StagingBuffer_4_5::StagingBuffer_4_5(size_t size)
+    : m_size(size)
+{
+    static constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    glCreateBuffers(1, &m_id);
+    glNamedBufferStorage(m_id, static_cast<GLsizeiptr>(m_size), nullptr, flags);
+    m_data = static_cast<uint8_t*>(glMapNamedBufferRange(m_id, 0, static_cast<GLsizeiptr>(m_size), flags));
+
+    if (!m_data) LOG_CRITICAL << "Failed to map staging buffer";
+}
+
+StagingBuffer_4_5::~StagingBuffer_4_5()
+{
+    for (auto& fence : m_fences)
+        glDeleteSync(fence.sync);
+
+    glUnmapNamedBuffer(m_id);
+    glDeleteBuffers(1, &m_id);
+}
+
+size_t StagingBuffer_4_5::size() const
+{
+    return m_size;
+}
+
+uint8_t* StagingBuffer_4_5::allocate(size_t size, size_t& offset)
+{
+    static constexpr size_t Alignment = 16u;
+
+    size = (size + Alignment - 1u) & ~(Alignment - 1u);
+    if (!m_data || (size > m_size)) return nullptr;
+
+    if (m_head + size > m_size)
+    {
+        // pending region must stay contiguous, so it's flushed before wrapping around
+        flush();
+        m_head = 0u;
+        m_pendingBegin = 0u;
+    }
+
+    waitFences(m_head, m_head + size);
+
+    offset = m_head;
+    m_head += size;
+
+    return m_data + offset;
+}
+
+void StagingBuffer_4_5::copy(size_t offset, GLuint dstBuffer, size_t dstOffset, size_t size)
+{
+    if (!m_copies.empty())
+    {
+        // merge with the previous copy if both source and destination ranges are adjacent
+        auto& last = m_copies.back();
+        if ((last.dstBuffer == dstBuffer) && (last.offset + last.size == offset) && (last.dstOffset + last.size == dstOffset))
+        {
+            last.size += size;
+            return;
+        }
+    }
+
+    m_copies.push_back({offset, dstBuffer, dstOffset, size});
+}
+
+void StagingBuffer_4_5::flush()
+{
+    if (m_copies.empty()) return;
+
+    auto renderer = currentGLFWRenderer();
+    for (const auto& copy : m_copies)
+    {
+        if (renderer) renderer->memoryBarriers().updateBuffer(copy.dstBuffer);
+        glCopyNamedBufferSubData(
+            m_id, copy.dstBuffer, static_cast<GLintptr>(copy.offset), static_cast<GLintptr>(copy.dstOffset),
+            static_cast<GLsizeiptr>(copy.size));
+    }
+    m_copies.clear();
+
+    m_fences.push_back({m_pendingBegin, m_head, glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)});
+    m_pendingBegin = m_head;
+
+    releaseSignaledFences();
+}
+
+std::shared_ptr<StagingBuffer_4_5> StagingBuffer_4_5::create(size_t size)
+{
+    return std::make_shared<StagingBuffer_4_5>(size);
+}
+
+void StagingBuffer_4_5::waitFences(size_t begin, size_t end)
+{
+    for (auto it = m_fences.begin(); it != m_fences.end();)
+    {
+        if ((it->begin < end) && (begin < it->end))
+        {
+            GLenum status = GL_TIMEOUT_EXPIRED;
+            while (status == GL_TIMEOUT_EXPIRED)
+                status = glClientWaitSync(it->sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000u);
+
+            if (status == GL_WAIT_FAILED) LOG_ERROR << "Failed to wait for staging buffer fence";
+
+            glDeleteSync(it->sync);
+            it = m_fences.erase(it);
+        }
+        else
+            ++it;
+    }
+}
+
+void StagingBuffer_4_5::releaseSignaledFences()
+{
+    while (!m_fences.empty())
+    {
+        auto status = glClientWaitSync(m_fences.front().sync, 0, 0u);
+        if ((status != GL_ALREADY_SIGNALED) && (status != GL_CONDITION_SATISFIED)) break;
+
+        glDeleteSync(m_fences.front().sync);
+        m_fences.pop_front();
+    }
+}
+
 // BufferBase_4_5::MappedData_4_5
 
 BufferBase_4_5::MappedData_4_5::MappedData_4_5(const std::weak_ptr<const BufferBase_4_5>& mappedBuffer, uint8_t* data)
@@ -571,11 +702,56 @@ const uint8_t* BufferBase_4_5::MappedData_4_5::get() const
     return const_cast<MappedData_4_5*>(this)->get();
 }
 
+// BufferBase_4_5::StagedData_4_5
+
+BufferBase_4_5::StagedData_4_5::StagedData_4_5(
+    const std::weak_ptr<const BufferBase_4_5>& mappedBuffer,
+    const std::weak_ptr<StagingBuffer_4_5>& stagingBuffer,
+    uint8_t* data,
+    size_t stagingOffset,
+    size_t offset,
+    size_t size)
+    : m_mappedBuffer(mappedBuffer)
+    , m_stagingBuffer(stagingBuffer)
+    , m_data(data)
+    , m_stagingOffset(stagingOffset)
+    , m_offset(offset)
+    , m_size(size)
+{
+    SAVE_CURRENT_CONTEXT;
+}
+
+BufferBase_4_5::StagedData_4_5::~StagedData_4_5()
+{
+    CHECK_CURRENT_CONTEXT;
+    if (!m_mappedBuffer.expired())
+    {
+        auto bufferBase_4_5 = m_mappedBuffer.lock();
+        if (auto stagingBuffer = m_stagingBuffer.lock())
+            stagingBuffer->copy(m_stagingOffset, bufferBase_4_5->id(), m_offset, m_size);
+        bufferBase_4_5->m_isMapped = false;
+    }
+}
+
+uint8_t* BufferBase_4_5::StagedData_4_5::get()
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_mappedBuffer.expired() ? nullptr : m_data;
+}
+
+const uint8_t* BufferBase_4_5::StagedData_4_5::get() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return const_cast<StagedData_4_5*>(this)->get();
+}
+
 // BufferBase_4_5
 
 BufferBase_4_5::~BufferBase_4_5()
 {
     CHECK_CURRENT_CONTEXT;
+    flushStagingBuffer();
+    releaseMemoryBarrier();
     glDeleteBuffers(1, &m_id);
 }
 
@@ -607,15 +783,19 @@ void BufferBase_4_5::resizeImpl(size_t newSize)
     auto oldSize = sizeImpl();
     if (oldSize == newSize) return;
 
+    flushStagingBuffer();
+    updateMemoryBarrier();
+
     GLuint newID;
     glCreateBuffers(1, &newID);
     glNamedBufferStorage(newID, newSize, nullptr, GL_DYNAMIC_STORAGE_BIT | GL_MAP_READ_BIT | GL_MAP_WRITE_BIT);
     glCopyNamedBufferSubData(m_id, newID, 0u, 0u, glm::min(oldSize, newSize));
+    releaseMemoryBarrier();
     glDeleteBuffers(1, &m_id);
     m_id = newID;
 }
 
-std::unique_ptr<BufferBase_4_5::MappedData_4_5> BufferBase_4_5::mapImpl(
+std::unique_ptr<core::graphics::IBuffer::MappedData> BufferBase_4_5::mapImpl(
     core::graphics::IBuffer::MapAccess access,
     size_t offset,
     size_t size)
@@ -629,12 +809,44 @@ std::unique_ptr<BufferBase_4_5::MappedData_4_5> BufferBase_4_5::mapImpl(
 
     m_isMapped = true;
 
+    if (access == core::graphics::IBuffer::MapAccess::WriteOnly)
+    {
+        if (auto renderer = currentGLFWRenderer())
+        {
+            auto stagingBuffer = renderer->stagingBuffer();
+            size_t stagingOffset = 0u;
+            if (auto data = stagingBuffer->allocate(size, stagingOffset))
+                return std::make_unique<StagedData_4_5>(weak_from_this(), stagingBuffer, data, stagingOffset, offset, size);
+        }
+    }
+
+    flushStagingBuffer();
+    updateMemoryBarrier();
+
+    if (access != core::graphics::IBuffer::MapAccess::WriteOnly)
+        if (auto renderer = currentGLFWRenderer()) ++renderer->frameStatistics().numGPUReadbacks;
+
     return std::make_unique<MappedData_4_5>(
         weak_from_this(),
         static_cast<uint8_t*>(glMapNamedBufferRange(
             m_id, static_cast<GLintptr>(offset), static_cast<GLsizei>(size), Conversions::BufferMapAccess2GL(access))));
 }
 
+void BufferBase_4_5::flushStagingBuffer() const
+{
+    if (auto renderer = currentGLFWRenderer()) renderer->flushStagingBuffer();
+}
+
+void BufferBase_4_5::updateMemoryBarrier() const
+{
+    if (auto renderer = currentGLFWRenderer()) renderer->memoryBarriers().updateBuffer(m_id);
+}
+
+void BufferBase_4_5::releaseMemoryBarrier() const
+{
+    if (auto renderer = currentGLFWRenderer()) renderer->memoryBarriers().releaseBuffer(m_id);
+}
+
 // StaticBuffer_4_5
 
 StaticBuffer_4_5::StaticBuffer_4_5(uint64_t size, const void* data)
@@ -755,35 +967,39 @@ void DynamicBuffer_4_5::insert(size_t offset, const void* data, size_t insertedS
         return;
     }
 
-    // the case when data is inserted to the end and it's enough memory to insert is handled separatly
-    // it's a freq-used case and no need to reallocate the memory
-    if ((offset == oldSize) && (newSize <= capacity()))
-    {
-        if (data)
-        {
-            glNamedBufferSubData(m_id, oldSize, insertedSize, data);
-        }
-    }
-    else
+    flushStagingBuffer();
+    updateMemoryBarrier();
+
+    const auto tailSize = oldSize - offset;
+
+    if (auto capacitySize = capacity(); newSize > capacitySize)
     {
+        // the memory is reallocated geometrically, so the tail is moved to its new place while copying
         GLuint newID;
         glCreateBuffers(1, &newID);
-        glNamedBufferStorage(newID, newSize, nullptr, GL_DYNAMIC_STORAGE_BIT | GL_MAP_READ_BIT | GL_MAP_WRITE_BIT);
-
-        glCopyNamedBufferSubData(m_id, newID, 0u, 0u, static_cast<GLsizeiptr>(offset));
-
-        if (data)
-        {
-            glNamedBufferSubData(newID, offset, insertedSize, data);
-        }
+        glNamedBufferStorage(
+            newID, static_cast<GLsizeiptr>(glm::max(newSize, capacitySize * 2u)), nullptr,
+            GL_DYNAMIC_STORAGE_BIT | GL_MAP_READ_BIT | GL_MAP_WRITE_BIT);
 
-        glCopyNamedBufferSubData(
-            m_id, newID, static_cast<GLintptr>(offset), static_cast<GLintptr>(offset + insertedSize),
-            static_cast<GLsizeiptr>(oldSize - offset));
+        if (offset) glCopyNamedBufferSubData(m_id, newID, 0u, 0u, static_cast<GLsizeiptr>(offset));
+        if (tailSize)
+            glCopyNamedBufferSubData(
+                m_id, newID, static_cast<GLintptr>(offset), static_cast<GLintptr>(offset + insertedSize),
+                static_cast<GLsizeiptr>(tailSize));
 
+        releaseMemoryBarrier();
         glDeleteBuffers(1, &m_id);
         m_id = newID;
     }
+    else if (tailSize)
+    {
+        moveData(offset, offset + insertedSize, tailSize);
+    }
+
+    if (data)
+    {
+        glNamedBufferSubData(m_id, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(insertedSize), data);
+    }
 
     m_size = newSize;
 }
@@ -808,18 +1024,12 @@ void DynamicBuffer_4_5::erase(size_t offset, size_t erasedSize)
         return;
     }
 
-    auto newSize = oldSize - erasedSize;
+    flushStagingBuffer();
+    updateMemoryBarrier();
 
-    GLuint newID;
-    glCreateBuffers(1, &newID);
-    glNamedBufferStorage(newID, newSize, nullptr, GL_DYNAMIC_STORAGE_BIT | GL_MAP_READ_BIT | GL_MAP_WRITE_BIT);
-    glCopyNamedBufferSubData(m_id, newID, 0u, 0u, static_cast<GLsizeiptr>(offset));
-    glCopyNamedBufferSubData(
-        m_id, newID, static_cast<GLintptr>(offset + erasedSize), static_cast<GLintptr>(offset),
-        static_cast<GLsizeiptr>(oldSize - offset - erasedSize));
-    glDeleteBuffers(1, &m_id);
-    m_id = newID;
-    m_size = newSize;
+    if (auto tailSize = oldSize - offset - erasedSize) moveData(offset + erasedSize, offset, tailSize);
+
+    m_size = oldSize - erasedSize;
 }
 
 void DynamicBuffer_4_5::resize(size_t size)
@@ -831,6 +1041,26 @@ void DynamicBuffer_4_5::resize(size_t size)
     m_size = size;
 }
 
+void DynamicBuffer_4_5::copy(size_t srcOffset, size_t dstOffset, size_t copiedSize)
+{
+    CHECK_CURRENT_CONTEXT;
+
+    if (!copiedSize) return;
+
+    const auto bufferSize = size();
+
+    if ((srcOffset + copiedSize > bufferSize) || (dstOffset + copiedSize > bufferSize))
+    {
+        LOG_ERROR << "The range of copied data is out of range";
+        return;
+    }
+
+    flushStagingBuffer();
+    updateMemoryBarrier();
+
+    moveData(srcOffset, dstOffset, copiedSize);
+}
+
 std::unique_ptr<core::graphics::IBuffer::MappedData> DynamicBuffer_4_5::map(MapAccess access, size_t offset, size_t size)
 {
     CHECK_CURRENT_CONTEXT;
@@ -866,6 +1096,38 @@ std::shared_ptr<DynamicBuffer_4_5> DynamicBuffer_4_5::create(size_t size, const
     return std::make_shared<DynamicBuffer_4_5>(size, data);
 }
 
+void DynamicBuffer_4_5::moveData(size_t srcOffset, size_t dstOffset, size_t size)
+{
+    const auto distance = (srcOffset > dstOffset) ? srcOffset - dstOffset : dstOffset - srcOffset;
+
+    // copying between overlapping ranges of the same buffer is not allowed, so it goes through the scratch buffer
+    if (distance >= size)
+    {
+        glCopyNamedBufferSubData(
+            m_id, m_id, static_cast<GLintptr>(srcOffset), static_cast<GLintptr>(dstOffset), static_cast<GLsizeiptr>(size));
+    }
+    else if (auto renderer = currentGLFWRenderer())
+    {
+        auto scratchBuffer = renderer->scratchBuffer(size);
+        glCopyNamedBufferSubData(m_id, scratchBuffer, static_cast<GLintptr>(srcOffset), 0, static_cast<GLsizeiptr>(size));
+        glCopyNamedBufferSubData(scratchBuffer, m_id, 0, static_cast<GLintptr>(dstOffset), static_cast<GLsizeiptr>(size));
+    }
+    else if (distance)
+    {
+        // no scratch buffer without the renderer, so the data is moved by the chunks that don't overlap their destinations
+        const bool isMovedForward = dstOffset > srcOffset;
+        for (size_t movedSize = 0u; movedSize < size;)
+        {
+            const auto chunkSize = glm::min(distance, size - movedSize);
+            const auto chunkOffset = isMovedForward ? size - movedSize - chunkSize : movedSize;
+            glCopyNamedBufferSubData(
+                m_id, m_id, static_cast<GLintptr>(srcOffset + chunkOffset), static_cast<GLintptr>(dstOffset + chunkOffset),
+                static_cast<GLsizeiptr>(chunkSize));
+            movedSize += chunkSize;
+        }
+    }
+}
+
 // VertexArray_4_5
 
 VertexArray_4_5::VertexArray_4_5()
@@ -878,6 +1140,9 @@ VertexArray_4_5::~VertexArray_4_5()
 {
     CHECK_CURRENT_CONTEXT;
     glDeleteVertexArrays(1, &m_id);
+
+    // deleting of the bound object resets the binding, so the cached state has to be dropped
+    if (auto renderer = currentGLFWRenderer()) renderer->renderState().invalidate();
 }
 
 GLuint VertexArray_4_5::id() const
@@ -2166,7 +2431,7 @@ ImageHandle_4_5::ImageHandle_4_5(const core::graphics::PConstImage& image)
 ImageHandle_4_5::~ImageHandle_4_5()
 {
     CHECK_CURRENT_CONTEXT;
-    glMakeImageHandleNonResidentARB(m_id);
+    doneResident();
 }
 
 core::graphics::TextureHandle ImageHandle_4_5::handle() const
@@ -2185,12 +2450,20 @@ void ImageHandle_4_5::makeResident()
 {
     CHECK_CURRENT_CONTEXT;
     glMakeImageHandleResidentARB(m_id, Conversions::ImageDataAccess2GL(m_image->access()));
+
+    if (!m_isResident && (m_image->access() != core::graphics::Image::DataAccess::ReadOnly))
+        if (auto renderer = currentGLFWRenderer()) renderer->memoryBarriers().addWritableImageHandle();
+    m_isResident = true;
 }
 
 void ImageHandle_4_5::doneResident()
 {
     CHECK_CURRENT_CONTEXT;
     glMakeImageHandleNonResidentARB(m_id);
+
+    if (m_isResident && (m_image->access() != core::graphics::Image::DataAccess::ReadOnly))
+        if (auto renderer = currentGLFWRenderer()) renderer->memoryBarriers().removeWritableImageHandle();
+    m_isResident = false;
 }
 
 std::shared_ptr<ImageHandle_4_5> ImageHandle_4_5::create(const core::graphics::PConstImage& image)
@@ -2198,6 +2471,114 @@ std::shared_ptr<ImageHandle_4_5> ImageHandle_4_5::create(const core::graphics::P
     return std::make_shared<ImageHandle_4_5>(image);
 }
 
+// TimestampQuery_4_5
+
+TimestampQuery_4_5::TimestampQuery_4_5()
+{
+    SAVE_CURRENT_CONTEXT;
+    glCreateQueries(GL_TIMESTAMP, 1, &m_id);
+}
+
+TimestampQuery_4_5::~TimestampQuery_4_5()
+{
+    CHECK_CURRENT_CONTEXT;
+    glDeleteQueries(1, &m_id);
+}
+
+void TimestampQuery_4_5::record()
+{
+    CHECK_CURRENT_CONTEXT;
+    glQueryCounter(m_id, GL_TIMESTAMP);
+}
+
+bool TimestampQuery_4_5::isAvailable() const
+{
+    CHECK_CURRENT_CONTEXT;
+    GLint result = GL_FALSE;
+    glGetQueryObjectiv(m_id, GL_QUERY_RESULT_AVAILABLE, &result);
+    return result == GL_TRUE;
+}
+
+uint64_t TimestampQuery_4_5::time() const
+{
+    CHECK_CURRENT_CONTEXT;
+    GLuint64 result = 0u;
+    glGetQueryObjectui64v(m_id, GL_QUERY_RESULT, &result);
+    return static_cast<uint64_t>(result);
+}
+
+std::shared_ptr<TimestampQuery_4_5> TimestampQuery_4_5::create()
+{
+    return std::make_shared<TimestampQuery_4_5>();
+}
+
+// BufferReadback_4_5
+
+BufferReadback_4_5::BufferReadback_4_5(size_t size)
+    : m_size(size)
+{
+    SAVE_CURRENT_CONTEXT;
+    static constexpr GLbitfield s_flags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    glCreateBuffers(1, &m_id);
+    glNamedBufferStorage(m_id, static_cast<GLsizeiptr>(m_size), nullptr, s_flags);
+    m_data = static_cast<const uint8_t*>(glMapNamedBufferRange(m_id, 0, static_cast<GLsizeiptr>(m_size), s_flags));
+}
+
+BufferReadback_4_5::~BufferReadback_4_5()
+{
+    CHECK_CURRENT_CONTEXT;
+    if (m_fence) glDeleteSync(m_fence);
+    glUnmapNamedBuffer(m_id);
+    glDeleteBuffers(1, &m_id);
+}
+
+size_t BufferReadback_4_5::size() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_size;
+}
+
+void BufferReadback_4_5::record(const core::graphics::PConstBuffer& buffer, size_t offset)
+{
+    CHECK_CURRENT_CONTEXT;
+    auto buffer_4_5 = std::dynamic_pointer_cast<const BufferBase_4_5>(buffer);
+    if (!buffer_4_5) LOG_CRITICAL << "Buffer can't be nullptr";
+    CHECK_SHARED_CONTEXTS(this, buffer_4_5);
+
+    if (auto renderer = currentGLFWRenderer())
+    {
+        renderer->flushStagingBuffer();
+        renderer->memoryBarriers().updateBuffer(buffer_4_5->id());
+    }
+
+    glCopyNamedBufferSubData(buffer_4_5->id(), m_id, static_cast<GLintptr>(offset), 0, static_cast<GLsizeiptr>(m_size));
+
+    if (m_fence) glDeleteSync(m_fence);
+    m_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+bool BufferReadback_4_5::isAvailable() const
+{
+    CHECK_CURRENT_CONTEXT;
+    if (!m_fence) return false;
+
+    GLint status = GL_UNSIGNALED;
+    glGetSynciv(m_fence, GL_SYNC_STATUS, 1, nullptr, &status);
+    return status == GL_SIGNALED;
+}
+
+const uint8_t* BufferReadback_4_5::data() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_data;
+}
+
+std::shared_ptr<BufferReadback_4_5> BufferReadback_4_5::create(size_t size)
+{
+    return std::make_shared<BufferReadback_4_5>(size);
+}
+
 // RenderBuffer_4_5
 
 RenderBuffer_4_5::RenderBuffer_4_5(uint32_t width, uint32_t height, core::graphics::PixelInternalFormat internalFormat)
@@ -2285,6 +2666,16 @@ void FrameBufferBase_4_5::clear(const std::unordered_set<core::graphics::FrameBu
 {
     CHECK_CURRENT_CONTEXT;
 
+    auto renderer = currentGLFWRenderer();
+    if (!renderer)
+    {
+        LOG_CRITICAL << "No current context";
+        return;
+    }
+
+    auto& renderState = renderer->renderState();
+    renderer->memoryBarriers().updateFramebuffer();
+
     for (auto attachment : mask)
     {
         if (!m_attachments.count(attachment)) continue;
@@ -2296,8 +2687,7 @@ void FrameBufferBase_4_5::clear(const std::unordered_set<core::graphics::FrameBu
             const GLenum drawBuffer = GL_COLOR_ATTACHMENT0 + index;
             glNamedFramebufferDrawBuffers(m_id, 1, &drawBuffer);
 
-            const GLboolean colorMask = m_colorMasks[index];
-            glColorMaski(0, colorMask, colorMask, colorMask, colorMask);
+            renderState.colorMask(0, m_colorMasks[index]);
 
             const auto& clearColor = m_clearColor[index];
             switch (clearColor.index())
@@ -2323,12 +2713,12 @@ void FrameBufferBase_4_5::clear(const std::unordered_set<core::graphics::FrameBu
         }
         else if (attachment == core::graphics::FrameBufferAttachment::DepthStencil)
         {
-            glDepthMask(m_depthMask);
+            renderState.depthMask(m_depthMask);
             glClearNamedFramebufferfi(m_id, GL_DEPTH_STENCIL, 0, m_clearDepth, m_clearStencil);
         }
         else if (attachment == core::graphics::FrameBufferAttachment::Depth)
         {
-            glDepthMask(m_depthMask);
+            renderState.depthMask(m_depthMask);
             glClearNamedFramebufferfv(m_id, GL_DEPTH, 0, &m_clearDepth);
         }
         else if (attachment == core::graphics::FrameBufferAttachment::Stencil)
@@ -2850,6 +3240,9 @@ FrameBuffer_4_5::~FrameBuffer_4_5()
 {
     CHECK_CURRENT_CONTEXT;
     glDeleteFramebuffers(1, &m_id);
+
+    // see VertexArray_4_5::~VertexArray_4_5
+    if (auto renderer = currentGLFWRenderer()) renderer->renderState().invalidate();
 }
 
 void FrameBuffer_4_5::attach(
@@ -3031,6 +3424,7 @@ ProgramBase_4_5::ProgramBase_4_5()
     , m_uniformBlockNameMaxLength(0)
     , m_bufferVariableNameMaxLength(0)
     , m_shaderStorageBlockNameMaxLength(0)
+    , m_isWritingImages(true)
 {
     SAVE_CURRENT_CONTEXT;
     m_id = glCreateProgram();
@@ -3144,6 +3538,34 @@ bool ProgramBase_4_5::compileAndLink(const std::unordered_map<GLenum, std::refer
         }
     }
 
+    if (isOk)
+    {
+        // GL doesn't reflect the access qualifiers, so they are taken from the sources.
+        // A block is read only if all the stages declare it readonly, multiline declarations are treated as writable
+        static const std::regex s_shaderStorageBlockRegex(R"(([^;{}\n]*)\bbuffer\s+(\w+)\s*\{)");
+        static const std::regex s_readOnlyRegex(R"(\breadonly\b)");
+        static const std::regex s_imageWriteRegex(R"(\b(imageStore|imageAtomic\w*)\s*\()");
+
+        std::unordered_set<std::string> readOnlyNames, writableNames;
+        m_isWritingImages = false;
+        for (const auto& [type, shader] : shadersData)
+        {
+            const auto& data = shader.get();
+            for (std::sregex_iterator it(data.begin(), data.end(), s_shaderStorageBlockRegex), end; it != end; ++it)
+            {
+                const auto qualifiers = (*it)[1u].str();
+                (std::regex_search(qualifiers, s_readOnlyRegex) ? readOnlyNames : writableNames).insert((*it)[2u].str());
+            }
+            m_isWritingImages = m_isWritingImages || std::regex_search(data, s_imageWriteRegex);
+        }
+
+        for (size_t i = 0u; i < m_shaderStorageBlocksInfo.size(); ++i)
+        {
+            const auto name = shaderStorageBlockNameByIndex(m_shaderStorageBlocksInfo[i].index);
+            m_isShaderStorageBlocksReadOnly[i] = readOnlyNames.count(name) && !writableNames.count(name);
+        }
+    }
+
     if (!isOk)
     {
         for (const auto& shaderId : shadersIds)
@@ -3153,21 +3575,77 @@ bool ProgramBase_4_5::compileAndLink(const std::unordered_map<GLenum, std::refer
     return isOk;
 }
 
-GLuint ProgramBase_4_5::id() const
+bool ProgramBase_4_5::loadBinary(const core::graphics::ProgramBinary& programBinary)
 {
     CHECK_CURRENT_CONTEXT;
-    return m_id;
-}
+    if (!m_id) LOG_CRITICAL << "Program can't be nullptr";
 
-bool ProgramBase_4_5::preBuild(std::string&)
-{
-    CHECK_CURRENT_CONTEXT;
-    return true;
-}
+    if (programBinary.data.empty()) return false;
 
-bool ProgramBase_4_5::postBuild(std::string&)
-{
-    CHECK_CURRENT_CONTEXT;
+    glProgramBinary(
+        m_id, static_cast<GLenum>(programBinary.format), programBinary.data.data(), static_cast<GLsizei>(programBinary.data.size()));
+
+    // the driver rejects binaries after updates, so it's not an error
+    GLint linked;
+    glGetProgramiv(m_id, GL_LINK_STATUS, &linked);
+    if (!linked) return false;
+
+    std::string logString;
+    if (!postBuild(logString))
+    {
+        LOG_ERROR << "Program post build: " << logString;
+        return false;
+    }
+
+    for (auto index : programBinary.readOnlyShaderStorageBlocks)
+        for (size_t i = 0u; i < m_shaderStorageBlocksInfo.size(); ++i)
+            if (m_shaderStorageBlocksInfo[i].index == index) m_isShaderStorageBlocksReadOnly[i] = true;
+    m_isWritingImages = programBinary.isWritingImages;
+
+    return true;
+}
+
+GLuint ProgramBase_4_5::id() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_id;
+}
+
+bool ProgramBase_4_5::binary(core::graphics::ProgramBinary& programBinary) const
+{
+    CHECK_CURRENT_CONTEXT;
+    GLint length = 0;
+    glGetProgramiv(m_id, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return false;
+
+    programBinary.data.resize(static_cast<size_t>(length));
+
+    GLenum format = 0u;
+    glGetProgramBinary(m_id, length, &length, &format, programBinary.data.data());
+    if (length <= 0) return false;
+
+    programBinary.format = static_cast<uint32_t>(format);
+    programBinary.data.resize(static_cast<size_t>(length));
+
+    programBinary.readOnlyShaderStorageBlocks.clear();
+    for (size_t i = 0u; i < m_shaderStorageBlocksInfo.size(); ++i)
+        if (m_isShaderStorageBlocksReadOnly[i])
+            programBinary.readOnlyShaderStorageBlocks.push_back(m_shaderStorageBlocksInfo[i].index);
+    programBinary.isWritingImages = m_isWritingImages;
+
+    return true;
+}
+
+bool ProgramBase_4_5::preBuild(std::string&)
+{
+    CHECK_CURRENT_CONTEXT;
+    glProgramParameteri(m_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    return true;
+}
+
+bool ProgramBase_4_5::postBuild(std::string&)
+{
+    CHECK_CURRENT_CONTEXT;
     auto currentRenderer = core::graphics::RendererBase::current();
     if (!currentRenderer) LOG_CRITICAL << "Graphics renderer can't be nullptr";
 
@@ -3343,6 +3821,15 @@ bool ProgramBase_4_5::postBuild(std::string&)
              static_cast<uint16_t>(shaderStorageBlockIndex), std::move(variables)});
     }
 
+    // binding points don't depend on bound buffers, so they are assigned once
+    for (size_t i = 0u; i < m_uniformBlocksInfo.size(); ++i)
+        glUniformBlockBinding(m_id, m_uniformBlocksInfo[i].index, static_cast<GLuint>(i));
+
+    for (size_t i = 0u; i < m_shaderStorageBlocksInfo.size(); ++i)
+        glShaderStorageBlockBinding(m_id, m_shaderStorageBlocksInfo[i].index, static_cast<GLuint>(i));
+
+    m_isShaderStorageBlocksReadOnly.assign(m_shaderStorageBlocksInfo.size(), false);
+
     return true;
 }
 
@@ -3370,6 +3857,18 @@ const std::vector<core::graphics::ShaderStorageBlockInfo>& ProgramBase_4_5::shad
     return m_shaderStorageBlocksInfo;
 }
 
+bool ProgramBase_4_5::isShaderStorageBlockReadOnly(size_t bindingPoint) const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_isShaderStorageBlocksReadOnly[bindingPoint];
+}
+
+bool ProgramBase_4_5::isWritingImages() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_isWritingImages;
+}
+
 std::string ProgramBase_4_5::uniformNameByIndex(uint16_t index) const
 {
     CHECK_CURRENT_CONTEXT;
@@ -3409,6 +3908,96 @@ std::string ProgramBase_4_5::shaderStorageBlockNameByIndex(uint16_t index) const
     return name.data();
 }
 
+const ProgramBase_4_5::BindingLayout& ProgramBase_4_5::bindingLayout(const core::StateSetList& stateSetList)
+{
+    static constexpr size_t MaxBindingLayoutsCount = 8u;
+
+    CHECK_CURRENT_CONTEXT;
+
+    std::vector<uint64_t> stateSetVersions;
+    stateSetVersions.reserve(stateSetList.size());
+    for (const auto& stateSet : stateSetList)
+        stateSetVersions.push_back(stateSet->version());
+
+    for (const auto& bindingLayout : m_bindingLayouts)
+        if (bindingLayout.stateSetVersions == stateSetVersions) return bindingLayout;
+
+    m_bindingLayouts.erase(
+        std::remove_if(m_bindingLayouts.begin(), m_bindingLayouts.end(), [](const auto& layout) { return layout.isExpired(); }),
+        m_bindingLayouts.end());
+    if (m_bindingLayouts.size() == MaxBindingLayoutsCount) m_bindingLayouts.pop_back();
+    auto& bindingLayout = m_bindingLayouts.emplace_front();
+    bindingLayout.stateSetVersions = std::move(stateSetVersions);
+
+    bindingLayout.uniforms.reserve(m_uniformsInfo.size());
+    bindingLayout.isUniformsSet.reserve(m_uniformsInfo.size());
+    for (const auto& uniformInfo : m_uniformsInfo)
+    {
+        core::PConstAbstractUniform abstractUniform;
+
+        for (const auto& stateSet : stateSetList)
+            if (abstractUniform = stateSet->uniform(uniformInfo.ID); abstractUniform) break;
+
+        if (!abstractUniform)
+        {
+            const auto uniformName = uniformNameByIndex(uniformInfo.index);
+            for (const auto& stateSet : stateSetList)
+                if (abstractUniform = stateSet->userUniform(uniformName); abstractUniform) break;
+        }
+
+        if (!abstractUniform) LOG_CRITICAL << "Uniform \"" << uniformNameByIndex(uniformInfo.index) << "\" has not set";
+
+        bindingLayout.uniforms.push_back(abstractUniform);
+        bindingLayout.isUniformsSet.push_back(abstractUniform != nullptr);
+    }
+
+    bindingLayout.uniformBlocks.reserve(m_uniformBlocksInfo.size());
+    bindingLayout.isUniformBlocksSet.reserve(m_uniformBlocksInfo.size());
+    for (const auto& uniformBlockInfo : m_uniformBlocksInfo)
+    {
+        core::graphics::PConstBufferRange buffer;
+
+        for (const auto& stateSet : stateSetList)
+            if (buffer = stateSet->uniformBlock(uniformBlockInfo.ID); buffer) break;
+
+        if (!buffer) LOG_CRITICAL << "Uniform block \"" << uniformBlockNameByIndex(uniformBlockInfo.index) << "\" has not set";
+
+        bindingLayout.uniformBlocks.push_back(buffer);
+        bindingLayout.isUniformBlocksSet.push_back(buffer != nullptr);
+    }
+
+    bindingLayout.shaderStorageBlocks.reserve(m_shaderStorageBlocksInfo.size());
+    bindingLayout.isShaderStorageBlocksSet.reserve(m_shaderStorageBlocksInfo.size());
+    for (const auto& shaderStorageBlockInfo : m_shaderStorageBlocksInfo)
+    {
+        core::graphics::PConstBufferRange buffer;
+
+        for (const auto& stateSet : stateSetList)
+            if (buffer = stateSet->shaderStorageBlock(shaderStorageBlockInfo.ID); buffer) break;
+
+        if (!buffer)
+            LOG_CRITICAL << "Shader storage block \"" << shaderStorageBlockNameByIndex(shaderStorageBlockInfo.index)
+                         << "\" has not set";
+
+        bindingLayout.shaderStorageBlocks.push_back(buffer);
+        bindingLayout.isShaderStorageBlocksSet.push_back(buffer != nullptr);
+    }
+
+    return bindingLayout;
+}
+
+bool ProgramBase_4_5::BindingLayout::isExpired() const
+{
+    auto isAnyResourceExpired = [](const auto& resources, const std::vector<bool>& isResourcesSet)
+    {
+        for (size_t i = 0u; i < resources.size(); ++i)
+            if (isResourcesSet[i] && resources[i].expired()) return true;
+        return false;
+    };
+    return isAnyResourceExpired(uniforms, isUniformsSet) || isAnyResourceExpired(uniformBlocks, isUniformBlocksSet) ||
+           isAnyResourceExpired(shaderStorageBlocks, isShaderStorageBlocksSet);
+}
+
 // RenderProgram_4_5
 
 RenderProgram_4_5::RenderProgram_4_5()
@@ -3555,6 +4144,12 @@ std::shared_ptr<RenderProgram_4_5> RenderProgram_4_5::create(
                : nullptr;
 }
 
+std::shared_ptr<RenderProgram_4_5> RenderProgram_4_5::create(const core::graphics::ProgramBinary& programBinary)
+{
+    auto renderProgram = std::make_shared<RenderProgram_4_5>();
+    return renderProgram->loadBinary(programBinary) ? renderProgram : nullptr;
+}
+
 // ComputeProgram_4_5
 
 ComputeProgram_4_5::ComputeProgram_4_5()
@@ -3592,18 +4187,286 @@ std::shared_ptr<ComputeProgram_4_5> ComputeProgram_4_5::create(const std::shared
                : nullptr;
 }
 
+std::shared_ptr<ComputeProgram_4_5> ComputeProgram_4_5::create(const core::graphics::ProgramBinary& programBinary)
+{
+    auto computerProgram = std::make_shared<ComputeProgram_4_5>();
+    return computerProgram->loadBinary(programBinary) ? computerProgram : nullptr;
+}
+
+// RenderState_4_5
+
+RenderState_4_5::RenderState_4_5(core::graphics::FrameStatistics& frameStatistics)
+    : m_frameStatistics(frameStatistics)
+{
+}
+
+void RenderState_4_5::invalidate()
+{
+    m_program.reset();
+    m_vertexArray.reset();
+    m_framebuffer.reset();
+    m_viewport.reset();
+
+    m_faceCulling.reset();
+    m_cullFace.reset();
+    m_colorMasks.fill(std::nullopt);
+    m_depthTest.reset();
+    m_depthFunc.reset();
+    m_depthMask.reset();
+    m_stencilTest.reset();
+    m_stencilOps.fill(std::nullopt);
+    m_stencilFuncs.fill(std::nullopt);
+    m_blending.reset();
+    m_blendColor.reset();
+    m_blendEquations.fill(std::nullopt);
+    m_blendFuncs.fill(std::nullopt);
+    m_clipDistances.fill(std::nullopt);
+}
+
+void RenderState_4_5::useProgram(GLuint value)
+{
+    if (update(m_program, value)) glUseProgram(value);
+}
+
+void RenderState_4_5::bindVertexArray(GLuint value)
+{
+    if (update(m_vertexArray, value)) glBindVertexArray(value);
+}
+
+void RenderState_4_5::bindFramebuffer(GLuint value)
+{
+    if (update(m_framebuffer, value)) glBindFramebuffer(GL_FRAMEBUFFER, value);
+}
+
+void RenderState_4_5::viewport(const glm::uvec4& value)
+{
+    if (update(m_viewport, value))
+        glViewport(
+            static_cast<GLint>(value.x), static_cast<GLint>(value.y), static_cast<GLsizei>(value.z),
+            static_cast<GLsizei>(value.w));
+}
+
+void RenderState_4_5::faceCulling(bool value)
+{
+    if (update(m_faceCulling, value)) enable(GL_CULL_FACE, value);
+}
+
+void RenderState_4_5::cullFace(GLenum value)
+{
+    if (update(m_cullFace, value)) glCullFace(value);
+}
+
+void RenderState_4_5::colorMask(GLuint index, GLboolean value)
+{
+    if (update(m_colorMasks[index], value)) glColorMaski(index, value, value, value, value);
+}
+
+void RenderState_4_5::depthTest(bool value)
+{
+    if (update(m_depthTest, value)) enable(GL_DEPTH_TEST, value);
+}
+
+void RenderState_4_5::depthFunc(GLenum value)
+{
+    if (update(m_depthFunc, value)) glDepthFunc(value);
+}
+
+void RenderState_4_5::depthMask(GLboolean value)
+{
+    if (update(m_depthMask, value)) glDepthMask(value);
+}
+
+void RenderState_4_5::stencilTest(bool value)
+{
+    if (update(m_stencilTest, value)) enable(GL_STENCIL_TEST, value);
+}
+
+void RenderState_4_5::stencilOp(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass)
+{
+    if (update(m_stencilOps[face == GL_FRONT ? 0u : 1u], std::make_tuple(sfail, dpfail, dppass)))
+        glStencilOpSeparate(face, sfail, dpfail, dppass);
+}
+
+void RenderState_4_5::stencilFunc(GLenum face, GLenum func, GLint ref, GLuint mask)
+{
+    if (update(m_stencilFuncs[face == GL_FRONT ? 0u : 1u], std::make_tuple(func, ref, mask)))
+        glStencilFuncSeparate(face, func, ref, mask);
+}
+
+void RenderState_4_5::blending(bool value)
+{
+    if (update(m_blending, value)) enable(GL_BLEND, value);
+}
+
+void RenderState_4_5::blendColor(const glm::vec4& value)
+{
+    if (update(m_blendColor, value)) glBlendColor(value.r, value.g, value.b, value.a);
+}
+
+void RenderState_4_5::blendEquation(GLuint index, GLenum color, GLenum alpha)
+{
+    if (update(m_blendEquations[index], std::make_pair(color, alpha))) glBlendEquationSeparatei(index, color, alpha);
+}
+
+void RenderState_4_5::blendFunc(GLuint index, GLenum srcColor, GLenum dstColor, GLenum srcAlpha, GLenum dstAlpha)
+{
+    if (update(m_blendFuncs[index], std::make_tuple(srcColor, dstColor, srcAlpha, dstAlpha)))
+        glBlendFuncSeparatei(index, srcColor, dstColor, srcAlpha, dstAlpha);
+}
+
+void RenderState_4_5::clipDistance(uint32_t index, bool value)
+{
+    if (update(m_clipDistances[index], value)) enable(GL_CLIP_DISTANCE0 + index, value);
+}
+
+template <typename T>
+bool RenderState_4_5::update(std::optional<T>& cachedValue, const T& value)
+{
+    if (cachedValue == value)
+    {
+        ++m_frameStatistics.numStateChangesSkipped;
+        return false;
+    }
+
+    cachedValue = value;
+    ++m_frameStatistics.numStateChangesIssued;
+    return true;
+}
+
+void RenderState_4_5::enable(GLenum cap, bool value)
+{
+    if (value)
+        glEnable(cap);
+    else
+        glDisable(cap);
+}
+
+// MemoryBarriers_4_5
+
+static constexpr GLbitfield BufferBarrierBits =
+    GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_ELEMENT_ARRAY_BARRIER_BIT | GL_UNIFORM_BARRIER_BIT | GL_COMMAND_BARRIER_BIT |
+    GL_PIXEL_BUFFER_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT | GL_TRANSFORM_FEEDBACK_BARRIER_BIT |
+    GL_ATOMIC_COUNTER_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT | GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT |
+    GL_QUERY_BUFFER_BARRIER_BIT;
+
+static constexpr GLbitfield ImageBarrierBits =
+    GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT;
+
+MemoryBarriers_4_5::MemoryBarriers_4_5(core::graphics::FrameStatistics& frameStatistics, bool isFullBarriersMode)
+    : m_frameStatistics(frameStatistics)
+    , m_isFullBarriersMode(isFullBarriersMode)
+{
+}
+
+bool MemoryBarriers_4_5::isFullBarriersMode() const
+{
+    return m_isFullBarriersMode;
+}
+
+void MemoryBarriers_4_5::readBuffer(GLuint id, GLbitfield bits)
+{
+    m_commandReads.push_back({id, bits});
+}
+
+void MemoryBarriers_4_5::writeBuffer(GLuint id)
+{
+    m_commandWrites.push_back(id);
+}
+
+void MemoryBarriers_4_5::writeImages()
+{
+    m_isCommandWritingImages = true;
+}
+
+void MemoryBarriers_4_5::writeImageHandles()
+{
+    if (m_numWritableImageHandles) m_isCommandWritingImages = true;
+}
+
+void MemoryBarriers_4_5::beginCommand()
+{
+    // images and textures are accessed through bindless handles, so any command may read what was written before
+    GLbitfield bits = m_dirtyImages & (GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT);
+
+    for (const auto& [id, readBits] : m_commandReads)
+        if (auto it = m_dirtyBuffers.find(id); it != m_dirtyBuffers.end()) bits |= it->second & readBits;
+    m_commandReads.clear();
+
+    barrier(bits);
+}
+
+void MemoryBarriers_4_5::endCommand()
+{
+    for (auto id : m_commandWrites)
+        m_dirtyBuffers[id] = BufferBarrierBits;
+    m_commandWrites.clear();
+
+    if (m_isCommandWritingImages) m_dirtyImages = ImageBarrierBits;
+    m_isCommandWritingImages = false;
+
+    if (m_isFullBarriersMode) barrier(GL_ALL_BARRIER_BITS);
+}
+
+void MemoryBarriers_4_5::updateBuffer(GLuint id)
+{
+    if (auto it = m_dirtyBuffers.find(id); it != m_dirtyBuffers.end())
+        barrier(it->second & (GL_BUFFER_UPDATE_BARRIER_BIT | GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT));
+}
+
+void MemoryBarriers_4_5::updateFramebuffer()
+{
+    barrier(m_dirtyImages & (GL_FRAMEBUFFER_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT));
+}
+
+void MemoryBarriers_4_5::releaseBuffer(GLuint id)
+{
+    m_dirtyBuffers.erase(id);
+}
+
+void MemoryBarriers_4_5::addWritableImageHandle()
+{
+    ++m_numWritableImageHandles;
+}
+
+void MemoryBarriers_4_5::removeWritableImageHandle()
+{
+    if (m_numWritableImageHandles) --m_numWritableImageHandles;
+}
+
+void MemoryBarriers_4_5::barrier(GLbitfield bits)
+{
+    if (!bits) return;
+
+    glMemoryBarrier(bits);
+    ++m_frameStatistics.numMemoryBarriers;
+
+    for (auto it = m_dirtyBuffers.begin(); it != m_dirtyBuffers.end();)
+    {
+        it->second &= ~bits;
+        if (it->second)
+            ++it;
+        else
+            it = m_dirtyBuffers.erase(it);
+    }
+
+    m_dirtyImages &= ~bits;
+}
+
 // GLFWRenderer
 
 GLFWRenderer::GLFWRenderer(const std::string& name, const std::weak_ptr<GLFWWidget>& widget)
     : core::graphics::RendererBase(name)
     , m_widget(widget)
     , m_screenSize(0u, 0u)
+    , m_renderState(frameStatistics())
+    , m_memoryBarriers(frameStatistics(), core::settings::Settings::instance().graphics().debugRendering().fullMemoryBarriers())
 {
     LOG_INFO << "Graphics renderer \"" << GLFWRenderer::name() << "\" has been created";
 }
 
 GLFWRenderer::~GLFWRenderer()
 {
+    if (m_scratchBufferID) glDeleteBuffers(1, &m_scratchBufferID);
     LOG_INFO << "Graphics renderer \"" << GLFWRenderer::name() << "\" has been destroyed";
 }
 
@@ -3647,6 +4510,7 @@ void GLFWRenderer::blitFrameBuffer(
 
     GLenum filter = linearFilter ? GL_LINEAR : GL_NEAREST;
 
+    m_memoryBarriers.updateFramebuffer();
     glBlitNamedFramebuffer(
         srcFramebuffer->id(), dstFramebuffer->id(), static_cast<GLint>(srcViewport.x), static_cast<GLint>(srcViewport.y),
         static_cast<GLint>(srcViewport.z), static_cast<GLint>(srcViewport.w), static_cast<GLint>(dstViewport.x),
@@ -3888,6 +4752,46 @@ std::shared_ptr<core::graphics::IComputeProgram> GLFWRenderer::createComputeProg
     return ComputeProgram_4_5::create(computeShader);
 }
 
+std::shared_ptr<core::graphics::ITimestampQuery> GLFWRenderer::createTimestampQuery() const
+{
+    CHECK_THIS_CONTEXT;
+    return TimestampQuery_4_5::create();
+}
+
+std::shared_ptr<core::graphics::IBufferReadback> GLFWRenderer::createBufferReadback(size_t size) const
+{
+    CHECK_THIS_CONTEXT;
+    return BufferReadback_4_5::create(size);
+}
+
+std::string GLFWRenderer::programBinaryDriverKey() const
+{
+    CHECK_THIS_CONTEXT;
+    GLint numFormats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+    if (numFormats <= 0) return std::string();
+
+    std::string result;
+    for (auto name : {GL_VENDOR, GL_RENDERER, GL_VERSION})
+        if (auto value = glGetString(name)) result += std::string(reinterpret_cast<const char*>(value)) + ";";
+
+    return result;
+}
+
+std::shared_ptr<core::graphics::IRenderProgram> GLFWRenderer::createRenderProgram(
+    const core::graphics::ProgramBinary& programBinary) const
+{
+    CHECK_THIS_CONTEXT;
+    return RenderProgram_4_5::create(programBinary);
+}
+
+std::shared_ptr<core::graphics::IComputeProgram> GLFWRenderer::createComputeProgram(
+    const core::graphics::ProgramBinary& programBinary) const
+{
+    CHECK_THIS_CONTEXT;
+    return ComputeProgram_4_5::create(programBinary);
+}
+
 void GLFWRenderer::compute(
     const glm::uvec3& numInvocations,
     const std::shared_ptr<core::graphics::IComputeProgram>& computeProgram,
@@ -3900,9 +4804,10 @@ void GLFWRenderer::compute(
 
     auto numWorkGroups =
         glm::uvec3(glm::ceil(glm::vec3(numInvocations) / glm::vec3(computeProgram->workGroupSize())) + glm::vec3(.5f));
-    glDispatchCompute(numWorkGroups.x, numWorkGroups.y, numWorkGroups.z);
 
-    glMemoryBarrier(GL_ALL_BARRIER_BITS);
+    m_memoryBarriers.beginCommand();
+    glDispatchCompute(numWorkGroups.x, numWorkGroups.y, numWorkGroups.z);
+    m_memoryBarriers.endCommand();
 }
 
 void GLFWRenderer::computeIndirect(
@@ -3916,9 +4821,9 @@ void GLFWRenderer::computeIndirect(
     setupCompute(computeProgram, stateSetList);
     bindDispatchIndirectBuffer(commandBuffer->buffer());
 
+    m_memoryBarriers.beginCommand();
     glDispatchComputeIndirect(0);
-
-    glMemoryBarrier(GL_ALL_BARRIER_BITS);
+    m_memoryBarriers.endCommand();
 }
 
 void GLFWRenderer::drawArrays(
@@ -3936,9 +4841,9 @@ void GLFWRenderer::drawArrays(
 
     setupRender(viewport, renderProgram, framebuffer, VAO, stateSetList);
 
+    m_memoryBarriers.beginCommand();
     glDrawArrays(Conversions::PrimitiveType2GL(primitiveType), static_cast<GLint>(first), static_cast<GLsizei>(count));
-
-    glMemoryBarrier(GL_ALL_BARRIER_BITS);
+    m_memoryBarriers.endCommand();
 }
 
 void GLFWRenderer::drawElements(
@@ -3957,9 +4862,11 @@ void GLFWRenderer::drawElements(
 
     setupRender(viewport, renderProgram, framebuffer, VAO, stateSetList);
 
+    m_memoryBarriers.beginCommand();
     glDrawElements(
         Conversions::PrimitiveType2GL(primitiveType), static_cast<GLsizei>(count),
         Conversions::DrawElementsIndexType2GL(indexType), reinterpret_cast<const void*>(offset));
+    m_memoryBarriers.endCommand();
 }
 
 void GLFWRenderer::multiDrawArrays(
@@ -3992,8 +4899,10 @@ void GLFWRenderer::multiDrawArrays(
 
     setupRender(viewport, renderProgram, framebuffer, VAO, stateSetList);
 
+    m_memoryBarriers.beginCommand();
     glMultiDrawArrays(
         Conversions::PrimitiveType2GL(primitiveType), GLFirsts.data(), GLCounts.data(), static_cast<GLsizei>(count));
+    m_memoryBarriers.endCommand();
 }
 
 void GLFWRenderer::multiDrawElements(
@@ -4027,9 +4936,11 @@ void GLFWRenderer::multiDrawElements(
 
     setupRender(viewport, renderProgram, framebuffer, VAO, stateSetList);
 
+    m_memoryBarriers.beginCommand();
     glMultiDrawElements(
         Conversions::PrimitiveType2GL(primitiveType), GLCounts.data(), Conversions::DrawElementsIndexType2GL(indexType),
         GLIndices.data(), static_cast<GLsizei>(count));
+    m_memoryBarriers.endCommand();
 }
 
 void GLFWRenderer::drawElementsBaseVertex(
@@ -4049,9 +4960,11 @@ void GLFWRenderer::drawElementsBaseVertex(
 
     setupRender(viewport, renderProgram, framebuffer, VAO, stateSetList);
 
+    m_memoryBarriers.beginCommand();
     glDrawElementsBaseVertex(
         Conversions::PrimitiveType2GL(primitiveType), static_cast<GLsizei>(count),
         Conversions::DrawElementsIndexType2GL(indexType), reinterpret_cast<const void*>(offset), static_cast<GLint>(baseVertex));
+    m_memoryBarriers.endCommand();
 }
 
 void GLFWRenderer::drawArraysInstanced(
@@ -4070,9 +4983,11 @@ void GLFWRenderer::drawArraysInstanced(
 
     setupRender(viewport, renderProgram, framebuffer, VAO, stateSetList);
 
+    m_memoryBarriers.beginCommand();
     glDrawArraysInstanced(
         Conversions::PrimitiveType2GL(primitiveType), static_cast<GLint>(first), static_cast<GLsizei>(count),
         static_cast<GLsizei>(numInstances));
+    m_memoryBarriers.endCommand();
 }
 
 void GLFWRenderer::drawElementsInstanced(
@@ -4092,10 +5007,12 @@ void GLFWRenderer::drawElementsInstanced(
 
     setupRender(viewport, renderProgram, framebuffer, VAO, stateSetList);
 
+    m_memoryBarriers.beginCommand();
     glDrawElementsInstanced(
         Conversions::PrimitiveType2GL(primitiveType), static_cast<GLsizei>(count),
         Conversions::DrawElementsIndexType2GL(indexType), reinterpret_cast<const void*>(offset),
         static_cast<GLsizei>(numInstances));
+    m_memoryBarriers.endCommand();
 }
 
 void GLFWRenderer::drawArraysInstancedBaseInstance(
@@ -4115,9 +5032,11 @@ void GLFWRenderer::drawArraysInstancedBaseInstance(
 
     setupRender(viewport, renderProgram, framebuffer, VAO, stateSetList);
 
+    m_memoryBarriers.beginCommand();
     glDrawArraysInstancedBaseInstance(
         Conversions::PrimitiveType2GL(primitiveType), static_cast<GLint>(first), static_cast<GLsizei>(count),
         static_cast<GLsizei>(numInstances), static_cast<GLuint>(baseInstance));
+    m_memoryBarriers.endCommand();
 }
 
 void GLFWRenderer::drawElementsInstancedBaseInstance(
@@ -4138,10 +5057,12 @@ void GLFWRenderer::drawElementsInstancedBaseInstance(
 
     setupRender(viewport, renderProgram, framebuffer, VAO, stateSetList);
 
+    m_memoryBarriers.beginCommand();
     glDrawElementsInstancedBaseInstance(
         Conversions::PrimitiveType2GL(primitiveType), static_cast<GLsizei>(count),
         Conversions::DrawElementsIndexType2GL(indexType), reinterpret_cast<const void*>(offset),
         static_cast<GLsizei>(numInstances), static_cast<GLuint>(baseInstance));
+    m_memoryBarriers.endCommand();
 }
 
 void GLFWRenderer::drawArraysIndirect(
@@ -4159,7 +5080,9 @@ void GLFWRenderer::drawArraysIndirect(
     setupRender(viewport, renderProgram, framebuffer, VAO, stateSetList);
     bindDrawIndirectBuffer(commandsBuffer->buffer());
 
+    m_memoryBarriers.beginCommand();
     glDrawArraysIndirect(Conversions::PrimitiveType2GL(primitiveType), nullptr);
+    m_memoryBarriers.endCommand();
 }
 
 void GLFWRenderer::drawElementsIndirect(
@@ -4178,8 +5101,10 @@ void GLFWRenderer::drawElementsIndirect(
     setupRender(viewport, renderProgram, framebuffer, VAO, stateSetList);
     bindDrawIndirectBuffer(commandsBuffer->buffer());
 
+    m_memoryBarriers.beginCommand();
     glDrawElementsIndirect(
         Conversions::PrimitiveType2GL(primitiveType), Conversions::DrawElementsIndexType2GL(indexType), nullptr);
+    m_memoryBarriers.endCommand();
 }
 
 void GLFWRenderer::multiDrawArraysIndirect(
@@ -4197,9 +5122,11 @@ void GLFWRenderer::multiDrawArraysIndirect(
     setupRender(viewport, renderProgram, framebuffer, VAO, stateSetList);
     bindDrawIndirectBuffer(commandsBuffer->buffer());
 
+    m_memoryBarriers.beginCommand();
     glMultiDrawArraysIndirect(
         Conversions::PrimitiveType2GL(primitiveType), nullptr, static_cast<GLsizei>(commandsBuffer->size()),
         static_cast<GLsizei>(0u));
+    m_memoryBarriers.endCommand();
 }
 
 void GLFWRenderer::multiDrawElementsIndirect(
@@ -4218,9 +5145,11 @@ void GLFWRenderer::multiDrawElementsIndirect(
     setupRender(viewport, renderProgram, framebuffer, VAO, stateSetList);
     bindDrawIndirectBuffer(commandsBuffer->buffer());
 
+    m_memoryBarriers.beginCommand();
     glMultiDrawElementsIndirect(
         Conversions::PrimitiveType2GL(primitiveType), Conversions::DrawElementsIndexType2GL(indexType), nullptr,
         static_cast<GLsizei>(commandsBuffer->size()), static_cast<GLsizei>(0u));
+    m_memoryBarriers.endCommand();
 }
 
 void GLFWRenderer::multiDrawArraysIndirectCount(
@@ -4240,9 +5169,11 @@ void GLFWRenderer::multiDrawArraysIndirectCount(
     bindDrawIndirectBuffer(commandsBuffer->buffer());
     bindParameterBuffer(parameterBuffer->buffer());
 
+    m_memoryBarriers.beginCommand();
     glMultiDrawArraysIndirectCountARB(
         Conversions::PrimitiveType2GL(primitiveType), nullptr, static_cast<GLintptr>(parameterBuffer->offset()),
         static_cast<GLsizei>(commandsBuffer->size()), static_cast<GLsizei>(0u));
+    m_memoryBarriers.endCommand();
 }
 
 void GLFWRenderer::multiDrawElementsIndirectCount(
@@ -4263,9 +5194,51 @@ void GLFWRenderer::multiDrawElementsIndirectCount(
     bindDrawIndirectBuffer(commandsBuffer->buffer());
     bindParameterBuffer(parameterBuffer->buffer());
 
+    m_memoryBarriers.beginCommand();
     glMultiDrawElementsIndirectCountARB(
         Conversions::PrimitiveType2GL(primitiveType), Conversions::DrawElementsIndexType2GL(indexType), nullptr,
         static_cast<GLintptr>(parameterBuffer->offset()), static_cast<GLsizei>(commandsBuffer->size()), static_cast<GLsizei>(0u));
+    m_memoryBarriers.endCommand();
+}
+
+std::shared_ptr<StagingBuffer_4_5> GLFWRenderer::stagingBuffer()
+{
+    static constexpr size_t StagingBufferSize = 16u * 1024u * 1024u;
+
+    CHECK_THIS_CONTEXT;
+    if (!m_stagingBuffer) m_stagingBuffer = StagingBuffer_4_5::create(StagingBufferSize);
+    return m_stagingBuffer;
+}
+
+void GLFWRenderer::flushStagingBuffer()
+{
+    if (m_stagingBuffer) m_stagingBuffer->flush();
+}
+
+RenderState_4_5& GLFWRenderer::renderState()
+{
+    return m_renderState;
+}
+
+MemoryBarriers_4_5& GLFWRenderer::memoryBarriers()
+{
+    return m_memoryBarriers;
+}
+
+GLuint GLFWRenderer::scratchBuffer(size_t size)
+{
+    CHECK_THIS_CONTEXT;
+
+    if (size > m_scratchBufferSize)
+    {
+        if (m_scratchBufferID) glDeleteBuffers(1, &m_scratchBufferID);
+
+        m_scratchBufferSize = glm::max(size, m_scratchBufferSize * 2u);
+        glCreateBuffers(1, &m_scratchBufferID);
+        glNamedBufferStorage(m_scratchBufferID, static_cast<GLsizeiptr>(m_scratchBufferSize), nullptr, 0u);
+    }
+
+    return m_scratchBufferID;
 }
 
 bool GLFWRenderer::doMakeCurrent()
@@ -4279,12 +5252,15 @@ bool GLFWRenderer::doMakeCurrent()
     if (window == glfwGetCurrentContext()) return true;
 
     glfwMakeContextCurrent(window);
+    m_renderState.invalidate();
     return true;
 }
 
 bool GLFWRenderer::doDoneCurrent()
 {
+    flushStagingBuffer();
     glfwMakeContextCurrent(nullptr);
+    m_renderState.invalidate();
     return true;
 }
 
@@ -4293,14 +5269,16 @@ void GLFWRenderer::setupCompute(
     const core::StateSetList& stateSetList)
 {
     CHECK_THIS_CONTEXT;
+    flushStagingBuffer();
 
     auto computeProgram_4_5 = std::dynamic_pointer_cast<ComputeProgram_4_5>(computeProgram);
     if (!computeProgram_4_5) LOG_CRITICAL << "Compute program can't be nullptr";
     CHECK_RESOURCE_CONTEXT(computeProgram_4_5);
-    glUseProgram(computeProgram_4_5->id());
+    m_renderState.useProgram(computeProgram_4_5->id());
 
-    setupUniforms(computeProgram_4_5, stateSetList);
-    setupShaderStorageBlocks(computeProgram_4_5, stateSetList);
+    const auto& bindingLayout = computeProgram_4_5->bindingLayout(stateSetList);
+    setupUniforms(computeProgram_4_5, bindingLayout);
+    setupShaderStorageBlocks(computeProgram_4_5, bindingLayout);
 }
 
 void GLFWRenderer::setupRender(
@@ -4311,6 +5289,7 @@ void GLFWRenderer::setupRender(
     const core::StateSetList& stateSetList)
 {
     CHECK_THIS_CONTEXT;
+    flushStagingBuffer();
 
     auto frameBufferBase_4_5 = std::dynamic_pointer_cast<FrameBufferBase_4_5>(framebufferBase);
     if (!frameBufferBase_4_5) LOG_CRITICAL << "Framebuffer can't be nullptr";
@@ -4323,18 +5302,17 @@ void GLFWRenderer::setupRender(
     auto renderProgram_4_5 = std::dynamic_pointer_cast<RenderProgram_4_5>(renderProgram);
     if (!renderProgram_4_5) LOG_CRITICAL << "Render program can't be nullptr";
     CHECK_RESOURCE_CONTEXT(renderProgram_4_5);
-    glUseProgram(renderProgram_4_5->id());
+    m_renderState.useProgram(renderProgram_4_5->id());
 
     setupFramebuffer(renderProgram_4_5, frameBufferBase_4_5);
     setupVAO(renderProgram_4_5, vao_4_5);
 
-    setupUniforms(renderProgram_4_5, stateSetList);
-    setupShaderStorageBlocks(renderProgram_4_5, stateSetList);
-    setupUniformBlocks(renderProgram_4_5, stateSetList);
+    const auto& bindingLayout = renderProgram_4_5->bindingLayout(stateSetList);
+    setupUniforms(renderProgram_4_5, bindingLayout);
+    setupShaderStorageBlocks(renderProgram_4_5, bindingLayout);
+    setupUniformBlocks(renderProgram_4_5, bindingLayout);
 
-    glViewport(
-        static_cast<GLint>(viewport.x), static_cast<GLint>(viewport.y), static_cast<GLsizei>(viewport.z),
-        static_cast<GLsizei>(viewport.w));
+    m_renderState.viewport(viewport);
 }
 
 void GLFWRenderer::setupFramebuffer(
@@ -4345,77 +5323,56 @@ void GLFWRenderer::setupFramebuffer(
     CHECK_RESOURCE_CONTEXT(renderProgram);
     CHECK_RESOURCE_CONTEXT(framebuffer);
 
-    if (framebuffer->faceCulling())
-    {
-        glCullFace(Conversions::FaceType2GL(framebuffer->cullFaceType()));
-        glEnable(GL_CULL_FACE);
-    }
-    else
-        glDisable(GL_CULL_FACE);
+    m_renderState.faceCulling(framebuffer->faceCulling());
+    if (framebuffer->faceCulling()) m_renderState.cullFace(Conversions::FaceType2GL(framebuffer->cullFaceType()));
 
     for (uint16_t i = 0; i < core::graphics::FrameBufferColorAttachmentsCount(); ++i)
-    {
-        GLboolean mask = framebuffer->colorMask(i);
-        glColorMaski(i, mask, mask, mask, mask);
-    }
+        m_renderState.colorMask(i, framebuffer->colorMask(i));
 
+    m_renderState.depthTest(framebuffer->depthTest());
     if (framebuffer->depthTest())
     {
-        glEnable(GL_DEPTH_TEST);
-        glDepthFunc(Conversions::ComparingFunc2GL(framebuffer->depthFunc()));
-        glDepthMask(framebuffer->depthMask());
+        m_renderState.depthFunc(Conversions::ComparingFunc2GL(framebuffer->depthFunc()));
+        m_renderState.depthMask(framebuffer->depthMask());
     }
-    else
-        glDisable(GL_DEPTH_TEST);
 
+    m_renderState.stencilTest(framebuffer->stencilTest());
     if (framebuffer->stencilTest())
     {
-        glEnable(GL_STENCIL_TEST);
         for (const auto& face : {core::graphics::FaceType::Front, core::graphics::FaceType::Back})
         {
             const auto& operations = framebuffer->stencilOperations(face);
 
-            glStencilOpSeparate(
+            m_renderState.stencilOp(
                 Conversions::FaceType2GL(face), Conversions::StencilOperation2GL(operations[0]),
                 Conversions::StencilOperation2GL(operations[1]), Conversions::StencilOperation2GL(operations[2]));
 
-            glStencilFuncSeparate(
+            m_renderState.stencilFunc(
                 Conversions::FaceType2GL(face), Conversions::ComparingFunc2GL(framebuffer->stencilComparingFunc(face)),
                 framebuffer->stencilReferenceValue(face), framebuffer->stencilMaskValue(face));
         }
     }
-    else
-        glDisable(GL_STENCIL_TEST);
 
+    m_renderState.blending(framebuffer->blending());
     if (framebuffer->blending())
     {
-        glEnable(GL_BLEND);
-
-        auto blendConstantColor = framebuffer->blendConstantColor();
-        glBlendColor(blendConstantColor.r, blendConstantColor.g, blendConstantColor.b, framebuffer->blendConstantAlpha());
+        m_renderState.blendColor(glm::vec4(framebuffer->blendConstantColor(), framebuffer->blendConstantAlpha()));
 
         for (uint16_t i = 0; i < core::graphics::FrameBufferColorAttachmentsCount(); ++i)
         {
-            glBlendEquationSeparatei(
+            m_renderState.blendEquation(
                 i, Conversions::BlendEquetion2GL(framebuffer->blendColorEquation(i)),
                 Conversions::BlendEquetion2GL(framebuffer->blendAlphaEquation(i)));
-            glBlendFuncSeparatei(
+            m_renderState.blendFunc(
                 i, Conversions::BlendFactor2GL(framebuffer->blendColorSourceFactor(i)),
                 Conversions::BlendFactor2GL(framebuffer->blendColorDestinationFactor(i)),
                 Conversions::BlendFactor2GL(framebuffer->blendAlphaSourceFactor(i)),
                 Conversions::BlendFactor2GL(framebuffer->blendAlphaDestinationFactor(i)));
         }
     }
-    else
-        glDisable(GL_BLEND);
 
     for (uint32_t i = 0u; i < core::graphics::FrameBufferClipDistancesCount(); ++i)
-    {
-        if (framebuffer->clipDistance(i))
-            glEnable(GL_CLIP_DISTANCE0 + i);
-        else
-            glDisable(GL_CLIP_DISTANCE0 + i);
-    }
+        m_renderState.clipDistance(i, framebuffer->clipDistance(i));
 
     int32_t maxOuputLocation = -1;
     for (const auto& outputInfo : renderProgram->outputsInfo())
@@ -4438,7 +5395,7 @@ void GLFWRenderer::setupFramebuffer(
         return;
     }
 
-    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer->id());
+    m_renderState.bindFramebuffer(framebuffer->id());
 }
 
 void GLFWRenderer::setupVAO(
@@ -4464,9 +5421,16 @@ void GLFWRenderer::setupVAO(
                          << "\" has wrong number of components";
 
         vao->setupVertexAttrubute(attributeInfo.ID, attributeInfo.location);
+
+        auto vertexBuffer_4_5 = std::dynamic_pointer_cast<const BufferBase_4_5>(
+            vao->vertexBuffer(vao->vertexAttributeBindingIndex(attributeInfo.ID)));
+        if (vertexBuffer_4_5) m_memoryBarriers.readBuffer(vertexBuffer_4_5->id(), GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
     }
 
-    glBindVertexArray(vao->id());
+    if (auto indexBuffer_4_5 = std::dynamic_pointer_cast<const BufferBase_4_5>(vao->indexBuffer()))
+        m_memoryBarriers.readBuffer(indexBuffer_4_5->id(), GL_ELEMENT_ARRAY_BARRIER_BIT);
+
+    m_renderState.bindVertexArray(vao->id());
 }
 
 bool GLFWRenderer::setupUniform(
@@ -4754,95 +5718,50 @@ bool GLFWRenderer::setupUniform(
     return result;
 }
 
-void GLFWRenderer::setupUniforms(const std::shared_ptr<ProgramBase_4_5>& program, const core::StateSetList& stateSetList)
+void GLFWRenderer::setupUniforms(
+    const std::shared_ptr<ProgramBase_4_5>& program,
+    const ProgramBase_4_5::BindingLayout& bindingLayout)
 {
     CHECK_THIS_CONTEXT;
     CHECK_RESOURCE_CONTEXT(program);
     int32_t textureUnit = 0;
     int32_t imageUnit = 0;
 
-    for (const auto& uniformInfo : program->uniformsInfo())
+    const auto& uniformsInfo = program->uniformsInfo();
+    for (size_t i = 0u; i < uniformsInfo.size(); ++i)
     {
-        core::PConstAbstractUniform abstractUniform;
-        const auto uniformId = uniformInfo.ID;
-
-        for (const auto& stateSet : stateSetList)
-            if (abstractUniform = stateSet->uniform(uniformId); abstractUniform) break;
-
-        if (!abstractUniform)
-        {
-            const auto uniformName = program->uniformNameByIndex(uniformInfo.index);
-            for (const auto& stateSet : stateSetList)
-                if (abstractUniform = stateSet->userUniform(uniformName); abstractUniform) break;
-        }
-
-        if (!abstractUniform) LOG_CRITICAL << "Uniform \"" << program->uniformNameByIndex(uniformInfo.index) << "\" has not set";
-
-        if (!setupUniform(program->id(), uniformInfo.type, uniformInfo.location, textureUnit, imageUnit, abstractUniform))
+        const auto& uniformInfo = uniformsInfo[i];
+        if (!setupUniform(
+                program->id(), uniformInfo.type, uniformInfo.location, textureUnit, imageUnit, bindingLayout.uniforms[i].lock()))
             LOG_CRITICAL << "Failed to setup uniform \"" << program->uniformNameByIndex(uniformInfo.index)
                          << "\". It has wrong type";
     }
 }
 
-void GLFWRenderer::setupUniformBlocks(const std::shared_ptr<ProgramBase_4_5>& program, const core::StateSetList& stateSetList)
+void GLFWRenderer::setupUniformBlocks(
+    const std::shared_ptr<ProgramBase_4_5>& program,
+    const ProgramBase_4_5::BindingLayout& bindingLayout)
 {
     CHECK_THIS_CONTEXT;
     CHECK_RESOURCE_CONTEXT(program);
-    uint32_t bindingPoint = 0u;
-
-    for (const auto& uniformBlockInfo : program->uniformBlocksInfo())
-    {
-        core::graphics::PConstBufferRange buffer;
-
-        for (const auto& stateSet : stateSetList)
-            if (buffer = stateSet->uniformBlock(uniformBlockInfo.ID); buffer) break;
 
-        if (!buffer)
-        {
-            const auto name = program->uniformNameByIndex(uniformBlockInfo.index);
-            //            for (const auto &stateSet: stateSetList)
-            //                if (bufferRange = stateSet->userShaderStorageBlock(name); bufferRange)
-            //                    break;
-        }
-
-        if (!buffer)
-            LOG_CRITICAL << "Uniform block \"" << program->uniformNameByIndex(uniformBlockInfo.index) << "\" has not set";
-
-        bindUniformBlock(bindingPoint, buffer);
-        glUniformBlockBinding(program->id(), uniformBlockInfo.index, bindingPoint++);
-    }
+    for (size_t i = 0u; i < bindingLayout.uniformBlocks.size(); ++i)
+        bindUniformBlock(static_cast<uint32_t>(i), bindingLayout.uniformBlocks[i].lock());
 }
 
 void GLFWRenderer::setupShaderStorageBlocks(
     const std::shared_ptr<ProgramBase_4_5>& program,
-    const core::StateSetList& stateSetList)
+    const ProgramBase_4_5::BindingLayout& bindingLayout)
 {
     CHECK_THIS_CONTEXT;
     CHECK_RESOURCE_CONTEXT(program);
-    uint32_t bindingPoint = 0u;
-
-    for (const auto& shaderStorageBlockInfo : program->shaderStorageBlocksInfo())
-    {
-        core::graphics::PConstBufferRange buffer;
-
-        for (const auto& stateSet : stateSetList)
-            if (buffer = stateSet->shaderStorageBlock(shaderStorageBlockInfo.ID); buffer) break;
-
-        if (!buffer)
-        {
-            const auto name = program->shaderStorageBlockNameByIndex(shaderStorageBlockInfo.index);
-            //            for (const auto &stateSet: stateSetList)
-            //                if (bufferRange = stateSet->userShaderStorageBlock(name); bufferRange)
-            //                    break;
-        }
 
-        if (!buffer)
-            LOG_CRITICAL << "Shader storage block \"" << program->shaderStorageBlockNameByIndex(shaderStorageBlockInfo.index)
-                         << "\" has not set";
+    for (size_t i = 0u; i < bindingLayout.shaderStorageBlocks.size(); ++i)
+        bindShaderStorageBlock(
+            static_cast<uint32_t>(i), bindingLayout.shaderStorageBlocks[i].lock(), !program->isShaderStorageBlockReadOnly(i));
 
-        bindShaderStorageBlock(bindingPoint, buffer);
-        glShaderStorageBlockBinding(program->id(), shaderStorageBlockInfo.index, bindingPoint++);
-    }
+    // writable images are accessed through bindless handles that may be stored anywhere, so only programs writing images count
+    if (program->isWritingImages()) m_memoryBarriers.writeImageHandles();
 }
 
 void GLFWRenderer::bindTexture(int32_t unit, const core::graphics::PConstTexture& texture)
@@ -4875,6 +5794,8 @@ void GLFWRenderer::bindImage(
     glBindImageTexture(
         static_cast<GLuint>(unit), textureBase->id(), static_cast<GLint>(level), GL_TRUE, 0u,
         Conversions::ImageDataAccess2GL(access), Conversions::PixelInternalFormat2GL(texture->internalFormat()));
+
+    if (access != core::graphics::Image::DataAccess::ReadOnly) m_memoryBarriers.writeImages();
 }
 
 void GLFWRenderer::bindBuffer(GLenum target, const core::graphics::PConstBuffer& buffer)
@@ -4885,6 +5806,9 @@ void GLFWRenderer::bindBuffer(GLenum target, const core::graphics::PConstBuffer&
     CHECK_RESOURCE_CONTEXT(buffer_4_5);
 
     glBindBuffer(target, buffer_4_5->id());
+
+    // only indirect command and parameter buffers are bound to non-indexed targets
+    m_memoryBarriers.readBuffer(buffer_4_5->id(), GL_COMMAND_BARRIER_BIT);
 }
 
 void GLFWRenderer::bindBufferRange(GLenum target, GLuint bindingPoint, const core::graphics::PConstBufferRange& bufferRange)
@@ -4897,6 +5821,29 @@ void GLFWRenderer::bindBufferRange(GLenum target, GLuint bindingPoint, const cor
     glBindBufferRange(
         target, bindingPoint, buffer_4_5->id(), static_cast<GLintptr>(bufferRange->offset()),
         static_cast<GLsizeiptr>(bufferRange->size()));
+
+    switch (target)
+    {
+        case GL_UNIFORM_BUFFER:
+        {
+            m_memoryBarriers.readBuffer(buffer_4_5->id(), GL_UNIFORM_BARRIER_BIT);
+            break;
+        }
+        case GL_SHADER_STORAGE_BUFFER:
+        {
+            // writes are tracked by bindShaderStorageBlock, it knows if the block is readonly
+            m_memoryBarriers.readBuffer(buffer_4_5->id(), GL_SHADER_STORAGE_BARRIER_BIT);
+            break;
+        }
+        case GL_ATOMIC_COUNTER_BUFFER:
+        {
+            m_memoryBarriers.readBuffer(buffer_4_5->id(), GL_ATOMIC_COUNTER_BARRIER_BIT);
+            m_memoryBarriers.writeBuffer(buffer_4_5->id());
+            break;
+        }
+        default:
+            break;
+    }
 }
 
 void GLFWRenderer::bindUniformBlock(uint32_t bindingPoint, const core::graphics::PConstBufferRange& bufferRange)
@@ -4905,10 +5852,19 @@ void GLFWRenderer::bindUniformBlock(uint32_t bindingPoint, const core::graphics:
     bindBufferRange(GL_UNIFORM_BUFFER, bindingPoint, bufferRange);
 }
 
-void GLFWRenderer::bindShaderStorageBlock(uint32_t bindingPoint, const core::graphics::PConstBufferRange& bufferRange)
+void GLFWRenderer::bindShaderStorageBlock(
+    uint32_t bindingPoint,
+    const core::graphics::PConstBufferRange& bufferRange,
+    bool isWritable)
 {
     CHECK_THIS_CONTEXT;
     bindBufferRange(GL_SHADER_STORAGE_BUFFER, bindingPoint, bufferRange);
+
+    if (isWritable)
+    {
+        auto buffer_4_5 = std::dynamic_pointer_cast<const BufferBase_4_5>(bufferRange->buffer());
+        m_memoryBarriers.writeBuffer(buffer_4_5->id());
+    }
 }
 
 void GLFWRenderer::bindAtomicCounterBuffer(GLuint bindingPoint, const core::graphics::PConstBufferRange& bufferRange)
@@ -4,6 +4,7 @@
 #include <bitset>
 #include <deque>
 #include <list>
+#include <optional>
 #include <tuple>
 
 #include <utils/noncopyble.h>
@@ -78,6 +79,49 @@ public:
     static GLenum ClipControlDepth2GL(core::graphics::ClipControlDepth);
 };
 
+class StagingBuffer_4_5
+{
+    NONCOPYBLE(StagingBuffer_4_5)
+public:
+    StagingBuffer_4_5(size_t size);
+    ~StagingBuffer_4_5();
+
+    size_t size() const;
+
+    uint8_t* allocate(size_t size, size_t& offset);
+    void copy(size_t offset, GLuint dstBuffer, size_t dstOffset, size_t size);
+    void flush();
+
+    static std::shared_ptr<StagingBuffer_4_5> create(size_t);
+
+private:
+    struct Copy
+    {
+        size_t offset;
+        GLuint dstBuffer;
+        size_t dstOffset;
+        size_t size;
+    };
+
+    struct Fence
+    {
+        size_t begin;
+        size_t end;
+        GLsync sync;
+    };
+
+    void waitFences(size_t begin, size_t end);
+    void releaseSignaledFences();
+
+    GLuint m_id = 0;
+    uint8_t* m_data = nullptr;
+    size_t m_size = 0u;
+    size_t m_head = 0u;
+    size_t m_pendingBegin = 0u;
+    std::vector<Copy> m_copies;
+    std::deque<Fence> m_fences;
+};
+
 class BufferBase_4_5 : public std::enable_shared_from_this<BufferBase_4_5>
 {
     NONCOPYBLE(BufferBase_4_5)
@@ -97,6 +141,31 @@ public:
         uint8_t* m_data;
     };
 
+    // write-only mapping that is placed in the staging buffer and copied to the buffer when the staging buffer is flushed
+    class StagedData_4_5 : public core::graphics::IBuffer::MappedData
+    {
+        CURRENT_CONTEXT_INFO
+    public:
+        StagedData_4_5(
+            const std::weak_ptr<const BufferBase_4_5>&,
+            const std::weak_ptr<StagingBuffer_4_5>&,
+            uint8_t*,
+            size_t stagingOffset,
+            size_t offset,
+            size_t size);
+        ~StagedData_4_5() override;
+        uint8_t* get() override;
+        const uint8_t* get() const override;
+
+    private:
+        std::weak_ptr<const BufferBase_4_5> m_mappedBuffer;
+        std::weak_ptr<StagingBuffer_4_5> m_stagingBuffer;
+        uint8_t* m_data;
+        size_t m_stagingOffset;
+        size_t m_offset;
+        size_t m_size;
+    };
+
     virtual ~BufferBase_4_5();
 
     GLuint id() const;
@@ -107,13 +176,21 @@ protected:
     size_t sizeImpl() const;
     void resizeImpl(size_t size);
 
-    std::unique_ptr<MappedData_4_5> mapImpl(core::graphics::IBuffer::MapAccess access, size_t offset = 0u, size_t size = 0u);
+    std::unique_ptr<core::graphics::IBuffer::MappedData> mapImpl(
+        core::graphics::IBuffer::MapAccess access,
+        size_t offset = 0u,
+        size_t size = 0u);
+
+    void flushStagingBuffer() const;
+    void updateMemoryBarrier() const;
+    void releaseMemoryBarrier() const;
 
 protected:
     GLuint m_id = 0;
     mutable bool m_isMapped = false;
 
     friend class MappedData_4_5;
+    friend class StagedData_4_5;
 };
 
 class StaticBuffer_4_5 : public core::graphics::IStaticBuffer, public BufferBase_4_5
@@ -154,6 +231,7 @@ public:
     void insert(size_t offset, const void* data, size_t size) override;
     void erase(size_t offset, size_t size) override;
     void resize(size_t) override;
+    void copy(size_t srcOffset, size_t dstOffset, size_t size) override;
 
     std::unique_ptr<MappedData> map(MapAccess access, size_t offset = 0u, size_t size = 0u) override;
     std::unique_ptr<const MappedData> map(MapAccess access, size_t offset = 0u, size_t size = 0u) const override;
@@ -161,6 +239,8 @@ public:
     static std::shared_ptr<DynamicBuffer_4_5> create(size_t = 0u, const void* = nullptr);
 
 private:
+    void moveData(size_t srcOffset, size_t dstOffset, size_t size);
+
     size_t m_size = 0;
 };
 
@@ -577,6 +657,48 @@ public:
 protected:
     GLuint64 m_id = 0;
     core::graphics::PConstImage m_image;
+    bool m_isResident = false;
+};
+
+class TimestampQuery_4_5 : public core::graphics::ITimestampQuery
+{
+    NONCOPYBLE(TimestampQuery_4_5)
+    CURRENT_CONTEXT_INFO
+public:
+    TimestampQuery_4_5();
+    ~TimestampQuery_4_5() override;
+
+    void record() override;
+    bool isAvailable() const override;
+    uint64_t time() const override;
+
+    static std::shared_ptr<TimestampQuery_4_5> create();
+
+private:
+    GLuint m_id = 0;
+};
+
+// the copy is read through a persistent mapping after its fence is signaled
+class BufferReadback_4_5 : public core::graphics::IBufferReadback
+{
+    NONCOPYBLE(BufferReadback_4_5)
+    CURRENT_CONTEXT_INFO
+public:
+    BufferReadback_4_5(size_t);
+    ~BufferReadback_4_5() override;
+
+    size_t size() const override;
+    void record(const core::graphics::PConstBuffer&, size_t offset) override;
+    bool isAvailable() const override;
+    const uint8_t* data() const override;
+
+    static std::shared_ptr<BufferReadback_4_5> create(size_t);
+
+private:
+    GLuint m_id = 0;
+    size_t m_size;
+    const uint8_t* m_data = nullptr;
+    GLsync m_fence = nullptr;
 };
 
 class RenderBuffer_4_5 : public core::graphics::IRenderBuffer
@@ -785,11 +907,14 @@ public:
     ~ProgramBase_4_5() override;
 
     bool compileAndLink(const std::unordered_map<GLenum, std::reference_wrapper<const std::string>>&);
+    bool loadBinary(const core::graphics::ProgramBinary&);
 
     GLuint id() const;
     virtual bool preBuild(std::string&);
     virtual bool postBuild(std::string&);
 
+    bool binary(core::graphics::ProgramBinary&) const override;
+
     // int32_t uniformLocationByName(const std::string&) const override;
 
     const std::vector<core::graphics::UniformInfo>& uniformsInfo() const override;
@@ -801,6 +926,26 @@ public:
     std::string uniformBlockNameByIndex(uint16_t) const override;
     std::string shaderStorageBlockNameByIndex(uint16_t) const override;
 
+    bool isShaderStorageBlockReadOnly(size_t) const; // by binding point
+    bool isWritingImages() const;
+
+    // the state sets own the resources, so the layout doesn't keep them alive after the state sets are gone
+    struct BindingLayout
+    {
+        std::vector<uint64_t> stateSetVersions;
+        std::vector<std::weak_ptr<const core::AbstractUniform>> uniforms;
+        std::vector<std::weak_ptr<const core::graphics::BufferRange>> uniformBlocks;
+        std::vector<std::weak_ptr<const core::graphics::BufferRange>> shaderStorageBlocks;
+
+        // empty weak pointers are expired too, so only the slots set when the layout was built are tested
+        std::vector<bool> isUniformsSet;
+        std::vector<bool> isUniformBlocksSet;
+        std::vector<bool> isShaderStorageBlocksSet;
+
+        bool isExpired() const;
+    };
+    const BindingLayout& bindingLayout(const core::StateSetList&);
+
 protected:
     GLuint m_id;
 
@@ -812,6 +957,11 @@ protected:
     GLint m_uniformBlockNameMaxLength;
     GLint m_bufferVariableNameMaxLength;
     GLint m_shaderStorageBlockNameMaxLength;
+
+    std::vector<bool> m_isShaderStorageBlocksReadOnly;
+    bool m_isWritingImages;
+
+    std::deque<BindingLayout> m_bindingLayouts;
 };
 
 class RenderProgram_4_5 : public core::graphics::IRenderProgram, public ProgramBase_4_5
@@ -838,6 +988,7 @@ public:
         const std::shared_ptr<utils::Shader>& vertexShader,
         const std::shared_ptr<utils::Shader>& geometryShader,
         const std::shared_ptr<utils::Shader>& fragmentShader);
+    static std::shared_ptr<RenderProgram_4_5> create(const core::graphics::ProgramBinary&);
 
 protected:
     std::vector<core::graphics::AttributeInfo> m_attributesInfo;
@@ -860,11 +1011,108 @@ public:
     glm::uvec3 workGroupSize() const override;
 
     static std::shared_ptr<ComputeProgram_4_5> create(const std::shared_ptr<utils::Shader>& computeShader);
+    static std::shared_ptr<ComputeProgram_4_5> create(const core::graphics::ProgramBinary&);
 
 protected:
     glm::uvec3 m_workGroupSize;
 };
 
+class RenderState_4_5
+{
+    NONCOPYBLE(RenderState_4_5)
+public:
+    RenderState_4_5(core::graphics::FrameStatistics&);
+
+    void invalidate();
+
+    void useProgram(GLuint);
+    void bindVertexArray(GLuint);
+    void bindFramebuffer(GLuint);
+    void viewport(const glm::uvec4&);
+
+    void faceCulling(bool);
+    void cullFace(GLenum);
+    void colorMask(GLuint, GLboolean);
+    void depthTest(bool);
+    void depthFunc(GLenum);
+    void depthMask(GLboolean);
+    void stencilTest(bool);
+    void stencilOp(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass);
+    void stencilFunc(GLenum face, GLenum func, GLint ref, GLuint mask);
+    void blending(bool);
+    void blendColor(const glm::vec4&);
+    void blendEquation(GLuint, GLenum color, GLenum alpha);
+    void blendFunc(GLuint, GLenum srcColor, GLenum dstColor, GLenum srcAlpha, GLenum dstAlpha);
+    void clipDistance(uint32_t, bool);
+
+private:
+    template <typename T>
+    bool update(std::optional<T>&, const T&);
+
+    void enable(GLenum, bool);
+
+    core::graphics::FrameStatistics& m_frameStatistics;
+
+    std::optional<GLuint> m_program;
+    std::optional<GLuint> m_vertexArray;
+    std::optional<GLuint> m_framebuffer;
+    std::optional<glm::uvec4> m_viewport;
+
+    std::optional<bool> m_faceCulling;
+    std::optional<GLenum> m_cullFace;
+    std::array<std::optional<GLboolean>, core::graphics::FrameBufferColorAttachmentsCount()> m_colorMasks;
+    std::optional<bool> m_depthTest;
+    std::optional<GLenum> m_depthFunc;
+    std::optional<GLboolean> m_depthMask;
+    std::optional<bool> m_stencilTest;
+    std::array<std::optional<std::tuple<GLenum, GLenum, GLenum>>, 2u> m_stencilOps;
+    std::array<std::optional<std::tuple<GLenum, GLint, GLuint>>, 2u> m_stencilFuncs;
+    std::optional<bool> m_blending;
+    std::optional<glm::vec4> m_blendColor;
+    std::array<std::optional<std::pair<GLenum, GLenum>>, core::graphics::FrameBufferColorAttachmentsCount()> m_blendEquations;
+    std::array<std::optional<std::tuple<GLenum, GLenum, GLenum, GLenum>>, core::graphics::FrameBufferColorAttachmentsCount()>
+        m_blendFuncs;
+    std::array<std::optional<bool>, core::graphics::FrameBufferClipDistancesCount()> m_clipDistances;
+};
+
+class MemoryBarriers_4_5
+{
+    NONCOPYBLE(MemoryBarriers_4_5)
+public:
+    MemoryBarriers_4_5(core::graphics::FrameStatistics&, bool isFullBarriersMode);
+
+    bool isFullBarriersMode() const;
+
+    void readBuffer(GLuint, GLbitfield);
+    void writeBuffer(GLuint);
+    void writeImages();
+    void writeImageHandles();
+    void beginCommand();
+    void endCommand();
+
+    void updateBuffer(GLuint);
+    void updateFramebuffer();
+    void releaseBuffer(GLuint);
+
+    void addWritableImageHandle();
+    void removeWritableImageHandle();
+
+private:
+    void barrier(GLbitfield);
+
+    core::graphics::FrameStatistics& m_frameStatistics;
+    bool m_isFullBarriersMode;
+
+    std::unordered_map<GLuint, GLbitfield> m_dirtyBuffers;
+    GLbitfield m_dirtyImages = 0u;
+
+    std::vector<std::pair<GLuint, GLbitfield>> m_commandReads;
+    std::vector<GLuint> m_commandWrites;
+    bool m_isCommandWritingImages = false;
+
+    uint32_t m_numWritableImageHandles = 0u;
+};
+
 class GLFWRenderer : public core::graphics::RendererBase
 {
     NONCOPYBLE(GLFWRenderer)
@@ -986,6 +1234,12 @@ public:
         const std::shared_ptr<utils::Shader>& fragmentShader) const override;
     std::shared_ptr<core::graphics::IComputeProgram> createComputeProgram(
         const std::shared_ptr<utils::Shader>& computeShader) const override;
+    std::shared_ptr<core::graphics::ITimestampQuery> createTimestampQuery() const override;
+    std::shared_ptr<core::graphics::IBufferReadback> createBufferReadback(size_t) const override;
+
+    std::string programBinaryDriverKey() const override;
+    std::shared_ptr<core::graphics::IRenderProgram> createRenderProgram(const core::graphics::ProgramBinary&) const override;
+    std::shared_ptr<core::graphics::IComputeProgram> createComputeProgram(const core::graphics::ProgramBinary&) const override;
 
     void compute(const glm::uvec3&, const std::shared_ptr<core::graphics::IComputeProgram>&, const core::StateSetList&) override;
 
@@ -1155,6 +1409,12 @@ public:
         const core::graphics::PDrawElementsIndirectCommandConstBuffer&,
         const core::graphics::PConstBufferRange&) override;
 
+    std::shared_ptr<StagingBuffer_4_5> stagingBuffer();
+    void flushStagingBuffer();
+    GLuint scratchBuffer(size_t);
+    RenderState_4_5& renderState();
+    MemoryBarriers_4_5& memoryBarriers();
+
 protected:
     bool doMakeCurrent() override;
     bool doDoneCurrent() override;
@@ -1179,9 +1439,9 @@ private:
         int32_t&,
         int32_t&,
         const core::PConstAbstractUniform&);
-    void setupUniforms(const std::shared_ptr<ProgramBase_4_5>&, const core::StateSetList&);
-    void setupUniformBlocks(const std::shared_ptr<ProgramBase_4_5>&, const core::StateSetList&);
-    void setupShaderStorageBlocks(const std::shared_ptr<ProgramBase_4_5>&, const core::StateSetList&);
+    void setupUniforms(const std::shared_ptr<ProgramBase_4_5>&, const ProgramBase_4_5::BindingLayout&);
+    void setupUniformBlocks(const std::shared_ptr<ProgramBase_4_5>&, const ProgramBase_4_5::BindingLayout&);
+    void setupShaderStorageBlocks(const std::shared_ptr<ProgramBase_4_5>&, const ProgramBase_4_5::BindingLayout&);
 
     void bindTexture(int32_t, const core::graphics::PConstTexture&);
     void bindImage(int32_t, const core::graphics::PConstImage&);
@@ -1189,7 +1449,7 @@ private:
     void bindBuffer(GLenum target, const core::graphics::PConstBuffer&);
     void bindBufferRange(GLenum target, GLuint bindingPoint, const core::graphics::PConstBufferRange&);
     void bindUniformBlock(uint32_t, const core::graphics::PConstBufferRange&);
-    void bindShaderStorageBlock(uint32_t, const core::graphics::PConstBufferRange&);
+    void bindShaderStorageBlock(uint32_t, const core::graphics::PConstBufferRange&, bool isWritable);
     void bindAtomicCounterBuffer(GLuint bindingPoint, const core::graphics::PConstBufferRange&);
     void bindDispatchIndirectBuffer(const core::graphics::PConstBuffer&);
     void bindDrawIndirectBuffer(const core::graphics::PConstBuffer&);
@@ -1197,6 +1457,11 @@ private:
 
     std::weak_ptr<GLFWWidget> m_widget;
     glm::uvec2 m_screenSize;
+    std::shared_ptr<StagingBuffer_4_5> m_stagingBuffer;
+    RenderState_4_5 m_renderState;
+    MemoryBarriers_4_5 m_memoryBarriers;
+    GLuint m_scratchBufferID = 0;
+    size_t m_scratchBufferSize = 0u;
 };
 
 } // namespace graphics_glfw
@@ -0,0 +1,2323 @@
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <numeric>
+#include <regex>
+
+#include <utils/glm/gtx/texture.hpp>
+#include <utils/image.h>
+#include <utils/logger.h>
+#include <utils/mesh.h>
+#include <utils/shader.h>
+
+#include <graphics_headless/headlesswidget.h>
+
+#include "headlessrenderer.h"
+
+namespace simplex
+{
+namespace graphics_headless
+{
+
+static std::shared_ptr<HeadlessRenderer> currentHeadlessRenderer()
+{
+    return std::dynamic_pointer_cast<HeadlessRenderer>(core::graphics::RendererBase::current());
+}
+
+static core::graphics::TextureHandle nextHandle()
+{
+    static std::atomic<core::graphics::TextureHandle> s_nextHandle(1u);
+    return s_nextHandle.fetch_add(1u);
+}
+
+static bool pixelInternalFormatHasAlpha(core::graphics::PixelInternalFormat value)
+{
+    static const std::unordered_set<core::graphics::PixelInternalFormat> s_table{
+        core::graphics::PixelInternalFormat::RGBA2,        core::graphics::PixelInternalFormat::RGBA4,
+        core::graphics::PixelInternalFormat::RGB5_A1,      core::graphics::PixelInternalFormat::RGBA8,
+        core::graphics::PixelInternalFormat::RGBA8_SNORM,  core::graphics::PixelInternalFormat::RGB10_A2,
+        core::graphics::PixelInternalFormat::RGB10_A2UI,   core::graphics::PixelInternalFormat::RGBA12,
+        core::graphics::PixelInternalFormat::RGBA16,       core::graphics::PixelInternalFormat::RGBA16_SNORM,
+        core::graphics::PixelInternalFormat::SRGB8_ALPHA8, core::graphics::PixelInternalFormat::RGBA16F,
+        core::graphics::PixelInternalFormat::RGBA32F,      core::graphics::PixelInternalFormat::RGBA8I,
+        core::graphics::PixelInternalFormat::RGBA8UI,      core::graphics::PixelInternalFormat::RGBA16I,
+        core::graphics::PixelInternalFormat::RGBA16UI,     core::graphics::PixelInternalFormat::RGBA32I,
+        core::graphics::PixelInternalFormat::RGBA32UI};
+
+    return s_table.count(value) > 0u;
+}
+
+static bool pixelInternalFormatHasDepth(core::graphics::PixelInternalFormat value)
+{
+    static const std::unordered_set<core::graphics::PixelInternalFormat> s_table{
+        core::graphics::PixelInternalFormat::Depth16,         core::graphics::PixelInternalFormat::Depth24,
+        core::graphics::PixelInternalFormat::Depth32F,        core::graphics::PixelInternalFormat::Depth24Stencil8,
+        core::graphics::PixelInternalFormat::Depth32FStencil8};
+
+    return s_table.count(value) > 0u;
+}
+
+static size_t pixelsDataSize(const glm::uvec3& size, uint32_t numComponents, utils::PixelComponentType type)
+{
+    return static_cast<size_t>(size.x) * glm::max(size.y, 1u) * glm::max(size.z, 1u) * numComponents *
+           utils::sizeOfPixelComponentType(type);
+}
+
+// HeadlessBufferBase
+
+HeadlessBufferBase::MappedData_Headless::MappedData_Headless(const HeadlessBufferBase& mappedBuffer, uint8_t* data)
+    : m_mappedBuffer(mappedBuffer)
+    , m_data(data)
+{
+}
+
+HeadlessBufferBase::MappedData_Headless::~MappedData_Headless()
+{
+    m_mappedBuffer.m_isMapped = false;
+}
+
+uint8_t* HeadlessBufferBase::MappedData_Headless::get()
+{
+    return m_data;
+}
+
+const uint8_t* HeadlessBufferBase::MappedData_Headless::get() const
+{
+    return m_data;
+}
+
+HeadlessBufferBase::~HeadlessBufferBase() = default;
+
+const std::vector<uint8_t>& HeadlessBufferBase::data() const
+{
+    return m_data;
+}
+
+HeadlessBufferBase::HeadlessBufferBase(size_t size, const void* data)
+    : m_data(size, 0u)
+{
+    SAVE_CURRENT_CONTEXT;
+
+    if (size && data)
+    {
+        std::memcpy(m_data.data(), data, size);
+        if (auto renderer = currentHeadlessRenderer()) renderer->frameRecord().numBytesUploaded += size;
+    }
+}
+
+size_t HeadlessBufferBase::sizeImpl() const
+{
+    return m_data.size();
+}
+
+void HeadlessBufferBase::resizeImpl(size_t size)
+{
+    CHECK_CURRENT_CONTEXT;
+
+    // reallocation copies the content to a new storage
+    if (auto renderer = currentHeadlessRenderer()) renderer->frameRecord().numBytesCopied += glm::min(size, m_data.size());
+
+    m_data.resize(size);
+    m_data.shrink_to_fit();
+}
+
+std::unique_ptr<core::graphics::IBuffer::MappedData> HeadlessBufferBase::mapImpl(
+    core::graphics::IBuffer::MapAccess access,
+    size_t offset,
+    size_t size,
+    size_t bufferSize)
+{
+    CHECK_CURRENT_CONTEXT;
+
+    if (size == 0) size = bufferSize - offset;
+
+    if (offset > bufferSize)
+    {
+        LOG_ERROR << "The offset of mapped data is out of range";
+        return nullptr;
+    }
+
+    if (offset + size > bufferSize)
+    {
+        LOG_ERROR << "The size of mapped data is out of range";
+        return nullptr;
+    }
+
+    if (m_isMapped)
+    {
+        LOG_ERROR << "Buffer is already mapped";
+        return nullptr;
+    }
+
+    m_isMapped = true;
+
+    if (auto renderer = currentHeadlessRenderer())
+    {
+        auto& frameRecord = renderer->frameRecord();
+        if (access != core::graphics::IBuffer::MapAccess::ReadOnly) frameRecord.numBytesUploaded += size;
+        if (access != core::graphics::IBuffer::MapAccess::WriteOnly)
+        {
+            frameRecord.numBytesRead += size;
+            ++renderer->frameStatistics().numGPUReadbacks;
+        }
+    }
+
+    return std::make_unique<MappedData_Headless>(*this, m_data.data() + offset);
+}
+
+// HeadlessStaticBuffer
+
+HeadlessStaticBuffer::HeadlessStaticBuffer(size_t size, const void* data)
+    : HeadlessBufferBase(size, data)
+{
+    SAVE_CURRENT_CONTEXT;
+}
+
+HeadlessStaticBuffer::~HeadlessStaticBuffer() = default;
+
+bool HeadlessStaticBuffer::isEmpty() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return sizeImpl() == 0u;
+}
+
+size_t HeadlessStaticBuffer::size() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return sizeImpl();
+}
+
+std::unique_ptr<core::graphics::IBuffer::MappedData> HeadlessStaticBuffer::map(MapAccess access, size_t offset, size_t size)
+{
+    CHECK_CURRENT_CONTEXT;
+    return mapImpl(access, offset, size, HeadlessStaticBuffer::size());
+}
+
+std::unique_ptr<const core::graphics::IBuffer::MappedData> HeadlessStaticBuffer::map(
+    MapAccess access,
+    size_t offset,
+    size_t size) const
+{
+    CHECK_CURRENT_CONTEXT;
+    return const_cast<HeadlessStaticBuffer*>(this)->map(access, offset, size);
+}
+
+std::shared_ptr<HeadlessStaticBuffer> HeadlessStaticBuffer::create(size_t size, const void* data)
+{
+    return std::make_shared<HeadlessStaticBuffer>(size, data);
+}
+
+// HeadlessDynamicBuffer
+
+HeadlessDynamicBuffer::HeadlessDynamicBuffer(size_t size, const void* data)
+    : HeadlessBufferBase(size, data)
+    , m_size(size)
+{
+    SAVE_CURRENT_CONTEXT;
+}
+
+HeadlessDynamicBuffer::~HeadlessDynamicBuffer() = default;
+
+bool HeadlessDynamicBuffer::isEmpty() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_size == 0u;
+}
+
+size_t HeadlessDynamicBuffer::size() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_size;
+}
+
+size_t HeadlessDynamicBuffer::capacity() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return sizeImpl();
+}
+
+void HeadlessDynamicBuffer::reserve(size_t size)
+{
+    CHECK_CURRENT_CONTEXT;
+    if (size > capacity()) resizeImpl(size);
+}
+
+void HeadlessDynamicBuffer::shrinkToFit()
+{
+    CHECK_CURRENT_CONTEXT;
+    resizeImpl(m_size);
+}
+
+void HeadlessDynamicBuffer::clear()
+{
+    CHECK_CURRENT_CONTEXT;
+    m_size = 0u;
+}
+
+void HeadlessDynamicBuffer::insert(size_t offset, const void* data, size_t insertedSize)
+{
+    CHECK_CURRENT_CONTEXT;
+
+    if (!insertedSize) return;
+
+    const auto oldSize = size();
+    const auto newSize = oldSize + insertedSize;
+
+    if (offset > oldSize)
+    {
+        LOG_ERROR << "The offset of inserted data is out of range";
+        return;
+    }
+
+    // the same growth policy as the GPU backend has, so the copied bytes are comparable
+    if (auto capacitySize = capacity(); newSize > capacitySize) resizeImpl(glm::max(newSize, capacitySize * 2u));
+
+    if (const auto tailSize = oldSize - offset)
+    {
+        std::memmove(m_data.data() + offset + insertedSize, m_data.data() + offset, tailSize);
+        if (auto renderer = currentHeadlessRenderer()) renderer->frameRecord().numBytesCopied += tailSize;
+    }
+
+    if (data)
+    {
+        std::memcpy(m_data.data() + offset, data, insertedSize);
+        if (auto renderer = currentHeadlessRenderer()) renderer->frameRecord().numBytesUploaded += insertedSize;
+    }
+
+    m_size = newSize;
+}
+
+void HeadlessDynamicBuffer::erase(size_t offset, size_t erasedSize)
+{
+    CHECK_CURRENT_CONTEXT;
+
+    if (!erasedSize) return;
+
+    auto oldSize = size();
+
+    if (offset > oldSize)
+    {
+        LOG_ERROR << "The offset of erased data is out of range";
+        return;
+    }
+
+    if (offset + erasedSize > oldSize)
+    {
+        LOG_ERROR << "The size of erased data is out of range";
+        return;
+    }
+
+    if (auto tailSize = oldSize - offset - erasedSize)
+    {
+        std::memmove(m_data.data() + offset, m_data.data() + offset + erasedSize, tailSize);
+        if (auto renderer = currentHeadlessRenderer()) renderer->frameRecord().numBytesCopied += tailSize;
+    }
+
+    m_size = oldSize - erasedSize;
+}
+
+void HeadlessDynamicBuffer::resize(size_t size)
+{
+    CHECK_CURRENT_CONTEXT;
+
+    if (auto capacitySize = capacity(); size > capacitySize) reserve(glm::max(size, capacitySize * 2u));
+
+    m_size = size;
+}
+
+void HeadlessDynamicBuffer::copy(size_t srcOffset, size_t dstOffset, size_t copiedSize)
+{
+    CHECK_CURRENT_CONTEXT;
+
+    if (!copiedSize) return;
+
+    const auto bufferSize = size();
+
+    if ((srcOffset + copiedSize > bufferSize) || (dstOffset + copiedSize > bufferSize))
+    {
+        LOG_ERROR << "The range of copied data is out of range";
+        return;
+    }
+
+    std::memmove(m_data.data() + dstOffset, m_data.data() + srcOffset, copiedSize);
+    if (auto renderer = currentHeadlessRenderer()) renderer->frameRecord().numBytesCopied += copiedSize;
+}
+
+std::unique_ptr<core::graphics::IBuffer::MappedData> HeadlessDynamicBuffer::map(MapAccess access, size_t offset, size_t size)
+{
+    CHECK_CURRENT_CONTEXT;
+    return mapImpl(access, offset, size, HeadlessDynamicBuffer::size());
+}
+
+std::unique_ptr<const core::graphics::IBuffer::MappedData> HeadlessDynamicBuffer::map(
+    MapAccess access,
+    size_t offset,
+    size_t size) const
+{
+    CHECK_CURRENT_CONTEXT;
+    return const_cast<HeadlessDynamicBuffer*>(this)->map(access, offset, size);
+}
+
+std::shared_ptr<HeadlessDynamicBuffer> HeadlessDynamicBuffer::create(size_t size, const void* data)
+{
+    return std::make_shared<HeadlessDynamicBuffer>(size, data);
+}
+
+// HeadlessVertexArray
+
+HeadlessVertexArray::HeadlessVertexArray()
+{
+    SAVE_CURRENT_CONTEXT;
+}
+
+HeadlessVertexArray::~HeadlessVertexArray() = default;
+
+uint32_t HeadlessVertexArray::attachVertexBuffer(const core::graphics::PConstBuffer& buffer, size_t offset, size_t stride)
+{
+    CHECK_CURRENT_CONTEXT;
+    if (!buffer) LOG_CRITICAL << "Buffer can't be nullptr";
+
+    auto declaration = VertexBufferDeclaration{buffer, offset, stride};
+
+    if (auto it = std::find(m_vertexBuffers.begin(), m_vertexBuffers.end(), declaration); it != m_vertexBuffers.end())
+        return static_cast<uint32_t>(it - m_vertexBuffers.begin());
+
+    auto it = std::find_if(
+        m_vertexBuffers.begin(), m_vertexBuffers.end(), [](const VertexBufferDeclaration& v) { return v.buffer == nullptr; });
+    auto bindingIndex = static_cast<uint32_t>(it - m_vertexBuffers.begin());
+    if (it == m_vertexBuffers.end()) m_vertexBuffers.resize(m_vertexBuffers.size() + 1);
+    m_vertexBuffers[bindingIndex] = declaration;
+
+    return bindingIndex;
+}
+
+void HeadlessVertexArray::detachVertexBuffer(uint32_t bindingIndex)
+{
+    CHECK_CURRENT_CONTEXT;
+    m_vertexBuffers[bindingIndex] = VertexBufferDeclaration{nullptr, 0u, 0u};
+
+    for (const auto& [attrib, attributeDeclaration] : m_attributes)
+        if (attributeDeclaration.bindingIndex == bindingIndex)
+        {
+            undeclareVertexAttribute(attrib);
+            break;
+        }
+}
+
+core::graphics::PConstBuffer HeadlessVertexArray::vertexBuffer(uint32_t bindingIndex) const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_vertexBuffers[bindingIndex].buffer;
+}
+
+size_t HeadlessVertexArray::vertexBufferOffset(uint32_t bindingIndex) const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_vertexBuffers[bindingIndex].offset;
+}
+
+size_t HeadlessVertexArray::vertexBufferStride(uint32_t bindingIndex) const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_vertexBuffers[bindingIndex].stride;
+}
+
+void HeadlessVertexArray::declareVertexAttribute(
+    utils::VertexAttribute attrib,
+    uint32_t bindingIndex,
+    uint32_t numComponents,
+    utils::VertexComponentType type,
+    uint32_t relativeOffset)
+{
+    CHECK_CURRENT_CONTEXT;
+    if (numComponents < 1 || numComponents > 4) LOG_CRITICAL << "Num components must be [1..4]";
+
+    m_attributes[attrib] = AttributeDeclaration{bindingIndex, numComponents, type, relativeOffset};
+}
+
+void HeadlessVertexArray::undeclareVertexAttribute(utils::VertexAttribute attrib)
+{
+    CHECK_CURRENT_CONTEXT;
+    m_attributes.erase(attrib);
+}
+
+uint32_t HeadlessVertexArray::vertexAttributeBindingIndex(utils::VertexAttribute attrib) const
+{
+    CHECK_CURRENT_CONTEXT;
+    auto it = m_attributes.find(attrib);
+    return (it != m_attributes.end()) ? it->second.bindingIndex : static_cast<uint32_t>(-1);
+}
+
+uint32_t HeadlessVertexArray::vertexAttributeNumComponents(utils::VertexAttribute attrib) const
+{
+    CHECK_CURRENT_CONTEXT;
+    auto it = m_attributes.find(attrib);
+    return (it != m_attributes.end()) ? it->second.numComponents : 0u;
+}
+
+utils::VertexComponentType HeadlessVertexArray::vertexAttributeComponentType(utils::VertexAttribute attrib) const
+{
+    CHECK_CURRENT_CONTEXT;
+    auto it = m_attributes.find(attrib);
+    return (it != m_attributes.end()) ? it->second.componentType : utils::VertexComponentType::Count;
+}
+
+uint32_t HeadlessVertexArray::vertexAttributeRelativeOffset(utils::VertexAttribute attrib) const
+{
+    CHECK_CURRENT_CONTEXT;
+    auto it = m_attributes.find(attrib);
+    return (it != m_attributes.end()) ? it->second.relativeOffset : 0u;
+}
+
+void HeadlessVertexArray::attachIndexBuffer(const core::graphics::PConstBuffer& buffer)
+{
+    CHECK_CURRENT_CONTEXT;
+    if (!buffer) LOG_CRITICAL << "Buffer can't be nullptr";
+
+    m_indexBuffer = buffer;
+}
+
+void HeadlessVertexArray::detachIndexBuffer()
+{
+    CHECK_CURRENT_CONTEXT;
+    m_indexBuffer = nullptr;
+}
+
+core::graphics::PConstBuffer HeadlessVertexArray::indexBuffer() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_indexBuffer;
+}
+
+std::shared_ptr<HeadlessVertexArray> HeadlessVertexArray::create()
+{
+    return std::make_shared<HeadlessVertexArray>();
+}
+
+// HeadlessTexture
+
+HeadlessTexture::HeadlessTexture(
+    core::graphics::TextureType type,
+    const glm::uvec3& size,
+    core::graphics::PixelInternalFormat internalFormat,
+    uint32_t numLevels)
+    : m_type(type)
+    , m_size(size)
+    , m_internalFormat(internalFormat)
+    , m_numLevels(numLevels)
+{
+    SAVE_CURRENT_CONTEXT;
+}
+
+HeadlessTexture::~HeadlessTexture() = default;
+
+glm::uvec2 HeadlessTexture::size() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return mipmapSize(0u);
+}
+
+core::graphics::PixelInternalFormat HeadlessTexture::internalFormat() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_internalFormat;
+}
+
+bool HeadlessTexture::hasAlpha() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return pixelInternalFormatHasAlpha(m_internalFormat);
+}
+
+bool HeadlessTexture::hasDepth() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return pixelInternalFormatHasDepth(m_internalFormat);
+}
+
+core::graphics::TextureType HeadlessTexture::type() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_type;
+}
+
+glm::uvec3 HeadlessTexture::mipmapSize(uint32_t level) const
+{
+    CHECK_CURRENT_CONTEXT;
+    if (level >= m_numLevels) return glm::uvec3(0u);
+
+    auto result = glm::max(m_size >> glm::uvec3(level), glm::uvec3(1u));
+
+    // layers are not reduced
+    switch (m_type)
+    {
+        case core::graphics::TextureType::Type1DArray:
+        {
+            result.y = m_size.y;
+            break;
+        }
+        case core::graphics::TextureType::Type2DArray:
+        case core::graphics::TextureType::TypeCubeArray:
+        {
+            result.z = m_size.z;
+            break;
+        }
+        default:
+            break;
+    }
+
+    return result;
+}
+
+uint32_t HeadlessTexture::numMipmapLevels() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_numLevels;
+}
+
+uint32_t HeadlessTexture::numFaces() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return (m_type == core::graphics::TextureType::TypeCube) ? 6u : 1u;
+}
+
+void HeadlessTexture::setSubImage(
+    uint32_t,
+    const glm::uvec3&,
+    const glm::uvec3& size,
+    uint32_t numComponents,
+    utils::PixelComponentType type,
+    const void* data)
+{
+    CHECK_CURRENT_CONTEXT;
+    if (!data) return;
+
+    if (auto renderer = currentHeadlessRenderer())
+        renderer->frameRecord().numTextureBytesUploaded += pixelsDataSize(size, numComponents, type);
+}
+
+void HeadlessTexture::subImage(
+    uint32_t,
+    const glm::uvec3&,
+    const glm::uvec3& size,
+    uint32_t numComponents,
+    utils::PixelComponentType type,
+    size_t bufSize,
+    void* data) const
+{
+    CHECK_CURRENT_CONTEXT;
+    if (!data) return;
+
+    std::memset(data, 0, glm::min(bufSize, pixelsDataSize(size, numComponents, type)));
+
+    if (auto renderer = currentHeadlessRenderer()) ++renderer->frameStatistics().numGPUReadbacks;
+}
+
+void HeadlessTexture::generateMipmaps()
+{
+    CHECK_CURRENT_CONTEXT;
+}
+
+void HeadlessTexture::setBorderColor(const glm::vec4&)
+{
+    CHECK_CURRENT_CONTEXT;
+}
+
+void HeadlessTexture::setWrapMode(core::graphics::TextureWrapMode)
+{
+    CHECK_CURRENT_CONTEXT;
+}
+
+void HeadlessTexture::setFilterMode(core::graphics::TextureFilterMode)
+{
+    CHECK_CURRENT_CONTEXT;
+}
+
+void HeadlessTexture::setSwizzleMask(const core::graphics::TextureSwizzleMask&)
+{
+    CHECK_CURRENT_CONTEXT;
+}
+
+core::graphics::PTexture HeadlessTexture::copyEmpty() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return std::make_shared<HeadlessTexture>(m_type, m_size, m_internalFormat, m_numLevels);
+}
+
+core::graphics::PTexture HeadlessTexture::copy() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return copyEmpty();
+}
+
+std::shared_ptr<HeadlessTexture> HeadlessTexture::createEmpty(
+    core::graphics::TextureType type,
+    const glm::uvec3& size,
+    core::graphics::PixelInternalFormat internalFormat,
+    uint32_t numLevels)
+{
+    if (size.x * size.y * size.z == 0u) LOG_CRITICAL << "Texture size can't be 0";
+
+    if (internalFormat == core::graphics::PixelInternalFormat::Count) LOG_CRITICAL << "Undefined pixel internal format";
+
+    auto mipmappedSize = size;
+    switch (type)
+    {
+        case core::graphics::TextureType::Type1DArray:
+        {
+            mipmappedSize.y = 1u;
+            break;
+        }
+        case core::graphics::TextureType::Type2DArray:
+        case core::graphics::TextureType::TypeCubeArray:
+        {
+            mipmappedSize.z = 1u;
+            break;
+        }
+        default:
+            break;
+    }
+
+    auto numMipmapLevels = (type == core::graphics::TextureType::TypeRect) ? 1u
+                                                                            : static_cast<uint32_t>(glm::levels(mipmappedSize));
+    if (numLevels == 0u) numLevels = numMipmapLevels;
+    numLevels = glm::min(numLevels, numMipmapLevels);
+
+    return std::make_shared<HeadlessTexture>(type, size, internalFormat, numLevels);
+}
+
+std::shared_ptr<HeadlessTexture> HeadlessTexture::create(
+    core::graphics::TextureType type,
+    const std::vector<std::shared_ptr<const utils::Image>>& images,
+    core::graphics::PixelInternalFormat internalFormat,
+    uint32_t numLevels,
+    bool genMipmaps)
+{
+    if (images.empty()) LOG_CRITICAL << "Images count can't be 0";
+
+    for (const auto& image : images)
+        if (!image) LOG_CRITICAL << "Image can't be nullptr";
+
+    auto width = images[0u]->width();
+    auto height = images[0u]->height();
+    auto numComponents = images[0u]->numComponents();
+    auto componentType = images[0u]->type();
+
+    for (const auto& image : images)
+        if ((width != image->width()) || (height != image->height()) || (numComponents != image->numComponents()) ||
+            (componentType != image->type()))
+            LOG_CRITICAL << "All the images must be the the same size, components count and component pixel type";
+
+    if (internalFormat == core::graphics::PixelInternalFormat::Count)
+        internalFormat = core::graphics::pixelNumComponentsAndPixelComponentTypeToPixelInternalFormat(numComponents, componentType);
+
+    const auto numImages = static_cast<uint32_t>(images.size());
+    glm::uvec3 size(width, height, 1u);
+    switch (type)
+    {
+        case core::graphics::TextureType::Type1D:
+        {
+            size.y = 1u;
+            break;
+        }
+        case core::graphics::TextureType::Type1DArray:
+        {
+            size.y = numImages;
+            break;
+        }
+        case core::graphics::TextureType::Type3D:
+        case core::graphics::TextureType::Type2DArray:
+        case core::graphics::TextureType::TypeCubeArray:
+        {
+            size.z = numImages;
+            break;
+        }
+        default:
+            break;
+    }
+
+    auto result = createEmpty(type, size, internalFormat, numLevels);
+    for (uint32_t i = 0u; i < numImages; ++i)
+        result->setSubImage(
+            0u, glm::uvec3(0u), glm::uvec3(width, (type == core::graphics::TextureType::Type1D) ? 1u : height, 1u),
+            numComponents, componentType, images[i]->data());
+
+    if (genMipmaps) result->generateMipmaps();
+
+    return result;
+}
+
+// HeadlessTextureHandle
+
+HeadlessTextureHandle::HeadlessTextureHandle(const core::graphics::PConstTexture& texture)
+    : m_id(nextHandle())
+    , m_texture(texture)
+{
+    SAVE_CURRENT_CONTEXT;
+}
+
+HeadlessTextureHandle::~HeadlessTextureHandle() = default;
+
+core::graphics::TextureHandle HeadlessTextureHandle::handle() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_id;
+}
+
+core::graphics::PConstTexture HeadlessTextureHandle::texture() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_texture;
+}
+
+void HeadlessTextureHandle::makeResident()
+{
+    CHECK_CURRENT_CONTEXT;
+}
+
+void HeadlessTextureHandle::doneResident()
+{
+    CHECK_CURRENT_CONTEXT;
+}
+
+std::shared_ptr<HeadlessTextureHandle> HeadlessTextureHandle::create(const core::graphics::PConstTexture& texture)
+{
+    if (!texture) LOG_CRITICAL << "Texture can't be nullptr";
+    return std::make_shared<HeadlessTextureHandle>(texture);
+}
+
+// HeadlessImageHandle
+
+HeadlessImageHandle::HeadlessImageHandle(const core::graphics::PConstImage& image)
+    : m_id(nextHandle())
+    , m_image(image)
+{
+    SAVE_CURRENT_CONTEXT;
+}
+
+HeadlessImageHandle::~HeadlessImageHandle() = default;
+
+core::graphics::TextureHandle HeadlessImageHandle::handle() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_id;
+}
+
+core::graphics::PConstImage HeadlessImageHandle::image() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_image;
+}
+
+void HeadlessImageHandle::makeResident()
+{
+    CHECK_CURRENT_CONTEXT;
+}
+
+void HeadlessImageHandle::doneResident()
+{
+    CHECK_CURRENT_CONTEXT;
+}
+
+std::shared_ptr<HeadlessImageHandle> HeadlessImageHandle::create(const core::graphics::PConstImage& image)
+{
+    if (!image) LOG_CRITICAL << "Image can't be nullptr";
+    return std::make_shared<HeadlessImageHandle>(image);
+}
+
+// HeadlessTimestampQuery
+
+HeadlessTimestampQuery::HeadlessTimestampQuery()
+{
+    SAVE_CURRENT_CONTEXT;
+}
+
+HeadlessTimestampQuery::~HeadlessTimestampQuery() = default;
+
+void HeadlessTimestampQuery::record()
+{
+    CHECK_CURRENT_CONTEXT;
+    m_time = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+bool HeadlessTimestampQuery::isAvailable() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return true;
+}
+
+uint64_t HeadlessTimestampQuery::time() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_time;
+}
+
+std::shared_ptr<HeadlessTimestampQuery> HeadlessTimestampQuery::create()
+{
+    return std::make_shared<HeadlessTimestampQuery>();
+}
+
+// HeadlessBufferReadback
+
+HeadlessBufferReadback::HeadlessBufferReadback(size_t size)
+    : m_data(size, 0u)
+{
+    SAVE_CURRENT_CONTEXT;
+}
+
+HeadlessBufferReadback::~HeadlessBufferReadback() = default;
+
+size_t HeadlessBufferReadback::size() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_data.size();
+}
+
+void HeadlessBufferReadback::record(const core::graphics::PConstBuffer& buffer, size_t offset)
+{
+    CHECK_CURRENT_CONTEXT;
+    auto headlessBuffer = std::dynamic_pointer_cast<const HeadlessBufferBase>(buffer);
+    if (!headlessBuffer) LOG_CRITICAL << "Buffer can't be nullptr";
+
+    const auto& bufferData = headlessBuffer->data();
+    const auto size = (offset < bufferData.size()) ? glm::min(m_data.size(), bufferData.size() - offset) : size_t(0u);
+    std::memcpy(m_data.data(), bufferData.data() + offset, size);
+    m_isRecorded = true;
+
+    if (auto renderer = currentHeadlessRenderer()) renderer->frameRecord().numBytesCopied += size;
+}
+
+bool HeadlessBufferReadback::isAvailable() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_isRecorded;
+}
+
+const uint8_t* HeadlessBufferReadback::data() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_data.data();
+}
+
+std::shared_ptr<HeadlessBufferReadback> HeadlessBufferReadback::create(size_t size)
+{
+    return std::make_shared<HeadlessBufferReadback>(size);
+}
+
+// HeadlessRenderBuffer
+
+HeadlessRenderBuffer::HeadlessRenderBuffer(uint32_t width, uint32_t height, core::graphics::PixelInternalFormat internalFormat)
+    : m_size(width, height)
+    , m_internalFormat(internalFormat)
+{
+    SAVE_CURRENT_CONTEXT;
+}
+
+HeadlessRenderBuffer::~HeadlessRenderBuffer() = default;
+
+glm::uvec2 HeadlessRenderBuffer::size() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_size;
+}
+
+core::graphics::PixelInternalFormat HeadlessRenderBuffer::internalFormat() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_internalFormat;
+}
+
+bool HeadlessRenderBuffer::hasAlpha() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return pixelInternalFormatHasAlpha(m_internalFormat);
+}
+
+bool HeadlessRenderBuffer::hasDepth() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return pixelInternalFormatHasDepth(m_internalFormat);
+}
+
+std::shared_ptr<HeadlessRenderBuffer> HeadlessRenderBuffer::create(
+    uint32_t width,
+    uint32_t height,
+    core::graphics::PixelInternalFormat internalFormat)
+{
+    if (width * height == 0u) LOG_CRITICAL << "Width and height can't be 0";
+    if (internalFormat == core::graphics::PixelInternalFormat::Count) LOG_CRITICAL << "Undefined pixel internal format";
+
+    return std::make_shared<HeadlessRenderBuffer>(width, height, internalFormat);
+}
+
+// HeadlessFrameBufferBase
+
+HeadlessFrameBufferBase::~HeadlessFrameBufferBase() = default;
+
+bool HeadlessFrameBufferBase::isComplete() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return !m_attachments.empty();
+}
+
+void HeadlessFrameBufferBase::clear(const std::unordered_set<core::graphics::FrameBufferAttachment>&)
+{
+    CHECK_CURRENT_CONTEXT;
+    if (auto renderer = currentHeadlessRenderer()) renderer->recordCommand({HeadlessCommandType::ClearFrameBuffer});
+}
+
+void HeadlessFrameBufferBase::setDefaultClearDepth(float value)
+{
+    m_defaultClearDepth = value;
+}
+
+void HeadlessFrameBufferBase::setDefaultDepthFunc(core::graphics::ComparingFunc value)
+{
+    m_defaultDepthFunc = value;
+}
+
+void HeadlessFrameBufferBase::reset()
+{
+    detachAll();
+
+    for (uint32_t i = 0; i < core::graphics::FrameBufferColorAttachmentsCount(); ++i)
+        setClearColor(i, glm::vec4(.5f, .5f, 1.f, 1.f));
+
+    setClearDepth(m_defaultClearDepth);
+
+    setClearStencil(0x00u);
+
+    setFaceCulling(false);
+
+    setColorMasks(false);
+
+    setDepthTest(false);
+    setDepthFunc(m_defaultDepthFunc);
+    setDepthMask(false);
+
+    setStencilTest(false);
+
+    setBlending(false);
+    setBlendConstantColor(glm::vec3(1.f));
+    setBlendConstantAlpha(1.f);
+    for (uint32_t i = 0; i < core::graphics::FrameBufferColorAttachmentsCount(); ++i)
+    {
+        setBlendEquation(i, core::graphics::BlendEquation::Add, core::graphics::BlendEquation::Add);
+        setBlendFactor(
+            i, core::graphics::BlendFactor::Zero, core::graphics::BlendFactor::One, core::graphics::BlendFactor::Zero,
+            core::graphics::BlendFactor::One);
+    }
+
+    setClipDistances(false);
+}
+
+std::shared_ptr<const core::graphics::ISurface> HeadlessFrameBufferBase::attachmentSurface(
+    core::graphics::FrameBufferAttachment value) const
+{
+    CHECK_CURRENT_CONTEXT;
+    std::shared_ptr<const core::graphics::ISurface> result;
+    if (auto it = m_attachments.find(value); it != m_attachments.end()) result = it->second.surface;
+    return result;
+}
+
+uint32_t HeadlessFrameBufferBase::attachmentMipmapLevel(core::graphics::FrameBufferAttachment value) const
+{
+    CHECK_CURRENT_CONTEXT;
+    auto result = static_cast<uint32_t>(-1);
+    if (auto it = m_attachments.find(value); it != m_attachments.end()) result = it->second.mipmapLevel;
+    return result;
+}
+
+uint32_t HeadlessFrameBufferBase::attachmentLayer(core::graphics::FrameBufferAttachment value) const
+{
+    CHECK_CURRENT_CONTEXT;
+    auto result = static_cast<uint32_t>(-1);
+    if (auto it = m_attachments.find(value); it != m_attachments.end()) result = it->second.layer;
+    return result;
+}
+
+const core::graphics::FrameBufferClearColor& HeadlessFrameBufferBase::clearColor(uint32_t index) const
+{
+    CHECK_CURRENT_CONTEXT;
+    if (index >= core::graphics::FrameBufferColorAttachmentsCount())
+        LOG_CRITICAL << "Index must be less than " << core::graphics::FrameBufferColorAttachmentsCount();
+
+    return m_clearColor[index];
+}
+
+void HeadlessFrameBufferBase::setClearColor(uint32_t index, const glm::vec4& value)
+{
+    CHECK_CURRENT_CONTEXT;
+    if (index >= core::graphics::FrameBufferColorAttachmentsCount())
+        LOG_CRITICAL << "Index must be less than " << core::graphics::FrameBufferColorAttachmentsCount();
+
+    m_clearColor[index] = value;
+}
+
+void HeadlessFrameBufferBase::setClearColor(uint32_t index, const glm::i32vec4& value)
+{
+    CHECK_CURRENT_CONTEXT;
+    if (index >= core::graphics::FrameBufferColorAttachmentsCount())
+        LOG_CRITICAL << "Index must be less than " << core::graphics::FrameBufferColorAttachmentsCount();
+
+    m_clearColor[index] = value;
+}
+
+void HeadlessFrameBufferBase::setClearColor(uint32_t index, const glm::u32vec4& value)
+{
+    CHECK_CURRENT_CONTEXT;
+    if (index >= core::graphics::FrameBufferColorAttachmentsCount())
+        LOG_CRITICAL << "Index must be less than " << core::graphics::FrameBufferColorAttachmentsCount();
+
+    m_clearColor[index] = value;
+}
+
+float HeadlessFrameBufferBase::clearDepth() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_clearDepth;
+}
+
+void HeadlessFrameBufferBase::setClearDepth(float value)
+{
+    CHECK_CURRENT_CONTEXT;
+    m_clearDepth = value;
+}
+
+int32_t HeadlessFrameBufferBase::clearStencil() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_clearStencil;
+}
+
+void HeadlessFrameBufferBase::setClearStencil(uint8_t value)
+{
+    CHECK_CURRENT_CONTEXT;
+    m_clearStencil = value;
+}
+
+bool HeadlessFrameBufferBase::faceCulling() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_faceCulling;
+}
+
+core::graphics::FaceType HeadlessFrameBufferBase::cullFaceType() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_cullFaceType;
+}
+
+void HeadlessFrameBufferBase::setFaceCulling(bool value, core::graphics::FaceType type)
+{
+    CHECK_CURRENT_CONTEXT;
+    m_faceCulling = value;
+    m_cullFaceType = type;
+}
+
+bool HeadlessFrameBufferBase::colorMask(uint32_t index) const
+{
+    CHECK_CURRENT_CONTEXT;
+    if (index >= m_colorMasks.size()) LOG_CRITICAL << "Index must be less than " << m_colorMasks.size();
+
+    return m_colorMasks[index];
+}
+
+void HeadlessFrameBufferBase::setColorMask(uint32_t index, bool value)
+{
+    CHECK_CURRENT_CONTEXT;
+    if (index >= m_colorMasks.size()) LOG_CRITICAL << "Index must be less than " << m_colorMasks.size();
+
+    m_colorMasks[index] = value;
+}
+
+void HeadlessFrameBufferBase::setColorMasks(bool value)
+{
+    CHECK_CURRENT_CONTEXT;
+    (value) ? m_colorMasks.set() : m_colorMasks.reset();
+}
+
+bool HeadlessFrameBufferBase::depthTest() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_depthTest;
+}
+
+void HeadlessFrameBufferBase::setDepthTest(bool value)
+{
+    CHECK_CURRENT_CONTEXT;
+    m_depthTest = value;
+}
+
+core::graphics::ComparingFunc HeadlessFrameBufferBase::depthFunc() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_depthFunc;
+}
+
+void HeadlessFrameBufferBase::setDepthFunc(core::graphics::ComparingFunc value)
+{
+    CHECK_CURRENT_CONTEXT;
+    m_depthFunc = value;
+}
+
+bool HeadlessFrameBufferBase::depthMask() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_depthMask;
+}
+
+void HeadlessFrameBufferBase::setDepthMask(bool value)
+{
+    CHECK_CURRENT_CONTEXT;
+    m_depthMask = value;
+}
+
+bool HeadlessFrameBufferBase::stencilTest() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_stencilTest;
+}
+
+void HeadlessFrameBufferBase::setStencilTest(bool value)
+{
+    CHECK_CURRENT_CONTEXT;
+    m_stencilTest = value;
+}
+
+core::graphics::ComparingFunc HeadlessFrameBufferBase::stencilComparingFunc(core::graphics::FaceType value) const
+{
+    CHECK_CURRENT_CONTEXT;
+    auto result = core::graphics::ComparingFunc::Always;
+
+    switch (value)
+    {
+        case core::graphics::FaceType::Front:
+            result = m_stencilComparingFuncFrontFace;
+            break;
+        case core::graphics::FaceType::Back:
+            result = m_stencilComparingFuncBackFace;
+            break;
+        default:
+            LOG_CRITICAL << "Face type must be Front or Back";
+            break;
+    }
+
+    return result;
+}
+
+uint8_t HeadlessFrameBufferBase::stencilReferenceValue(core::graphics::FaceType value) const
+{
+    CHECK_CURRENT_CONTEXT;
+    uint8_t result = 0x00u;
+
+    switch (value)
+    {
+        case core::graphics::FaceType::Front:
+            result = m_stencilRefFrontFace;
+            break;
+        case core::graphics::FaceType::Back:
+            result = m_stencilRefBackFace;
+            break;
+        default:
+            LOG_CRITICAL << "Face type must be Front or Back";
+            break;
+    }
+
+    return result;
+}
+
+uint8_t HeadlessFrameBufferBase::stencilMaskValue(core::graphics::FaceType value) const
+{
+    CHECK_CURRENT_CONTEXT;
+    uint8_t result = 0x00u;
+
+    switch (value)
+    {
+        case core::graphics::FaceType::Front:
+            result = m_stencilMaskFrontFace;
+            break;
+        case core::graphics::FaceType::Back:
+            result = m_stencilMaskBackFace;
+            break;
+        default:
+            LOG_CRITICAL << "Face type must be Front or Back";
+            break;
+    }
+
+    return result;
+}
+
+void HeadlessFrameBufferBase::setStencilFunc(
+    core::graphics::FaceType face,
+    core::graphics::ComparingFunc func,
+    uint8_t ref,
+    uint8_t mask)
+{
+    CHECK_CURRENT_CONTEXT;
+    switch (face)
+    {
+        case core::graphics::FaceType::Front:
+            m_stencilComparingFuncFrontFace = func;
+            m_stencilRefFrontFace = ref;
+            m_stencilMaskFrontFace = mask;
+            break;
+        case core::graphics::FaceType::Back:
+            m_stencilComparingFuncBackFace = func;
+            m_stencilRefBackFace = ref;
+            m_stencilMaskBackFace = mask;
+            break;
+        case core::graphics::FaceType::FrontAndBack:
+            m_stencilComparingFuncFrontFace = m_stencilComparingFuncBackFace = func;
+            m_stencilRefFrontFace = m_stencilRefBackFace = ref;
+            m_stencilMaskFrontFace = m_stencilMaskBackFace = mask;
+            break;
+        default:
+            LOG_CRITICAL << "Face type must be Front, Back or FrontAndBack";
+            break;
+    }
+}
+
+const core::graphics::StencilOperations& HeadlessFrameBufferBase::stencilOperations(core::graphics::FaceType value) const
+{
+    CHECK_CURRENT_CONTEXT;
+    static core::graphics::StencilOperations errorResult;
+
+    switch (value)
+    {
+        case core::graphics::FaceType::Front:
+            return m_stencilOperationsFrontFace;
+        case core::graphics::FaceType::Back:
+            return m_stencilOperationsBackFace;
+        default:
+            LOG_CRITICAL << "Face type must be Front or Back";
+            break;
+    }
+
+    return errorResult;
+}
+
+void HeadlessFrameBufferBase::setStencilOperations(core::graphics::FaceType face, const core::graphics::StencilOperations& value)
+{
+    CHECK_CURRENT_CONTEXT;
+    switch (face)
+    {
+        case core::graphics::FaceType::Front:
+            m_stencilOperationsFrontFace = value;
+            break;
+        case core::graphics::FaceType::Back:
+            m_stencilOperationsBackFace = value;
+            break;
+        case core::graphics::FaceType::FrontAndBack:
+            m_stencilOperationsFrontFace = m_stencilOperationsBackFace = value;
+            break;
+        default:
+            LOG_CRITICAL << "Face type must be Front, Back or FrontAndBack";
+            break;
+    }
+}
+
+bool HeadlessFrameBufferBase::blending() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_blending;
+}
+
+void HeadlessFrameBufferBase::setBlending(bool value)
+{
+    CHECK_CURRENT_CONTEXT;
+    m_blending = value;
+}
+
+core::graphics::BlendEquation HeadlessFrameBufferBase::blendColorEquation(uint32_t index) const
+{
+    CHECK_CURRENT_CONTEXT;
+    if (index >= core::graphics::FrameBufferColorAttachmentsCount())
+        LOG_CRITICAL << "Index must be less than " << core::graphics::FrameBufferColorAttachmentsCount();
+
+    return m_blendColorEquation[index];
+}
+
+core::graphics::BlendEquation HeadlessFrameBufferBase::blendAlphaEquation(uint32_t index) const
+{
+    CHECK_CURRENT_CONTEXT;
+    if (index >= core::graphics::FrameBufferColorAttachmentsCount())
+        LOG_CRITICAL << "Index must be less than " << core::graphics::FrameBufferColorAttachmentsCount();
+
+    return m_blendAlphaEquation[index];
+}
+
+void HeadlessFrameBufferBase::setBlendEquation(
+    uint32_t index,
+    core::graphics::BlendEquation colorValue,
+    core::graphics::BlendEquation alphaValue)
+{
+    CHECK_CURRENT_CONTEXT;
+    if (index >= core::graphics::FrameBufferColorAttachmentsCount())
+        LOG_CRITICAL << "Index must be less than " << core::graphics::FrameBufferColorAttachmentsCount();
+
+    m_blendColorEquation[index] = colorValue;
+    m_blendAlphaEquation[index] = alphaValue;
+}
+
+core::graphics::BlendFactor HeadlessFrameBufferBase::blendColorSourceFactor(uint32_t index) const
+{
+    CHECK_CURRENT_CONTEXT;
+    if (index >= core::graphics::FrameBufferColorAttachmentsCount())
+        LOG_CRITICAL << "Index must be less than " << core::graphics::FrameBufferColorAttachmentsCount();
+
+    return m_blendColorSourceFactor[index];
+}
+
+core::graphics::BlendFactor HeadlessFrameBufferBase::blendAlphaSourceFactor(uint32_t index) const
+{
+    CHECK_CURRENT_CONTEXT;
+    if (index >= core::graphics::FrameBufferColorAttachmentsCount())
+        LOG_CRITICAL << "Index must be less than " << core::graphics::FrameBufferColorAttachmentsCount();
+
+    return m_blendAlphaSourceFactor[index];
+}
+
+core::graphics::BlendFactor HeadlessFrameBufferBase::blendColorDestinationFactor(uint32_t index) const
+{
+    CHECK_CURRENT_CONTEXT;
+    if (index >= core::graphics::FrameBufferColorAttachmentsCount())
+        LOG_CRITICAL << "Index must be less than " << core::graphics::FrameBufferColorAttachmentsCount();
+
+    return m_blendColorDestFactor[index];
+}
+
+core::graphics::BlendFactor HeadlessFrameBufferBase::blendAlphaDestinationFactor(uint32_t index) const
+{
+    CHECK_CURRENT_CONTEXT;
+    if (index >= core::graphics::FrameBufferColorAttachmentsCount())
+        LOG_CRITICAL << "Index must be less than " << core::graphics::FrameBufferColorAttachmentsCount();
+
+    return m_blendAlphaDestFactor[index];
+}
+
+void HeadlessFrameBufferBase::setBlendFactor(
+    uint32_t index,
+    core::graphics::BlendFactor colorSourceValue,
+    core::graphics::BlendFactor colorDestValue,
+    core::graphics::BlendFactor alphaSourceValue,
+    core::graphics::BlendFactor alphaDestValue)
+{
+    CHECK_CURRENT_CONTEXT;
+    if (index >= core::graphics::FrameBufferColorAttachmentsCount())
+        LOG_CRITICAL << "Index must be less than " << core::graphics::FrameBufferColorAttachmentsCount();
+
+    m_blendColorSourceFactor[index] = colorSourceValue;
+    m_blendColorDestFactor[index] = colorDestValue;
+    m_blendAlphaSourceFactor[index] = alphaSourceValue;
+    m_blendAlphaDestFactor[index] = alphaDestValue;
+}
+
+glm::vec3 HeadlessFrameBufferBase::blendConstantColor() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_blendConstColor;
+}
+
+void HeadlessFrameBufferBase::setBlendConstantColor(const glm::vec3& value)
+{
+    CHECK_CURRENT_CONTEXT;
+    m_blendConstColor = value;
+}
+
+float HeadlessFrameBufferBase::blendConstantAlpha() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_blendConstAlpha;
+}
+
+void HeadlessFrameBufferBase::setBlendConstantAlpha(float value)
+{
+    CHECK_CURRENT_CONTEXT;
+    m_blendConstAlpha = value;
+}
+
+bool HeadlessFrameBufferBase::clipDistance(uint32_t index) const
+{
+    CHECK_CURRENT_CONTEXT;
+    if (index >= m_clipDistances.size()) LOG_CRITICAL << "Index must be less than " << m_clipDistances.size();
+
+    return m_clipDistances[index];
+}
+
+void HeadlessFrameBufferBase::setClipDistance(uint32_t index, bool state)
+{
+    CHECK_CURRENT_CONTEXT;
+    if (index >= m_clipDistances.size()) LOG_CRITICAL << "Index must be less than " << m_clipDistances.size();
+
+    m_clipDistances[index] = state;
+}
+
+void HeadlessFrameBufferBase::setClipDistances(bool state)
+{
+    CHECK_CURRENT_CONTEXT;
+    state ? m_clipDistances.set() : m_clipDistances.reset();
+}
+
+HeadlessFrameBufferBase::HeadlessFrameBufferBase()
+{
+    SAVE_CURRENT_CONTEXT;
+}
+
+// HeadlessFrameBuffer
+
+HeadlessFrameBuffer::HeadlessFrameBuffer()
+    : HeadlessFrameBufferBase()
+{
+    SAVE_CURRENT_CONTEXT;
+}
+
+HeadlessFrameBuffer::~HeadlessFrameBuffer() = default;
+
+void HeadlessFrameBuffer::attach(
+    core::graphics::FrameBufferAttachment key,
+    std::shared_ptr<const core::graphics::ISurface> surface,
+    uint32_t level)
+{
+    CHECK_CURRENT_CONTEXT;
+    if (!surface) LOG_CRITICAL << "Attachment can't be nullptr";
+
+    m_attachments[key] = {surface, level, 0u};
+}
+
+void HeadlessFrameBuffer::attachLayer(
+    core::graphics::FrameBufferAttachment key,
+    std::shared_ptr<const core::graphics::ITexture> texture,
+    uint32_t level,
+    uint32_t layer)
+{
+    CHECK_CURRENT_CONTEXT;
+    if (!texture) LOG_CRITICAL << "Attachment can't be nullptr";
+
+    m_attachments[key] = {texture, level, layer};
+}
+
+void HeadlessFrameBuffer::detach(core::graphics::FrameBufferAttachment key)
+{
+    CHECK_CURRENT_CONTEXT;
+    m_attachments.erase(key);
+}
+
+void HeadlessFrameBuffer::detachAll()
+{
+    CHECK_CURRENT_CONTEXT;
+    m_attachments.clear();
+}
+
+std::shared_ptr<HeadlessFrameBuffer> HeadlessFrameBuffer::create()
+{
+    auto result = std::make_shared<HeadlessFrameBuffer>();
+    result->reset();
+    return result;
+}
+
+// HeadlessDefaultFrameBuffer
+
+HeadlessDefaultFrameBuffer::HeadlessDefaultFrameBuffer()
+    : HeadlessFrameBufferBase()
+{
+    SAVE_CURRENT_CONTEXT;
+
+    m_attachments[core::graphics::FrameBufferAttachment::Depth] = {nullptr, 0, 0};
+    m_attachments[core::graphics::FrameBufferAttachment::Stencil] = {nullptr, 0, 0};
+    m_attachments[core::graphics::FrameBufferColorAttachment(0u)] = {nullptr, 0, 0};
+}
+
+HeadlessDefaultFrameBuffer::~HeadlessDefaultFrameBuffer() = default;
+
+void HeadlessDefaultFrameBuffer::attach(
+    core::graphics::FrameBufferAttachment,
+    std::shared_ptr<const core::graphics::ISurface>,
+    uint32_t)
+{
+    CHECK_CURRENT_CONTEXT;
+}
+
+void HeadlessDefaultFrameBuffer::attachLayer(
+    core::graphics::FrameBufferAttachment,
+    std::shared_ptr<const core::graphics::ITexture>,
+    uint32_t,
+    uint32_t)
+{
+    CHECK_CURRENT_CONTEXT;
+}
+
+void HeadlessDefaultFrameBuffer::detach(core::graphics::FrameBufferAttachment)
+{
+    CHECK_CURRENT_CONTEXT;
+}
+
+void HeadlessDefaultFrameBuffer::detachAll()
+{
+    CHECK_CURRENT_CONTEXT;
+}
+
+std::shared_ptr<HeadlessDefaultFrameBuffer> HeadlessDefaultFrameBuffer::create()
+{
+    auto result = std::make_shared<HeadlessDefaultFrameBuffer>();
+    result->reset();
+    return result;
+}
+
+// HeadlessProgramBase
+
+HeadlessProgramBase::HeadlessProgramBase()
+{
+    SAVE_CURRENT_CONTEXT;
+}
+
+HeadlessProgramBase::~HeadlessProgramBase() = default;
+
+bool HeadlessProgramBase::binary(core::graphics::ProgramBinary&) const
+{
+    CHECK_CURRENT_CONTEXT;
+    return false;
+}
+
+const std::vector<core::graphics::UniformInfo>& HeadlessProgramBase::uniformsInfo() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_uniformsInfo;
+}
+
+const std::vector<core::graphics::UniformBlockInfo>& HeadlessProgramBase::uniformBlocksInfo() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_uniformBlocksInfo;
+}
+
+const std::vector<core::graphics::ShaderStorageBlockInfo>& HeadlessProgramBase::shaderStorageBlocksInfo() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_shaderStorageBlocksInfo;
+}
+
+std::string HeadlessProgramBase::uniformNameByIndex(uint16_t) const
+{
+    CHECK_CURRENT_CONTEXT;
+    return std::string();
+}
+
+std::string HeadlessProgramBase::bufferVariableNameByIndex(uint16_t) const
+{
+    CHECK_CURRENT_CONTEXT;
+    return std::string();
+}
+
+std::string HeadlessProgramBase::uniformBlockNameByIndex(uint16_t) const
+{
+    CHECK_CURRENT_CONTEXT;
+    return std::string();
+}
+
+std::string HeadlessProgramBase::shaderStorageBlockNameByIndex(uint16_t) const
+{
+    CHECK_CURRENT_CONTEXT;
+    return std::string();
+}
+
+// HeadlessRenderProgram
+
+HeadlessRenderProgram::HeadlessRenderProgram()
+    : HeadlessProgramBase()
+{
+    SAVE_CURRENT_CONTEXT;
+}
+
+HeadlessRenderProgram::~HeadlessRenderProgram() = default;
+
+const std::vector<core::graphics::AttributeInfo>& HeadlessRenderProgram::attributesInfo() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_attributesInfo;
+}
+
+std::string HeadlessRenderProgram::attributeNameByIndex(uint16_t) const
+{
+    CHECK_CURRENT_CONTEXT;
+    return std::string();
+}
+
+const std::vector<core::graphics::OutputInfo>& HeadlessRenderProgram::outputsInfo() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_outputInfo;
+}
+
+std::string HeadlessRenderProgram::outputNameByIndex(uint16_t) const
+{
+    CHECK_CURRENT_CONTEXT;
+    return std::string();
+}
+
+std::shared_ptr<HeadlessRenderProgram> HeadlessRenderProgram::create(
+    const std::shared_ptr<utils::Shader>& vertexShader,
+    const std::shared_ptr<utils::Shader>&,
+    const std::shared_ptr<utils::Shader>& fragmentShader)
+{
+    if (!vertexShader) LOG_CRITICAL << "Vertex shader can't be nullptr";
+    if (!fragmentShader) LOG_CRITICAL << "Fragment shader can't be nullptr";
+
+    return std::make_shared<HeadlessRenderProgram>();
+}
+
+// HeadlessComputeProgram
+
+HeadlessComputeProgram::HeadlessComputeProgram(const glm::uvec3& workGroupSize)
+    : HeadlessProgramBase()
+    , m_workGroupSize(workGroupSize)
+{
+    SAVE_CURRENT_CONTEXT;
+}
+
+HeadlessComputeProgram::~HeadlessComputeProgram() = default;
+
+glm::uvec3 HeadlessComputeProgram::workGroupSize() const
+{
+    CHECK_CURRENT_CONTEXT;
+    return m_workGroupSize;
+}
+
+std::shared_ptr<HeadlessComputeProgram> HeadlessComputeProgram::create(const std::shared_ptr<utils::Shader>& computeShader)
+{
+    if (!computeShader) LOG_CRITICAL << "Compute shader can't be nullptr";
+
+    // the work group size is the only thing that core asks from compute programs, so it is parsed from the source
+    static const std::array<std::regex, 3u> s_localSizeRegex{
+        std::regex(R"(local_size_x\s*=\s*(\d+))"), std::regex(R"(local_size_y\s*=\s*(\d+))"),
+        std::regex(R"(local_size_z\s*=\s*(\d+))")};
+
+    glm::uvec3 workGroupSize(1u);
+    for (glm::length_t i = 0; i < 3; ++i)
+        if (std::smatch match; std::regex_search(computeShader->data(), match, s_localSizeRegex[static_cast<size_t>(i)]))
+            workGroupSize[i] = static_cast<uint32_t>(std::stoul(match[1].str()));
+
+    return std::make_shared<HeadlessComputeProgram>(workGroupSize);
+}
+
+// HeadlessRenderer
+
+HeadlessRenderer::HeadlessRenderer(const std::string& name, const std::weak_ptr<HeadlessWidget>& widget)
+    : RendererBase(name)
+    , m_widget(widget)
+{
+}
+
+HeadlessRenderer::~HeadlessRenderer() = default;
+
+std::shared_ptr<core::graphics::IGraphicsWidget> HeadlessRenderer::widget()
+{
+    // No CHECK_THIS_CONTEXT because of recursion calls
+    return m_widget.expired() ? nullptr : m_widget.lock();
+}
+
+std::shared_ptr<const core::graphics::IGraphicsWidget> HeadlessRenderer::widget() const
+{
+    // No CHECK_THIS_CONTEXT because of recursion calls
+    return const_cast<HeadlessRenderer*>(this)->widget();
+}
+
+HeadlessFrameRecord& HeadlessRenderer::frameRecord()
+{
+    return m_frameRecord;
+}
+
+const HeadlessFrameRecord& HeadlessRenderer::lastFrameRecord() const
+{
+    return m_lastFrameRecord;
+}
+
+void HeadlessRenderer::endFrameRecord()
+{
+    m_lastFrameRecord = std::move(m_frameRecord);
+    m_frameRecord = HeadlessFrameRecord();
+}
+
+void HeadlessRenderer::recordCommand(const HeadlessCommand& command)
+{
+    switch (command.type)
+    {
+        case HeadlessCommandType::Compute:
+        case HeadlessCommandType::ComputeIndirect:
+        {
+            ++m_frameRecord.numDispatches;
+            break;
+        }
+        case HeadlessCommandType::Draw:
+        case HeadlessCommandType::DrawIndirect:
+        case HeadlessCommandType::DrawIndirectCount:
+        {
+            m_frameRecord.numDraws += static_cast<uint32_t>(command.numDraws);
+            break;
+        }
+        default:
+            break;
+    }
+
+    m_frameRecord.commands.push_back(command);
+}
+
+void HeadlessRenderer::blitFrameBuffer(
+    std::shared_ptr<const core::graphics::IFrameBuffer> src,
+    std::shared_ptr<core::graphics::IFrameBuffer> dst,
+    const glm::uvec4&,
+    const glm::uvec4&,
+    bool,
+    bool,
+    bool,
+    bool)
+{
+    CHECK_THIS_CONTEXT;
+    if (!src) LOG_CRITICAL << "Source framebuffer can't be nullptr";
+    if (!dst) LOG_CRITICAL << "Destination framebuffer can't be nullptr";
+
+    recordCommand({HeadlessCommandType::BlitFrameBuffer});
+}
+
+void HeadlessRenderer::setClipControl(core::graphics::ClipControlOrigin, core::graphics::ClipControlDepth)
+{
+    CHECK_THIS_CONTEXT;
+}
+
+std::shared_ptr<core::graphics::IStaticBuffer> HeadlessRenderer::createStaticBuffer(size_t size, const void* data) const
+{
+    CHECK_THIS_CONTEXT;
+    return HeadlessStaticBuffer::create(size, data);
+}
+
+std::shared_ptr<core::graphics::IDynamicBuffer> HeadlessRenderer::createDynamicBuffer(size_t size, const void* data) const
+{
+    CHECK_THIS_CONTEXT;
+    return HeadlessDynamicBuffer::create(size, data);
+}
+
+std::shared_ptr<core::graphics::IVertexArray> HeadlessRenderer::createVertexArray() const
+{
+    CHECK_THIS_CONTEXT;
+    return HeadlessVertexArray::create();
+}
+
+std::shared_ptr<core::graphics::ITexture> HeadlessRenderer::createTexture1DEmpty(
+    uint32_t width,
+    core::graphics::PixelInternalFormat internalFormat,
+    uint32_t numLevels) const
+{
+    CHECK_THIS_CONTEXT;
+    return HeadlessTexture::createEmpty(core::graphics::TextureType::Type1D, glm::uvec3(width, 1u, 1u), internalFormat, numLevels);
+}
+
+std::shared_ptr<core::graphics::ITexture> HeadlessRenderer::createTexture1D(
+    const std::shared_ptr<const utils::Image>& image,
+    core::graphics::PixelInternalFormat internalFormat,
+    uint32_t numLevels,
+    bool genMipmaps) const
+{
+    CHECK_THIS_CONTEXT;
+    return HeadlessTexture::create(core::graphics::TextureType::Type1D, {image}, internalFormat, numLevels, genMipmaps);
+}
+
+std::shared_ptr<core::graphics::ITexture> HeadlessRenderer::createTexture2DEmpty(
+    uint32_t width,
+    uint32_t height,
+    core::graphics::PixelInternalFormat internalFormat,
+    uint32_t numLevels) const
+{
+    CHECK_THIS_CONTEXT;
+    return HeadlessTexture::createEmpty(
+        core::graphics::TextureType::Type2D, glm::uvec3(width, height, 1u), internalFormat, numLevels);
+}
+
+std::shared_ptr<core::graphics::ITexture> HeadlessRenderer::createTexture2D(
+    const std::shared_ptr<const utils::Image>& image,
+    core::graphics::PixelInternalFormat internalFormat,
+    uint32_t numLevels,
+    bool genMipmaps) const
+{
+    CHECK_THIS_CONTEXT;
+    return HeadlessTexture::create(core::graphics::TextureType::Type2D, {image}, internalFormat, numLevels, genMipmaps);
+}
+
+std::shared_ptr<core::graphics::ITexture> HeadlessRenderer::createTexture3DEmpty(
+    uint32_t width,
+    uint32_t height,
+    uint32_t depth,
+    core::graphics::PixelInternalFormat internalFormat,
+    uint32_t numLevels) const
+{
+    CHECK_THIS_CONTEXT;
+    return HeadlessTexture::createEmpty(
+        core::graphics::TextureType::Type3D, glm::uvec3(width, height, depth), internalFormat, numLevels);
+}
+
+std::shared_ptr<core::graphics::ITexture> HeadlessRenderer::createTexture3D(
+    const std::vector<std::shared_ptr<const utils::Image>>& images,
+    core::graphics::PixelInternalFormat internalFormat,
+    uint32_t numLevels,
+    bool genMipmaps) const
+{
+    CHECK_THIS_CONTEXT;
+    return HeadlessTexture::create(core::graphics::TextureType::Type3D, images, internalFormat, numLevels, genMipmaps);
+}
+
+std::shared_ptr<core::graphics::ITexture> HeadlessRenderer::createTextureCubeEmpty(
+    uint32_t width,
+    uint32_t height,
+    core::graphics::PixelInternalFormat internalFormat,
+    uint32_t numLevels) const
+{
+    CHECK_THIS_CONTEXT;
+    return HeadlessTexture::createEmpty(
+        core::graphics::TextureType::TypeCube, glm::uvec3(width, height, 1u), internalFormat, numLevels);
+}
+
+std::shared_ptr<core::graphics::ITexture> HeadlessRenderer::createTextureCube(
+    const std::vector<std::shared_ptr<const utils::Image>>& images,
+    core::graphics::PixelInternalFormat internalFormat,
+    uint32_t numLevels,
+    bool genMipmaps) const
+{
+    CHECK_THIS_CONTEXT;
+    if (images.size() != 6u) LOG_CRITICAL << "Images count of cubemap texture must be 6";
+
+    return HeadlessTexture::create(core::graphics::TextureType::TypeCube, images, internalFormat, numLevels, genMipmaps);
+}
+
+std::shared_ptr<core::graphics::ITexture> HeadlessRenderer::createTexture1DArrayEmpty(
+    uint32_t width,
+    uint32_t numLayers,
+    core::graphics::PixelInternalFormat internalFormat,
+    uint32_t numLevels) const
+{
+    CHECK_THIS_CONTEXT;
+    return HeadlessTexture::createEmpty(
+        core::graphics::TextureType::Type1DArray, glm::uvec3(width, numLayers, 1u), internalFormat, numLevels);
+}
+
+std::shared_ptr<core::graphics::ITexture> HeadlessRenderer::createTexture1DArray(
+    const std::vector<std::shared_ptr<const utils::Image>>& images,
+    core::graphics::PixelInternalFormat internalFormat,
+    uint32_t numLevels,
+    bool genMipmaps) const
+{
+    CHECK_THIS_CONTEXT;
+    return HeadlessTexture::create(core::graphics::TextureType::Type1DArray, images, internalFormat, numLevels, genMipmaps);
+}
+
+std::shared_ptr<core::graphics::ITexture> HeadlessRenderer::createTexture2DArrayEmpty(
+    uint32_t width,
+    uint32_t height,
+    uint32_t numLayers,
+    core::graphics::PixelInternalFormat internalFormat,
+    uint32_t numLevels) const
+{
+    CHECK_THIS_CONTEXT;
+    return HeadlessTexture::createEmpty(
+        core::graphics::TextureType::Type2DArray, glm::uvec3(width, height, numLayers), internalFormat, numLevels);
+}
+
+std::shared_ptr<core::graphics::ITexture> HeadlessRenderer::createTexture2DArray(
+    const std::vector<std::shared_ptr<const utils::Image>>& images,
+    core::graphics::PixelInternalFormat internalFormat,
+    uint32_t numLevels,
+    bool genMipmaps) const
+{
+    CHECK_THIS_CONTEXT;
+    return HeadlessTexture::create(core::graphics::TextureType::Type2DArray, images, internalFormat, numLevels, genMipmaps);
+}
+
+std::shared_ptr<core::graphics::ITexture> HeadlessRenderer::createTextureCubeArrayEmpty(
+    uint32_t width,
+    uint32_t height,
+    uint32_t numLayers,
+    core::graphics::PixelInternalFormat internalFormat,
+    uint32_t numLevels) const
+{
+    CHECK_THIS_CONTEXT;
+    return HeadlessTexture::createEmpty(
+        core::graphics::TextureType::TypeCubeArray, glm::uvec3(width, height, 6u * numLayers), internalFormat, numLevels);
+}
+
+std::shared_ptr<core::graphics::ITexture> HeadlessRenderer::createTextureCubeArray(
+    const std::vector<std::vector<std::shared_ptr<const utils::Image>>>& images,
+    core::graphics::PixelInternalFormat internalFormat,
+    uint32_t numLevels,
+    bool genMipmaps) const
+{
+    CHECK_THIS_CONTEXT;
+    std::vector<std::shared_ptr<const utils::Image>> layerFaces;
+    for (const auto& layerImages : images)
+    {
+        if (layerImages.size() != 6u) LOG_CRITICAL << "Images count of cubemap texture array must be 6";
+        layerFaces.insert(layerFaces.end(), layerImages.begin(), layerImages.end());
+    }
+
+    return HeadlessTexture::create(core::graphics::TextureType::TypeCubeArray, layerFaces, internalFormat, numLevels, genMipmaps);
+}
+
+std::shared_ptr<core::graphics::ITexture> HeadlessRenderer::createTextureRectEmpty(
+    uint32_t width,
+    uint32_t height,
+    core::graphics::PixelInternalFormat internalFormat) const
+{
+    CHECK_THIS_CONTEXT;
+    return HeadlessTexture::createEmpty(core::graphics::TextureType::TypeRect, glm::uvec3(width, height, 1u), internalFormat, 1u);
+}
+
+std::shared_ptr<core::graphics::ITexture> HeadlessRenderer::createTextureRect(
+    const std::shared_ptr<const utils::Image>& image,
+    core::graphics::PixelInternalFormat internalFormat) const
+{
+    CHECK_THIS_CONTEXT;
+    return HeadlessTexture::create(core::graphics::TextureType::TypeRect, {image}, internalFormat, 1u, false);
+}
+
+std::shared_ptr<core::graphics::ITextureHandle> HeadlessRenderer::createTextureHandle(
+    const core::graphics::PConstTexture& texture) const
+{
+    CHECK_THIS_CONTEXT;
+    return HeadlessTextureHandle::create(texture);
+}
+
+std::shared_ptr<core::graphics::IImageHandle> HeadlessRenderer::createImageHandle(const core::graphics::PConstImage& image) const
+{
+    CHECK_THIS_CONTEXT;
+    return HeadlessImageHandle::create(image);
+}
+
+std::shared_ptr<core::graphics::IRenderBuffer> HeadlessRenderer::createRenderBuffer(
+    uint32_t width,
+    uint32_t height,
+    core::graphics::PixelInternalFormat internalFormat) const
+{
+    CHECK_THIS_CONTEXT;
+    return HeadlessRenderBuffer::create(width, height, internalFormat);
+}
+
+std::shared_ptr<core::graphics::IFrameBuffer> HeadlessRenderer::createFrameBuffer() const
+{
+    CHECK_THIS_CONTEXT;
+    return HeadlessFrameBuffer::create();
+}
+
+std::shared_ptr<core::graphics::IRenderProgram> HeadlessRenderer::createRenderProgram(
+    const std::shared_ptr<utils::Shader>& vertexShader,
+    const std::shared_ptr<utils::Shader>& fragmentShader) const
+{
+    CHECK_THIS_CONTEXT;
+    return HeadlessRenderProgram::create(vertexShader, nullptr, fragmentShader);
+}
+
+std::shared_ptr<core::graphics::IRenderProgram> HeadlessRenderer::createRenderProgram(
+    const std::shared_ptr<utils::Shader>& vertexShader,
+    const std::shared_ptr<utils::Shader>& geometryShader,
+    const std::shared_ptr<utils::Shader>& fragmentShader) const
+{
+    CHECK_THIS_CONTEXT;
+    return HeadlessRenderProgram::create(vertexShader, geometryShader, fragmentShader);
+}
+
+std::shared_ptr<core::graphics::IComputeProgram> HeadlessRenderer::createComputeProgram(
+    const std::shared_ptr<utils::Shader>& computeShader) const
+{
+    CHECK_THIS_CONTEXT;
+    return HeadlessComputeProgram::create(computeShader);
+}
+
+std::shared_ptr<core::graphics::ITimestampQuery> HeadlessRenderer::createTimestampQuery() const
+{
+    CHECK_THIS_CONTEXT;
+    return HeadlessTimestampQuery::create();
+}
+
+std::shared_ptr<core::graphics::IBufferReadback> HeadlessRenderer::createBufferReadback(size_t size) const
+{
+    CHECK_THIS_CONTEXT;
+    return HeadlessBufferReadback::create(size);
+}
+
+std::string HeadlessRenderer::programBinaryDriverKey() const
+{
+    CHECK_THIS_CONTEXT;
+    return std::string();
+}
+
+std::shared_ptr<core::graphics::IRenderProgram> HeadlessRenderer::createRenderProgram(const core::graphics::ProgramBinary&) const
+{
+    CHECK_THIS_CONTEXT;
+    return nullptr;
+}
+
+std::shared_ptr<core::graphics::IComputeProgram> HeadlessRenderer::createComputeProgram(const core::graphics::ProgramBinary&) const
+{
+    CHECK_THIS_CONTEXT;
+    return nullptr;
+}
+
+void HeadlessRenderer::compute(
+    const glm::uvec3& numInvocations,
+    const std::shared_ptr<core::graphics::IComputeProgram>& computeProgram,
+    const core::StateSetList&)
+{
+    CHECK_THIS_CONTEXT;
+    if (!computeProgram) LOG_CRITICAL << "Compute program can't be nullptr";
+
+    auto numWorkGroups =
+        glm::uvec3(glm::ceil(glm::vec3(numInvocations) / glm::vec3(computeProgram->workGroupSize())) + glm::vec3(.5f));
+
+    recordCommand({HeadlessCommandType::Compute, numWorkGroups});
+}
+
+void HeadlessRenderer::computeIndirect(
+    const std::shared_ptr<core::graphics::IComputeProgram>& computeProgram,
+    const core::StateSetList&,
+    const core::graphics::PDispatchComputeIndirectCommandConstBuffer&)
+{
+    CHECK_THIS_CONTEXT;
+    if (!computeProgram) LOG_CRITICAL << "Compute program can't be nullptr";
+
+    recordCommand({HeadlessCommandType::ComputeIndirect});
+}
+
+void HeadlessRenderer::drawArrays(
+    const glm::uvec4&,
+    const std::shared_ptr<core::graphics::IRenderProgram>&,
+    const std::shared_ptr<core::graphics::IFrameBuffer>&,
+    const std::shared_ptr<core::graphics::IVertexArray>&,
+    const core::StateSetList&,
+    utils::PrimitiveType,
+    size_t,
+    size_t count)
+{
+    CHECK_THIS_CONTEXT;
+    recordCommand({HeadlessCommandType::Draw, glm::uvec3(0u), 1u, count, 1u});
+}
+
+void HeadlessRenderer::drawElements(
+    const glm::uvec4&,
+    const std::shared_ptr<core::graphics::IRenderProgram>&,
+    const std::shared_ptr<core::graphics::IFrameBuffer>&,
+    const std::shared_ptr<core::graphics::IVertexArray>&,
+    const core::StateSetList&,
+    utils::PrimitiveType,
+    size_t count,
+    utils::DrawElementsIndexType,
+    size_t)
+{
+    CHECK_THIS_CONTEXT;
+    recordCommand({HeadlessCommandType::Draw, glm::uvec3(0u), 1u, count, 1u});
+}
+
+void HeadlessRenderer::multiDrawArrays(
+    const glm::uvec4&,
+    const std::shared_ptr<core::graphics::IRenderProgram>&,
+    const std::shared_ptr<core::graphics::IFrameBuffer>&,
+    const std::shared_ptr<core::graphics::IVertexArray>&,
+    const core::StateSetList&,
+    utils::PrimitiveType,
+    const std::vector<size_t>&,
+    const std::vector<size_t>& counts)
+{
+    CHECK_THIS_CONTEXT;
+    recordCommand(
+        {HeadlessCommandType::Draw, glm::uvec3(0u), counts.size(), std::accumulate(counts.begin(), counts.end(), size_t(0u)),
+         1u});
+}
+
+void HeadlessRenderer::multiDrawElements(
+    const glm::uvec4&,
+    const std::shared_ptr<core::graphics::IRenderProgram>&,
+    const std::shared_ptr<core::graphics::IFrameBuffer>&,
+    const std::shared_ptr<core::graphics::IVertexArray>&,
+    const core::StateSetList&,
+    utils::PrimitiveType,
+    const std::vector<size_t>& counts,
+    utils::DrawElementsIndexType,
+    const std::vector<size_t>&)
+{
+    CHECK_THIS_CONTEXT;
+    recordCommand(
+        {HeadlessCommandType::Draw, glm::uvec3(0u), counts.size(), std::accumulate(counts.begin(), counts.end(), size_t(0u)),
+         1u});
+}
+
+void HeadlessRenderer::drawElementsBaseVertex(
+    const glm::uvec4&,
+    const std::shared_ptr<core::graphics::IRenderProgram>&,
+    const std::shared_ptr<core::graphics::IFrameBuffer>&,
+    const std::shared_ptr<core::graphics::IVertexArray>&,
+    const core::StateSetList&,
+    utils::PrimitiveType,
+    size_t count,
+    utils::DrawElementsIndexType,
+    size_t,
+    uint32_t)
+{
+    CHECK_THIS_CONTEXT;
+    recordCommand({HeadlessCommandType::Draw, glm::uvec3(0u), 1u, count, 1u});
+}
+
+void HeadlessRenderer::drawArraysInstanced(
+    const glm::uvec4&,
+    const std::shared_ptr<core::graphics::IRenderProgram>&,
+    const std::shared_ptr<core::graphics::IFrameBuffer>&,
+    const std::shared_ptr<core::graphics::IVertexArray>&,
+    const core::StateSetList&,
+    utils::PrimitiveType,
+    size_t,
+    size_t count,
+    size_t numInstances)
+{
+    CHECK_THIS_CONTEXT;
+    recordCommand({HeadlessCommandType::Draw, glm::uvec3(0u), 1u, count, numInstances});
+}
+
+void HeadlessRenderer::drawElementsInstanced(
+    const glm::uvec4&,
+    const std::shared_ptr<core::graphics::IRenderProgram>&,
+    const std::shared_ptr<core::graphics::IFrameBuffer>&,
+    const std::shared_ptr<core::graphics::IVertexArray>&,
+    const core::StateSetList&,
+    utils::PrimitiveType,
+    size_t count,
+    utils::DrawElementsIndexType,
+    size_t,
+    size_t numInstances)
+{
+    CHECK_THIS_CONTEXT;
+    recordCommand({HeadlessCommandType::Draw, glm::uvec3(0u), 1u, count, numInstances});
+}
+
+void HeadlessRenderer::drawArraysInstancedBaseInstance(
+    const glm::uvec4&,
+    const std::shared_ptr<core::graphics::IRenderProgram>&,
+    const std::shared_ptr<core::graphics::IFrameBuffer>&,
+    const std::shared_ptr<core::graphics::IVertexArray>&,
+    const core::StateSetList&,
+    utils::PrimitiveType,
+    size_t,
+    size_t count,
+    size_t numInstances,
+    uint32_t)
+{
+    CHECK_THIS_CONTEXT;
+    recordCommand({HeadlessCommandType::Draw, glm::uvec3(0u), 1u, count, numInstances});
+}
+
+void HeadlessRenderer::drawElementsInstancedBaseInstance(
+    const glm::uvec4&,
+    const std::shared_ptr<core::graphics::IRenderProgram>&,
+    const std::shared_ptr<core::graphics::IFrameBuffer>&,
+    const std::shared_ptr<core::graphics::IVertexArray>&,
+    const core::StateSetList&,
+    utils::PrimitiveType,
+    size_t count,
+    utils::DrawElementsIndexType,
+    size_t,
+    size_t numInstances,
+    uint32_t)
+{
+    CHECK_THIS_CONTEXT;
+    recordCommand({HeadlessCommandType::Draw, glm::uvec3(0u), 1u, count, numInstances});
+}
+
+void HeadlessRenderer::drawArraysIndirect(
+    const glm::uvec4&,
+    const std::shared_ptr<core::graphics::IRenderProgram>&,
+    const std::shared_ptr<core::graphics::IFrameBuffer>&,
+    const std::shared_ptr<core::graphics::IVertexArray>&,
+    const core::StateSetList&,
+    utils::PrimitiveType,
+    const core::graphics::PDrawArraysIndirectCommandsConstBuffer&)
+{
+    CHECK_THIS_CONTEXT;
+    recordCommand({HeadlessCommandType::DrawIndirect, glm::uvec3(0u), 1u});
+}
+
+void HeadlessRenderer::drawElementsIndirect(
+    const glm::uvec4&,
+    const std::shared_ptr<core::graphics::IRenderProgram>&,
+    const std::shared_ptr<core::graphics::IFrameBuffer>&,
+    const std::shared_ptr<core::graphics::IVertexArray>&,
+    const core::StateSetList&,
+    utils::PrimitiveType,
+    utils::DrawElementsIndexType,
+    const core::graphics::PDrawElementsIndirectCommandConstBuffer&)
+{
+    CHECK_THIS_CONTEXT;
+    recordCommand({HeadlessCommandType::DrawIndirect, glm::uvec3(0u), 1u});
+}
+
+void HeadlessRenderer::multiDrawArraysIndirect(
+    const glm::uvec4&,
+    const std::shared_ptr<core::graphics::IRenderProgram>&,
+    const std::shared_ptr<core::graphics::IFrameBuffer>&,
+    const std::shared_ptr<core::graphics::IVertexArray>&,
+    const core::StateSetList&,
+    utils::PrimitiveType,
+    const core::graphics::PDrawArraysIndirectCommandsConstBuffer& commandsBuffer)
+{
+    CHECK_THIS_CONTEXT;
+    recordCommand({HeadlessCommandType::DrawIndirect, glm::uvec3(0u), commandsBuffer->size()});
+}
+
+void HeadlessRenderer::multiDrawElementsIndirect(
+    const glm::uvec4&,
+    const std::shared_ptr<core::graphics::IRenderProgram>&,
+    const std::shared_ptr<core::graphics::IFrameBuffer>&,
+    const std::shared_ptr<core::graphics::IVertexArray>&,
+    const core::StateSetList&,
+    utils::PrimitiveType,
+    utils::DrawElementsIndexType,
+    const core::graphics::PDrawElementsIndirectCommandConstBuffer& commandsBuffer)
+{
+    CHECK_THIS_CONTEXT;
+    recordCommand({HeadlessCommandType::DrawIndirect, glm::uvec3(0u), commandsBuffer->size()});
+}
+
+void HeadlessRenderer::multiDrawArraysIndirectCount(
+    const glm::uvec4&,
+    const std::shared_ptr<core::graphics::IRenderProgram>&,
+    const std::shared_ptr<core::graphics::IFrameBuffer>&,
+    const std::shared_ptr<core::graphics::IVertexArray>&,
+    const core::StateSetList&,
+    utils::PrimitiveType,
+    const core::graphics::PDrawArraysIndirectCommandsConstBuffer& commandsBuffer,
+    const core::graphics::PConstBufferRange&)
+{
+    CHECK_THIS_CONTEXT;
+    recordCommand({HeadlessCommandType::DrawIndirectCount, glm::uvec3(0u), commandsBuffer->size()});
+}
+
+void HeadlessRenderer::multiDrawElementsIndirectCount(
+    const glm::uvec4&,
+    const std::shared_ptr<core::graphics::IRenderProgram>&,
+    const std::shared_ptr<core::graphics::IFrameBuffer>&,
+    const std::shared_ptr<core::graphics::IVertexArray>&,
+    const core::StateSetList&,
+    utils::PrimitiveType,
+    utils::DrawElementsIndexType,
+    const core::graphics::PDrawElementsIndirectCommandConstBuffer& commandsBuffer,
+    const core::graphics::PConstBufferRange&)
+{
+    CHECK_THIS_CONTEXT;
+    recordCommand({HeadlessCommandType::DrawIndirectCount, glm::uvec3(0u), commandsBuffer->size()});
+}
+
+bool HeadlessRenderer::doMakeCurrent()
+{
+    return true;
+}
+
+bool HeadlessRenderer::doDoneCurrent()
+{
+    return true;
+}
+
+} // namespace graphics_headless
+} // namespace simplex
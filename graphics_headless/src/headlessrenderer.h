@@ -0,0 +1,903 @@
+#ifndef GRAPHICS_HEADLESS_RENDERER_H
+#define GRAPHICS_HEADLESS_RENDERER_H
+
+#include <bitset>
+#include <tuple>
+
+#include <utils/noncopyble.h>
+
+#include <core/graphicsrendererbase.h>
+
+#include <graphics_headless/forwarddecl.h>
+#include <graphics_headless/headlessframerecord.h>
+
+#define CURRENT_CONTEXT_INFO                                                                                                     \
+private:                                                                                                                         \
+    std::shared_ptr<core::graphics::RendererBase> m_renderer;                                                                    \
+                                                                                                                                 \
+public:                                                                                                                          \
+    std::shared_ptr<core::graphics::RendererBase> renderer() const                                                               \
+    {                                                                                                                            \
+        return m_renderer;                                                                                                       \
+    };
+
+#define SAVE_CURRENT_CONTEXT                                                                                                     \
+    m_renderer = core::graphics::RendererBase::current();                                                                        \
+    if (!m_renderer) LOG_CRITICAL << "No current context";
+
+#define CHECK_CURRENT_CONTEXT                                                                                                    \
+    if (!core::graphics::RendererBase::areShared(m_renderer, core::graphics::RendererBase::current()))                           \
+        LOG_CRITICAL << "Resource was created in anotrher context";
+
+#define CHECK_THIS_CONTEXT                                                                                                       \
+    if (!core::graphics::RendererBase::areShared(shared_from_this(), core::graphics::RendererBase::current()))                   \
+        LOG_CRITICAL << "This context is not current";
+
+namespace simplex
+{
+namespace graphics_headless
+{
+
+// Buffers keep their data in CPU memory. Everything that is written by "GPU" (compute passes) keeps the CPU contents
+class HeadlessBufferBase
+{
+    NONCOPYBLE(HeadlessBufferBase)
+    CURRENT_CONTEXT_INFO
+public:
+    class MappedData_Headless : public core::graphics::IBuffer::MappedData
+    {
+    public:
+        MappedData_Headless(const HeadlessBufferBase&, uint8_t*);
+        ~MappedData_Headless() override;
+        uint8_t* get() override;
+        const uint8_t* get() const override;
+
+    private:
+        const HeadlessBufferBase& m_mappedBuffer;
+        uint8_t* m_data;
+    };
+
+    virtual ~HeadlessBufferBase();
+
+    const std::vector<uint8_t>& data() const;
+
+protected:
+    HeadlessBufferBase(size_t size, const void* data);
+
+    size_t sizeImpl() const;
+    void resizeImpl(size_t size);
+
+    std::unique_ptr<core::graphics::IBuffer::MappedData> mapImpl(
+        core::graphics::IBuffer::MapAccess access,
+        size_t offset,
+        size_t size,
+        size_t bufferSize);
+
+    std::vector<uint8_t> m_data;
+    mutable bool m_isMapped = false;
+
+    friend class MappedData_Headless;
+};
+
+class HeadlessStaticBuffer : public core::graphics::IStaticBuffer, public HeadlessBufferBase
+{
+    NONCOPYBLE(HeadlessStaticBuffer)
+    CURRENT_CONTEXT_INFO
+public:
+    HeadlessStaticBuffer(size_t size, const void* data);
+    ~HeadlessStaticBuffer() override;
+
+    bool isEmpty() const override;
+    size_t size() const override;
+
+    std::unique_ptr<MappedData> map(MapAccess access, size_t offset = 0u, size_t size = 0u) override;
+    std::unique_ptr<const MappedData> map(MapAccess access, size_t offset = 0u, size_t size = 0u) const override;
+
+    static std::shared_ptr<HeadlessStaticBuffer> create(size_t = 0u, const void* = nullptr);
+};
+
+class HeadlessDynamicBuffer : public core::graphics::IDynamicBuffer, public HeadlessBufferBase
+{
+    NONCOPYBLE(HeadlessDynamicBuffer)
+    CURRENT_CONTEXT_INFO
+public:
+    HeadlessDynamicBuffer(size_t size, const void* data);
+    ~HeadlessDynamicBuffer() override;
+
+    bool isEmpty() const override;
+    size_t size() const override;
+
+    size_t capacity() const override;
+    void reserve(size_t) override;
+    void shrinkToFit() override;
+
+    void clear() override;
+    void insert(size_t offset, const void* data, size_t size) override;
+    void erase(size_t offset, size_t size) override;
+    void resize(size_t) override;
+    void copy(size_t srcOffset, size_t dstOffset, size_t size) override;
+
+    std::unique_ptr<MappedData> map(MapAccess access, size_t offset = 0u, size_t size = 0u) override;
+    std::unique_ptr<const MappedData> map(MapAccess access, size_t offset = 0u, size_t size = 0u) const override;
+
+    static std::shared_ptr<HeadlessDynamicBuffer> create(size_t = 0u, const void* = nullptr);
+
+private:
+    size_t m_size = 0;
+};
+
+class HeadlessVertexArray : public core::graphics::IVertexArray
+{
+    NONCOPYBLE(HeadlessVertexArray)
+    CURRENT_CONTEXT_INFO
+public:
+    HeadlessVertexArray();
+    ~HeadlessVertexArray() override;
+
+    uint32_t attachVertexBuffer(const core::graphics::PConstBuffer& buffer, size_t offset, size_t stride) override;
+    void detachVertexBuffer(uint32_t bindingIndex) override;
+    core::graphics::PConstBuffer vertexBuffer(uint32_t bindingIndex) const override;
+    size_t vertexBufferOffset(uint32_t bindingIndex) const override;
+    size_t vertexBufferStride(uint32_t bindingIndex) const override;
+
+    void declareVertexAttribute(
+        utils::VertexAttribute,
+        uint32_t bindingIndex,
+        uint32_t numComponents,
+        utils::VertexComponentType type,
+        uint32_t relativeOffset) override;
+    void undeclareVertexAttribute(utils::VertexAttribute) override;
+    uint32_t vertexAttributeBindingIndex(utils::VertexAttribute) const override;
+    uint32_t vertexAttributeNumComponents(utils::VertexAttribute) const override;
+    utils::VertexComponentType vertexAttributeComponentType(utils::VertexAttribute) const override;
+    uint32_t vertexAttributeRelativeOffset(utils::VertexAttribute) const override;
+
+    void attachIndexBuffer(const core::graphics::PConstBuffer& buffer) override;
+    void detachIndexBuffer() override;
+    core::graphics::PConstBuffer indexBuffer() const override;
+
+    static std::shared_ptr<HeadlessVertexArray> create();
+
+private:
+    struct VertexBufferDeclaration
+    {
+        core::graphics::PConstBuffer buffer;
+        size_t offset;
+        size_t stride;
+
+        bool operator==(const VertexBufferDeclaration& o) const
+        {
+            return std::tie(buffer, offset, stride) == std::tie(o.buffer, o.offset, o.stride);
+        }
+    };
+    std::vector<VertexBufferDeclaration> m_vertexBuffers;
+
+    struct AttributeDeclaration
+    {
+        uint32_t bindingIndex;
+        uint32_t numComponents;
+        utils::VertexComponentType componentType;
+        uint32_t relativeOffset;
+    };
+    std::unordered_map<utils::VertexAttribute, AttributeDeclaration> m_attributes;
+
+    core::graphics::PConstBuffer m_indexBuffer;
+};
+
+// Textures keep only their description. Uploaded texels are counted and dropped, read texels are zeros
+class HeadlessTexture : public core::graphics::ITexture
+{
+    NONCOPYBLE(HeadlessTexture)
+    CURRENT_CONTEXT_INFO
+public:
+    HeadlessTexture(core::graphics::TextureType, const glm::uvec3&, core::graphics::PixelInternalFormat, uint32_t numLevels);
+    ~HeadlessTexture() override;
+
+    glm::uvec2 size() const override;
+    core::graphics::PixelInternalFormat internalFormat() const override;
+    bool hasAlpha() const override;
+    bool hasDepth() const override;
+
+    core::graphics::TextureType type() const override;
+
+    glm::uvec3 mipmapSize(uint32_t level = 0) const override;
+    uint32_t numMipmapLevels() const override;
+    uint32_t numFaces() const override;
+
+    void setSubImage(
+        uint32_t level,
+        const glm::uvec3& offset,
+        const glm::uvec3& size,
+        uint32_t numComponents,
+        utils::PixelComponentType type,
+        const void* data) override;
+
+    void subImage(
+        uint32_t level,
+        const glm::uvec3& offset,
+        const glm::uvec3& size,
+        uint32_t numComponents,
+        utils::PixelComponentType type,
+        size_t bufSize,
+        void* data) const override;
+
+    void generateMipmaps() override;
+    void setBorderColor(const glm::vec4&) override;
+    void setWrapMode(core::graphics::TextureWrapMode) override;
+    void setFilterMode(core::graphics::TextureFilterMode) override;
+    void setSwizzleMask(const core::graphics::TextureSwizzleMask&) override;
+
+    core::graphics::PTexture copyEmpty() const override;
+    core::graphics::PTexture copy() const override;
+
+    static std::shared_ptr<HeadlessTexture> createEmpty(
+        core::graphics::TextureType,
+        const glm::uvec3&,
+        core::graphics::PixelInternalFormat,
+        uint32_t numLevels);
+    static std::shared_ptr<HeadlessTexture> create(
+        core::graphics::TextureType,
+        const std::vector<std::shared_ptr<const utils::Image>>&,
+        core::graphics::PixelInternalFormat,
+        uint32_t numLevels,
+        bool genMipmaps);
+
+private:
+    core::graphics::TextureType m_type;
+    glm::uvec3 m_size;
+    core::graphics::PixelInternalFormat m_internalFormat;
+    uint32_t m_numLevels;
+};
+
+class HeadlessTextureHandle : public core::graphics::ITextureHandle
+{
+    NONCOPYBLE(HeadlessTextureHandle)
+    CURRENT_CONTEXT_INFO
+public:
+    HeadlessTextureHandle(const core::graphics::PConstTexture&);
+    ~HeadlessTextureHandle() override;
+
+    core::graphics::TextureHandle handle() const override;
+
+    core::graphics::PConstTexture texture() const override;
+
+    void makeResident() override;
+    void doneResident() override;
+
+    static std::shared_ptr<HeadlessTextureHandle> create(const core::graphics::PConstTexture&);
+
+protected:
+    core::graphics::TextureHandle m_id = 0;
+    core::graphics::PConstTexture m_texture;
+};
+
+class HeadlessImageHandle : public core::graphics::IImageHandle
+{
+    NONCOPYBLE(HeadlessImageHandle)
+    CURRENT_CONTEXT_INFO
+public:
+    HeadlessImageHandle(const core::graphics::PConstImage&);
+    ~HeadlessImageHandle() override;
+
+    core::graphics::TextureHandle handle() const override;
+
+    core::graphics::PConstImage image() const override;
+
+    void makeResident() override;
+    void doneResident() override;
+
+    static std::shared_ptr<HeadlessImageHandle> create(const core::graphics::PConstImage&);
+
+protected:
+    core::graphics::TextureHandle m_id = 0;
+    core::graphics::PConstImage m_image;
+};
+
+// Timestamps are taken from CPU clock when they are recorded, so they are available immediately
+class HeadlessTimestampQuery : public core::graphics::ITimestampQuery
+{
+    NONCOPYBLE(HeadlessTimestampQuery)
+    CURRENT_CONTEXT_INFO
+public:
+    HeadlessTimestampQuery();
+    ~HeadlessTimestampQuery() override;
+
+    void record() override;
+    bool isAvailable() const override;
+    uint64_t time() const override;
+
+    static std::shared_ptr<HeadlessTimestampQuery> create();
+
+private:
+    uint64_t m_time = 0u;
+};
+
+// Buffers keep their data in CPU memory, so the copy is available as soon as it's recorded
+class HeadlessBufferReadback : public core::graphics::IBufferReadback
+{
+    NONCOPYBLE(HeadlessBufferReadback)
+    CURRENT_CONTEXT_INFO
+public:
+    HeadlessBufferReadback(size_t);
+    ~HeadlessBufferReadback() override;
+
+    size_t size() const override;
+    void record(const core::graphics::PConstBuffer&, size_t offset) override;
+    bool isAvailable() const override;
+    const uint8_t* data() const override;
+
+    static std::shared_ptr<HeadlessBufferReadback> create(size_t);
+
+private:
+    std::vector<uint8_t> m_data;
+    bool m_isRecorded = false;
+};
+
+class HeadlessRenderBuffer : public core::graphics::IRenderBuffer
+{
+    NONCOPYBLE(HeadlessRenderBuffer)
+    CURRENT_CONTEXT_INFO
+public:
+    HeadlessRenderBuffer(uint32_t width, uint32_t height, core::graphics::PixelInternalFormat);
+    ~HeadlessRenderBuffer() override;
+
+    glm::uvec2 size() const override;
+    core::graphics::PixelInternalFormat internalFormat() const override;
+    bool hasAlpha() const override;
+    bool hasDepth() const override;
+
+    static std::shared_ptr<HeadlessRenderBuffer> create(uint32_t width, uint32_t height, core::graphics::PixelInternalFormat);
+
+private:
+    glm::uvec2 m_size;
+    core::graphics::PixelInternalFormat m_internalFormat;
+};
+
+class HeadlessFrameBufferBase : public core::graphics::IFrameBuffer
+{
+    NONCOPYBLE(HeadlessFrameBufferBase)
+    CURRENT_CONTEXT_INFO
+public:
+    ~HeadlessFrameBufferBase() override;
+
+    bool isComplete() const override;
+    void clear(const std::unordered_set<core::graphics::FrameBufferAttachment>&) override;
+
+    void setDefaultClearDepth(float) override;
+    void setDefaultDepthFunc(core::graphics::ComparingFunc) override;
+
+    void reset() override;
+
+    std::shared_ptr<const core::graphics::ISurface> attachmentSurface(core::graphics::FrameBufferAttachment) const override;
+    uint32_t attachmentMipmapLevel(core::graphics::FrameBufferAttachment) const override;
+    uint32_t attachmentLayer(core::graphics::FrameBufferAttachment) const override;
+
+    const core::graphics::FrameBufferClearColor& clearColor(uint32_t) const override;
+    void setClearColor(uint32_t, const glm::vec4&) override;
+    void setClearColor(uint32_t, const glm::i32vec4&) override;
+    void setClearColor(uint32_t, const glm::u32vec4&) override;
+
+    float clearDepth() const override;
+    void setClearDepth(float) override;
+
+    int32_t clearStencil() const override;
+    void setClearStencil(uint8_t) override;
+
+    bool faceCulling() const override;
+    core::graphics::FaceType cullFaceType() const override;
+    void setFaceCulling(bool, core::graphics::FaceType = core::graphics::FaceType::Back) override;
+
+    bool colorMask(uint32_t) const override;
+    void setColorMask(uint32_t, bool) override;
+    void setColorMasks(bool) override;
+
+    bool depthTest() const override;
+    void setDepthTest(bool) override;
+    core::graphics::ComparingFunc depthFunc() const override;
+    void setDepthFunc(core::graphics::ComparingFunc) override;
+    bool depthMask() const override;
+    void setDepthMask(bool) override;
+
+    bool stencilTest() const override;
+    void setStencilTest(bool) override;
+    core::graphics::ComparingFunc stencilComparingFunc(core::graphics::FaceType) const override;
+    uint8_t stencilReferenceValue(core::graphics::FaceType) const override;
+    uint8_t stencilMaskValue(core::graphics::FaceType) const override;
+    void setStencilFunc(core::graphics::FaceType, core::graphics::ComparingFunc, uint8_t ref, uint8_t mask) override;
+    const core::graphics::StencilOperations& stencilOperations(core::graphics::FaceType) const override;
+    void setStencilOperations(core::graphics::FaceType, const core::graphics::StencilOperations&) override;
+
+    bool blending() const override;
+    void setBlending(bool) override;
+    core::graphics::BlendEquation blendColorEquation(uint32_t) const override;
+    core::graphics::BlendEquation blendAlphaEquation(uint32_t) const override;
+    void setBlendEquation(uint32_t, core::graphics::BlendEquation, core::graphics::BlendEquation) override;
+    core::graphics::BlendFactor blendColorSourceFactor(uint32_t) const override;
+    core::graphics::BlendFactor blendAlphaSourceFactor(uint32_t) const override;
+    core::graphics::BlendFactor blendColorDestinationFactor(uint32_t) const override;
+    core::graphics::BlendFactor blendAlphaDestinationFactor(uint32_t) const override;
+    void setBlendFactor(
+        uint32_t,
+        core::graphics::BlendFactor,
+        core::graphics::BlendFactor,
+        core::graphics::BlendFactor,
+        core::graphics::BlendFactor) override;
+    glm::vec3 blendConstantColor() const override;
+    void setBlendConstantColor(const glm::vec3&) override;
+    float blendConstantAlpha() const override;
+    void setBlendConstantAlpha(float) override;
+
+    bool clipDistance(uint32_t) const override;
+    void setClipDistance(uint32_t, bool) override;
+    void setClipDistances(bool) override;
+
+protected:
+    HeadlessFrameBufferBase();
+
+    struct AttachmentDescription
+    {
+        std::shared_ptr<const core::graphics::ISurface> surface;
+        uint32_t mipmapLevel;
+        uint32_t layer;
+    };
+
+    std::unordered_map<core::graphics::FrameBufferAttachment, AttachmentDescription> m_attachments;
+
+    float m_defaultClearDepth = 1.f;
+    core::graphics::ComparingFunc m_defaultDepthFunc = core::graphics::ComparingFunc::Less;
+
+    std::array<core::graphics::FrameBufferClearColor, core::graphics::FrameBufferColorAttachmentsCount()> m_clearColor;
+    float m_clearDepth;
+    int32_t m_clearStencil;
+
+    core::graphics::FaceType m_cullFaceType;
+    bool m_faceCulling;
+
+    std::bitset<core::graphics::FrameBufferColorAttachmentsCount()> m_colorMasks;
+
+    core::graphics::ComparingFunc m_depthFunc;
+    bool m_depthTest;
+    bool m_depthMask;
+
+    core::graphics::ComparingFunc m_stencilComparingFuncFrontFace, m_stencilComparingFuncBackFace;
+    uint8_t m_stencilRefFrontFace, m_stencilRefBackFace;
+    uint8_t m_stencilMaskFrontFace, m_stencilMaskBackFace;
+    core::graphics::StencilOperations m_stencilOperationsFrontFace, m_stencilOperationsBackFace;
+    bool m_stencilTest;
+
+    std::array<core::graphics::BlendEquation, core::graphics::FrameBufferColorAttachmentsCount()> m_blendColorEquation;
+    std::array<core::graphics::BlendEquation, core::graphics::FrameBufferColorAttachmentsCount()> m_blendAlphaEquation;
+    std::array<core::graphics::BlendFactor, core::graphics::FrameBufferColorAttachmentsCount()> m_blendColorSourceFactor;
+    std::array<core::graphics::BlendFactor, core::graphics::FrameBufferColorAttachmentsCount()> m_blendAlphaSourceFactor;
+    std::array<core::graphics::BlendFactor, core::graphics::FrameBufferColorAttachmentsCount()> m_blendColorDestFactor;
+    std::array<core::graphics::BlendFactor, core::graphics::FrameBufferColorAttachmentsCount()> m_blendAlphaDestFactor;
+    glm::vec3 m_blendConstColor;
+    float m_blendConstAlpha;
+    bool m_blending;
+
+    std::bitset<core::graphics::FrameBufferClipDistancesCount()> m_clipDistances;
+};
+
+class HeadlessFrameBuffer : public HeadlessFrameBufferBase
+{
+    NONCOPYBLE(HeadlessFrameBuffer)
+    CURRENT_CONTEXT_INFO
+public:
+    HeadlessFrameBuffer();
+    ~HeadlessFrameBuffer() override;
+
+    void attach(core::graphics::FrameBufferAttachment, std::shared_ptr<const core::graphics::ISurface>, uint32_t level = 0u)
+        override;
+    void attachLayer(
+        core::graphics::FrameBufferAttachment,
+        std::shared_ptr<const core::graphics::ITexture>,
+        uint32_t level = 0u,
+        uint32_t layer = 0u) override;
+    void detach(core::graphics::FrameBufferAttachment) override;
+    void detachAll() override;
+
+    static std::shared_ptr<HeadlessFrameBuffer> create();
+};
+
+class HeadlessDefaultFrameBuffer : public HeadlessFrameBufferBase
+{
+    NONCOPYBLE(HeadlessDefaultFrameBuffer)
+    CURRENT_CONTEXT_INFO
+public:
+    HeadlessDefaultFrameBuffer();
+    ~HeadlessDefaultFrameBuffer() override;
+
+    void attach(core::graphics::FrameBufferAttachment, std::shared_ptr<const core::graphics::ISurface>, uint32_t = 0u) override;
+    void attachLayer(
+        core::graphics::FrameBufferAttachment,
+        std::shared_ptr<const core::graphics::ITexture>,
+        uint32_t = 0u,
+        uint32_t = 0u) override;
+    void detach(core::graphics::FrameBufferAttachment) override;
+    void detachAll() override;
+
+    static std::shared_ptr<HeadlessDefaultFrameBuffer> create();
+};
+
+// Shaders are neither compiled nor introspected, so programs have no uniforms, blocks, attributes and outputs
+class HeadlessProgramBase : public virtual core::graphics::IProgram
+{
+    NONCOPYBLE(HeadlessProgramBase)
+    CURRENT_CONTEXT_INFO
+public:
+    HeadlessProgramBase();
+    ~HeadlessProgramBase() override;
+
+    bool binary(core::graphics::ProgramBinary&) const override;
+
+    const std::vector<core::graphics::UniformInfo>& uniformsInfo() const override;
+    const std::vector<core::graphics::UniformBlockInfo>& uniformBlocksInfo() const override;
+    const std::vector<core::graphics::ShaderStorageBlockInfo>& shaderStorageBlocksInfo() const override;
+
+    std::string uniformNameByIndex(uint16_t) const override;
+    std::string bufferVariableNameByIndex(uint16_t) const override;
+    std::string uniformBlockNameByIndex(uint16_t) const override;
+    std::string shaderStorageBlockNameByIndex(uint16_t) const override;
+
+protected:
+    std::vector<core::graphics::UniformInfo> m_uniformsInfo;
+    std::vector<core::graphics::UniformBlockInfo> m_uniformBlocksInfo;
+    std::vector<core::graphics::ShaderStorageBlockInfo> m_shaderStorageBlocksInfo;
+};
+
+class HeadlessRenderProgram : public core::graphics::IRenderProgram, public HeadlessProgramBase
+{
+    NONCOPYBLE(HeadlessRenderProgram)
+    CURRENT_CONTEXT_INFO
+public:
+    HeadlessRenderProgram();
+    ~HeadlessRenderProgram() override;
+
+    const std::vector<core::graphics::AttributeInfo>& attributesInfo() const override;
+    std::string attributeNameByIndex(uint16_t) const override;
+
+    const std::vector<core::graphics::OutputInfo>& outputsInfo() const override;
+    std::string outputNameByIndex(uint16_t) const override;
+
+    static std::shared_ptr<HeadlessRenderProgram> create(
+        const std::shared_ptr<utils::Shader>& vertexShader,
+        const std::shared_ptr<utils::Shader>& geometryShader,
+        const std::shared_ptr<utils::Shader>& fragmentShader);
+
+protected:
+    std::vector<core::graphics::AttributeInfo> m_attributesInfo;
+    std::vector<core::graphics::OutputInfo> m_outputInfo;
+};
+
+class HeadlessComputeProgram : public core::graphics::IComputeProgram, public HeadlessProgramBase
+{
+    NONCOPYBLE(HeadlessComputeProgram)
+    CURRENT_CONTEXT_INFO
+public:
+    HeadlessComputeProgram(const glm::uvec3&);
+    ~HeadlessComputeProgram() override;
+
+    glm::uvec3 workGroupSize() const override;
+
+    static std::shared_ptr<HeadlessComputeProgram> create(const std::shared_ptr<utils::Shader>& computeShader);
+
+protected:
+    glm::uvec3 m_workGroupSize;
+};
+
+class HeadlessRenderer : public core::graphics::RendererBase
+{
+    NONCOPYBLE(HeadlessRenderer)
+public:
+    HeadlessRenderer(const std::string&, const std::weak_ptr<HeadlessWidget>&);
+    ~HeadlessRenderer() override;
+
+    std::shared_ptr<core::graphics::IGraphicsWidget> widget() override;
+    std::shared_ptr<const core::graphics::IGraphicsWidget> widget() const override;
+
+    HeadlessFrameRecord& frameRecord();
+    const HeadlessFrameRecord& lastFrameRecord() const;
+    void endFrameRecord();
+    void recordCommand(const HeadlessCommand&);
+
+    void blitFrameBuffer(
+        std::shared_ptr<const core::graphics::IFrameBuffer> src,
+        std::shared_ptr<core::graphics::IFrameBuffer> dst,
+        const glm::uvec4& srcViewport,
+        const glm::uvec4& dstViewport,
+        bool colorMsk,
+        bool depthMask,
+        bool stencilMask,
+        bool linearFilter = false) override;
+
+    void setClipControl(core::graphics::ClipControlOrigin, core::graphics::ClipControlDepth) override;
+
+    std::shared_ptr<core::graphics::IStaticBuffer> createStaticBuffer(size_t = 0u, const void* = nullptr) const override;
+    std::shared_ptr<core::graphics::IDynamicBuffer> createDynamicBuffer(size_t size = 0u, const void* data = nullptr)
+        const override;
+    std::shared_ptr<core::graphics::IVertexArray> createVertexArray() const override;
+    std::shared_ptr<core::graphics::ITexture> createTexture1DEmpty(
+        uint32_t width,
+        core::graphics::PixelInternalFormat,
+        uint32_t numLevels = 1) const override;
+    std::shared_ptr<core::graphics::ITexture> createTexture1D(
+        const std::shared_ptr<const utils::Image>&,
+        core::graphics::PixelInternalFormat = core::graphics::PixelInternalFormat::Count,
+        uint32_t numLevels = 0,
+        bool genMipmaps = true) const override;
+    std::shared_ptr<core::graphics::ITexture> createTexture2DEmpty(
+        uint32_t width,
+        uint32_t height,
+        core::graphics::PixelInternalFormat,
+        uint32_t numLevels = 1) const override;
+    std::shared_ptr<core::graphics::ITexture> createTexture2D(
+        const std::shared_ptr<const utils::Image>&,
+        core::graphics::PixelInternalFormat = core::graphics::PixelInternalFormat::Count,
+        uint32_t numLevels = 0,
+        bool genMipmaps = true) const override;
+    std::shared_ptr<core::graphics::ITexture> createTexture3DEmpty(
+        uint32_t width,
+        uint32_t height,
+        uint32_t depth,
+        core::graphics::PixelInternalFormat,
+        uint32_t numLevels = 1) const override;
+    std::shared_ptr<core::graphics::ITexture> createTexture3D(
+        const std::vector<std::shared_ptr<const utils::Image>>&,
+        core::graphics::PixelInternalFormat = core::graphics::PixelInternalFormat::Count,
+        uint32_t numLevels = 0,
+        bool genMipmaps = true) const override;
+    std::shared_ptr<core::graphics::ITexture> createTextureCubeEmpty(
+        uint32_t width,
+        uint32_t height,
+        core::graphics::PixelInternalFormat,
+        uint32_t numLevels = 1) const override;
+    std::shared_ptr<core::graphics::ITexture> createTextureCube(
+        const std::vector<std::shared_ptr<const utils::Image>>&,
+        core::graphics::PixelInternalFormat = core::graphics::PixelInternalFormat::Count,
+        uint32_t numLevels = 0,
+        bool genMipmaps = true) const override;
+    std::shared_ptr<core::graphics::ITexture> createTexture1DArrayEmpty(
+        uint32_t width,
+        uint32_t numLayers,
+        core::graphics::PixelInternalFormat,
+        uint32_t numLevels = 1) const override;
+    std::shared_ptr<core::graphics::ITexture> createTexture1DArray(
+        const std::vector<std::shared_ptr<const utils::Image>>&,
+        core::graphics::PixelInternalFormat = core::graphics::PixelInternalFormat::Count,
+        uint32_t numLevels = 0,
+        bool genMipmaps = true) const override;
+    std::shared_ptr<core::graphics::ITexture> createTexture2DArrayEmpty(
+        uint32_t width,
+        uint32_t height,
+        uint32_t numLayers,
+        core::graphics::PixelInternalFormat,
+        uint32_t numLevels = 1) const override;
+    std::shared_ptr<core::graphics::ITexture> createTexture2DArray(
+        const std::vector<std::shared_ptr<const utils::Image>>&,
+        core::graphics::PixelInternalFormat = core::graphics::PixelInternalFormat::Count,
+        uint32_t numLevels = 0,
+        bool genMipmaps = true) const override;
+    std::shared_ptr<core::graphics::ITexture> createTextureCubeArrayEmpty(
+        uint32_t width,
+        uint32_t height,
+        uint32_t numLayers,
+        core::graphics::PixelInternalFormat,
+        uint32_t numLevels = 1) const override;
+    std::shared_ptr<core::graphics::ITexture> createTextureCubeArray(
+        const std::vector<std::vector<std::shared_ptr<const utils::Image>>>&,
+        core::graphics::PixelInternalFormat = core::graphics::PixelInternalFormat::Count,
+        uint32_t numLevels = 0,
+        bool genMipmaps = true) const override;
+    std::shared_ptr<core::graphics::ITexture> createTextureRectEmpty(
+        uint32_t width,
+        uint32_t height,
+        core::graphics::PixelInternalFormat) const override;
+    std::shared_ptr<core::graphics::ITexture> createTextureRect(
+        const std::shared_ptr<const utils::Image>&,
+        core::graphics::PixelInternalFormat = core::graphics::PixelInternalFormat::Count) const override;
+    std::shared_ptr<core::graphics::ITextureHandle> createTextureHandle(const core::graphics::PConstTexture&) const override;
+    std::shared_ptr<core::graphics::IImageHandle> createImageHandle(const core::graphics::PConstImage&) const override;
+    std::shared_ptr<core::graphics::IRenderBuffer> createRenderBuffer(
+        uint32_t width,
+        uint32_t height,
+        core::graphics::PixelInternalFormat) const override;
+    std::shared_ptr<core::graphics::IFrameBuffer> createFrameBuffer() const override;
+    std::shared_ptr<core::graphics::IRenderProgram> createRenderProgram(
+        const std::shared_ptr<utils::Shader>& vertexShader,
+        const std::shared_ptr<utils::Shader>& fragmentShader) const override;
+    std::shared_ptr<core::graphics::IRenderProgram> createRenderProgram(
+        const std::shared_ptr<utils::Shader>& vertexShader,
+        const std::shared_ptr<utils::Shader>& geometryShader,
+        const std::shared_ptr<utils::Shader>& fragmentShader) const override;
+    std::shared_ptr<core::graphics::IComputeProgram> createComputeProgram(const std::shared_ptr<utils::Shader>& computeShader)
+        const override;
+    std::shared_ptr<core::graphics::ITimestampQuery> createTimestampQuery() const override;
+    std::shared_ptr<core::graphics::IBufferReadback> createBufferReadback(size_t) const override;
+
+    std::string programBinaryDriverKey() const override;
+    std::shared_ptr<core::graphics::IRenderProgram> createRenderProgram(const core::graphics::ProgramBinary&) const override;
+    std::shared_ptr<core::graphics::IComputeProgram> createComputeProgram(const core::graphics::ProgramBinary&) const override;
+
+    void compute(const glm::uvec3&, const std::shared_ptr<core::graphics::IComputeProgram>&, const core::StateSetList&) override;
+
+    void computeIndirect(
+        const std::shared_ptr<core::graphics::IComputeProgram>&,
+        const core::StateSetList&,
+        const core::graphics::PDispatchComputeIndirectCommandConstBuffer&) override;
+
+    void drawArrays(
+        const glm::uvec4&,
+        const std::shared_ptr<core::graphics::IRenderProgram>&,
+        const std::shared_ptr<core::graphics::IFrameBuffer>&,
+        const std::shared_ptr<core::graphics::IVertexArray>&,
+        const core::StateSetList&,
+        utils::PrimitiveType,
+        size_t first,
+        size_t count) override;
+
+    void drawElements(
+        const glm::uvec4&,
+        const std::shared_ptr<core::graphics::IRenderProgram>&,
+        const std::shared_ptr<core::graphics::IFrameBuffer>&,
+        const std::shared_ptr<core::graphics::IVertexArray>&,
+        const core::StateSetList&,
+        utils::PrimitiveType,
+        size_t count,
+        utils::DrawElementsIndexType,
+        size_t offset) override;
+
+    void multiDrawArrays(
+        const glm::uvec4&,
+        const std::shared_ptr<core::graphics::IRenderProgram>&,
+        const std::shared_ptr<core::graphics::IFrameBuffer>&,
+        const std::shared_ptr<core::graphics::IVertexArray>&,
+        const core::StateSetList&,
+        utils::PrimitiveType,
+        const std::vector<size_t>& firsts,
+        const std::vector<size_t>& counts) override;
+
+    void multiDrawElements(
+        const glm::uvec4&,
+        const std::shared_ptr<core::graphics::IRenderProgram>&,
+        const std::shared_ptr<core::graphics::IFrameBuffer>&,
+        const std::shared_ptr<core::graphics::IVertexArray>&,
+        const core::StateSetList&,
+        utils::PrimitiveType,
+        const std::vector<size_t>& counts,
+        utils::DrawElementsIndexType,
+        const std::vector<size_t>& offsets) override;
+
+    void drawElementsBaseVertex(
+        const glm::uvec4&,
+        const std::shared_ptr<core::graphics::IRenderProgram>&,
+        const std::shared_ptr<core::graphics::IFrameBuffer>&,
+        const std::shared_ptr<core::graphics::IVertexArray>&,
+        const core::StateSetList&,
+        utils::PrimitiveType,
+        size_t count,
+        utils::DrawElementsIndexType,
+        size_t offset,
+        uint32_t baseVertex) override;
+
+    void drawArraysInstanced(
+        const glm::uvec4&,
+        const std::shared_ptr<core::graphics::IRenderProgram>&,
+        const std::shared_ptr<core::graphics::IFrameBuffer>&,
+        const std::shared_ptr<core::graphics::IVertexArray>&,
+        const core::StateSetList&,
+        utils::PrimitiveType,
+        size_t first,
+        size_t count,
+        size_t numInstances) override;
+
+    void drawElementsInstanced(
+        const glm::uvec4&,
+        const std::shared_ptr<core::graphics::IRenderProgram>&,
+        const std::shared_ptr<core::graphics::IFrameBuffer>&,
+        const std::shared_ptr<core::graphics::IVertexArray>&,
+        const core::StateSetList&,
+        utils::PrimitiveType,
+        size_t count,
+        utils::DrawElementsIndexType,
+        size_t offset,
+        size_t numInstances) override;
+
+    void drawArraysInstancedBaseInstance(
+        const glm::uvec4&,
+        const std::shared_ptr<core::graphics::IRenderProgram>&,
+        const std::shared_ptr<core::graphics::IFrameBuffer>&,
+        const std::shared_ptr<core::graphics::IVertexArray>&,
+        const core::StateSetList&,
+        utils::PrimitiveType,
+        size_t first,
+        size_t count,
+        size_t numInstances,
+        uint32_t baseInstance) override;
+
+    void drawElementsInstancedBaseInstance(
+        const glm::uvec4&,
+        const std::shared_ptr<core::graphics::IRenderProgram>&,
+        const std::shared_ptr<core::graphics::IFrameBuffer>&,
+        const std::shared_ptr<core::graphics::IVertexArray>&,
+        const core::StateSetList&,
+        utils::PrimitiveType,
+        size_t count,
+        utils::DrawElementsIndexType,
+        size_t offset,
+        size_t numInstances,
+        uint32_t baseInstance) override;
+
+    void drawArraysIndirect(
+        const glm::uvec4&,
+        const std::shared_ptr<core::graphics::IRenderProgram>&,
+        const std::shared_ptr<core::graphics::IFrameBuffer>&,
+        const std::shared_ptr<core::graphics::IVertexArray>&,
+        const core::StateSetList&,
+        utils::PrimitiveType,
+        const core::graphics::PDrawArraysIndirectCommandsConstBuffer&) override;
+
+    void drawElementsIndirect(
+        const glm::uvec4&,
+        const std::shared_ptr<core::graphics::IRenderProgram>&,
+        const std::shared_ptr<core::graphics::IFrameBuffer>&,
+        const std::shared_ptr<core::graphics::IVertexArray>&,
+        const core::StateSetList&,
+        utils::PrimitiveType,
+        utils::DrawElementsIndexType,
+        const core::graphics::PDrawElementsIndirectCommandConstBuffer&) override;
+
+    void multiDrawArraysIndirect(
+        const glm::uvec4&,
+        const std::shared_ptr<core::graphics::IRenderProgram>&,
+        const std::shared_ptr<core::graphics::IFrameBuffer>&,
+        const std::shared_ptr<core::graphics::IVertexArray>&,
+        const core::StateSetList&,
+        utils::PrimitiveType,
+        const core::graphics::PDrawArraysIndirectCommandsConstBuffer&) override;
+
+    void multiDrawElementsIndirect(
+        const glm::uvec4&,
+        const std::shared_ptr<core::graphics::IRenderProgram>&,
+        const std::shared_ptr<core::graphics::IFrameBuffer>&,
+        const std::shared_ptr<core::graphics::IVertexArray>&,
+        const core::StateSetList&,
+        utils::PrimitiveType,
+        utils::DrawElementsIndexType,
+        const core::graphics::PDrawElementsIndirectCommandConstBuffer&) override;
+
+    void multiDrawArraysIndirectCount(
+        const glm::uvec4&,
+        const std::shared_ptr<core::graphics::IRenderProgram>&,
+        const std::shared_ptr<core::graphics::IFrameBuffer>&,
+        const std::shared_ptr<core::graphics::IVertexArray>&,
+        const core::StateSetList&,
+        utils::PrimitiveType,
+        const core::graphics::PDrawArraysIndirectCommandsConstBuffer&,
+        const core::graphics::PConstBufferRange&) override;
+
+    void multiDrawElementsIndirectCount(
+        const glm::uvec4&,
+        const std::shared_ptr<core::graphics::IRenderProgram>&,
+        const std::shared_ptr<core::graphics::IFrameBuffer>&,
+        const std::shared_ptr<core::graphics::IVertexArray>&,
+        const core::StateSetList&,
+        utils::PrimitiveType,
+        utils::DrawElementsIndexType,
+        const core::graphics::PDrawElementsIndirectCommandConstBuffer&,
+        const core::graphics::PConstBufferRange&) override;
+
+protected:
+    bool doMakeCurrent() override;
+    bool doDoneCurrent() override;
+
+private:
+    std::weak_ptr<HeadlessWidget> m_widget;
+
+    HeadlessFrameRecord m_frameRecord;
+    HeadlessFrameRecord m_lastFrameRecord;
+};
+
+} // namespace graphics_headless
+} // namespace simplex
+
+#endif // GRAPHICS_HEADLESS_RENDERER_H
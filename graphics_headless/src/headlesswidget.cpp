@@ -0,0 +1,346 @@
+#include <chrono>
+
+#include <utils/logger.h>
+
+#include <core/graphicsengine.h>
+
+#include <graphics_headless/headlesswidget.h>
+
+#include "headlessrenderer.h"
+#include "headlesswidgetprivate.h"
+
+namespace simplex
+{
+namespace graphics_headless
+{
+
+static void closeWidget(const HeadlessWidget& widget)
+{
+    if (!widget.isInitialized()) return;
+
+    if (auto callback = widget.closeCallback()) callback();
+
+    auto& widgetPrivate = widget.m();
+
+    if (auto& renderer = widgetPrivate.renderer())
+    {
+        renderer->makeCurrent();
+        widgetPrivate.defaultFrameBuffer() = nullptr;
+        widgetPrivate.engine() = nullptr;
+        renderer = nullptr;
+    }
+}
+
+HeadlessWidget::~HeadlessWidget()
+{
+    closeWidget(*this);
+    LOG_INFO << "HeadlessWidget \"" << HeadlessWidget::name() << "\" has been destroyed";
+}
+
+const std::string& HeadlessWidget::name() const
+{
+    return m_->name();
+}
+
+bool HeadlessWidget::isInitialized() const
+{
+    return m_->engine() != nullptr;
+}
+
+void HeadlessWidget::update(const std::shared_ptr<core::Scene>& scene, uint64_t time, uint32_t dt)
+{
+    if (auto& callback = m_->updateCallback()) callback(time, dt);
+
+    m_->engine()->update(scene, time, dt);
+
+    m_->renderer()->endFrameRecord();
+}
+
+std::shared_ptr<core::IEngine> HeadlessWidget::engine()
+{
+    return graphicsEngine();
+}
+
+std::shared_ptr<const core::IEngine> HeadlessWidget::engine() const
+{
+    return graphicsEngine();
+}
+
+std::shared_ptr<core::GraphicsEngine> HeadlessWidget::graphicsEngine()
+{
+    return m_->engine();
+}
+
+std::shared_ptr<const core::GraphicsEngine> HeadlessWidget::graphicsEngine() const
+{
+    return const_cast<HeadlessWidget*>(this)->graphicsEngine();
+}
+
+std::shared_ptr<core::graphics::IFrameBuffer> HeadlessWidget::defaultFrameBuffer()
+{
+    return m().defaultFrameBuffer();
+}
+
+std::shared_ptr<const core::graphics::IFrameBuffer> HeadlessWidget::defaultFrameBuffer() const
+{
+    return const_cast<HeadlessWidget*>(this)->defaultFrameBuffer();
+}
+
+std::string HeadlessWidget::title() const
+{
+    return m_->title();
+}
+
+void HeadlessWidget::setTitle(const std::string& value)
+{
+    m_->title() = value;
+}
+
+void HeadlessWidget::setIcon(const std::shared_ptr<utils::Image>&)
+{
+}
+
+glm::uvec2 HeadlessWidget::position() const
+{
+    return m_->position();
+}
+
+void HeadlessWidget::setPosition(const glm::uvec2& value)
+{
+    m_->position() = value;
+}
+
+glm::uvec2 HeadlessWidget::size() const
+{
+    return m_->size();
+}
+
+void HeadlessWidget::setSize(const glm::uvec2& value)
+{
+    if (m_->size() == value) return;
+
+    m_->size() = value;
+    if (auto callback = m_->resizeCallback()) callback(value);
+}
+
+void HeadlessWidget::minimize()
+{
+}
+
+void HeadlessWidget::maximize()
+{
+}
+
+void HeadlessWidget::restore()
+{
+}
+
+void HeadlessWidget::show(bool)
+{
+}
+
+void HeadlessWidget::hide()
+{
+}
+
+void HeadlessWidget::setFocus()
+{
+}
+
+glm::ivec2 HeadlessWidget::mouseCursorPosition() const
+{
+    return m_->mouseCursorPosition();
+}
+
+void HeadlessWidget::setMouseCursorPosition(const glm::ivec2& value)
+{
+    m_->mouseCursorPosition() = value;
+}
+
+void HeadlessWidget::showMouseCursor(bool)
+{
+}
+
+void HeadlessWidget::hideMouseCursor()
+{
+}
+
+void HeadlessWidget::setMouseStandardCursor(core::graphics::MouseStandardCursor)
+{
+}
+
+void HeadlessWidget::setMouseCursor(const std::shared_ptr<utils::Image>&, const glm::uvec2&)
+{
+}
+
+bool HeadlessWidget::isMouseCursorInside() const
+{
+    return false;
+}
+
+core::graphics::KeyState HeadlessWidget::keyState(core::graphics::KeyCode) const
+{
+    return core::graphics::KeyState::Released;
+}
+
+std::string HeadlessWidget::keyName(core::graphics::KeyCode) const
+{
+    return std::string();
+}
+
+core::graphics::MouseButtonState HeadlessWidget::mouseButtonState(core::graphics::MouseButton) const
+{
+    return core::graphics::MouseButtonState::Released;
+}
+
+core::graphics::CloseCallback HeadlessWidget::closeCallback() const
+{
+    return m_->closeCallback();
+}
+
+void HeadlessWidget::setCloseCallback(core::graphics::CloseCallback value)
+{
+    m_->closeCallback() = value;
+}
+
+core::graphics::ResizeCallback HeadlessWidget::resizeCallback() const
+{
+    return m_->resizeCallback();
+}
+
+void HeadlessWidget::setResizeCallback(core::graphics::ResizeCallback value)
+{
+    m_->resizeCallback() = value;
+}
+
+core::graphics::UpdateCallback HeadlessWidget::updateCallback() const
+{
+    return m_->updateCallback();
+}
+
+void HeadlessWidget::setUpdateCallback(core::graphics::UpdateCallback value)
+{
+    m_->updateCallback() = value;
+}
+
+core::graphics::KeyCallback HeadlessWidget::keyCallback() const
+{
+    return m_->keyCallback();
+}
+
+void HeadlessWidget::setKeyCallback(core::graphics::KeyCallback value)
+{
+    m_->keyCallback() = value;
+}
+
+core::graphics::MouseCursorMoveCallback HeadlessWidget::mouseCursorMoveCallback() const
+{
+    return m_->mouseCursorMoveCallback();
+}
+
+void HeadlessWidget::setMouseCursorMoveCallback(core::graphics::MouseCursorMoveCallback value)
+{
+    m_->mouseCursorMoveCallback() = value;
+}
+
+core::graphics::MouseCursorEnterCallback HeadlessWidget::mouseCursorEnterCallback() const
+{
+    return m_->mouseCursorEnterCallback();
+}
+
+void HeadlessWidget::setMouseCursorEnterCallback(core::graphics::MouseCursorEnterCallback value)
+{
+    m_->mouseCursorEnterCallback() = value;
+}
+
+core::graphics::MouseButtonCallback HeadlessWidget::mouseButtonCallback() const
+{
+    return m_->mouseButtonCallback();
+}
+
+void HeadlessWidget::setMouseButtonCallback(core::graphics::MouseButtonCallback value)
+{
+    m_->mouseButtonCallback() = value;
+}
+
+core::graphics::MouseScrollCallback HeadlessWidget::mouseScrollCallback() const
+{
+    return m_->mouseScrollCallback();
+}
+
+void HeadlessWidget::setMouseScrollCallback(core::graphics::MouseScrollCallback value)
+{
+    m_->mouseScrollCallback() = value;
+}
+
+std::shared_ptr<core::graphics::ShareGroup> HeadlessWidget::shareGroup()
+{
+    return m_->shareGroup();
+}
+
+std::shared_ptr<const core::graphics::ShareGroup> HeadlessWidget::shareGroup() const
+{
+    return const_cast<HeadlessWidget*>(this)->shareGroup();
+}
+
+const HeadlessFrameRecord& HeadlessWidget::lastFrameRecord() const
+{
+    return m_->renderer()->lastFrameRecord();
+}
+
+std::shared_ptr<HeadlessWidget> HeadlessWidget::getOrCreate(const std::string& name, const std::shared_ptr<HeadlessWidget>& sharedWidget)
+{
+    std::shared_ptr<HeadlessWidget> result;
+
+    auto& instances = HeadlessWidgetPrivate::instances();
+    if (auto it = instances.find_if([&name](const std::shared_ptr<HeadlessWidget>& value) { return value->name() == name; });
+        it != instances.end())
+    {
+        result = it->lock();
+    }
+
+    if (!result)
+    {
+        std::shared_ptr<core::graphics::ShareGroup> shareGroup;
+        if (sharedWidget) shareGroup = sharedWidget->shareGroup();
+
+        if (!shareGroup) shareGroup = std::make_shared<core::graphics::ShareGroup>();
+
+        result = std::shared_ptr<HeadlessWidget>(new HeadlessWidget(name, shareGroup));
+        auto& resultPrivate = result->m();
+
+        auto renderer = std::make_shared<HeadlessRenderer>(name + "Renderer", result);
+        resultPrivate.renderer() = renderer;
+
+        auto engine = std::make_shared<core::GraphicsEngine>(name + "Engine", renderer);
+        resultPrivate.engine() = engine;
+
+        resultPrivate.defaultFrameBuffer() = HeadlessDefaultFrameBuffer::create();
+
+        shareGroup->push_back(result);
+        instances.push_back(result);
+
+        LOG_INFO << "HeadlessWidget has been created (Name: \"" << name << "\")";
+    }
+
+    return result;
+}
+
+void HeadlessWidget::pollEvents()
+{
+}
+
+uint64_t HeadlessWidget::time()
+{
+    static const auto s_startTime = std::chrono::steady_clock::now();
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - s_startTime).count());
+}
+
+HeadlessWidget::HeadlessWidget(const std::string& name, const std::shared_ptr<core::graphics::ShareGroup>& shareGroup)
+    : m_(std::make_unique<HeadlessWidgetPrivate>(name, shareGroup))
+{
+}
+
+} // namespace graphics_headless
+} // namespace simplex
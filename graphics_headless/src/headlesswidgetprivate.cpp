@@ -0,0 +1,114 @@
+#include "headlesswidgetprivate.h"
+
+namespace simplex
+{
+namespace graphics_headless
+{
+
+utils::WeakPtrList<HeadlessWidget> HeadlessWidgetPrivate::s_instances;
+
+HeadlessWidgetPrivate::HeadlessWidgetPrivate(const std::string &name, const std::shared_ptr<core::graphics::ShareGroup> &shareGroup)
+    : m_name(name)
+    , m_title(name)
+    , m_position(0u)
+    , m_size(1920u, 1080u)
+    , m_mouseCursorPosition(0)
+    , m_closeCallback(nullptr)
+    , m_shareGroup(shareGroup)
+{
+}
+
+HeadlessWidgetPrivate::~HeadlessWidgetPrivate() = default;
+
+std::string &HeadlessWidgetPrivate::name()
+{
+    return m_name;
+}
+
+std::shared_ptr<core::GraphicsEngine>& HeadlessWidgetPrivate::engine()
+{
+    return m_engine;
+}
+
+std::shared_ptr<HeadlessRenderer>& HeadlessWidgetPrivate::renderer()
+{
+    return m_renderer;
+}
+
+std::string &HeadlessWidgetPrivate::title()
+{
+    return m_title;
+}
+
+glm::uvec2 &HeadlessWidgetPrivate::position()
+{
+    return m_position;
+}
+
+glm::uvec2 &HeadlessWidgetPrivate::size()
+{
+    return m_size;
+}
+
+glm::ivec2 &HeadlessWidgetPrivate::mouseCursorPosition()
+{
+    return m_mouseCursorPosition;
+}
+
+core::graphics::CloseCallback& HeadlessWidgetPrivate::closeCallback()
+{
+    return m_closeCallback;
+}
+
+core::graphics::ResizeCallback& HeadlessWidgetPrivate::resizeCallback()
+{
+    return m_resizeCallback;
+}
+
+core::graphics::UpdateCallback& HeadlessWidgetPrivate::updateCallback()
+{
+    return m_updateCallback;
+}
+
+core::graphics::KeyCallback& HeadlessWidgetPrivate::keyCallback()
+{
+    return m_keyCallback;
+}
+
+core::graphics::MouseCursorMoveCallback& HeadlessWidgetPrivate::mouseCursorMoveCallback()
+{
+    return m_mouseCursorMoveCallback;
+}
+
+core::graphics::MouseCursorEnterCallback& HeadlessWidgetPrivate::mouseCursorEnterCallback()
+{
+    return m_mouseCursorEnterCallback;
+}
+
+core::graphics::MouseButtonCallback& HeadlessWidgetPrivate::mouseButtonCallback()
+{
+    return m_mouseButtonCallback;
+}
+
+core::graphics::MouseScrollCallback& HeadlessWidgetPrivate::mouseScrollCallback()
+{
+    return m_mouseScrollCallback;
+}
+
+std::shared_ptr<core::graphics::ShareGroup>& HeadlessWidgetPrivate::shareGroup()
+{
+    return m_shareGroup;
+}
+
+std::shared_ptr<HeadlessDefaultFrameBuffer> &HeadlessWidgetPrivate::defaultFrameBuffer()
+{
+    return m_defaultFrameBuffer;
+}
+
+utils::WeakPtrList<HeadlessWidget>& HeadlessWidgetPrivate::instances()
+{
+    return s_instances;
+}
+
+}
+}
@@ -0,0 +1,73 @@
+#ifndef GRAPHICS_HEADLESS_WIDGET_PRIVATE_H
+#define GRAPHICS_HEADLESS_WIDGET_PRIVATE_H
+
+#include <core/igraphicswidget.h>
+
+#include <graphics_headless/forwarddecl.h>
+
+namespace simplex
+{
+namespace graphics_headless
+{
+
+class HeadlessRenderer;
+class HeadlessDefaultFrameBuffer;
+
+class HeadlessWidgetPrivate
+{
+public:
+    HeadlessWidgetPrivate(const std::string &name, const std::shared_ptr<core::graphics::ShareGroup>&);
+    ~HeadlessWidgetPrivate();
+
+    std::string &name();
+    std::shared_ptr<core::GraphicsEngine>& engine();
+    std::shared_ptr<HeadlessRenderer>& renderer();
+
+    std::string &title();
+    glm::uvec2 &position();
+    glm::uvec2 &size();
+    glm::ivec2 &mouseCursorPosition();
+
+    core::graphics::CloseCallback &closeCallback();
+    core::graphics::ResizeCallback &resizeCallback();
+    core::graphics::UpdateCallback& updateCallback();
+    core::graphics::KeyCallback &keyCallback();
+    core::graphics::MouseCursorMoveCallback &mouseCursorMoveCallback();
+    core::graphics::MouseCursorEnterCallback &mouseCursorEnterCallback();
+    core::graphics::MouseButtonCallback &mouseButtonCallback();
+    core::graphics::MouseScrollCallback &mouseScrollCallback();
+
+    std::shared_ptr<core::graphics::ShareGroup> &shareGroup();
+    std::shared_ptr<HeadlessDefaultFrameBuffer> &defaultFrameBuffer();
+
+    static utils::WeakPtrList<HeadlessWidget> &instances();
+
+private:
+    std::string m_name;
+    std::shared_ptr<core::GraphicsEngine> m_engine;
+    std::shared_ptr<HeadlessRenderer> m_renderer;
+
+    std::string m_title;
+    glm::uvec2 m_position;
+    glm::uvec2 m_size;
+    glm::ivec2 m_mouseCursorPosition;
+
+    core::graphics::CloseCallback m_closeCallback;
+    core::graphics::ResizeCallback m_resizeCallback;
+    core::graphics::UpdateCallback m_updateCallback;
+    core::graphics::KeyCallback m_keyCallback;
+    core::graphics::MouseCursorMoveCallback m_mouseCursorMoveCallback;
+    core::graphics::MouseCursorEnterCallback m_mouseCursorEnterCallback;
+    core::graphics::MouseButtonCallback m_mouseButtonCallback;
+    core::graphics::MouseScrollCallback m_mouseScrollCallback;
+
+    std::shared_ptr<core::graphics::ShareGroup> m_shareGroup;
+    std::shared_ptr<HeadlessDefaultFrameBuffer> m_defaultFrameBuffer;
+
+    static utils::WeakPtrList<HeadlessWidget> s_instances;
+};
+
+}
+}
+
+#endif // GRAPHICS_HEADLESS_WIDGET_PRIVATE_H
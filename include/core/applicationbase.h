@@ -43,6 +43,9 @@ public:
 
     uint32_t FPS() const;
 
+    const debug::Information& debugInformation() const;
+    debug::Information& debugInformation();
+
 protected:
     ApplicationBase(const std::string&, ApplicationTimeCallback, ApplicationPollEventsCallback);
 
@@ -50,6 +50,12 @@ public:
     const glm::uvec3& clusterSize() const;
     void setClusterSize(const glm::uvec3&);
 
+    bool isAutoInstancingEnabled() const; // the visible draw data of the same drawable are drawn by one instanced command
+    void setAutoInstancingEnabled(bool);
+
+    bool isLightBinningEnabled() const; // the local lights are binned by the screen tiles and the depth slices
+    void setLightBinningEnabled(bool);
+
     ShadowsSettings& shadowsSettings();
     const ShadowsSettings& shadowsSettings() const;
 
@@ -11,6 +11,13 @@ namespace core
 namespace debug
 {
 
+struct RenderPassInformation
+{
+    std::string renderPassName;
+    float GPUTime = 0.f; // milliseconds
+    float averageGPUTime = 0.f; // milliseconds
+};
+
 struct CameraInformation
 {
     std::string cameraName;
@@ -18,11 +25,23 @@ struct CameraInformation
     uint32_t numTransparentDrawablesRendered = 0u;
     uint32_t numFragmentsRendered = 0u;
     uint32_t numLightsRendered = 0u;
+    uint32_t numDrawDataRenderCommands = 0u; // the instanced ones are counted once
+    uint32_t numDrawDataInstancesRendered = 0u;
+    uint32_t numMeshletsProcessed = 0u;
+    uint32_t numMeshletsCulled = 0u;
+    uint32_t numMeshletTrianglesCulled = 0u;
+    uint32_t numDrawDataOcclusionCulled = 0u; // the draw data in the frustum hidden by the depth pyramid
+    float GPUTime = 0.f; // milliseconds
+    float averageGPUTime = 0.f; // milliseconds
+    std::vector<RenderPassInformation> renderPassesInformation;
 };
 
 struct SceneInformation
 {
     std::string sceneName;
+    float geometryDataFragmentation = 0.f; // percents
+    uint64_t numGeometryDataBytesReclaimed = 0u;
+    uint64_t numDeduplicatedGeometryBytes = 0u;
     std::vector<CameraInformation> camerasInformation;
 };
 
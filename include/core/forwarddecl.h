@@ -21,6 +21,7 @@ namespace core
 
 namespace debug
 {
+struct RenderPassInformation;
 struct CameraInformation;
 struct SceneInformation;
 struct Information;
@@ -84,14 +85,18 @@ using ImageHandle = uint64_t;
 class ITextureHandle;
 class IImageHandle;
 class IRenderBuffer;
+class ITimestampQuery;
+class IBufferReadback;
 class IFrameBuffer;
 class IProgram;
 class IRenderProgram;
 class IComputeProgram;
+struct ProgramBinary;
 struct DispatchIndirectCommand;
 struct DrawArraysIndirectCommand;
 struct DrawElementsIndirectCommand;
 struct DrawIndirectCommandsBufferReservedData;
+struct FrameStatistics;
 class RendererBase;
 class BufferRange;
 class Image;
@@ -302,6 +302,7 @@ public:
     virtual void insert(size_t offset, const void* data, size_t size) = 0;
     virtual void erase(size_t offset, size_t size) = 0;
     virtual void resize(size_t) = 0;
+    virtual void copy(size_t srcOffset, size_t dstOffset, size_t size) = 0; // the ranges may overlap
 };
 
 class IVertexArray
@@ -410,6 +411,28 @@ class IRenderBuffer : public ISurface
 public:
 };
 
+class ITimestampQuery
+{
+public:
+    virtual ~ITimestampQuery() = default;
+
+    virtual void record() = 0;
+    virtual bool isAvailable() const = 0;
+    virtual uint64_t time() const = 0; // nanoseconds
+};
+
+// The buffer range is copied on GPU when it's recorded and read when the copy is finished, so the readback never waits
+class IBufferReadback
+{
+public:
+    virtual ~IBufferReadback() = default;
+
+    virtual size_t size() const = 0;
+    virtual void record(const PConstBuffer&, size_t offset) = 0; // copies size() bytes from the offset
+    virtual bool isAvailable() const = 0;
+    virtual const uint8_t* data() const = 0; // the last recorded copy, valid when it's available
+};
+
 class IFrameBuffer
 {
 public:
@@ -491,11 +514,23 @@ public:
     virtual void setClipDistances(bool) = 0;
 };
 
+struct ProgramBinary
+{
+    uint32_t format = 0u;
+    std::vector<uint8_t> data;
+
+    // drivers don't report the access qualifiers, so they are stored next to the binary
+    std::vector<uint16_t> readOnlyShaderStorageBlocks; // indices of the blocks declared readonly
+    bool isWritingImages = true;
+};
+
 class IProgram
 {
 public:
     virtual ~IProgram() = default;
 
+    virtual bool binary(ProgramBinary&) const = 0; // false if the program can't be retrieved
+
     // virtual int32_t uniformLocationByName(const std::string&) const = 0;
 
     virtual const std::vector<UniformInfo>& uniformsInfo() const = 0;
@@ -552,7 +587,16 @@ struct DrawElementsIndirectCommand
     uint32_t baseInstance;
 };
 
+struct FrameStatistics
+{
+    uint32_t numGPUReadbacks = 0u;
+    uint32_t numStateChangesIssued = 0u;
+    uint32_t numStateChangesSkipped = 0u;
+    uint32_t numMemoryBarriers = 0u;
+};
+
 class RendererBasePrivate;
+
 class CORE_SHARED_EXPORT RendererBase : public std::enable_shared_from_this<RendererBase>, public IRenderer
 {
 public:
@@ -586,6 +630,10 @@ public:
     bool unregisterShaderStorageBlock(const std::string&);
     ShaderStorageBlockID shaderStorageBlockByName(const std::string&) const;
 
+    void beginFrame();
+    FrameStatistics& frameStatistics();
+    const FrameStatistics& lastFrameStatistics() const;
+
     virtual std::shared_ptr<IGraphicsWidget> widget() = 0;
     virtual std::shared_ptr<const IGraphicsWidget> widget() const = 0;
 
@@ -690,6 +738,13 @@ public:
         const std::shared_ptr<utils::Shader>& geometryShader,
         const std::shared_ptr<utils::Shader>& fragmentShader) const = 0;
     virtual std::shared_ptr<IComputeProgram> createComputeProgram(const std::shared_ptr<utils::Shader>& computeShader) const = 0;
+    virtual std::shared_ptr<ITimestampQuery> createTimestampQuery() const = 0;
+    virtual std::shared_ptr<IBufferReadback> createBufferReadback(size_t size) const = 0;
+
+    // Program binaries are valid only for the same driver. Empty key means that binaries are not supported
+    virtual std::string programBinaryDriverKey() const = 0;
+    virtual std::shared_ptr<IRenderProgram> createRenderProgram(const ProgramBinary&) const = 0; // nullptr if rejected
+    virtual std::shared_ptr<IComputeProgram> createComputeProgram(const ProgramBinary&) const = 0; // nullptr if rejected
 
     virtual void compute(const glm::uvec3&, const std::shared_ptr<IComputeProgram>&, const StateSetList&) = 0;
 
@@ -923,26 +978,37 @@ public:
 
     std::shared_ptr<const IStaticBuffer> buffer() const { return m_buffer; }
 
-    value_type get() const { return *reinterpret_cast<value_type*>(m_buffer->map(IBuffer::MapAccess::ReadOnly)->get()); }
+    bool isHostMirrored() const { return m_hostData != nullptr; }
+
+    value_type get() const
+    {
+        if (m_hostData) return *m_hostData;
+        return *reinterpret_cast<value_type*>(m_buffer->map(IBuffer::MapAccess::ReadOnly)->get());
+    }
 
     template <typename FieldType>
     FieldType getField(size_t offset) const
     {
+        if (m_hostData) return *reinterpret_cast<const FieldType*>(reinterpret_cast<const uint8_t*>(m_hostData.get()) + offset);
         return *reinterpret_cast<FieldType*>(m_buffer->map(IBuffer::MapAccess::ReadOnly, offset, sizeof(FieldType))->get());
     }
 
     void set(const value_type& value)
     {
+        if (m_hostData) *m_hostData = value;
         *reinterpret_cast<value_type*>(m_buffer->map(IBuffer::MapAccess::WriteOnly)->get()) = value;
     }
 
     template <typename FieldType>
     void setField(size_t offset, const FieldType& value) const
     {
+        if (m_hostData) *reinterpret_cast<FieldType*>(reinterpret_cast<uint8_t*>(m_hostData.get()) + offset) = value;
         *reinterpret_cast<FieldType*>(m_buffer->map(IBuffer::MapAccess::WriteOnly, offset, sizeof(FieldType))->get()) = value;
     }
 
-    static std::shared_ptr<StructBuffer<value_type>> create(const value_type& value = value_type())
+    // host mirrored buffer keeps the authoritative copy in CPU memory, so reading never waits for GPU.
+    // It must not be used for buffers that are written by GPU
+    static std::shared_ptr<StructBuffer<value_type>> create(const value_type& value = value_type(), bool isHostMirrored = false)
     {
         auto currentContext = RendererBase::current();
         if (!currentContext)
@@ -952,16 +1018,18 @@ public:
         }
 
         return std::shared_ptr<StructBuffer<value_type>>(
-            new StructBuffer<value_type>(currentContext->createStaticBuffer(sizeofT(), &value)));
+            new StructBuffer<value_type>(currentContext->createStaticBuffer(sizeofT(), &value), value, isHostMirrored));
     }
 
 private:
-    StructBuffer(const std::shared_ptr<IStaticBuffer>& buffer)
+    StructBuffer(const std::shared_ptr<IStaticBuffer>& buffer, const value_type& value, bool isHostMirrored)
         : m_buffer(buffer)
+        , m_hostData(isHostMirrored ? std::make_unique<value_type>(value) : nullptr)
     {
     }
 
     std::shared_ptr<IStaticBuffer> m_buffer;
+    std::unique_ptr<value_type> m_hostData;
 };
 
 template <typename T>
@@ -987,13 +1055,50 @@ public:
     void insert(size_t index, const value_type* data, size_t count)
     {
         m_buffer->insert(index * sizeofT(), data, count * sizeofT());
+
+        if (m_hostData && count && (index <= m_hostData->size()))
+        {
+            auto it = m_hostData->begin() + static_cast<std::ptrdiff_t>(index);
+            if (data)
+                m_hostData->insert(it, data, data + count);
+            else
+                m_hostData->insert(it, count, value_type());
+        }
     }
     void insert(size_t index, std::initializer_list<value_type> l) { insert(index, l.begin(), l.size()); }
-    void erase(size_t index, size_t count) { m_buffer->erase(index * sizeofT(), count * sizeofT()); }
-    void resize(size_t count) { m_buffer->resize(count * sizeofT()); }
+    void erase(size_t index, size_t count)
+    {
+        m_buffer->erase(index * sizeofT(), count * sizeofT());
+
+        if (m_hostData && count && (index + count <= m_hostData->size()))
+        {
+            auto it = m_hostData->begin() + static_cast<std::ptrdiff_t>(index);
+            m_hostData->erase(it, it + static_cast<std::ptrdiff_t>(count));
+        }
+    }
+    void resize(size_t count)
+    {
+        m_buffer->resize(count * sizeofT());
+        if (m_hostData) m_hostData->resize(count);
+    }
 
     void pushBack(const value_type& value) { insert(size(), &value, 1u); }
 
+    void copy(size_t srcIndex, size_t dstIndex, size_t count)
+    {
+        m_buffer->copy(srcIndex * sizeofT(), dstIndex * sizeofT(), count * sizeofT());
+
+        if (m_hostData && count && (srcIndex + count <= m_hostData->size()) && (dstIndex + count <= m_hostData->size()))
+        {
+            auto srcIt = m_hostData->begin() + static_cast<std::ptrdiff_t>(srcIndex);
+            auto dstIt = m_hostData->begin() + static_cast<std::ptrdiff_t>(dstIndex);
+            if (srcIndex > dstIndex)
+                std::copy(srcIt, srcIt + static_cast<std::ptrdiff_t>(count), dstIt);
+            else
+                std::copy_backward(srcIt, srcIt + static_cast<std::ptrdiff_t>(count), dstIt + static_cast<std::ptrdiff_t>(count));
+        }
+    }
+
     void set(size_t index, const value_type* value, size_t count)
     {
         if (!value || !count) return;
@@ -1001,6 +1106,8 @@ public:
         if (index >= size()) LOG_CRITICAL << "Index is out of range";
         if (index + count > size()) LOG_CRITICAL << "Count is out of range";
 
+        if (m_hostData) std::copy(value, value + count, m_hostData->begin() + static_cast<std::ptrdiff_t>(index));
+
         auto mapData = m_buffer->map(IBuffer::MapAccess::WriteOnly, index * sizeofT(), count * sizeofT());
         std::memcpy(mapData->get(), value, count * sizeofT());
     }
@@ -1010,12 +1117,17 @@ public:
     {
         if (index >= size()) LOG_CRITICAL << "Index is out of range";
 
+        if (m_hostData) return (*m_hostData)[index];
+
         auto mapData = m_buffer->map(IBuffer::MapAccess::ReadOnly, index * sizeofT(), sizeofT());
 
         return *reinterpret_cast<value_type*>(mapData->get());
     }
 
-    static std::shared_ptr<VectorBuffer<value_type>> create(std::initializer_list<value_type> l = {})
+    bool isHostMirrored() const { return m_hostData != nullptr; }
+
+    // see StructBuffer::create
+    static std::shared_ptr<VectorBuffer<value_type>> create(std::initializer_list<value_type> l = {}, bool isHostMirrored = false)
     {
         auto currentContext = RendererBase::current();
         if (!currentContext)
@@ -1025,18 +1137,20 @@ public:
         }
 
         return std::shared_ptr<VectorBuffer<value_type>>(
-            new VectorBuffer<value_type>(currentContext->createDynamicBuffer(), l.begin(), l.size()));
+            new VectorBuffer<value_type>(currentContext->createDynamicBuffer(), l.begin(), l.size(), isHostMirrored));
     }
 
 private:
-    VectorBuffer(const std::shared_ptr<IDynamicBuffer>& buffer, const value_type* data, size_t count)
+    VectorBuffer(const std::shared_ptr<IDynamicBuffer>& buffer, const value_type* data, size_t count, bool isHostMirrored)
         : m_buffer(buffer)
+        , m_hostData(isHostMirrored ? std::make_unique<std::vector<value_type>>() : nullptr)
     {
         clear();
         insert(0u, data, count);
     }
 
     std::shared_ptr<IDynamicBuffer> m_buffer;
+    std::unique_ptr<std::vector<value_type>> m_hostData;
 };
 
 inline UniformType IProgram::uniformTypeByTextureType(TextureType textureType)
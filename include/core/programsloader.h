@@ -10,6 +10,14 @@ namespace simplex
 namespace core
 {
 
+struct ProgramBinaryCacheStatistics
+{
+    uint32_t numHits = 0u;
+    uint32_t numMisses = 0u;
+    uint32_t numRejected = 0u; // binaries that were found but rejected by the driver
+    uint64_t savedTime = 0u; // microseconds
+};
+
 class ProgramsLoaderPrivate;
 class CORE_SHARED_EXPORT ProgramsLoader : public ResourceLoaderBase<graphics::IProgram>
 {
@@ -34,6 +42,8 @@ public:
 
     std::shared_ptr<graphics::IComputeProgram> loadOrGetComputeProgram(const std::filesystem::path&, const utils::ShaderDefines&);
 
+    const ProgramBinaryCacheStatistics& programBinaryCacheStatistics() const;
+
 private:
     std::unique_ptr<ProgramsLoaderPrivate> m_;
 };
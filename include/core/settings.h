@@ -55,6 +55,7 @@ public:
     const utils::Range& cullPlaneLimits() const;
     const utils::Range& ZRange() const;
     const glm::u32vec3& clusterSize() const;
+    uint32_t maxClusterLightIndicesCount() const; // the cap of the light indices pool shared by all the clusters
 };
 
 class CORE_SHARED_EXPORT Background : public utils::SettingsComponent
@@ -220,6 +221,7 @@ public:
     const DrawableNodeLocalBoundingBox& drawableNodeLocalBoundingBox() const;
     const DrawableBoundingBox& drawableBoundingBox() const;
     const LightNodeAreaBoundingBox& lightNodeAreaBoundingBox() const;
+    bool fullMemoryBarriers() const;
 };
 
 class CORE_SHARED_EXPORT Graphics : public utils::SettingsComponent
@@ -229,8 +231,18 @@ public:
     ~Graphics() override;
 
     DrawDataCullingAlgorithm drawDataCullingAlgorithm() const;
+    bool occlusionCulling() const; // the draw data hidden by the depth of the ones visible last frame are not drawn
     ShadowDataCullingAlgorithm shadowDataCullingAlgorithm() const;
     SpotLightCullingAlgorithm spotLightCullingAlgorithm() const;
+    const std::filesystem::path& programBinaryCacheDirectory() const;
+    uint32_t geometryCompactionBytesPerFrame() const;
+    bool compactVertexFormat() const;
+    uint32_t meshLODsCount() const; // including the full detailed one
+    float meshLODBias() const; // the max error of the LODs in pixels
+    bool meshletCulling() const;
+    uint32_t meshletMaxTrianglesCount() const;
+    bool autoInstancing() const; // the visible draw data of the same drawable are drawn by one instanced command
+    bool lightBinning() const; // the local lights are binned by the screen tiles and the depth slices before the cluster tests
     const Camera& camera() const;
     const Background& background() const;
     const PBR& pbr() const;
@@ -89,11 +89,14 @@ ENUMCLASS(
     uint16_t,
     PositionNormalTexCoordsDataBuffer,
     TangentDataBuffer,
+    CompactPositionNormalTexCoordsDataBuffer,
+    CompactTangentDataBuffer,
     BoneDataBuffer,
     SkeletonsDataBuffer,
     BonesTransformsDataBuffer,
     ShadowTransformsDataBuffer,
     ShadowDataBuffer,
+    MeshletsDataBuffer,
 
     MeshesBuffer,
     MapsBuffer,
@@ -105,30 +108,43 @@ ENUMCLASS(
     SkeletonsBuffer,
 
     DrawDataBuffer,
+    LiveDrawDataBuffer,
     SkeletalAnimatedDataBuffer,
 
     SkeletalAnimatedDataToUpdateBuffer,
     ShadowsToUpdateBuffer,
+    MeshletsCullDrawDataBuffer,
+    DrawablesInstancesBuffer,
+    InstancedDrawDataBuffer,
+    DrawDataInstancesBuffer,
+    DrawDataVisibilityBuffer,
 
     SkeletalAnimatedDataToUpdateCommandBuffer,
     OpaqueDrawDataRenderCommandsBuffer,
     TransparentDrawDataRenderCommandsBuffer,
+    OpaqueDrawData16RenderCommandsBuffer,
+    TransparentDrawData16RenderCommandsBuffer,
+    MeshletsCullCommandBuffer,
     ClusterLocalLightsCommandBuffer,
     ShadowDataCullCommandBuffer,
     ShadowMapBlurCommandsBuffer,
     ShadowDataRenderCommandsBuffer,
     OpaqueShadowDataRenderCommandsBuffer,
     TransparentShadowDataRenderCommandsBuffer,
+    OpaqueShadowData16RenderCommandsBuffer,
+    TransparentShadowData16RenderCommandsBuffer,
 
     CameraBuffer,
     ClusterNodesBuffer,
     ClusterLocalLightsBuffer,
-    LightNodesBuffer,
+    LightIndicesBuffer,
+    LightMasksBuffer,
     RenderInfoBuffer,
     CountersBuffer,
     GBuffer,
     OITNodesBuffer,
     ShadowMapsBuffer,
+    DepthPyramidBuffer,
     HDRBuffer,
     ToneMappingBuffer,
 
@@ -145,6 +161,8 @@ public:
     StateSet();
     virtual ~StateSet();
 
+    uint64_t version() const;
+
     const UniformCollection& uniformCollection() const;
     PConstAbstractUniform uniform(UniformID) const;
     PAbstractUniform uniform(UniformID);
@@ -0,0 +1,20 @@
+#ifndef GRAPHICS_HEADLESS_FORWARDDECL_H
+#define GRAPHICS_HEADLESS_FORWARDDECL_H
+
+#include <cstdint>
+
+namespace simplex
+{
+namespace graphics_headless
+{
+
+enum class HeadlessCommandType : uint16_t;
+struct HeadlessCommand;
+struct HeadlessFrameRecord;
+
+class HeadlessWidget;
+
+}
+}
+
+#endif // GRAPHICS_HEADLESS_FORWARDDECL_H
@@ -0,0 +1,41 @@
+#ifndef GRAPHICS_HEADLESS_FRAMERECORD_H
+#define GRAPHICS_HEADLESS_FRAMERECORD_H
+
+#include <vector>
+
+#include <utils/enumclass.h>
+#include <utils/glm/vec3.hpp>
+
+#include <graphics_headless/forwarddecl.h>
+
+namespace simplex
+{
+namespace graphics_headless
+{
+
+ENUMCLASS(HeadlessCommandType, uint16_t, Compute, ComputeIndirect, Draw, DrawIndirect, DrawIndirectCount, BlitFrameBuffer, ClearFrameBuffer)
+
+struct HeadlessCommand
+{
+    HeadlessCommandType type;
+    glm::uvec3 numWorkGroups = glm::uvec3(0u); // Compute only
+    size_t numDraws = 0u; // the size of commands buffer for indirect draws
+    size_t numElements = 0u; // vertices or indices of all the draws, 0 for indirect draws
+    size_t numInstances = 0u;
+};
+
+struct HeadlessFrameRecord
+{
+    std::vector<HeadlessCommand> commands;
+    uint32_t numDraws = 0u;
+    uint32_t numDispatches = 0u;
+    size_t numBytesUploaded = 0u; // CPU -> buffers
+    size_t numBytesRead = 0u; // buffers -> CPU
+    size_t numBytesCopied = 0u; // buffer -> buffer
+    size_t numTextureBytesUploaded = 0u;
+};
+
+} // namespace graphics_headless
+} // namespace simplex
+
+#endif // GRAPHICS_HEADLESS_FRAMERECORD_H
@@ -0,0 +1,12 @@
+#ifndef GRAPHICS_HEADLESS_GLOBAL_H
+#define GRAPHICS_HEADLESS_GLOBAL_H
+
+#include <build/importexport.h>
+
+#if defined(GRAPHICS_HEADLESS_LIBRARY)
+#define GRAPHICS_HEADLESS_SHARED_EXPORT SIMPEX_DECL_EXPORT
+#else
+#define GRAPHICS_HEADLESS_SHARED_EXPORT SIMPEX_DECL_IMPORT
+#endif
+
+#endif // GRAPHICS_HEADLESS_GLOBAL_H
@@ -0,0 +1,40 @@
+#ifndef UTILS_HASH_H
+#define UTILS_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace simplex
+{
+namespace utils
+{
+
+// FNV-1a
+constexpr uint64_t hashSeed()
+{
+    return 0xcbf29ce484222325ull;
+}
+
+inline uint64_t hashData(uint64_t hash, const void* data, size_t size)
+{
+    for (size_t i = 0u; i < size; ++i)
+    {
+        hash ^= static_cast<const uint8_t*>(data)[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+// the size is hashed too, so the sequences of strings are not ambiguous
+inline uint64_t hashString(uint64_t hash, const std::string& value)
+{
+    const uint64_t size = value.size();
+    hash = hashData(hash, &size, sizeof(size));
+    return hashData(hash, value.data(), value.size());
+}
+
+} // namespace utils
+} // namespace simplex
+
+#endif // UTILS_HASH_H
@@ -5,7 +5,9 @@
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
+#include <utils/glm/vec4.hpp>
 #include <utils/noncopyble.h>
 #include <utils/primitiveset.h>
 #include <utils/utilsglobal.h>
@@ -111,11 +113,23 @@ public:
     void convert(uint32_t, VertexComponentType);
     std::shared_ptr<VertexBuffer> converted(uint32_t, VertexComponentType) const;
 
+    // writes the vertices [first, first + count) converted to the components count and type into dst with the stride,
+    // the missing components are filled with zeros, unlike convert() any type conversion is allowed
+    void gather(size_t first, size_t count, uint32_t, VertexComponentType, uint8_t* dst, size_t dstStride) const;
+
 protected:
     uint32_t m_numComponents;
     VertexComponentType m_type;
 };
 
+struct Meshlet
+{
+    size_t firstIndex;
+    size_t numIndices;
+    glm::vec4 boundingSphere; // xyz - center, w - radius
+    glm::vec4 cone; // xyz - axis of the normals, w - sine of the normals cone half angle, 1 if it's too wide to be culled
+};
+
 class UTILS_SHARED_EXPORT DrawElementsBuffer : public DrawElements, public Buffer
 {
 public:
@@ -141,6 +155,13 @@ public:
 
     void applyBaseVertex();
     std::shared_ptr<DrawElementsBuffer> appliedBaseVertex() const;
+
+    // returns the triangles simplified by collapsing the edges until the number of indices isn't greater than numIndices
+    // or no more edges can be collapsed, the vertices aren't changed; error is the approximate distance to the source surface
+    std::shared_ptr<DrawElementsBuffer> simplified(const VertexBuffer& positions, size_t numIndices, float& error) const;
+
+    // reorders the triangles, so every meshlet of no more than maxNumTriangles neighbour triangles is a contiguous range
+    std::vector<Meshlet> buildMeshlets(const VertexBuffer& positions, size_t maxNumTriangles);
 };
 
 class UTILS_SHARED_EXPORT Mesh
@@ -0,0 +1,43 @@
+#ifndef UTILS_TLSF_ALLOCATOR_H
+#define UTILS_TLSF_ALLOCATOR_H
+
+#include <memory>
+
+#include <utils/noncopyble.h>
+#include <utils/utilsglobal.h>
+
+namespace simplex
+{
+namespace utils
+{
+
+// Two-level segregated fit allocator of the ranges [offset, offset + count).
+// It doesn't own any memory, it only tracks the free blocks and the allocated ones. If no free block fits the allocation,
+// the range is appended to the end, and the blocks freed at the end are trimmed, so size() is the minimal size of the storage.
+struct TLSFAllocatorPrivate;
+class UTILS_SHARED_EXPORT TLSFAllocator final
+{
+    NONCOPYBLE(TLSFAllocator)
+public:
+    TLSFAllocator();
+    ~TLSFAllocator();
+
+    size_t size() const;
+    size_t freeSize() const;
+    size_t freeBlocksCount() const;
+
+    size_t allocate(size_t count);
+    void free(size_t offset, size_t count);
+
+    void clear();
+
+    static size_t invalidOffset();
+
+private:
+    std::unique_ptr<TLSFAllocatorPrivate> m_;
+};
+
+} // namespace utils
+} // namespace simplex
+
+#endif // UTILS_TLSF_ALLOCATOR_H
@@ -4,7 +4,7 @@
 #include<geometry.glsl>
 #include<ibl.glsl>
 #include<light.glsl>
-#include<light_node.glsl>
+#include<light_indices.glsl>
 #include<map.glsl>
 #include<packing.glsl>
 #include<pbr.glsl>
@@ -403,15 +403,17 @@ vec4 proccessLighting(in vec3 NDC, in uvec4 PBRData, in bool isTexelTransparent)
 		const vec3 F0 = mix(vec3(renderInfoDielectricSpecular()), baseColor, metalness);
 		const vec3 viewWS = normalize(cameraViewPosition() - texelPosWS);
 		
-		const uint firstLightNodeIDs[2u] = uint[2u](
-			countersFirstGlobalLightNodeID(),
-			clusterNodeFirstLightNodeID(cameraClusterNodeID(NDC)));
+		const uint clusterNodeID = cameraClusterNodeID(NDC);
+		const uvec2 lightIndicesRanges[2u] = uvec2[2u](
+			uvec2(0u, countersGlobalLightsCount()),
+			uvec2(clusterNodeLightIndicesOffset(clusterNodeID), clusterNodeLightIndicesCount(clusterNodeID)));
 		
 		for (uint i = 0u; i < 2u; ++i)
 		{
-			for (uint lightNodeID = firstLightNodeIDs[i]; lightNodeID != 0xFFFFFFFFu; lightNodeID = lightNodeNextID(lightNodeID))
+			const uint lightIndicesEnd = lightIndicesRanges[i].x + lightIndicesRanges[i].y;
+			for (uint lightIndexID = lightIndicesRanges[i].x; lightIndexID < lightIndicesEnd; ++lightIndexID)
 			{
-				const uint lightID = lightNodeLightID(lightNodeID);
+				const uint lightID = lightIndexLightID(lightIndexID);
 				const uint typeID = lightTypeID(lightID);
 				
 				if (!IsLightTypeDefined(typeID))
@@ -592,15 +594,17 @@ vec3 proccessScattering(in vec2 NDC_XY_ZO, in float depthFrom, in float depthTo)
 		const vec3 texelPosWS = mix(pointFromWS, pointToWS, nextRayDepth / fromToWSLen);
 		const vec3 NDC_ZO = NO2ZO(projectPoint(cameraViewProjectionMatrix(), texelPosWS));
 		
-		const uint firstLightNodeIDs[2u] = uint[2u](
-			countersFirstGlobalLightNodeID(),
-			clusterNodeFirstLightNodeID(cameraClusterNodeID(NDC_ZO)));
+		const uint clusterNodeID = cameraClusterNodeID(NDC_ZO);
+		const uvec2 lightIndicesRanges[2u] = uvec2[2u](
+			uvec2(0u, countersGlobalLightsCount()),
+			uvec2(clusterNodeLightIndicesOffset(clusterNodeID), clusterNodeLightIndicesCount(clusterNodeID)));
 		
 		for (uint i = 0u; i < 2u; ++i)
 		{
-			for (uint lightNodeID = firstLightNodeIDs[i]; lightNodeID != 0xFFFFFFFFu; lightNodeID = lightNodeNextID(lightNodeID))
+			const uint lightIndicesEnd = lightIndicesRanges[i].x + lightIndicesRanges[i].y;
+			for (uint lightIndexID = lightIndicesRanges[i].x; lightIndexID < lightIndicesEnd; ++lightIndexID)
 			{
-				const uint lightID = lightNodeLightID(lightNodeID);
+				const uint lightID = lightIndexLightID(lightIndexID);
 				const uint typeID = lightTypeID(lightID);
 				
 				if (!IsLightTypeShadowed(typeID))
@@ -8,17 +8,28 @@ BoundingBox clusterNodeBoundingBox(in uint clusterNodeID)
 	return toBoundingBox(clusterNodes[clusterNodeID].boundingBox);
 }
 
-uint clusterNodeFirstLightNodeID(in uint clusterNodeID)
+uint clusterNodeLightIndicesOffset(in uint clusterNodeID)
 {
-	return clusterNodes[clusterNodeID].firstLightNodeID;
+	return clusterNodes[clusterNodeID].lightIndicesOffset;
+}
+
+uint clusterNodeLightIndicesCount(in uint clusterNodeID)
+{
+	return clusterNodes[clusterNodeID].lightIndicesCount;
 }
 
 void clusterNodeInitialize(in uint clusterNodeID, in BoundingBox bb)
 {
-	clusterNodes[clusterNodeID] = makeClusterNodeDescription(bb, 0xFFFFFFFFu);
+	clusterNodes[clusterNodeID] = makeClusterNodeDescription(bb);
+}
+
+void clusterNodeSetLightIndicesCount(in uint clusterNodeID, in uint count)
+{
+	clusterNodes[clusterNodeID].lightIndicesCount = count;
 }
 
-uint clusterNodeSetFirstLightNodeID(in uint clusterNodeID, uint lightNodeID)
+void clusterNodeSetLightIndicesRange(in uint clusterNodeID, in uint offset, in uint count)
 {
-	return atomicExchange(clusterNodes[clusterNodeID].firstLightNodeID, lightNodeID);
+	clusterNodes[clusterNodeID].lightIndicesOffset = offset;
+	clusterNodes[clusterNodeID].lightIndicesCount = count;
 }
\ No newline at end of file
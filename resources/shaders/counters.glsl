@@ -4,9 +4,9 @@ layout (std430) buffer ssbo_countersBuffer { CountersDescription counters; };
 
 void countersReset()
 {
-    counters.firstGlobalLightNodeID = 0xFFFFFFFFu;
+    counters.globalLightsCount = 0u;
 	counters.clusterLocalLightsCount = 0u;
-    counters.lightNodesCount = 0u;
+    counters.lightIndicesCount = 0u;
 	counters.skeletalAnimatedDataToUpdateCount = 0u;
     counters.shadowsToUpdateCount = 0u;
     counters.opaqueDrawDataRenderCommandsCount = 0u;
@@ -14,16 +14,28 @@ void countersReset()
 	counters.shadowDataCount = 0u;
 	counters.opaqueShadowDataRenderCommandsCount = 0u;
 	counters.transparentShadowDataRenderCommandsCount = 0u;
+	counters.opaqueDrawData16RenderCommandsCount = 0u;
+	counters.transparentDrawData16RenderCommandsCount = 0u;
+	counters.opaqueShadowData16RenderCommandsCount = 0u;
+	counters.transparentShadowData16RenderCommandsCount = 0u;
+	counters.meshletsCullDrawDataCount = 0u;
+	counters.meshletsCount = 0u;
+	counters.culledMeshletsCount = 0u;
+	counters.culledMeshletTrianglesCount = 0u;
+	counters.instancedDrawDataCount = 0u;
+	counters.drawDataInstancesCount = 0u;
+	counters.firstPhaseDrawDataRenderCommandsCount = 0u;
+	counters.occlusionCulledDrawDataCount = 0u;
 }
 
-uint countersFirstGlobalLightNodeID()
+uint countersGlobalLightsCount()
 {
-	return counters.firstGlobalLightNodeID;
+	return counters.globalLightsCount;
 }
 
-uint countersSetFirstGlobalLightNodeID(uint lightNodeID)
+uint countersGenerateGlobalLightID()
 {
-	return atomicExchange(counters.firstGlobalLightNodeID, lightNodeID);
+	return atomicAdd(counters.globalLightsCount, 1u);
 }
 
 uint countersClusterLocalLightsCount()
@@ -36,9 +48,9 @@ uint countersGenerateClusterLocalLightID()
 	return atomicAdd(counters.clusterLocalLightsCount, 1u);
 }
 
-uint countersGenerateLightNodeID()
+void countersSetLightIndicesCount(uint lightIndicesCount)
 {
-	return atomicAdd(counters.lightNodesCount, 1u);
+	counters.lightIndicesCount = lightIndicesCount;
 }
 
 uint countersSkeletalAnimatedDataToUpdateCount()
@@ -71,6 +83,87 @@ uint countersGenerateTransparentDrawDataRenderCommandID()
 	return atomicAdd(counters.transparentDrawDataRenderCommandsCount, 1u);
 }
 
+uint countersGenerateOpaqueDrawData16RenderCommandID()
+{
+	return atomicAdd(counters.opaqueDrawData16RenderCommandsCount, 1u);
+}
+
+uint countersGenerateTransparentDrawData16RenderCommandID()
+{
+	return atomicAdd(counters.transparentDrawData16RenderCommandsCount, 1u);
+}
+
+uint countersGenerateOpaqueDrawDataRenderCommandIDs(in uint count)
+{
+	return atomicAdd(counters.opaqueDrawDataRenderCommandsCount, count);
+}
+
+uint countersGenerateTransparentDrawDataRenderCommandIDs(in uint count)
+{
+	return atomicAdd(counters.transparentDrawDataRenderCommandsCount, count);
+}
+
+uint countersGenerateOpaqueDrawData16RenderCommandIDs(in uint count)
+{
+	return atomicAdd(counters.opaqueDrawData16RenderCommandsCount, count);
+}
+
+uint countersGenerateTransparentDrawData16RenderCommandIDs(in uint count)
+{
+	return atomicAdd(counters.transparentDrawData16RenderCommandsCount, count);
+}
+
+uint countersMeshletsCullDrawDataCount()
+{
+	return counters.meshletsCullDrawDataCount;
+}
+
+uint countersGenerateMeshletsCullDrawDataID()
+{
+	return atomicAdd(counters.meshletsCullDrawDataCount, 1u);
+}
+
+void countersAddMeshletsStatistics(in uint meshletsCount, in uint culledMeshletsCount, in uint culledMeshletTrianglesCount)
+{
+	atomicAdd(counters.meshletsCount, meshletsCount);
+	atomicAdd(counters.culledMeshletsCount, culledMeshletsCount);
+	atomicAdd(counters.culledMeshletTrianglesCount, culledMeshletTrianglesCount);
+}
+
+uint countersInstancedDrawDataCount()
+{
+	return counters.instancedDrawDataCount;
+}
+
+uint countersGenerateInstancedDrawDataID()
+{
+	return atomicAdd(counters.instancedDrawDataCount, 1u);
+}
+
+uint countersGenerateDrawDataInstanceIDs(in uint count)
+{
+	return atomicAdd(counters.drawDataInstancesCount, count);
+}
+
+// the commands of the first occlusion culling phase have been drawn, the second phase fills the same buffers from the start
+void countersResetDrawDataRenderCommands()
+{
+	counters.firstPhaseDrawDataRenderCommandsCount +=
+		counters.opaqueDrawDataRenderCommandsCount + counters.transparentDrawDataRenderCommandsCount +
+		counters.opaqueDrawData16RenderCommandsCount + counters.transparentDrawData16RenderCommandsCount;
+	counters.opaqueDrawDataRenderCommandsCount = 0u;
+	counters.transparentDrawDataRenderCommandsCount = 0u;
+	counters.opaqueDrawData16RenderCommandsCount = 0u;
+	counters.transparentDrawData16RenderCommandsCount = 0u;
+	counters.meshletsCullDrawDataCount = 0u;
+	counters.instancedDrawDataCount = 0u;
+}
+
+void countersAddOcclusionCulledDrawData()
+{
+	atomicAdd(counters.occlusionCulledDrawDataCount, 1u);
+}
+
 uint countersGenerateShadowDataID()
 {
 	return atomicAdd(counters.shadowDataCount, 1u);
@@ -85,3 +178,13 @@ uint countersGenerateTransparentShadowDataRenderCommandID()
 {
 	return atomicAdd(counters.transparentShadowDataRenderCommandsCount, 1u);
 }
+
+uint countersGenerateOpaqueShadowData16RenderCommandID()
+{
+	return atomicAdd(counters.opaqueShadowData16RenderCommandsCount, 1u);
+}
+
+uint countersGenerateTransparentShadowData16RenderCommandID()
+{
+	return atomicAdd(counters.transparentShadowData16RenderCommandsCount, 1u);
+}
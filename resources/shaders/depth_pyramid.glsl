@@ -0,0 +1,47 @@
+#include<descriptions.glsl>
+
+layout (std430) buffer ssbo_depthPyramidBuffer { DepthPyramidDescription depthPyramid; };
+
+uint depthPyramidLevelIndex()
+{
+	return depthPyramid.levelIndex;
+}
+
+uvec2 depthPyramidLevelSize(in uint level)
+{
+	return max(depthPyramid.size >> level, uvec2(1u));
+}
+
+float depthPyramidDepth(in uint level, in ivec2 coords)
+{
+	layout(r32f) image2D image = layout(r32f) image2D(depthPyramid.levelsImageHandles[level]);
+	return imageLoad(image, coords).r;
+}
+
+void depthPyramidSetDepth(in uint level, in ivec2 coords, in float depth)
+{
+	layout(r32f) image2D image = layout(r32f) image2D(depthPyramid.levelsImageHandles[level]);
+	imageStore(image, coords, vec4(depth));
+}
+
+// the depth is reversed, so a texel of the pyramid keeps the min depth of the texels it covers (the farthest one)
+bool depthPyramidIsRectOccluded(in vec2 minTexCoords, in vec2 maxTexCoords, in float nearestDepth)
+{
+	if (depthPyramid.levelsCount == 0u)
+		return false;
+
+	// the level where the rect covers 2x2 texels at most
+	const vec2 rectSize = (maxTexCoords - minTexCoords) * vec2(depthPyramid.size);
+	const uint level = min(uint(ceil(log2(max(max(rectSize.x, rectSize.y), 1.0f)))), depthPyramid.levelsCount - 1u);
+	
+	const ivec2 levelSize = ivec2(depthPyramidLevelSize(level));
+	const ivec2 minCoords = clamp(ivec2(minTexCoords * vec2(levelSize)), ivec2(0), levelSize - ivec2(1));
+	const ivec2 maxCoords = clamp(ivec2(maxTexCoords * vec2(levelSize)), ivec2(0), levelSize - ivec2(1));
+	
+	float farthestDepth = 1.0f;
+	for (int y = minCoords.y; y <= maxCoords.y; ++y)
+		for (int x = minCoords.x; x <= maxCoords.x; ++x)
+			farthestDepth = min(farthestDepth, depthPyramidDepth(level, ivec2(x, y)));
+	
+	return nearestDepth < farthestDepth;
+}
@@ -151,18 +151,20 @@ struct CameraDescription
 struct ClusterNodeDescription
 {
 	BoundingBoxDescription boundingBox;
-	uint firstLightNodeID; // it's stored separately because of atomic access
+	uint lightIndicesOffset;
+	uint lightIndicesCount;
 	
 	// padding
-	uint padding[3u];
+	uint padding[2u];
 };
 
-ClusterNodeDescription makeClusterNodeDescription(in BoundingBox bb, in uint firstLightNodeID)
+ClusterNodeDescription makeClusterNodeDescription(in BoundingBox bb)
 {
 	return ClusterNodeDescription(
 		makeBoundingBoxDescription(bb),
-		firstLightNodeID,
-		uint[3u](0u, 0u, 0u));
+		0u,
+		0u,
+		uint[2u](0u, 0u));
 }
 
 struct ClusterLocalLightDescription
@@ -178,20 +180,6 @@ ClusterLocalLightDescription makeClusterLocalLightDescription(in uint lightID)
 	return ClusterLocalLightDescription(lightID, uint[3u](0u, 0u, 0u));
 }
 
-struct LightNodeDescription
-{
-	uint lightID;
-	uint nextID;
-	
-	// padding
-    uint padding[2u];
-};
-
-LightNodeDescription makeLightNodeDescription(in uint lightID, in uint nextLightNodeID)
-{
-	return LightNodeDescription(lightID, nextLightNodeID, uint[2u](0u, 0u));
-}
-
 struct RenderInfoDescription
 {
     // global
@@ -223,9 +211,9 @@ struct RenderInfoDescription
 
 struct CountersDescription
 {
-    uint firstGlobalLightNodeID;
+    uint globalLightsCount;
 	uint clusterLocalLightsCount;
-    uint lightNodesCount;
+    uint lightIndicesCount;
     uint skeletalAnimatedDataToUpdateCount;
     uint shadowsToUpdateCount;
     uint opaqueDrawDataRenderCommandsCount;
@@ -233,8 +221,20 @@ struct CountersDescription
     uint shadowDataCount;
     uint opaqueShadowDataRenderCommandsCount;
     uint transparentShadowDataRenderCommandsCount;
+    uint opaqueDrawData16RenderCommandsCount;
+    uint transparentDrawData16RenderCommandsCount;
+    uint opaqueShadowData16RenderCommandsCount;
+    uint transparentShadowData16RenderCommandsCount;
+    uint meshletsCullDrawDataCount;
+    uint meshletsCount; // the statistics of CullMeshletsPass
+    uint culledMeshletsCount;
+    uint culledMeshletTrianglesCount;
+    uint instancedDrawDataCount;
+    uint drawDataInstancesCount;
+    uint firstPhaseDrawDataRenderCommandsCount;
+    uint occlusionCulledDrawDataCount;
 
-    uint padding[2u];
+    // uint padding[0u];
 };
 
 struct GBufferDescription
@@ -279,6 +279,32 @@ struct BoneDataDescription
 #define TangentDataDescription vec4
 #define ElementDataDescription uint
 
+struct CompactPositionNormalTexCoordsDataDescription
+{
+	uint positionXY; // snorm16x2 relative to the mesh bounding box
+	uint positionZ; // 0..15 - snorm16 relative to the mesh bounding box, 16..31 - free
+	uint normal; // octahedral snorm16x2
+	uint texCoords; // half2x16
+};
+
+#define CompactTangentDataDescription uint // octahedral snorm16x2, the least significant bit is the binormal flag
+
+struct MeshletDescription
+{
+    vec4 boundingSphere; // in the mesh space
+    vec4 cone; // xyz - axis, w - sine of the normals cone half angle, the cone isn't culled if it's 1
+    uint elementDataOffset; // relative to the element data of the mesh
+    uint elementDataSize;
+    uint padding[2u];
+};
+
+struct MeshletsCullDrawDataDescription
+{
+    uint drawDataID;
+    uint renderCommandID; // the command of the whole mesh made by CullDrawDataPass
+    uint drawDataInstanceID; // the base instance of the commands
+};
+
 struct MeshDescription
 {
     BoundingBoxDescription boundingBox;
@@ -292,8 +318,16 @@ struct MeshDescription
     //  1.. 1 - has normals
     //  2.. 2 - has tex coords
     //  3.. 5 - bones count [0..7]
-    //  6..31 - free (26 bits)
+    //  6.. 6 - has compact vertices
+    //  7.. 7 - has 16-bit element data
+    //  8.. 9 - LODs count - 1 [0..3]
+    // 10..31 - free (22 bits)
 
+    uint LODsElementDataSizes[3u]; // the indices of LOD i follow the ones of LOD i - 1
+    float LODsErrors[3u]; // in the mesh space
+
+    uint meshletsDataOffset;
+    uint meshletsCount;
     uint padding[2u];
 };
 
@@ -340,6 +374,19 @@ struct DrawDataDescription
 	uint padding[2u];
 };
 
+struct DrawableInstancesDescription
+{
+    uint instancesCount[4u];
+    uint instancesOffset[4u]; // in the draw data instances
+};
+
+struct InstancedDrawDataDescription
+{
+    uint drawDataID;
+    uint LOD;
+    uint instanceIndex; // in the instances of the drawable LOD
+};
+
 struct BackgroundDescription
 {
 	QuatDescription rotation;
@@ -389,6 +436,7 @@ struct LightDescription
 
 struct ShadowToUpdateDescription
 {
+    vec4 boundingSphere; // the light volume covered by the shadow in the world space
     uint shadowID;
 
     uint padding[3u];
@@ -442,6 +490,15 @@ struct ShadowMapsDescription
 	uint padding2[3u];
 };
 
+const uint DepthPyramidMaxLevelsCount = 16u;
+struct DepthPyramidDescription
+{
+    ImageHandle levelsImageHandles[DepthPyramidMaxLevelsCount];
+    uvec2 size;
+    uint levelsCount;
+    uint levelIndex;
+};
+
 struct HDRDescription
 {
     TextureHandle textureHandle;
@@ -5,6 +5,15 @@ layout (std430) readonly buffer ssbo_drawDataBuffer {
 	DrawDataDescription drawData[];
 };
 
+layout (std430) readonly buffer ssbo_liveDrawDataBuffer {
+	uint liveDrawDataIDs[];
+};
+
+uint liveDrawDataID(in uint liveDrawDataIndex)
+{
+	return liveDrawDataIDs[liveDrawDataIndex];
+}
+
 Transform drawDataTransform(in uint drawDataID)
 {
 	return toTransform(drawData[drawDataID].transform);
@@ -93,6 +93,11 @@ bool geometryBufferData(in uint OITNodeID, out uvec4 PBRData, out float depth, o
 	return true;
 }
 
+float geometryBufferDepth(in ivec2 fragCoords)
+{
+	return texelFetch(sampler2DRect(GBuffer.depthTextureHandle), fragCoords).r;
+}
+
 float geometryBufferDepth(in uint OITNodeID)
 {
 	if (OITNodeID == 0xFFFFFFFFu)
@@ -0,0 +1,16 @@
+layout (std430) buffer ssbo_lightIndicesBuffer { uint lightIndices[]; };
+
+uint lightIndicesCapacity()
+{
+	return uint(lightIndices.length());
+}
+
+uint lightIndexLightID(in uint lightIndexID)
+{
+	return lightIndices[lightIndexID];
+}
+
+void lightIndexInitialize(in uint lightIndexID, in uint lightID)
+{
+	lightIndices[lightIndexID] = lightID;
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#include<render_info.glsl>
+
+// the masks of the local lights for all the screen tiles go first, then for all the depth slices of the clusters
+layout (std430) buffer ssbo_lightMasksBuffer { uint lightMasks[]; };
+
+uint lightMasksWordsCount()
+{
+	return (renderInfoLightsCount() + 31u) / 32u;
+}
+
+uint lightMasksTileWordID(in uint tileID, in uint wordID)
+{
+	return tileID * lightMasksWordsCount() + wordID;
+}
+
+uint lightMasksZBinWordID(in uint zBinID, in uint wordID)
+{
+	const uvec3 clusterSize = renderInfoClusterSize();
+	return (clusterSize.x * clusterSize.y + zBinID) * lightMasksWordsCount() + wordID;
+}
+
+uint lightMasksCandidates(in uint tileID, in uint zBinID, in uint wordID)
+{
+	return lightMasks[lightMasksTileWordID(tileID, wordID)] & lightMasks[lightMasksZBinWordID(zBinID, wordID)];
+}
+
+void lightMasksAddToTile(in uint tileID, in uint clusterLocalLightID)
+{
+	atomicOr(lightMasks[lightMasksTileWordID(tileID, clusterLocalLightID / 32u)], 1u << (clusterLocalLightID % 32u));
+}
+
+void lightMasksAddToZBin(in uint zBinID, in uint clusterLocalLightID)
+{
+	atomicOr(lightMasks[lightMasksZBinWordID(zBinID, clusterLocalLightID / 32u)], 1u << (clusterLocalLightID % 32u));
+}
+
+void lightMasksClear(in uint lightMaskID)
+{
+	lightMasks[lightMaskID] = 0u;
+}
\ No newline at end of file
@@ -95,6 +95,17 @@ bool sphereVsFrustum(in Sphere s, in mat4x4 projectionMatrixInverted)
 	return distance(frustumClosestPoint(projectionMatrixInverted, c), c) <= sphereRadius(s);
 }
 
+bool sphereVsFrustumFast(in Sphere s, in Plane fPlanes[FRUSTUM_PLANES_COUNT])
+{
+	for (uint i = 0u; i < FRUSTUM_PLANES_COUNT; ++i)
+	{
+		if (distanceToPlane(fPlanes[i], sphereCenter(s)) < -sphereRadius(s))
+			return false;
+	}
+	
+	return true;
+}
+
 bool sphereVsBoundingBox(in Sphere s, in BoundingBox bb)
 {	
 	const vec3 c = sphereCenter(s);
@@ -1,6 +1,7 @@
 #include<constants.glsl>
 #include<line.glsl>
 #include<range.glsl>
+#include<sphere.glsl>
 #include<transform.glsl>
 #include<quat.glsl>
 #include<utils.glsl>
@@ -137,4 +138,15 @@ Pyramid transformPyramid(in Transform t, in Pyramid p)
 		transformPoint(t, p.translation),
 		transformSize(t, p.height),
 		p.halfAngle);
+}
+
+// the sphere through the apex and the corners of the base, or around the base if the pyramid is wide
+Sphere pyramidBoundingSphere(in Pyramid p)
+{
+	const float baseHalfDiagonal = sqrt(2.0f) * p.height * tan(p.halfAngle);
+	const float centerDistance = min((p.height * p.height + baseHalfDiagonal * baseHalfDiagonal) / (2.0f * p.height), p.height);
+	
+	return makeSphere(
+		p.translation + rotateVector(p.rotation, vec3(0.0f, 0.0f, -centerDistance)),
+		max(centerDistance, baseHalfDiagonal));
 }
\ No newline at end of file
@@ -14,6 +14,14 @@ vec3 orth(in uint orthID)
 	return result;
 }
 
+vec3 decodeOctahedral(in vec2 e)
+{
+	vec3 v = vec3(e, 1.0f - abs(e.x) - abs(e.y));
+	if (v.z < 0.0f)
+		v.xy = (vec2(1.0f) - abs(v.yx)) * mix(vec2(-1.0f), vec2(1.0f), greaterThanEqual(v.xy, vec2(0.0f)));
+	return normalize(v);
+}
+
 vec2 screenQuadVertexZO(in uint vertexID)
 {
 	return vec2(float(bitfieldExtract(vertexID, 0, 1)), float(bitfieldExtract(vertexID, 1, 1)));
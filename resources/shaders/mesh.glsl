@@ -1,4 +1,5 @@
 #include<math/bounding_box.glsl>
+#include<math/transform.glsl>
 #include<descriptions.glsl>
 
 layout (std430) readonly buffer ssbo_meshesBuffer { MeshDescription meshes[]; };
@@ -51,4 +52,74 @@ bool meshHasTexCoords(in uint meshID)
 uint meshBonesCount(in uint meshID)
 {
 	return bitfieldExtract(meshes[meshID].flags, 3, 3);
+}
+
+bool meshHasCompactVertices(in uint meshID)
+{
+	return bitfieldExtract(meshes[meshID].flags, 6, 1) != 0u;
+}
+
+bool meshHasElement16Data(in uint meshID)
+{
+	return bitfieldExtract(meshes[meshID].flags, 7, 1) != 0u;
+}
+
+uint meshLODsCount(in uint meshID)
+{
+	return bitfieldExtract(meshes[meshID].flags, 8, 2) + 1u;
+}
+
+uint meshLODElementDataOffset(in uint meshID, in uint LOD)
+{
+	uint result = meshes[meshID].elementDataOffset;
+	if (LOD > 0u)
+		result += meshes[meshID].elementDataSize;
+	for (uint i = 1u; i < LOD; ++i)
+		result += meshes[meshID].LODsElementDataSizes[i - 1u];
+	return result;
+}
+
+uint meshLODElementDataSize(in uint meshID, in uint LOD)
+{
+	return (LOD == 0u) ? meshes[meshID].elementDataSize : meshes[meshID].LODsElementDataSizes[LOD - 1u];
+}
+
+uint meshMeshletsDataOffset(in uint meshID)
+{
+	return meshes[meshID].meshletsDataOffset;
+}
+
+uint meshMeshletsCount(in uint meshID)
+{
+	return meshes[meshID].meshletsCount;
+}
+
+// selects the coarsest LOD which error projected to the viewport isn't greater than maxError pixels
+uint meshSelectLOD(
+	in uint meshID,
+	in Transform modelViewTransform,
+	in mat4x4 projectionMatrix,
+	in float viewportHeight,
+	in float maxError)
+{
+	const BoundingBox bb = meshBoundingBox(meshID);
+	const vec3 center = transformPoint(modelViewTransform, boundingBoxCenter(bb));
+	const float radius = transformSize(modelViewTransform, length(boundingBoxHalfSize(bb)));
+	
+	// w of the bounding sphere point nearest to the camera
+	const float w = projectionMatrix[2u][3u] * (center.z + radius) + projectionMatrix[3u][3u];
+	if (w <= 0.0f)
+		return 0u;
+	
+	const float pixelsPerUnit = 0.5f * viewportHeight * projectionMatrix[1u][1u] / w;
+	
+	uint result = 0u;
+	for (uint LOD = 1u; LOD < meshLODsCount(meshID); ++LOD)
+	{
+		if (transformSize(modelViewTransform, meshes[meshID].LODsErrors[LOD - 1u]) * pixelsPerUnit > maxError)
+			break;
+		result = LOD;
+	}
+	
+	return result;
 }
\ No newline at end of file
@@ -0,0 +1,29 @@
+#include<math/sphere.glsl>
+#include<descriptions.glsl>
+
+layout (std430) readonly buffer ssbo_meshletsDataBuffer { MeshletDescription meshletsData[]; };
+
+Sphere meshletsDataBoundingSphere(in uint meshletsDataOffset)
+{
+	return meshletsData[meshletsDataOffset].boundingSphere;
+}
+
+vec3 meshletsDataConeAxis(in uint meshletsDataOffset)
+{
+	return meshletsData[meshletsDataOffset].cone.xyz;
+}
+
+float meshletsDataConeCutoff(in uint meshletsDataOffset)
+{
+	return meshletsData[meshletsDataOffset].cone.w;
+}
+
+uint meshletsDataElementDataOffset(in uint meshletsDataOffset)
+{
+	return meshletsData[meshletsDataOffset].elementDataOffset;
+}
+
+uint meshletsDataElementDataSize(in uint meshletsDataOffset)
+{
+	return meshletsData[meshletsDataOffset].elementDataSize;
+}
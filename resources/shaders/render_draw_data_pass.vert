@@ -15,9 +15,14 @@ out vec2 v_texCoords;
 out vec3 v_tangent;
 out vec3 v_binormal;
 
+layout (std430) readonly buffer ssbo_drawDataInstancesBuffer {
+	uint drawDataInstances[];
+};
+
 void main(void)
 {
-	const uint drawDataID = gl_BaseInstance;
+	// the instances of a command are the draw data of the same drawable, see GenerateInstancedDrawDataCommandsPass
+	const uint drawDataID = drawDataInstances[gl_BaseInstance + uint(gl_InstanceID)];
 	
 	const Transform modelTransform = drawDataTransform(drawDataID);
 	const uint drawableID = drawDataDrawableID(drawDataID);
@@ -36,13 +41,18 @@ void main(void)
 	
 	const bool hasNormal = meshHasNormals(v_meshID);
 	const bool hasTangent = tangentDataOffset != 0xFFFFFFFFu;
+	const bool hasCompactVertices = meshHasCompactVertices(v_meshID);
 	
 	vec3 position = vec3(0.0f);
 	vec3 normal = vec3(0.0f);
 	vec2 texCoords = vec2(0.0f);
 	if (positionNormalTexCoordsDataOffset != 0xFFFFFFFFu)
 	{
-		verticesDataPositionNormalTexCoords(positionNormalTexCoordsDataOffset, gl_VertexID, position, normal, texCoords);
+		if (hasCompactVertices)
+			compactVerticesDataPositionNormalTexCoords(
+				positionNormalTexCoordsDataOffset, gl_VertexID, meshBoundingBox(v_meshID), position, normal, texCoords);
+		else
+			verticesDataPositionNormalTexCoords(positionNormalTexCoordsDataOffset, gl_VertexID, position, normal, texCoords);
 	}
 	
 	vec3 tangent = vec3(0.0f);
@@ -50,7 +60,10 @@ void main(void)
 	if (hasNormal && hasTangent)
 	{
 		float binormalFlag = 0.0f;
-		verticesDataTangentAndBinormalFlag(tangentDataOffset, gl_VertexID, tangent, binormalFlag);
+		if (hasCompactVertices)
+			compactVerticesDataTangentAndBinormalFlag(tangentDataOffset, gl_VertexID, tangent, binormalFlag);
+		else
+			verticesDataTangentAndBinormalFlag(tangentDataOffset, gl_VertexID, tangent, binormalFlag);
 		binormal = normalize(cross(normal, tangent) * binormalFlag);
 	}
 	
@@ -48,7 +48,11 @@ void main(void)
 	if (positionNormalTexCoordsDataOffset != 0xFFFFFFFFu)
 	{
 		vec3 normal; // no need later
-		verticesDataPositionNormalTexCoords(positionNormalTexCoordsDataOffset, gl_VertexID, position, normal, texCoords);
+		if (meshHasCompactVertices(v_meshID))
+			compactVerticesDataPositionNormalTexCoords(
+				positionNormalTexCoordsDataOffset, gl_VertexID, meshBoundingBox(v_meshID), position, normal, texCoords);
+		else
+			verticesDataPositionNormalTexCoords(positionNormalTexCoordsDataOffset, gl_VertexID, position, normal, texCoords);
 	}
 	
 	if ((bonesTransformsDataOffset != 0xFFFFFFFFu) && (boneDataOffset != 0xFFFFFFFFu))
@@ -1,5 +1,6 @@
 #include<descriptions.glsl>
 
+#include<math/sphere.glsl>
 #include<math/transform.glsl>
 
 layout (std430) buffer ssbo_shadowsToUpdateBuffer { ShadowToUpdateDescription shadowsToUpdate[]; };
@@ -9,7 +10,13 @@ uint shadowToUpdateShadowID(in uint shadowToUpdateID)
 	return shadowsToUpdate[shadowToUpdateID].shadowID;
 }
 
-void shadowToUpdateSetShadowID(in uint shadowToUpdateID, in uint shadowID)
+Sphere shadowToUpdateBoundingSphere(in uint shadowToUpdateID)
 {
+	return shadowsToUpdate[shadowToUpdateID].boundingSphere;
+}
+
+void shadowToUpdateInitialize(in uint shadowToUpdateID, in uint shadowID, in Sphere boundingSphere)
+{
+	shadowsToUpdate[shadowToUpdateID].boundingSphere = boundingSphere;
 	shadowsToUpdate[shadowToUpdateID].shadowID = shadowID;
 }
\ No newline at end of file
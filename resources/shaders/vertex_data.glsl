@@ -1,7 +1,11 @@
+#include<math/bounding_box.glsl>
+#include<math/utils.glsl>
 #include<descriptions.glsl>
 
 layout (std430) readonly buffer ssbo_positionNormalTexCoordsDataBuffer { PositionNormalTexCoordsDataDescription positionNormalTexCoordsData[]; };
 layout (std430) readonly buffer ssbo_tangentDataBuffer { TangentDataDescription tangentData[]; };
+layout (std430) readonly buffer ssbo_compactPositionNormalTexCoordsDataBuffer { CompactPositionNormalTexCoordsDataDescription compactPositionNormalTexCoordsData[]; };
+layout (std430) readonly buffer ssbo_compactTangentDataBuffer { CompactTangentDataDescription compactTangentData[]; };
 layout (std430) readonly buffer ssbo_boneDataBuffer { BoneDataDescription boneData[]; };
 
 void verticesDataPositionNormalTexCoords(
@@ -28,6 +32,32 @@ void verticesDataTangentAndBinormalFlag(
 	binormalFlag = value.w;
 }
 
+void compactVerticesDataPositionNormalTexCoords(
+	in uint positionNormalTexCoordsDataOffset,
+	in uint vertexID,
+	in BoundingBox meshBoundingBox,
+	out vec3 position,
+	out vec3 normal,
+	out vec2 texCoords)
+{
+	const CompactPositionNormalTexCoordsDataDescription value = compactPositionNormalTexCoordsData[positionNormalTexCoordsDataOffset + vertexID];
+	const vec3 relativePosition = vec3(unpackSnorm2x16(value.positionXY), unpackSnorm2x16(value.positionZ).x);
+	position = boundingBoxCenter(meshBoundingBox) + boundingBoxHalfSize(meshBoundingBox) * relativePosition;
+	normal = decodeOctahedral(unpackSnorm2x16(value.normal));
+	texCoords = unpackHalf2x16(value.texCoords);
+}
+
+void compactVerticesDataTangentAndBinormalFlag(
+	in uint tangentDataOffset,
+	in uint vertexID,
+	out vec3 tangent,
+	out float binormalFlag)
+{
+	const CompactTangentDataDescription value = compactTangentData[tangentDataOffset + vertexID];
+	tangent = decodeOctahedral(unpackSnorm2x16(value));
+	binormalFlag = (bitfieldExtract(value, 0, 1) != 0u) ? -1.0f : 1.0f;
+}
+
 void verticesDataBoneIDAndWeight(
 	in uint boneDataOffset,
 	in uint bonesCount,
@@ -150,6 +150,23 @@ std::shared_ptr<VertexBuffer> VertexBuffer::converted(uint32_t numComponents, Ve
     return result;
 }
 
+void VertexBuffer::gather(
+    size_t first,
+    size_t count,
+    uint32_t numComponents,
+    VertexComponentType type,
+    uint8_t* dst,
+    size_t dstStride) const
+{
+    if (first + count > numVertices())
+    {
+        LOG_CRITICAL << "Vertices are out of range";
+        return;
+    }
+
+    gatherVertices(vertex(first), m_numComponents, m_type, count, dst, numComponents, type, dstStride);
+}
+
 DrawElementsBuffer::DrawElementsBuffer(PrimitiveType primitiveType, size_t count, DrawElementsIndexType type, size_t baseVertex)
     : DrawElements(primitiveType, count, type, 0, baseVertex)
     , Buffer(0u)
@@ -259,6 +276,134 @@ std::shared_ptr<DrawElementsBuffer> DrawElementsBuffer::appliedBaseVertex() cons
     return result;
 }
 
+std::shared_ptr<DrawElementsBuffer> DrawElementsBuffer::simplified(
+    const VertexBuffer& positions,
+    size_t numIndices,
+    float& error) const
+{
+    error = 0.f;
+
+    auto buffer = convertedToIndexType(DrawElementsIndexType::Uint32);
+    buffer->convertToTriangles();
+
+    const auto numVertices = positions.numVertices();
+    const auto* srcIndices = reinterpret_cast<const uint32_t*>(buffer->data());
+
+    std::vector<uint32_t> indices(buffer->numIndices());
+    for (size_t i = 0u; i < indices.size(); ++i)
+    {
+        indices[i] = static_cast<uint32_t>(srcIndices[i] + m_baseVertex);
+        if (indices[i] >= numVertices)
+        {
+            LOG_ERROR << "Index is out of range";
+            return nullptr;
+        }
+    }
+
+    std::vector<glm::vec3> positionsData(numVertices);
+    positions.gather(
+        0u, numVertices, 3u, VertexComponentType::Single, reinterpret_cast<uint8_t*>(positionsData.data()), sizeof(glm::vec3));
+
+    indices = simplifyTriangles(indices, positionsData, numIndices, error);
+
+    auto result = std::make_shared<DrawElementsBuffer>(PrimitiveType::Triangles, indices.size(), m_indexType, m_baseVertex);
+    for (size_t i = 0u; i < indices.size(); ++i)
+    {
+        const auto index = indices[i] - static_cast<uint32_t>(m_baseVertex);
+        switch (m_indexType)
+        {
+            case DrawElementsIndexType::Uint8:
+            {
+                reinterpret_cast<uint8_t*>(result->m_data)[i] = static_cast<uint8_t>(index);
+                break;
+            }
+            case DrawElementsIndexType::Uint16:
+            {
+                reinterpret_cast<uint16_t*>(result->m_data)[i] = static_cast<uint16_t>(index);
+                break;
+            }
+            default:
+            {
+                reinterpret_cast<uint32_t*>(result->m_data)[i] = index;
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
+std::vector<Meshlet> DrawElementsBuffer::buildMeshlets(const VertexBuffer& positions, size_t maxNumTriangles)
+{
+    if (m_primitiveType != PrimitiveType::Triangles)
+    {
+        LOG_ERROR << "Meshlets can be built only from triangles";
+        return {};
+    }
+
+    const auto numVertices = positions.numVertices();
+
+    std::vector<uint32_t> indices(numIndices());
+    for (size_t i = 0u; i < indices.size(); ++i)
+    {
+        switch (m_indexType)
+        {
+            case DrawElementsIndexType::Uint8:
+            {
+                indices[i] = static_cast<uint32_t>(reinterpret_cast<const uint8_t*>(m_data)[i] + m_baseVertex);
+                break;
+            }
+            case DrawElementsIndexType::Uint16:
+            {
+                indices[i] = static_cast<uint32_t>(reinterpret_cast<const uint16_t*>(m_data)[i] + m_baseVertex);
+                break;
+            }
+            default:
+            {
+                indices[i] = static_cast<uint32_t>(reinterpret_cast<const uint32_t*>(m_data)[i] + m_baseVertex);
+                break;
+            }
+        }
+
+        if (indices[i] >= numVertices)
+        {
+            LOG_ERROR << "Index is out of range";
+            return {};
+        }
+    }
+
+    std::vector<glm::vec3> positionsData(numVertices);
+    positions.gather(
+        0u, numVertices, 3u, VertexComponentType::Single, reinterpret_cast<uint8_t*>(positionsData.data()), sizeof(glm::vec3));
+
+    auto result = utils::buildMeshlets(indices, positionsData, maxNumTriangles);
+
+    for (size_t i = 0u; i < indices.size(); ++i)
+    {
+        const auto index = indices[i] - static_cast<uint32_t>(m_baseVertex);
+        switch (m_indexType)
+        {
+            case DrawElementsIndexType::Uint8:
+            {
+                reinterpret_cast<uint8_t*>(m_data)[i] = static_cast<uint8_t>(index);
+                break;
+            }
+            case DrawElementsIndexType::Uint16:
+            {
+                reinterpret_cast<uint16_t*>(m_data)[i] = static_cast<uint16_t>(index);
+                break;
+            }
+            default:
+            {
+                reinterpret_cast<uint32_t*>(m_data)[i] = index;
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
 Mesh::Mesh() {}
 
 void Mesh::attachVertexBuffer(VertexAttribute vertexAttribute, const std::shared_ptr<VertexBuffer>& vertexBuffer)
@@ -1,10 +1,17 @@
 #ifndef UTILS_MESHIMPL_H
 #define UTILS_MESHIMPL_H
 
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <queue>
+#include <unordered_map>
 #include <vector>
 
 #include <utils/boundingbox.h>
+#include <utils/hash.h>
 #include <utils/glm/gtc/type_ptr.hpp>
+#include <utils/glm/gtx/norm.hpp>
 #include <utils/glm/gtx/normal.hpp>
 #include <utils/glm/matrix.hpp>
 #include <utils/logger.h>
@@ -266,6 +273,172 @@ static uint8_t* convertToVertexComponentType(
     return result;
 }
 
+// the number of components is known at compile time, so the compiler unrolls and vectorizes the loop
+template <typename DstType, typename SrcType, uint32_t NumComponents>
+inline void gatherVertices(const SrcType* src, size_t numVertices, uint8_t* dst, size_t dstStride)
+{
+    for (size_t i = 0u; i < numVertices; ++i, src += NumComponents, dst += dstStride)
+    {
+        auto* dstVertex = reinterpret_cast<DstType*>(dst);
+        for (uint32_t c = 0u; c < NumComponents; ++c)
+            dstVertex[c] = static_cast<DstType>(src[c]);
+    }
+}
+
+template <typename DstType, typename SrcType>
+inline void gatherVertices(
+    const uint8_t* data,
+    uint32_t numComponents,
+    size_t numVertices,
+    uint8_t* dst,
+    uint32_t dstNumComponents,
+    size_t dstStride)
+{
+    const auto* src = reinterpret_cast<const SrcType*>(data);
+
+    if (numComponents == dstNumComponents)
+    {
+        switch (numComponents)
+        {
+            case 1u: return gatherVertices<DstType, SrcType, 1u>(src, numVertices, dst, dstStride);
+            case 2u: return gatherVertices<DstType, SrcType, 2u>(src, numVertices, dst, dstStride);
+            case 3u: return gatherVertices<DstType, SrcType, 3u>(src, numVertices, dst, dstStride);
+            case 4u: return gatherVertices<DstType, SrcType, 4u>(src, numVertices, dst, dstStride);
+            default: break;
+        }
+    }
+
+    const auto minNumComponents = glm::min(numComponents, dstNumComponents);
+    for (size_t i = 0u; i < numVertices; ++i, src += numComponents, dst += dstStride)
+    {
+        auto* dstVertex = reinterpret_cast<DstType*>(dst);
+        for (uint32_t c = 0u; c < minNumComponents; ++c)
+            dstVertex[c] = static_cast<DstType>(src[c]);
+        for (uint32_t c = minNumComponents; c < dstNumComponents; ++c)
+            dstVertex[c] = static_cast<DstType>(0);
+    }
+}
+
+template <typename DstType>
+inline void gatherVertices(
+    const uint8_t* data,
+    uint32_t numComponents,
+    VertexComponentType type,
+    size_t numVertices,
+    uint8_t* dst,
+    uint32_t dstNumComponents,
+    size_t dstStride)
+{
+    switch (type)
+    {
+        case VertexComponentType::Single:
+        {
+            gatherVertices<DstType, float>(data, numComponents, numVertices, dst, dstNumComponents, dstStride);
+            break;
+        }
+        case VertexComponentType::Double:
+        {
+            gatherVertices<DstType, double>(data, numComponents, numVertices, dst, dstNumComponents, dstStride);
+            break;
+        }
+        case VertexComponentType::Int8:
+        {
+            gatherVertices<DstType, int8_t>(data, numComponents, numVertices, dst, dstNumComponents, dstStride);
+            break;
+        }
+        case VertexComponentType::Uint8:
+        {
+            gatherVertices<DstType, uint8_t>(data, numComponents, numVertices, dst, dstNumComponents, dstStride);
+            break;
+        }
+        case VertexComponentType::Int16:
+        {
+            gatherVertices<DstType, int16_t>(data, numComponents, numVertices, dst, dstNumComponents, dstStride);
+            break;
+        }
+        case VertexComponentType::Uint16:
+        {
+            gatherVertices<DstType, uint16_t>(data, numComponents, numVertices, dst, dstNumComponents, dstStride);
+            break;
+        }
+        case VertexComponentType::Int32:
+        {
+            gatherVertices<DstType, int32_t>(data, numComponents, numVertices, dst, dstNumComponents, dstStride);
+            break;
+        }
+        case VertexComponentType::Uint32:
+        {
+            gatherVertices<DstType, uint32_t>(data, numComponents, numVertices, dst, dstNumComponents, dstStride);
+            break;
+        }
+        default:
+        {
+            LOG_CRITICAL << "Undefined source type";
+            break;
+        }
+    }
+}
+
+static void gatherVertices(
+    const uint8_t* data,
+    uint32_t numComponents,
+    VertexComponentType type,
+    size_t numVertices,
+    uint8_t* dst,
+    uint32_t dstNumComponents,
+    VertexComponentType dstType,
+    size_t dstStride)
+{
+    switch (dstType)
+    {
+        case VertexComponentType::Single:
+        {
+            gatherVertices<float>(data, numComponents, type, numVertices, dst, dstNumComponents, dstStride);
+            break;
+        }
+        case VertexComponentType::Double:
+        {
+            gatherVertices<double>(data, numComponents, type, numVertices, dst, dstNumComponents, dstStride);
+            break;
+        }
+        case VertexComponentType::Int8:
+        {
+            gatherVertices<int8_t>(data, numComponents, type, numVertices, dst, dstNumComponents, dstStride);
+            break;
+        }
+        case VertexComponentType::Uint8:
+        {
+            gatherVertices<uint8_t>(data, numComponents, type, numVertices, dst, dstNumComponents, dstStride);
+            break;
+        }
+        case VertexComponentType::Int16:
+        {
+            gatherVertices<int16_t>(data, numComponents, type, numVertices, dst, dstNumComponents, dstStride);
+            break;
+        }
+        case VertexComponentType::Uint16:
+        {
+            gatherVertices<uint16_t>(data, numComponents, type, numVertices, dst, dstNumComponents, dstStride);
+            break;
+        }
+        case VertexComponentType::Int32:
+        {
+            gatherVertices<int32_t>(data, numComponents, type, numVertices, dst, dstNumComponents, dstStride);
+            break;
+        }
+        case VertexComponentType::Uint32:
+        {
+            gatherVertices<uint32_t>(data, numComponents, type, numVertices, dst, dstNumComponents, dstStride);
+            break;
+        }
+        default:
+        {
+            LOG_CRITICAL << "Undefined destination type";
+            break;
+        }
+    }
+}
+
 template <DrawElementsIndexType DstType, DrawElementsIndexType SrcType>
 inline uint8_t* convertToDrawElementsIndexType(const uint8_t* data, size_t numIndices)
 {
@@ -1009,6 +1182,377 @@ inline BoundingBox calculateBoundingBox(
     return result;
 }
 
+// Quadric error metrics edge collapse simplification of the triangles. Every edge collapses into one of its vertices, so
+// the vertices are kept and only the indices are changed. The vertices sharing the position with other ones (the attribute
+// seams) are locked to avoid the cracks. The error is the root mean square distance to the planes of the collapsed triangles.
+inline std::vector<uint32_t> simplifyTriangles(
+    const std::vector<uint32_t>& indices,
+    const std::vector<glm::vec3>& positions,
+    size_t targetNumIndices,
+    float& error)
+{
+    static constexpr double s_boundaryWeight = 10.;
+    static constexpr double s_minWeight = 1e-12;
+
+    const auto numVertices = positions.size();
+    const auto numTriangles = indices.size() / 3u;
+
+    std::vector<uint32_t> triangles(indices.begin(), indices.begin() + numTriangles * 3u);
+    std::vector<bool> isTriangleAlive(numTriangles, true);
+    std::vector<std::vector<uint32_t>> vertexTriangles(numVertices);
+
+    std::vector<glm::dmat4> quadrics(numVertices, glm::dmat4(0.));
+    std::vector<double> weights(numVertices, 0.);
+
+    auto addPlane = [&quadrics, &weights](uint32_t v, const glm::dvec4& plane, double weight)
+    {
+        quadrics[v] += glm::outerProduct(plane, plane) * weight;
+        weights[v] += weight;
+    };
+
+    // the number of the triangles sharing the edge, the key is the sorted pair of the vertices
+    std::unordered_map<uint64_t, uint32_t> edges;
+    auto edgeKey = [](uint32_t v0, uint32_t v1) { return (uint64_t(glm::min(v0, v1)) << 32u) | uint64_t(glm::max(v0, v1)); };
+
+    for (size_t t = 0u; t < numTriangles; ++t)
+    {
+        const auto* v = triangles.data() + 3u * t;
+        const glm::dvec3 p0(positions[v[0u]]), p1(positions[v[1u]]), p2(positions[v[2u]]);
+        const auto n = glm::cross(p1 - p0, p2 - p0);
+        const auto doubleArea = glm::length(n);
+
+        for (uint32_t i = 0u; i < 3u; ++i)
+        {
+            vertexTriangles[v[i]].push_back(static_cast<uint32_t>(t));
+            ++edges[edgeKey(v[i], v[(i + 1u) % 3u])];
+            if (doubleArea > 0.) addPlane(v[i], glm::dvec4(n / doubleArea, -glm::dot(n, p0) / doubleArea), .5 * doubleArea);
+        }
+    }
+
+    // the boundary edges are kept by the planes perpendicular to their triangles
+    for (size_t t = 0u; t < numTriangles; ++t)
+    {
+        const auto* v = triangles.data() + 3u * t;
+        const glm::dvec3 p0(positions[v[0u]]), p1(positions[v[1u]]), p2(positions[v[2u]]);
+        const auto n = glm::cross(p1 - p0, p2 - p0);
+
+        for (uint32_t i = 0u; i < 3u; ++i)
+        {
+            const auto v0 = v[i], v1 = v[(i + 1u) % 3u];
+            if (edges[edgeKey(v0, v1)] != 1u) continue;
+
+            const glm::dvec3 e0(positions[v0]), e1(positions[v1]);
+            const auto edgeNormal = glm::cross(e1 - e0, n);
+            const auto edgeNormalLength = glm::length(edgeNormal);
+            if (edgeNormalLength <= 0.) continue;
+
+            const auto plane = glm::dvec4(edgeNormal / edgeNormalLength, -glm::dot(edgeNormal, e0) / edgeNormalLength);
+            const auto weight = s_boundaryWeight * glm::dot(e1 - e0, e1 - e0);
+            addPlane(v0, plane, weight);
+            addPlane(v1, plane, weight);
+        }
+    }
+
+    std::vector<bool> isVertexLocked(numVertices, false);
+    {
+        std::vector<uint32_t> sortedVertices(numVertices);
+        for (uint32_t i = 0u; i < numVertices; ++i)
+            sortedVertices[i] = i;
+
+        auto less = [&positions](uint32_t v0, uint32_t v1)
+        {
+            const auto &p0 = positions[v0], &p1 = positions[v1];
+            return (p0.x < p1.x) || ((p0.x == p1.x) && ((p0.y < p1.y) || ((p0.y == p1.y) && (p0.z < p1.z))));
+        };
+        std::sort(sortedVertices.begin(), sortedVertices.end(), less);
+
+        for (size_t i = 1u; i < numVertices; ++i)
+        {
+            if (positions[sortedVertices[i - 1u]] == positions[sortedVertices[i]])
+                isVertexLocked[sortedVertices[i - 1u]] = isVertexLocked[sortedVertices[i]] = true;
+        }
+    }
+
+    struct Collapse
+    {
+        double cost;
+        uint32_t from, to;
+        uint32_t fromVersion, toVersion;
+        bool operator<(const Collapse& other) const { return cost > other.cost; }
+    };
+
+    std::vector<uint32_t> versions(numVertices, 0u);
+    std::vector<bool> isVertexRemoved(numVertices, false);
+    std::priority_queue<Collapse> collapses;
+
+    auto pushCollapse = [&](uint32_t from, uint32_t to)
+    {
+        if (isVertexLocked[from]) return;
+
+        const auto p = glm::dvec4(glm::dvec3(positions[to]), 1.);
+        const auto cost = glm::max(glm::dot(p, (quadrics[from] + quadrics[to]) * p), 0.) /
+                          glm::max(weights[from] + weights[to], s_minWeight);
+        collapses.push({cost, from, to, versions[from], versions[to]});
+    };
+
+    for (const auto& [key, count] : edges)
+    {
+        const auto v0 = static_cast<uint32_t>(key >> 32u), v1 = static_cast<uint32_t>(key & 0xFFFFFFFFu);
+        pushCollapse(v0, v1);
+        pushCollapse(v1, v0);
+    }
+
+    auto neighbors = [&](uint32_t v)
+    {
+        std::vector<uint32_t> result;
+        for (auto t : vertexTriangles[v])
+        {
+            if (!isTriangleAlive[t]) continue;
+            for (uint32_t i = 0u; i < 3u; ++i)
+                if (triangles[3u * t + i] != v) result.push_back(triangles[3u * t + i]);
+        }
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        return result;
+    };
+
+    auto isCollapseValid = [&](uint32_t from, uint32_t to)
+    {
+        uint32_t numSharedTriangles = 0u;
+        for (auto t : vertexTriangles[from])
+        {
+            if (!isTriangleAlive[t]) continue;
+
+            auto* v = triangles.data() + 3u * t;
+            if ((v[0u] == to) || (v[1u] == to) || (v[2u] == to))
+            {
+                ++numSharedTriangles;
+                continue;
+            }
+
+            // the triangle must not flip
+            glm::vec3 p[3u] = {positions[v[0u]], positions[v[1u]], positions[v[2u]]};
+            const auto nOld = glm::cross(p[1u] - p[0u], p[2u] - p[0u]);
+            for (uint32_t i = 0u; i < 3u; ++i)
+                if (v[i] == from) p[i] = positions[to];
+            const auto nNew = glm::cross(p[1u] - p[0u], p[2u] - p[0u]);
+            if (glm::dot(nOld, nNew) <= 0.f) return false;
+        }
+
+        // the link condition keeps the surface manifold
+        const auto fromNeighbors = neighbors(from), toNeighbors = neighbors(to);
+        std::vector<uint32_t> sharedNeighbors;
+        std::set_intersection(fromNeighbors.begin(), fromNeighbors.end(), toNeighbors.begin(), toNeighbors.end(),
+                              std::back_inserter(sharedNeighbors));
+        return sharedNeighbors.size() <= numSharedTriangles;
+    };
+
+    size_t numAliveTriangles = numTriangles;
+    double maxCost = 0.;
+
+    while ((numAliveTriangles * 3u > targetNumIndices) && !collapses.empty())
+    {
+        const auto collapse = collapses.top();
+        collapses.pop();
+
+        const auto from = collapse.from, to = collapse.to;
+        if (isVertexRemoved[from] || isVertexRemoved[to] || (versions[from] != collapse.fromVersion) ||
+            (versions[to] != collapse.toVersion) || !isCollapseValid(from, to))
+            continue;
+
+        for (auto t : vertexTriangles[from])
+        {
+            if (!isTriangleAlive[t]) continue;
+
+            auto* v = triangles.data() + 3u * t;
+            if ((v[0u] == to) || (v[1u] == to) || (v[2u] == to))
+            {
+                isTriangleAlive[t] = false;
+                --numAliveTriangles;
+                continue;
+            }
+
+            for (uint32_t i = 0u; i < 3u; ++i)
+                if (v[i] == from) v[i] = to;
+            vertexTriangles[to].push_back(t);
+        }
+        vertexTriangles[from].clear();
+
+        quadrics[to] += quadrics[from];
+        weights[to] += weights[from];
+        isVertexRemoved[from] = true;
+        ++versions[to];
+        maxCost = glm::max(maxCost, collapse.cost);
+
+        for (auto v : neighbors(to))
+        {
+            pushCollapse(v, to);
+            pushCollapse(to, v);
+        }
+    }
+
+    error = static_cast<float>(glm::sqrt(maxCost));
+
+    std::vector<uint32_t> result;
+    result.reserve(numAliveTriangles * 3u);
+    for (size_t t = 0u; t < numTriangles; ++t)
+        if (isTriangleAlive[t]) result.insert(result.end(), triangles.begin() + 3u * t, triangles.begin() + 3u * (t + 1u));
+
+    return result;
+}
+
+// reorders the triangles, so every meshlet is a contiguous range of the neighbour triangles
+inline std::vector<Meshlet> buildMeshlets(
+    std::vector<uint32_t>& indices,
+    const std::vector<glm::vec3>& positions,
+    size_t maxNumTriangles)
+{
+    // a normals cone wider than ~84 degrees culls almost nothing
+    static constexpr float s_minConeCosine = .1f;
+
+    const auto numTriangles = indices.size() / 3u;
+    if (!numTriangles || !maxNumTriangles) return {};
+
+    // the vertices split by the normals or the tex coords are welded, so the triangles around the seams are neighbours
+    std::vector<uint32_t> weldedVertices(positions.size());
+    std::unordered_map<uint64_t, std::vector<uint32_t>> positionVertices;
+    for (uint32_t v = 0u; v < positions.size(); ++v)
+    {
+        const auto hash = hashData(hashSeed(), glm::value_ptr(positions[v]), sizeof(glm::vec3));
+        auto& sameHashVertices = positionVertices[hash];
+
+        auto it = std::find_if(
+            sameHashVertices.begin(),
+            sameHashVertices.end(),
+            [&positions, v](uint32_t w) { return positions[w] == positions[v]; });
+        if (it == sameHashVertices.end()) it = sameHashVertices.insert(sameHashVertices.end(), v);
+        weldedVertices[v] = *it;
+    }
+
+    std::vector<uint32_t> vertexTrianglesOffsets(positions.size() + 1u, 0u);
+    for (size_t i = 0u; i < numTriangles * 3u; ++i)
+        ++vertexTrianglesOffsets[weldedVertices[indices[i]] + 1u];
+    for (size_t v = 0u; v < positions.size(); ++v)
+        vertexTrianglesOffsets[v + 1u] += vertexTrianglesOffsets[v];
+
+    std::vector<uint32_t> vertexTriangles(numTriangles * 3u);
+    auto vertexTrianglesEnds = vertexTrianglesOffsets;
+    for (size_t i = 0u; i < numTriangles * 3u; ++i)
+        vertexTriangles[vertexTrianglesEnds[weldedVertices[indices[i]]]++] = static_cast<uint32_t>(i / 3u);
+
+    std::vector<glm::vec3> triangleCenters(numTriangles);
+    for (size_t t = 0u; t < numTriangles; ++t)
+        triangleCenters[t] =
+            (positions[indices[3u * t]] + positions[indices[3u * t + 1u]] + positions[indices[3u * t + 2u]]) / 3.f;
+
+    std::vector<uint32_t> order;
+    order.reserve(numTriangles);
+
+    std::vector<Meshlet> result;
+    std::vector<bool> isTriangleUsed(numTriangles, false);
+    std::vector<size_t> triangleCandidateStamps(numTriangles, std::numeric_limits<size_t>::max());
+    std::vector<uint32_t> candidates;
+
+    // the meshlet grows from the first unused triangle by the neighbour triangle nearest to its centroid
+    for (uint32_t seed = 0u; order.size() < numTriangles;)
+    {
+        while (isTriangleUsed[seed])
+            ++seed;
+
+        const auto meshletID = result.size();
+        const auto firstTriangle = order.size();
+        auto centroidSum = glm::vec3(0.f);
+
+        candidates.assign(1u, seed);
+        triangleCandidateStamps[seed] = meshletID;
+
+        while (!candidates.empty() && (order.size() - firstTriangle < maxNumTriangles))
+        {
+            size_t bestCandidate = 0u;
+            if (order.size() > firstTriangle)
+            {
+                const auto centroid = centroidSum / static_cast<float>(order.size() - firstTriangle);
+                auto bestDistance = std::numeric_limits<float>::max();
+                for (size_t i = 0u; i < candidates.size(); ++i)
+                {
+                    if (const auto distance = glm::distance2(centroid, triangleCenters[candidates[i]]); distance < bestDistance)
+                    {
+                        bestDistance = distance;
+                        bestCandidate = i;
+                    }
+                }
+            }
+
+            const auto t = candidates[bestCandidate];
+            candidates[bestCandidate] = candidates.back();
+            candidates.pop_back();
+
+            isTriangleUsed[t] = true;
+            order.push_back(t);
+            centroidSum += triangleCenters[t];
+
+            for (uint32_t i = 0u; i < 3u; ++i)
+            {
+                const auto v = weldedVertices[indices[3u * t + i]];
+                for (auto j = vertexTrianglesOffsets[v]; j < vertexTrianglesOffsets[v + 1u]; ++j)
+                {
+                    const auto neighbour = vertexTriangles[j];
+                    if (isTriangleUsed[neighbour] || (triangleCandidateStamps[neighbour] == meshletID)) continue;
+
+                    triangleCandidateStamps[neighbour] = meshletID;
+                    candidates.push_back(neighbour);
+                }
+            }
+        }
+
+        // the bounding sphere is centered in the bounding box of the meshlet
+        BoundingBox bb;
+        auto coneAxis = glm::vec3(0.f);
+        std::vector<glm::vec3> normals;
+        normals.reserve(order.size() - firstTriangle);
+        for (auto i = firstTriangle; i < order.size(); ++i)
+        {
+            const auto* v = indices.data() + 3u * order[i];
+            for (uint32_t j = 0u; j < 3u; ++j)
+                bb += positions[v[j]];
+
+            const auto n = glm::cross(positions[v[1u]] - positions[v[0u]], positions[v[2u]] - positions[v[0u]]);
+            if (const auto nLength = glm::length(n); nLength > 0.f)
+            {
+                normals.push_back(n / nLength);
+                coneAxis += normals.back();
+            }
+        }
+
+        const auto center = bb.center();
+        float radius = 0.f;
+        for (auto i = firstTriangle; i < order.size(); ++i)
+            for (uint32_t j = 0u; j < 3u; ++j)
+                radius = glm::max(radius, glm::distance(center, positions[indices[3u * order[i] + j]]));
+
+        float coneCosine = -1.f;
+        if (const auto coneAxisLength = glm::length(coneAxis); coneAxisLength > 0.f)
+        {
+            coneAxis /= coneAxisLength;
+            coneCosine = 1.f;
+            for (const auto& n : normals)
+                coneCosine = glm::min(coneCosine, glm::dot(coneAxis, n));
+        }
+
+        result.push_back({3u * firstTriangle,
+                          3u * (order.size() - firstTriangle),
+                          glm::vec4(center, radius),
+                          glm::vec4(coneAxis, (coneCosine > s_minConeCosine) ? glm::sqrt(1.f - coneCosine * coneCosine) : 1.f)});
+    }
+
+    std::vector<uint32_t> reorderedIndices(numTriangles * 3u);
+    for (size_t i = 0u; i < numTriangles; ++i)
+        std::copy_n(indices.begin() + 3u * order[i], 3u, reorderedIndices.begin() + 3u * i);
+    std::copy(reorderedIndices.begin(), reorderedIndices.end(), indices.begin());
+
+    return result;
+}
+
 } // namespace utils
 } // namespace simplex
 
@@ -1,5 +1,6 @@
-#include <optional>
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 #include <utils/logger.h>
 #include <utils/shader.h>
@@ -14,6 +15,68 @@ std::string Shader::s_version = "460 core";
 std::unordered_set<std::string> Shader::s_extensions{"GL_ARB_bindless_texture"};
 bool Shader::s_printDebugShaders = false;
 
+// The content of a file is split by its #include<...> directives. Included files are expanded only once per shader,
+// so the content is cached unexpanded and the expansion is rebuilt from the cache for each shader
+struct ShaderFile
+{
+    std::filesystem::file_time_type lastWriteTime;
+    std::vector<std::string> chunks; // chunks.size() == includedFilenames.size() + 1
+    std::vector<std::filesystem::path> includedFilenames; // canonical
+};
+
+static std::shared_ptr<const ShaderFile> loadShaderFile(const std::filesystem::path& absoluteFilename)
+{
+    static const std::string includeString = "#include<";
+    static const std::string closedBracket = ">";
+
+    static std::unordered_map<std::string, std::shared_ptr<const ShaderFile>> s_cache;
+
+    std::error_code errorCode;
+    auto lastWriteTime = std::filesystem::last_write_time(absoluteFilename, errorCode);
+    if (errorCode) return nullptr;
+
+    auto& cachedFile = s_cache[absoluteFilename.string()];
+    if (cachedFile && (cachedFile->lastWriteTime == lastWriteTime)) return cachedFile;
+    cachedFile = nullptr;
+
+    auto textFile = TextFile::loadFromFile(absoluteFilename);
+    if (!textFile) return nullptr;
+
+    const auto& data = textFile->data();
+    const auto dir = absoluteFilename.parent_path();
+
+    auto result = std::make_shared<ShaderFile>();
+    result->lastWriteTime = lastWriteTime;
+
+    size_t chunkBegin = 0u;
+    for (auto pos = data.find(includeString); pos != std::string::npos; pos = data.find(includeString, chunkBegin))
+    {
+        auto pos2 = data.find(closedBracket, pos);
+        if (pos2 == std::string::npos)
+        {
+            LOG_ERROR << "Shader file " << absoluteFilename << ": Wrong order '<' and '>' in #include";
+            return nullptr;
+        }
+
+        auto pos1 = pos + includeString.length();
+        auto includedPath = std::filesystem::path(data.substr(pos1, pos2 - pos1));
+        auto includedFilename = std::filesystem::canonical(includedPath.is_absolute() ? includedPath : dir / includedPath, errorCode);
+        if (errorCode)
+        {
+            LOG_ERROR << "Shader file " << absoluteFilename << ": Can't open included file " << includedPath;
+            return nullptr;
+        }
+
+        result->chunks.push_back(data.substr(chunkBegin, pos - chunkBegin));
+        result->includedFilenames.push_back(std::move(includedFilename));
+        chunkBegin = pos2 + 1u;
+    }
+    result->chunks.push_back(data.substr(chunkBegin));
+
+    cachedFile = result;
+    return result;
+}
+
 Shader::Shader() {}
 
 Shader::~Shader() = default;
@@ -63,58 +126,36 @@ std::shared_ptr<Shader> Shader::loadFromData(const std::string& data)
 std::shared_ptr<Shader> Shader::loadFromFile(const std::filesystem::path& filename, const ShaderDefines& defines)
 {
     static const std::string versionString = "#version";
-    static const std::string includeString = "#include<";
-    static const std::string closedBracket = ">";
 
-    static const auto includeProccess = [](const auto& self, const std::string& srcData, const std::filesystem::path& filename,
-                                           const std::filesystem::path& dir,
-                                           std::set<std::filesystem::path>& includedFiles) -> std::optional<std::string>
+    static const auto includeProccess = [](const auto& self, const std::shared_ptr<const ShaderFile>& shaderFile,
+                                           std::set<std::filesystem::path>& includedFiles, std::string& result) -> bool
     {
-        std::string result = srcData;
+        result += shaderFile->chunks.front();
 
-        for (auto pos = result.find(includeString); pos != std::string::npos; pos = result.find(includeString, pos))
+        for (size_t i = 0u; i < shaderFile->includedFilenames.size(); ++i)
         {
-            auto pos2 = result.find(closedBracket, pos);
-            if (pos2 == std::string::npos)
-            {
-                LOG_ERROR << "Shader file " << filename << ": Wrong order '<' and '>' in #include";
-                return std::nullopt;
-            }
-
-            auto pos1 = pos + includeString.length();
-            auto includedPath = std::filesystem::path(result.substr(pos1, pos2 - pos1));
-            std::filesystem::path includedFilename = includedPath.is_absolute() ? includedPath : dir / includedPath;
-            includedFilename = std::filesystem::canonical(includedFilename);
-
-            if (includedFiles.count(includedFilename))
-            {
-                result.replace(pos, pos2 - pos + 1, "");
-                continue;
-            }
-            includedFiles.insert(includedFilename);
-
-            auto includedFile = TextFile::loadFromFile(includedFilename);
-            if (!includedFile)
-            {
-                LOG_ERROR << "Shader file " << filename << ": Can't open included file " << includedFilename;
-                return std::nullopt;
-            }
-
-            auto includedData = self(self, includedFile->data(), includedPath, includedFilename.parent_path(), includedFiles);
-            if (!includedData.has_value())
+            const auto& includedFilename = shaderFile->includedFilenames[i];
+            if (includedFiles.insert(includedFilename).second)
             {
-                return std::nullopt;
+                auto includedFile = loadShaderFile(includedFilename);
+                if (!includedFile)
+                {
+                    LOG_ERROR << "Can't open included file " << includedFilename;
+                    return false;
+                }
+
+                if (!self(self, includedFile, includedFiles, result)) return false;
             }
 
-            result.replace(pos, pos2 - pos + 1, includedData.value());
+            result += shaderFile->chunks[i + 1u];
         }
 
-        return result;
+        return true;
     };
 
     auto absoluteFilename = std::filesystem::canonical(filename);
 
-    auto shaderFile = TextFile::loadFromFile(absoluteFilename);
+    auto shaderFile = loadShaderFile(absoluteFilename);
     if (!shaderFile)
     {
         LOG_ERROR << "Can't open shader file " << absoluteFilename;
@@ -124,17 +165,13 @@ std::shared_ptr<Shader> Shader::loadFromFile(const std::filesystem::path& filena
     auto result = std::make_shared<Shader>();
 
     std::set<std::filesystem::path> includedFiles;
-    includedFiles.insert(std::filesystem::canonical(absoluteFilename));
+    includedFiles.insert(absoluteFilename);
 
-    if (auto includedData =
-            includeProccess(includeProccess, shaderFile->data(), absoluteFilename, absoluteFilename.parent_path(), includedFiles);
-        !includedData.has_value())
+    if (!includeProccess(includeProccess, shaderFile, includedFiles, result->m_data))
     {
         LOG_ERROR << "Shader file " << absoluteFilename << " parse error";
         return nullptr;
     }
-    else
-        result->m_data = std::move(includedData.value());
 
     if (!defines.empty()) result->m_data.insert(0, "\n");
     for (const auto& define : defines)
@@ -0,0 +1,392 @@
+#include <array>
+#include <limits>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include <utils/idgenerator.h>
+#include <utils/logger.h>
+#include <utils/tlsfallocator.h>
+
+namespace simplex
+{
+namespace utils
+{
+
+static uint32_t leastSignificantBit(uint64_t value)
+{
+#if defined(_MSC_VER)
+    unsigned long result = 0u;
+    _BitScanForward64(&result, value);
+    return static_cast<uint32_t>(result);
+#else
+    return static_cast<uint32_t>(__builtin_ctzll(value));
+#endif
+}
+
+static uint32_t mostSignificantBit(uint64_t value)
+{
+#if defined(_MSC_VER)
+    unsigned long result = 0u;
+    _BitScanReverse64(&result, value);
+    return static_cast<uint32_t>(result);
+#else
+    return static_cast<uint32_t>(63 - __builtin_clzll(value));
+#endif
+}
+
+// open addressing table of the allocated blocks by their offsets, it doesn't allocate memory per entry
+class AllocatedBlocksTable
+{
+public:
+    using BlockID = IDsGenerator::value_type;
+
+    void clear()
+    {
+        m_slots.assign(MinCapacity, {EmptyOffset, IDsGenerator::last()});
+        m_count = 0u;
+    }
+
+    BlockID find(size_t offset) const
+    {
+        for (auto i = slotIndex(offset);; i = (i + 1u) & (m_slots.size() - 1u))
+        {
+            if (m_slots[i].first == offset) return m_slots[i].second;
+            if (m_slots[i].first == EmptyOffset) return IDsGenerator::last();
+        }
+    }
+
+    void insert(size_t offset, BlockID blockID)
+    {
+        if (2u * (m_count + 1u) > m_slots.size()) rehash(2u * m_slots.size());
+
+        auto i = slotIndex(offset);
+        while (m_slots[i].first != EmptyOffset)
+            i = (i + 1u) & (m_slots.size() - 1u);
+
+        m_slots[i] = {offset, blockID};
+        ++m_count;
+    }
+
+    // the following entries of the probe sequence are shifted back, so no tombstones are needed
+    void erase(size_t offset)
+    {
+        const auto mask = m_slots.size() - 1u;
+
+        auto i = slotIndex(offset);
+        while (m_slots[i].first != offset)
+        {
+            if (m_slots[i].first == EmptyOffset) return;
+            i = (i + 1u) & mask;
+        }
+
+        for (auto j = (i + 1u) & mask; m_slots[j].first != EmptyOffset; j = (j + 1u) & mask)
+        {
+            if (((j - slotIndex(m_slots[j].first)) & mask) >= ((j - i) & mask))
+            {
+                m_slots[i] = m_slots[j];
+                i = j;
+            }
+        }
+
+        m_slots[i] = {EmptyOffset, IDsGenerator::last()};
+        --m_count;
+    }
+
+private:
+    static constexpr size_t MinCapacity = 64u;
+    static constexpr size_t EmptyOffset = std::numeric_limits<size_t>::max();
+
+    size_t slotIndex(size_t offset) const
+    {
+        return static_cast<size_t>((static_cast<uint64_t>(offset) * 0x9E3779B97F4A7C15ull) >> 32u) & (m_slots.size() - 1u);
+    }
+
+    void rehash(size_t capacity)
+    {
+        auto slots = std::move(m_slots);
+        m_slots.assign(capacity, {EmptyOffset, IDsGenerator::last()});
+        m_count = 0u;
+
+        for (const auto& slot : slots)
+            if (slot.first != EmptyOffset) insert(slot.first, slot.second);
+    }
+
+    std::vector<std::pair<size_t, BlockID>> m_slots;
+    size_t m_count = 0u;
+};
+
+struct TLSFAllocatorPrivate
+{
+    static constexpr uint32_t SLLog2 = 5u;
+    static constexpr uint32_t SLCount = 1u << SLLog2;
+    static constexpr uint32_t FLCount = 64u - SLLog2 + 1u;
+
+    using BlockID = IDsGenerator::value_type;
+
+    // the blocks cover [0, size) without gaps, the physical links are used to coalesce the free neighbors
+    struct Block
+    {
+        size_t offset;
+        size_t count;
+        BlockID physicalPrev;
+        BlockID physicalNext;
+        BlockID freePrev;
+        BlockID freeNext;
+        bool isFree;
+    };
+
+    size_t size = 0u;
+    size_t freeSize = 0u;
+    size_t freeBlocksCount = 0u;
+
+    uint64_t FLBitmap = 0u;
+    std::array<uint32_t, FLCount> SLBitmaps{};
+    std::array<std::array<BlockID, SLCount>, FLCount> heads;
+
+    std::vector<Block> blocks;
+    IDsGenerator blockIDsGenerator;
+    BlockID lastBlock = IDsGenerator::last();
+    AllocatedBlocksTable allocatedBlocks; // to find the freed blocks and to reject the frees of not allocated ranges
+
+    TLSFAllocatorPrivate() { clear(); }
+
+    void clear()
+    {
+        size = 0u;
+        freeSize = 0u;
+        freeBlocksCount = 0u;
+        FLBitmap = 0u;
+        SLBitmaps.fill(0u);
+        for (auto& SLHeads : heads)
+            SLHeads.fill(IDsGenerator::last());
+        blocks.clear();
+        blockIDsGenerator = IDsGenerator();
+        lastBlock = IDsGenerator::last();
+        allocatedBlocks.clear();
+    }
+
+    static void mapping(size_t count, uint32_t& FL, uint32_t& SL)
+    {
+        if (count < SLCount)
+        {
+            FL = 0u;
+            SL = static_cast<uint32_t>(count);
+        }
+        else
+        {
+            const auto MSB = mostSignificantBit(count);
+            FL = MSB - SLLog2 + 1u;
+            SL = static_cast<uint32_t>(count >> (MSB - SLLog2)) ^ SLCount;
+        }
+    }
+
+    // rounds the count up to the next list, so any block of the found list fits
+    static void searchMapping(size_t count, uint32_t& FL, uint32_t& SL)
+    {
+        if (count >= SLCount) count += (size_t(1u) << (mostSignificantBit(count) - SLLog2)) - 1u;
+        mapping(count, FL, SL);
+    }
+
+    BlockID findSuitableBlock(size_t count) const
+    {
+        uint32_t FL, SL;
+        searchMapping(count, FL, SL);
+        if (FL >= FLCount) return IDsGenerator::last();
+
+        auto SLMap = SLBitmaps[FL] & (~0u << SL);
+        if (!SLMap)
+        {
+            const auto FLMap = (FL + 1u < 64u) ? (FLBitmap & (~uint64_t(0u) << (FL + 1u))) : uint64_t(0u);
+            if (!FLMap) return IDsGenerator::last();
+
+            FL = leastSignificantBit(FLMap);
+            SLMap = SLBitmaps[FL];
+        }
+
+        return heads[FL][leastSignificantBit(SLMap)];
+    }
+
+    BlockID createBlock(size_t offset, size_t count, BlockID physicalPrev, BlockID physicalNext)
+    {
+        const auto blockID = blockIDsGenerator.generate();
+        if (blockID >= blocks.size()) blocks.resize(static_cast<size_t>(blockID) + 1u);
+
+        blocks[blockID] = {offset, count, physicalPrev, physicalNext, IDsGenerator::last(), IDsGenerator::last(), false};
+        if (physicalPrev != IDsGenerator::last()) blocks[physicalPrev].physicalNext = blockID;
+        if (physicalNext != IDsGenerator::last()) blocks[physicalNext].physicalPrev = blockID;
+        else lastBlock = blockID;
+
+        return blockID;
+    }
+
+    void destroyBlock(BlockID blockID)
+    {
+        const auto& block = blocks[blockID];
+        if (block.physicalPrev != IDsGenerator::last()) blocks[block.physicalPrev].physicalNext = block.physicalNext;
+        if (block.physicalNext != IDsGenerator::last()) blocks[block.physicalNext].physicalPrev = block.physicalPrev;
+        else lastBlock = block.physicalPrev;
+
+        blockIDsGenerator.clear(blockID);
+    }
+
+    void insertFreeBlock(BlockID blockID)
+    {
+        auto& block = blocks[blockID];
+
+        uint32_t FL, SL;
+        mapping(block.count, FL, SL);
+
+        auto& head = heads[FL][SL];
+        block.freePrev = IDsGenerator::last();
+        block.freeNext = head;
+        block.isFree = true;
+        if (head != IDsGenerator::last()) blocks[head].freePrev = blockID;
+        head = blockID;
+
+        FLBitmap |= uint64_t(1u) << FL;
+        SLBitmaps[FL] |= 1u << SL;
+
+        ++freeBlocksCount;
+    }
+
+    void removeFreeBlock(BlockID blockID)
+    {
+        auto& block = blocks[blockID];
+
+        uint32_t FL, SL;
+        mapping(block.count, FL, SL);
+
+        if (block.freePrev != IDsGenerator::last()) blocks[block.freePrev].freeNext = block.freeNext;
+        if (block.freeNext != IDsGenerator::last()) blocks[block.freeNext].freePrev = block.freePrev;
+
+        if (auto& head = heads[FL][SL]; head == blockID)
+        {
+            head = block.freeNext;
+            if (head == IDsGenerator::last())
+            {
+                SLBitmaps[FL] &= ~(1u << SL);
+                if (!SLBitmaps[FL]) FLBitmap &= ~(uint64_t(1u) << FL);
+            }
+        }
+
+        block.isFree = false;
+
+        --freeBlocksCount;
+    }
+};
+
+TLSFAllocator::TLSFAllocator()
+    : m_(std::make_unique<TLSFAllocatorPrivate>())
+{
+}
+
+TLSFAllocator::~TLSFAllocator() = default;
+
+size_t TLSFAllocator::size() const
+{
+    return m_->size;
+}
+
+size_t TLSFAllocator::freeSize() const
+{
+    return m_->freeSize;
+}
+
+size_t TLSFAllocator::freeBlocksCount() const
+{
+    return m_->freeBlocksCount;
+}
+
+size_t TLSFAllocator::allocate(size_t count)
+{
+    if (!count) return invalidOffset();
+
+    auto blockID = m_->findSuitableBlock(count);
+    if (blockID == IDsGenerator::last())
+    {
+        blockID = m_->createBlock(m_->size, count, m_->lastBlock, IDsGenerator::last());
+        m_->size += count;
+    }
+    else
+    {
+        m_->removeFreeBlock(blockID);
+
+        // the tail of the free block is allocated, the rest of it stays free
+        if (auto& block = m_->blocks[blockID]; block.count > count)
+        {
+            block.count -= count;
+            m_->insertFreeBlock(blockID);
+            blockID = m_->createBlock(block.offset + block.count, count, blockID, block.physicalNext);
+        }
+
+        m_->freeSize -= count;
+    }
+
+    const auto result = m_->blocks[blockID].offset;
+    m_->allocatedBlocks.insert(result, blockID);
+
+    return result;
+}
+
+void TLSFAllocator::free(size_t offset, size_t count)
+{
+    if (!count) return;
+
+    if (offset + count > m_->size)
+    {
+        LOG_CRITICAL << "The memory is out of range";
+        return;
+    }
+
+    // only whole allocated blocks can be freed, it also rejects double frees and the ranges overlapping free blocks
+    auto blockID = m_->allocatedBlocks.find(offset);
+    if ((blockID == IDsGenerator::last()) || (m_->blocks[blockID].count != count))
+    {
+        LOG_CRITICAL << "The memory is not allocated to be freed";
+        return;
+    }
+    m_->allocatedBlocks.erase(offset);
+    m_->freeSize += count;
+
+    if (const auto prevID = m_->blocks[blockID].physicalPrev; (prevID != IDsGenerator::last()) && m_->blocks[prevID].isFree)
+    {
+        m_->removeFreeBlock(prevID);
+        m_->blocks[prevID].count += m_->blocks[blockID].count;
+        m_->destroyBlock(blockID);
+        blockID = prevID;
+    }
+
+    if (const auto nextID = m_->blocks[blockID].physicalNext; (nextID != IDsGenerator::last()) && m_->blocks[nextID].isFree)
+    {
+        m_->removeFreeBlock(nextID);
+        m_->blocks[blockID].count += m_->blocks[nextID].count;
+        m_->destroyBlock(nextID);
+    }
+
+    if (blockID == m_->lastBlock)
+    {
+        m_->size = m_->blocks[blockID].offset;
+        m_->freeSize -= m_->blocks[blockID].count;
+        m_->destroyBlock(blockID);
+    }
+    else
+    {
+        m_->insertFreeBlock(blockID);
+    }
+}
+
+void TLSFAllocator::clear()
+{
+    m_->clear();
+}
+
+size_t TLSFAllocator::invalidOffset()
+{
+    return std::numeric_limits<size_t>::max();
+}
+
+} // namespace utils
+} // namespace simplex